@@ -0,0 +1,32 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/Atom.cpp" "CMakeFiles/HtmlParser.dir/src/Atom.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/Atom.cpp.o.d"
+  "/root/repo/src/CharacterReferences.cpp" "CMakeFiles/HtmlParser.dir/src/CharacterReferences.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/CharacterReferences.cpp.o.d"
+  "/root/repo/src/DOM.cpp" "CMakeFiles/HtmlParser.dir/src/DOM.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/DOM.cpp.o.d"
+  "/root/repo/src/Encoding.cpp" "CMakeFiles/HtmlParser.dir/src/Encoding.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/Encoding.cpp.o.d"
+  "/root/repo/src/Escape.cpp" "CMakeFiles/HtmlParser.dir/src/Escape.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/Escape.cpp.o.d"
+  "/root/repo/src/Instrumentation.cpp" "CMakeFiles/HtmlParser.dir/src/Instrumentation.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/Instrumentation.cpp.o.d"
+  "/root/repo/src/MappedFile.cpp" "CMakeFiles/HtmlParser.dir/src/MappedFile.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/MappedFile.cpp.o.d"
+  "/root/repo/src/Node.cpp" "CMakeFiles/HtmlParser.dir/src/Node.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/Node.cpp.o.d"
+  "/root/repo/src/Parser.cpp" "CMakeFiles/HtmlParser.dir/src/Parser.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/Parser.cpp.o.d"
+  "/root/repo/src/Query.cpp" "CMakeFiles/HtmlParser.dir/src/Query.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/Query.cpp.o.d"
+  "/root/repo/src/Serializer.cpp" "CMakeFiles/HtmlParser.dir/src/Serializer.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/Serializer.cpp.o.d"
+  "/root/repo/src/Snapshot.cpp" "CMakeFiles/HtmlParser.dir/src/Snapshot.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/Snapshot.cpp.o.d"
+  "/root/repo/src/TextExtractor.cpp" "CMakeFiles/HtmlParser.dir/src/TextExtractor.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/TextExtractor.cpp.o.d"
+  "/root/repo/src/Tokenizer.cpp" "CMakeFiles/HtmlParser.dir/src/Tokenizer.cpp.o" "gcc" "CMakeFiles/HtmlParser.dir/src/Tokenizer.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
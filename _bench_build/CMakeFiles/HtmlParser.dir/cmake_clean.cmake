@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/HtmlParser.dir/src/Atom.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/Atom.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/CharacterReferences.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/CharacterReferences.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/DOM.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/DOM.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/Encoding.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/Encoding.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/Escape.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/Escape.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/Instrumentation.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/Instrumentation.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/MappedFile.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/MappedFile.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/Node.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/Node.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/Parser.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/Parser.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/Query.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/Query.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/Serializer.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/Serializer.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/Snapshot.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/Snapshot.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/TextExtractor.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/TextExtractor.cpp.o.d"
+  "CMakeFiles/HtmlParser.dir/src/Tokenizer.cpp.o"
+  "CMakeFiles/HtmlParser.dir/src/Tokenizer.cpp.o.d"
+  "libHtmlParser.a"
+  "libHtmlParser.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/HtmlParser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,97 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/benchmarks/CMakeLists.txt"
+  "/root/repo/benchmarks/Suite/CMakeLists.txt"
+  "/root/repo/examples/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmarks/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmarks/Suite/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/HtmlParser.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/ConcurrentQueryBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/DeeplyNestedHtmlBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/DiffBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/EntityDecodingBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/EscapeHtmlBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/HeadOnlyParseBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/NameInterningBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/ParserInitializationBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/PrettyPrintedParseBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/ReparseBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/RewriteBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/ScriptHeavyParseBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/SerializeBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/SimpleParseBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/SnapshotBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/TemplateCloneBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/TextExtractionBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/TokenizerThroughputBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/TranscodingBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/UnmatchedEndTagBenchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/ZeroCopyBenchmark.dir/DependInfo.cmake"
+  "benchmarks/Suite/CMakeFiles/ParseSuite.dir/DependInfo.cmake"
+  "examples/CMakeFiles/ExtractTextContent.dir/DependInfo.cmake"
+  "examples/CMakeFiles/GetElementById.dir/DependInfo.cmake"
+  "examples/CMakeFiles/GetElementsByClassName.dir/DependInfo.cmake"
+  "examples/CMakeFiles/HandleMalformedHtml.dir/DependInfo.cmake"
+  "examples/CMakeFiles/ModifyAttributes.dir/DependInfo.cmake"
+  "examples/CMakeFiles/ParseAndSerialize.dir/DependInfo.cmake"
+  "examples/CMakeFiles/ParseHtmlFragment.dir/DependInfo.cmake"
+  "examples/CMakeFiles/QuerySelectors.dir/DependInfo.cmake"
+  "examples/CMakeFiles/RemoveElement.dir/DependInfo.cmake"
+  "examples/CMakeFiles/TraverseDOM.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ConcurrentQueryBenchmark.dir/ConcurrentQueryBenchmark.cpp.o"
+  "CMakeFiles/ConcurrentQueryBenchmark.dir/ConcurrentQueryBenchmark.cpp.o.d"
+  "ConcurrentQueryBenchmark"
+  "ConcurrentQueryBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ConcurrentQueryBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DeeplyNestedHtmlBenchmark.dir/DeeplyNestedHtmlBenchmark.cpp.o"
+  "CMakeFiles/DeeplyNestedHtmlBenchmark.dir/DeeplyNestedHtmlBenchmark.cpp.o.d"
+  "DeeplyNestedHtmlBenchmark"
+  "DeeplyNestedHtmlBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DeeplyNestedHtmlBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DiffBenchmark.dir/DiffBenchmark.cpp.o"
+  "CMakeFiles/DiffBenchmark.dir/DiffBenchmark.cpp.o.d"
+  "DiffBenchmark"
+  "DiffBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DiffBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/EntityDecodingBenchmark.dir/EntityDecodingBenchmark.cpp.o"
+  "CMakeFiles/EntityDecodingBenchmark.dir/EntityDecodingBenchmark.cpp.o.d"
+  "EntityDecodingBenchmark"
+  "EntityDecodingBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/EntityDecodingBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
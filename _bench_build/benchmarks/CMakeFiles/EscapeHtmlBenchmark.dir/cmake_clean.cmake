@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/EscapeHtmlBenchmark.dir/EscapeHtmlBenchmark.cpp.o"
+  "CMakeFiles/EscapeHtmlBenchmark.dir/EscapeHtmlBenchmark.cpp.o.d"
+  "EscapeHtmlBenchmark"
+  "EscapeHtmlBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/EscapeHtmlBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/HeadOnlyParseBenchmark.dir/HeadOnlyParseBenchmark.cpp.o"
+  "CMakeFiles/HeadOnlyParseBenchmark.dir/HeadOnlyParseBenchmark.cpp.o.d"
+  "HeadOnlyParseBenchmark"
+  "HeadOnlyParseBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/HeadOnlyParseBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/NameInterningBenchmark.dir/NameInterningBenchmark.cpp.o"
+  "CMakeFiles/NameInterningBenchmark.dir/NameInterningBenchmark.cpp.o.d"
+  "NameInterningBenchmark"
+  "NameInterningBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/NameInterningBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ParserInitializationBenchmark.dir/ParserInitializationBenchmark.cpp.o"
+  "CMakeFiles/ParserInitializationBenchmark.dir/ParserInitializationBenchmark.cpp.o.d"
+  "ParserInitializationBenchmark"
+  "ParserInitializationBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ParserInitializationBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
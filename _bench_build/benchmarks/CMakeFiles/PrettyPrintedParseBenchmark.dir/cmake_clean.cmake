@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/PrettyPrintedParseBenchmark.dir/PrettyPrintedParseBenchmark.cpp.o"
+  "CMakeFiles/PrettyPrintedParseBenchmark.dir/PrettyPrintedParseBenchmark.cpp.o.d"
+  "PrettyPrintedParseBenchmark"
+  "PrettyPrintedParseBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PrettyPrintedParseBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
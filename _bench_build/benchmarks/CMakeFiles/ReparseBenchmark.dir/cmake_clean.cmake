@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ReparseBenchmark.dir/ReparseBenchmark.cpp.o"
+  "CMakeFiles/ReparseBenchmark.dir/ReparseBenchmark.cpp.o.d"
+  "ReparseBenchmark"
+  "ReparseBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ReparseBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
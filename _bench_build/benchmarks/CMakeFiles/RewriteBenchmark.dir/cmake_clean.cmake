@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/RewriteBenchmark.dir/RewriteBenchmark.cpp.o"
+  "CMakeFiles/RewriteBenchmark.dir/RewriteBenchmark.cpp.o.d"
+  "RewriteBenchmark"
+  "RewriteBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/RewriteBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ScriptHeavyParseBenchmark.dir/ScriptHeavyParseBenchmark.cpp.o"
+  "CMakeFiles/ScriptHeavyParseBenchmark.dir/ScriptHeavyParseBenchmark.cpp.o.d"
+  "ScriptHeavyParseBenchmark"
+  "ScriptHeavyParseBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ScriptHeavyParseBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SerializeBenchmark.dir/SerializeBenchmark.cpp.o"
+  "CMakeFiles/SerializeBenchmark.dir/SerializeBenchmark.cpp.o.d"
+  "SerializeBenchmark"
+  "SerializeBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SerializeBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
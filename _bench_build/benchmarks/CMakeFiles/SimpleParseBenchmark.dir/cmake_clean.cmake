@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SimpleParseBenchmark.dir/SimpleParseBenchmark.cpp.o"
+  "CMakeFiles/SimpleParseBenchmark.dir/SimpleParseBenchmark.cpp.o.d"
+  "SimpleParseBenchmark"
+  "SimpleParseBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SimpleParseBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SnapshotBenchmark.dir/SnapshotBenchmark.cpp.o"
+  "CMakeFiles/SnapshotBenchmark.dir/SnapshotBenchmark.cpp.o.d"
+  "SnapshotBenchmark"
+  "SnapshotBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SnapshotBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TemplateCloneBenchmark.dir/TemplateCloneBenchmark.cpp.o"
+  "CMakeFiles/TemplateCloneBenchmark.dir/TemplateCloneBenchmark.cpp.o.d"
+  "TemplateCloneBenchmark"
+  "TemplateCloneBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TemplateCloneBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TextExtractionBenchmark.dir/TextExtractionBenchmark.cpp.o"
+  "CMakeFiles/TextExtractionBenchmark.dir/TextExtractionBenchmark.cpp.o.d"
+  "TextExtractionBenchmark"
+  "TextExtractionBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TextExtractionBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
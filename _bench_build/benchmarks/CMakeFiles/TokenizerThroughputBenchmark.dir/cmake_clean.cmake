@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TokenizerThroughputBenchmark.dir/TokenizerThroughputBenchmark.cpp.o"
+  "CMakeFiles/TokenizerThroughputBenchmark.dir/TokenizerThroughputBenchmark.cpp.o.d"
+  "TokenizerThroughputBenchmark"
+  "TokenizerThroughputBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TokenizerThroughputBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
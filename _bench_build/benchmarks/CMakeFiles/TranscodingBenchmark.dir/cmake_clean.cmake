@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TranscodingBenchmark.dir/TranscodingBenchmark.cpp.o"
+  "CMakeFiles/TranscodingBenchmark.dir/TranscodingBenchmark.cpp.o.d"
+  "TranscodingBenchmark"
+  "TranscodingBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TranscodingBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
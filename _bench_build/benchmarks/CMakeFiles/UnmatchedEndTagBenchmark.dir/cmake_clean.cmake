@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/UnmatchedEndTagBenchmark.dir/UnmatchedEndTagBenchmark.cpp.o"
+  "CMakeFiles/UnmatchedEndTagBenchmark.dir/UnmatchedEndTagBenchmark.cpp.o.d"
+  "UnmatchedEndTagBenchmark"
+  "UnmatchedEndTagBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/UnmatchedEndTagBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
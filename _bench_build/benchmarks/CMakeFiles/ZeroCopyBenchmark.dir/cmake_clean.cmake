@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ZeroCopyBenchmark.dir/ZeroCopyBenchmark.cpp.o"
+  "CMakeFiles/ZeroCopyBenchmark.dir/ZeroCopyBenchmark.cpp.o.d"
+  "ZeroCopyBenchmark"
+  "ZeroCopyBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ZeroCopyBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/benchmarks/Suite/Corpus.cpp" "benchmarks/Suite/CMakeFiles/ParseSuite.dir/Corpus.cpp.o" "gcc" "benchmarks/Suite/CMakeFiles/ParseSuite.dir/Corpus.cpp.o.d"
+  "/root/repo/benchmarks/Suite/ParseSuite.cpp" "benchmarks/Suite/CMakeFiles/ParseSuite.dir/ParseSuite.cpp.o" "gcc" "benchmarks/Suite/CMakeFiles/ParseSuite.dir/ParseSuite.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/CMakeFiles/HtmlParser.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
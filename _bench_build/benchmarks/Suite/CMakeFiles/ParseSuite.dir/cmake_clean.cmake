@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ParseSuite.dir/Corpus.cpp.o"
+  "CMakeFiles/ParseSuite.dir/Corpus.cpp.o.d"
+  "CMakeFiles/ParseSuite.dir/ParseSuite.cpp.o"
+  "CMakeFiles/ParseSuite.dir/ParseSuite.cpp.o.d"
+  "ParseSuite"
+  "ParseSuite.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ParseSuite.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ExtractTextContent.dir/ExtractTextContent.cpp.o"
+  "CMakeFiles/ExtractTextContent.dir/ExtractTextContent.cpp.o.d"
+  "ExtractTextContent"
+  "ExtractTextContent.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ExtractTextContent.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/GetElementById.dir/GetElementById.cpp.o"
+  "CMakeFiles/GetElementById.dir/GetElementById.cpp.o.d"
+  "GetElementById"
+  "GetElementById.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/GetElementById.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/GetElementsByClassName.dir/GetElementsByClassName.cpp.o"
+  "CMakeFiles/GetElementsByClassName.dir/GetElementsByClassName.cpp.o.d"
+  "GetElementsByClassName"
+  "GetElementsByClassName.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/GetElementsByClassName.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/HandleMalformedHtml.dir/HandleMalformedHtml.cpp.o"
+  "CMakeFiles/HandleMalformedHtml.dir/HandleMalformedHtml.cpp.o.d"
+  "HandleMalformedHtml"
+  "HandleMalformedHtml.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/HandleMalformedHtml.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
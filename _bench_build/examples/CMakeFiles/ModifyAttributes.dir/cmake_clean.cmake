@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ModifyAttributes.dir/ModifyAttributes.cpp.o"
+  "CMakeFiles/ModifyAttributes.dir/ModifyAttributes.cpp.o.d"
+  "ModifyAttributes"
+  "ModifyAttributes.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ModifyAttributes.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ParseAndSerialize.dir/ParseAndSerialize.cpp.o"
+  "CMakeFiles/ParseAndSerialize.dir/ParseAndSerialize.cpp.o.d"
+  "ParseAndSerialize"
+  "ParseAndSerialize.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ParseAndSerialize.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
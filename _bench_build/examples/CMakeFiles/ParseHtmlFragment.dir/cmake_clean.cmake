@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ParseHtmlFragment.dir/ParseHtmlFragment.cpp.o"
+  "CMakeFiles/ParseHtmlFragment.dir/ParseHtmlFragment.cpp.o.d"
+  "ParseHtmlFragment"
+  "ParseHtmlFragment.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ParseHtmlFragment.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
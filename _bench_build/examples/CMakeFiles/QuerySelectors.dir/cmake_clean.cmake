@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/QuerySelectors.dir/QuerySelectors.cpp.o"
+  "CMakeFiles/QuerySelectors.dir/QuerySelectors.cpp.o.d"
+  "QuerySelectors"
+  "QuerySelectors.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/QuerySelectors.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
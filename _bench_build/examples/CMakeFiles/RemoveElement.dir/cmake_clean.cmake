@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/RemoveElement.dir/RemoveElement.cpp.o"
+  "CMakeFiles/RemoveElement.dir/RemoveElement.cpp.o.d"
+  "RemoveElement"
+  "RemoveElement.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/RemoveElement.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TraverseDOM.dir/TraverseDOM.cpp.o"
+  "CMakeFiles/TraverseDOM.dir/TraverseDOM.cpp.o.d"
+  "TraverseDOM"
+  "TraverseDOM.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TraverseDOM.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
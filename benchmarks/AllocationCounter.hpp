@@ -0,0 +1,192 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// Counts heap allocations by replacing the global operator new and delete, which is why each benchmark
+// includes this from its only source file. Over-aligned allocations are not counted.
+namespace AllocationCounter
+{
+    inline std::atomic<std::uint64_t> Allocations{0};
+    inline std::atomic<std::uint64_t> AllocatedBytes{0};
+    inline std::atomic<std::int64_t> LiveBytes{0};
+    inline std::atomic<std::int64_t> PeakLiveBytes{0};
+
+    // Each block starts with its size, so that unsized deletes can be counted
+    constexpr std::size_t HeaderSize = alignof(std::max_align_t);
+
+    inline void* Allocate(std::size_t Size)
+    {
+        void* Block = std::malloc(Size + HeaderSize);
+        if (Block == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        *static_cast<std::size_t*>(Block) = Size;
+
+        Allocations.fetch_add(1, std::memory_order_relaxed);
+        AllocatedBytes.fetch_add(Size, std::memory_order_relaxed);
+        const std::int64_t Live = LiveBytes.fetch_add(Size, std::memory_order_relaxed) + static_cast<std::int64_t>(Size);
+        std::int64_t Peak = PeakLiveBytes.load(std::memory_order_relaxed);
+        while (Live > Peak && !PeakLiveBytes.compare_exchange_weak(Peak, Live, std::memory_order_relaxed))
+        {
+        }
+        return static_cast<char*>(Block) + HeaderSize;
+    }
+
+    inline void Release(void* Pointer)
+    {
+        if (Pointer == nullptr)
+        {
+            return;
+        }
+        void* Block = static_cast<char*>(Pointer) - HeaderSize;
+        LiveBytes.fetch_sub(*static_cast<std::size_t*>(Block), std::memory_order_relaxed);
+        std::free(Block);
+    }
+} // namespace AllocationCounter
+
+void* operator new(std::size_t Size)
+{
+    return AllocationCounter::Allocate(Size);
+}
+
+void* operator new[](std::size_t Size)
+{
+    return AllocationCounter::Allocate(Size);
+}
+
+void operator delete(void* Pointer) noexcept
+{
+    AllocationCounter::Release(Pointer);
+}
+
+void operator delete[](void* Pointer) noexcept
+{
+    AllocationCounter::Release(Pointer);
+}
+
+void operator delete(void* Pointer, std::size_t) noexcept
+{
+    AllocationCounter::Release(Pointer);
+}
+
+void operator delete[](void* Pointer, std::size_t) noexcept
+{
+    AllocationCounter::Release(Pointer);
+}
+
+// Collects timing and allocation results of a benchmark's measurements. Write() prints them and, when
+// the BENCHMARK_JSON_DIR environment variable is set, stores them in <dir>/<benchmark>.json so that
+// runs can be compared over time.
+class BenchmarkReport
+{
+public:
+    explicit BenchmarkReport(std::string Benchmark) : m_Benchmark(std::move(Benchmark))
+    {
+    }
+
+    // Calls Run Iterations times, each processing InputBytes of input (0 if it has none), and returns the
+    // total seconds taken. Peak live bytes are counted from what was live before the first call.
+    template <typename Function>
+    double Measure(const std::string& Name, std::size_t Iterations, std::size_t InputBytes, Function&& Run)
+    {
+        const std::uint64_t StartAllocations = AllocationCounter::Allocations.load();
+        const std::uint64_t StartBytes = AllocationCounter::AllocatedBytes.load();
+        const std::int64_t StartLive = AllocationCounter::LiveBytes.load();
+        AllocationCounter::PeakLiveBytes.store(StartLive);
+
+        const auto StartTime = std::chrono::high_resolution_clock::now();
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            Run();
+        }
+        const auto EndTime = std::chrono::high_resolution_clock::now();
+        const std::chrono::duration<double> Timer = EndTime - StartTime;
+
+        Result Entry;
+        Entry.Name = Name;
+        Entry.Iterations = Iterations;
+        Entry.InputBytes = InputBytes;
+        Entry.Seconds = Timer.count();
+        Entry.Allocations = AllocationCounter::Allocations.load() - StartAllocations;
+        Entry.AllocatedBytes = AllocationCounter::AllocatedBytes.load() - StartBytes;
+        Entry.PeakLiveBytes = AllocationCounter::PeakLiveBytes.load() - StartLive;
+        m_Results.push_back(Entry);
+        return Entry.Seconds;
+    }
+
+    void Write() const
+    {
+        for (const Result& Entry : m_Results)
+        {
+            std::cout << "[" << Entry.Name << "] " << Entry.AllocationsPerIteration() << " allocations and " << Entry.BytesPerIteration()
+                      << " bytes per iteration, peak " << Entry.PeakLiveBytes << " live bytes";
+            if (Entry.InputBytes != 0)
+            {
+                std::cout << ", " << Entry.AllocationsPerInputKB() << " allocations per input KB";
+            }
+            std::cout << ".\n";
+        }
+
+        const char* Directory = std::getenv("BENCHMARK_JSON_DIR");
+        if (Directory == nullptr)
+        {
+            return;
+        }
+        const std::string Path = std::string(Directory) + "/" + m_Benchmark + ".json";
+        std::ofstream File(Path);
+        if (!File)
+        {
+            std::cerr << "Failed to open file: " << Path << "\n";
+            return;
+        }
+        File << "{\n  \"benchmark\": \"" << m_Benchmark << "\",\n  \"results\": [";
+        for (std::size_t i = 0; i < m_Results.size(); ++i)
+        {
+            const Result& Entry = m_Results[i];
+            File << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << Entry.Name << "\", \"iterations\": " << Entry.Iterations
+                 << ", \"input_bytes\": " << Entry.InputBytes << ", \"seconds_per_iteration\": " << Entry.Seconds / Entry.Iterations
+                 << ", \"allocations_per_iteration\": " << Entry.AllocationsPerIteration() << ", \"bytes_per_iteration\": " << Entry.BytesPerIteration()
+                 << ", \"peak_live_bytes\": " << Entry.PeakLiveBytes << ", \"allocations_per_input_kb\": " << Entry.AllocationsPerInputKB() << "}";
+        }
+        File << "\n  ]\n}\n";
+    }
+
+private:
+    struct Result
+    {
+        std::string Name;
+        std::size_t Iterations = 0;
+        std::size_t InputBytes = 0;
+        double Seconds = 0;
+        std::uint64_t Allocations = 0;
+        std::uint64_t AllocatedBytes = 0;
+        std::int64_t PeakLiveBytes = 0;
+
+        double AllocationsPerIteration() const
+        {
+            return static_cast<double>(Allocations) / Iterations;
+        }
+
+        double BytesPerIteration() const
+        {
+            return static_cast<double>(AllocatedBytes) / Iterations;
+        }
+
+        double AllocationsPerInputKB() const
+        {
+            return InputBytes == 0 ? 0 : AllocationsPerIteration() / (InputBytes / 1024.0);
+        }
+    };
+
+    std::string m_Benchmark;
+    std::vector<Result> m_Results;
+};
@@ -0,0 +1,69 @@
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Query.hpp>
+#include <HtmlParser/Snapshot.hpp>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+
+// Runs Body(ThreadIndex) on ThreadCount threads at once and returns the wall time
+template <typename Function>
+static double RunThreads(BenchmarkReport& Report, const std::string& Name, std::size_t ThreadCount, Function&& Body)
+{
+    return Report.Measure(Name, 1, 0, [&] {
+        std::vector<std::thread> Threads;
+        for (std::size_t t = 0; t < ThreadCount; ++t)
+        {
+            Threads.emplace_back(Body, t);
+        }
+        for (auto& Thread : Threads)
+        {
+            Thread.join();
+        }
+    });
+}
+
+int main()
+{
+    std::ostringstream HtmlStream;
+    HtmlStream << "<html><body><ul>";
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+        HtmlStream << "<li class=\"item\"><a href=\"/item/" << i << "\">Item " << i << "</a><span class=\"price\">" << i % 100 << "</span></li>";
+    }
+    HtmlStream << "</ul></body></html>";
+
+    HtmlParser::Parser Parser;
+    const HtmlParser::DOM DOM = Parser.Parse(HtmlStream.str());
+    const HtmlParser::Snapshot Frozen = DOM.Freeze();
+
+    // Every thread runs the same number of queries, so perfect scaling keeps the time constant
+    const std::size_t QueriesPerThread = 20;
+    const std::size_t MaxThreads = std::max<std::size_t>(4, std::thread::hardware_concurrency());
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n";
+    BenchmarkReport Report("ConcurrentQueryBenchmark");
+    for (std::size_t ThreadCount = 1; ThreadCount <= MaxThreads; ThreadCount *= 2)
+    {
+        std::vector<std::size_t> Found(ThreadCount);
+        const double SharedSeconds = RunThreads(Report, "DOM/" + std::to_string(ThreadCount), ThreadCount, [&](std::size_t Thread) {
+            for (std::size_t i = 0; i < QueriesPerThread; ++i)
+            {
+                Found[Thread] += HtmlParser::Query(DOM.Root()).Select("span.price").size();
+                Found[Thread] += DOM.GetElementsByTagName("a").size();
+            }
+        });
+        const double FrozenSeconds = RunThreads(Report, "Frozen/" + std::to_string(ThreadCount), ThreadCount, [&](std::size_t Thread) {
+            for (std::size_t i = 0; i < QueriesPerThread; ++i)
+            {
+                Found[Thread] += Frozen.Select("span.price").size();
+                Found[Thread] += Frozen.GetElementsByTagName("a").size();
+            }
+        });
+        std::cout << ThreadCount << " threads: DOM " << SharedSeconds << " seconds, frozen " << FrozenSeconds << " seconds.\n";
+    }
+    Report.Write();
+
+    return 0;
+}
@@ -1,8 +1,10 @@
 #include <HtmlParser/Parser.hpp>
-#include <chrono>
 #include <iostream>
+#include <optional>
 #include <sstream>
 
+#include "AllocationCounter.hpp"
+
 int main()
 {
     // Generate deeply nested HTML
@@ -22,16 +24,14 @@ int main()
     const std::string Html = HtmlStream.str();
 
     HtmlParser::Parser Parser;
-
-    const auto StartTime = std::chrono::high_resolution_clock::now();
+    BenchmarkReport Report("DeeplyNestedHtmlBenchmark");
 
     // Parse the deeply nested HTML
-    const HtmlParser::DOM DOM = Parser.Parse(Html);
-
-    const auto EndTime = std::chrono::high_resolution_clock::now();
-    const std::chrono::duration<double> Timer = EndTime - StartTime;
+    std::optional<HtmlParser::DOM> DOM;
+    const double Seconds = Report.Measure("Parse", 1, Html.size(), [&] { DOM.emplace(Parser.Parse(Html)); });
 
-    std::cout << "Parsed deeply nested HTML with " << NestingLevel << " levels in " << Timer.count() << " seconds.\n";
+    std::cout << "Parsed deeply nested HTML with " << NestingLevel << " levels in " << Seconds << " seconds.\n";
+    Report.Write();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include <HtmlParser/Parser.hpp>
+#include <iostream>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+// A crawled page of about 1 MB; Version changes one article in the middle
+static std::string MakePage(int Version)
+{
+    std::ostringstream HtmlStream;
+    HtmlStream << "<html><head><title>Archive</title></head><body><main>";
+    for (int i = 0; i < 11000; ++i)
+    {
+        HtmlStream << "<article id=\"a" << i << "\"><h2>Story " << i << "</h2><p class=\"summary\">Summary of story " << i << (i == 5500 ? Version : 0) << ".</p></article>\n";
+    }
+    HtmlStream << "</main></body></html>";
+    return HtmlStream.str();
+}
+
+int main()
+{
+    const std::string OldPage = MakePage(1);
+    const std::string NewPage = MakePage(2);
+    const int Iterations = 100;
+
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM Old = Parser.Parse(OldPage);
+    HtmlParser::DOM New = Parser.Parse(NewPage);
+
+    BenchmarkReport Report("DiffBenchmark");
+    std::size_t Differences = 0;
+    const double StringSeconds = Report.Measure("CompareToHtml", Iterations, 0, [&] { Differences += Old.ToHtml() != New.ToHtml(); });
+
+    const double HashSeconds = Report.Measure("Hash", 1, 0, [&] {
+        Old.Root()->GetHash();
+        New.Root()->GetHash();
+    });
+
+    std::size_t Changes = 0;
+    const double DiffSeconds = Report.Measure("Diff", Iterations, 0, [&] { Changes += HtmlParser::DOM::Diff(Old, New).size(); });
+
+    std::cout << "Two " << OldPage.size() / 1024 << " KB pages differing in one paragraph.\n";
+    std::cout << "Comparing ToHtml strings: " << StringSeconds / Iterations * 1000 << " ms (" << Differences / Iterations << " difference).\n";
+    std::cout << "Hashing both trees once: " << HashSeconds * 1000 << " ms.\n";
+    std::cout << "DOM::Diff with hashes: " << DiffSeconds / Iterations * 1000 << " ms (" << Changes / Iterations << " change).\n";
+    Report.Write();
+
+    return 0;
+}
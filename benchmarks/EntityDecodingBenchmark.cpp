@@ -0,0 +1,39 @@
+#include <HtmlParser/Parser.hpp>
+#include <iostream>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+static double MeasureParse(BenchmarkReport& Report, const std::string& Name, HtmlParser::Parser& Parser, const std::string& Html, std::uint32_t ParseCount)
+{
+    return Report.Measure(Name, ParseCount, Html.size(), [&] { Parser.Parse(Html); }) / ParseCount;
+}
+
+int main()
+{
+    // Same structure, once with plain text and once with a reference every few characters
+    const std::size_t ParagraphCount = 5000;
+    std::ostringstream FreeStream;
+    std::ostringstream DenseStream;
+
+    for (std::size_t i = 0; i < ParagraphCount; ++i)
+    {
+        FreeStream << "<p title=\"Fish and Chips\">Plain paragraph text without references, number " << i << ".</p>";
+        DenseStream << "<p title=\"Fish &amp; Chips\">&lt;p&gt; &quot;Q&amp;A&quot; &copy; &eacute;t&eacute; &#8212; &#x27;" << i << "&#x27; &hellip;</p>";
+    }
+
+    const std::string FreeHtml = FreeStream.str();
+    const std::string DenseHtml = DenseStream.str();
+    const std::uint32_t ParseCount = 20;
+
+    HtmlParser::Parser Parser;
+    BenchmarkReport Report("EntityDecodingBenchmark");
+    const double FreeSeconds = MeasureParse(Report, "EntityFree", Parser, FreeHtml, ParseCount);
+    const double DenseSeconds = MeasureParse(Report, "EntityDense", Parser, DenseHtml, ParseCount);
+
+    std::cout << "Entity-free input: " << FreeHtml.size() / 1024 << " KB at " << FreeHtml.size() / FreeSeconds / 1e6 << " MB/s.\n";
+    std::cout << "Entity-dense input: " << DenseHtml.size() / 1024 << " KB at " << DenseHtml.size() / DenseSeconds / 1e6 << " MB/s.\n";
+    Report.Write();
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <HtmlParser/Escape.hpp>
+#include <iostream>
+#include <string>
+
+#include "AllocationCounter.hpp"
+
+// One character at a time through a switch, for comparison
+static void AppendEscapedPerCharacter(std::string& Out, std::string_view Text)
+{
+    for (char c : Text)
+    {
+        switch (c)
+        {
+        case '&':
+            Out.append("&amp;");
+            break;
+        case '<':
+            Out.append("&lt;");
+            break;
+        case '>':
+            Out.append("&gt;");
+            break;
+        default:
+            Out.push_back(c);
+            break;
+        }
+    }
+}
+
+template <typename Function>
+static double MeasureSeconds(BenchmarkReport& Report, const std::string& Name, const std::string& Text, std::uint32_t RunCount, Function&& Escape)
+{
+    std::string Out;
+    Out.reserve(Text.size() * 2);
+    return Report.Measure(Name, RunCount, Text.size(), [&] {
+        Out.clear();
+        Escape(Out, Text);
+    }) / RunCount;
+}
+
+static void Measure(BenchmarkReport& Report, const char* Label, const std::string& Text)
+{
+    const std::uint32_t RunCount = 20;
+    const double ScalarSeconds = MeasureSeconds(Report, std::string(Label) + "/PerCharacter", Text, RunCount, AppendEscapedPerCharacter);
+    const double VectorSeconds = MeasureSeconds(Report, std::string(Label) + "/AppendEscapedText", Text, RunCount, HtmlParser::AppendEscapedText);
+    std::cout << Label << ": per-character " << Text.size() / ScalarSeconds / 1e9 << " GB/s, AppendEscapedText " << Text.size() / VectorSeconds / 1e9 << " GB/s.\n";
+}
+
+int main()
+{
+    // 8 MB of prose with no escapes, one escape every ~200 bytes, and one every few bytes
+    const std::size_t TargetSize = 8 * 1024 * 1024;
+    const std::string Sentence = "The quick brown fox jumps over the lazy dog while the parser keeps counting bytes. ";
+    std::string Clean;
+    std::string Sparse;
+    std::string Dense;
+    while (Clean.size() < TargetSize)
+    {
+        Clean += Sentence;
+        Sparse += Sentence;
+        Sparse += Sentence;
+        Sparse += "Fish & chips <fresh>. ";
+        Dense += "a<b && c>d ";
+    }
+
+    BenchmarkReport Report("EscapeHtmlBenchmark");
+    Measure(Report, "Clean input", Clean);
+    Measure(Report, "Sparse escapes", Sparse);
+    Measure(Report, "Dense escapes", Dense);
+    Report.Write();
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include <HtmlParser/Parser.hpp>
+#include <iostream>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+int main()
+{
+    // Generate a large page with a small head
+    const std::size_t ArticleCount = 20000;
+    std::ostringstream HtmlStream;
+
+    HtmlStream << "<html><head><meta charset=\"utf-8\"><title>Large Page</title>";
+    HtmlStream << "<meta name=\"description\" content=\"A large generated page\"><link rel=\"canonical\" href=\"https://example.com/\"></head><body>";
+    for (std::size_t i = 0; i < ArticleCount; ++i)
+    {
+        HtmlStream << "<div class=\"article\" id=\"article-" << i << "\"><h2>Heading " << i << "</h2><p>Some <b>body</b> text for article " << i << ".</p></div>";
+    }
+    HtmlStream << "</body></html>";
+
+    const std::string Html = HtmlStream.str();
+    const std::uint32_t ParseCount = 10;
+
+    HtmlParser::Parser FullParser;
+    HtmlParser::Parser HeadParser;
+    HtmlParser::StopCondition Condition;
+    Condition.AfterElement = "head";
+    HeadParser.SetStopCondition(Condition);
+
+    BenchmarkReport Report("HeadOnlyParseBenchmark");
+    const double FullSeconds = Report.Measure("FullParse", ParseCount, Html.size(), [&] { FullParser.Parse(Html); });
+    const double HeadSeconds = Report.Measure("HeadOnlyParse", ParseCount, Html.size(), [&] { HeadParser.Parse(Html); });
+
+    std::cout << "Page size: " << Html.size() / 1024 << " KB.\n";
+    std::cout << "Average full parse: " << (FullSeconds / ParseCount) * 1e6 << " microseconds.\n";
+    std::cout << "Average head-only parse: " << (HeadSeconds / ParseCount) * 1e6 << " microseconds.\n";
+    Report.Write();
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Query.hpp>
+#include <iostream>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+int main()
+{
+    // Markup dominated by names: many small elements with several attributes each
+    std::ostringstream HtmlStream;
+    HtmlStream << "<html><body>";
+    for (std::size_t i = 0; i < 30000; ++i)
+    {
+        HtmlStream << "<div class=\"card card-" << i % 5 << "\" data-index=\"" << i << "\"><a href=\"#" << i << "\" data-tracking-label=\"card\" rel=\"nofollow\">" << i
+                   << "</a><span class=\"badge\" aria-hidden=\"true\"></span></div>";
+    }
+    HtmlStream << "</body></html>";
+    const std::string Html = HtmlStream.str();
+
+    HtmlParser::Parser Parser;
+    BenchmarkReport Report("NameInterningBenchmark");
+    const std::uint32_t RunCount = 5;
+    const double ParseSeconds = Report.Measure("Parse", RunCount, Html.size(), [&] { Parser.Parse(Html); }) / RunCount;
+
+    const HtmlParser::DOM DOM = Parser.Parse(Html);
+    std::size_t Found = 0;
+    const double QuerySeconds = Report.Measure("Query", RunCount, 0, [&] {
+        Found += DOM.GetElementsByTagName("span").size();
+        Found += DOM.GetElementsByClassName("card-3").size();
+        Found += HtmlParser::Query(DOM.Root()).Select("a[rel=nofollow]").size();
+        Found += HtmlParser::Query(DOM.Root()).Select("span.badge[aria-hidden]").size();
+    });
+
+    std::cout << "Node: " << sizeof(HtmlParser::Node) << " bytes, attribute entry: " << sizeof(decltype(HtmlParser::Node::Attributes)::value_type) << " bytes.\n";
+    std::cout << "Parsed " << Html.size() / 1024 << " KB in " << ParseSeconds << " seconds.\n";
+    std::cout << "Queries took " << QuerySeconds / RunCount << " seconds per round (" << Found << " results).\n";
+    Report.Write();
+    return 0;
+}
@@ -1,23 +1,18 @@
 #include <HtmlParser/Parser.hpp>
-#include <chrono>
 #include <iostream>
 
+#include "AllocationCounter.hpp"
+
 int main()
 {
     const std::size_t ParserCount = 100000;
 
-    const auto StartTime = std::chrono::high_resolution_clock::now();
-
-    for (std::size_t i = 0; i < ParserCount; ++i)
-    {
-        const HtmlParser::Parser Parser;
-    }
-
-    const auto EndTime = std::chrono::high_resolution_clock::now();
-    const std::chrono::duration<double> Timer = EndTime - StartTime;
+    BenchmarkReport Report("ParserInitializationBenchmark");
+    const double Seconds = Report.Measure("CreateParser", ParserCount, 0, [] { const HtmlParser::Parser Parser; });
 
-    std::cout << "Created and destroyed " << ParserCount << " parser instances in " << Timer.count() << " seconds.\n";
-    std::cout << "Average time per parser instance: " << (Timer.count() / ParserCount) * 1e6 << " microseconds.\n";
+    std::cout << "Created and destroyed " << ParserCount << " parser instances in " << Seconds << " seconds.\n";
+    std::cout << "Average time per parser instance: " << (Seconds / ParserCount) * 1e6 << " microseconds.\n";
+    Report.Write();
 
     return 0;
 }
\ No newline at end of file
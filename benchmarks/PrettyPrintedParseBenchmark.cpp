@@ -0,0 +1,53 @@
+#include <HtmlParser/Parser.hpp>
+#include <iostream>
+#include <optional>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+static std::size_t CountNodes(const std::shared_ptr<HtmlParser::Node>& Root, std::size_t& TextBytes)
+{
+    std::size_t Count = 1;
+    TextBytes += Root->Text.size();
+    for (const auto& Child : Root->Children)
+    {
+        Count += CountNodes(Child, TextBytes);
+    }
+    return Count;
+}
+
+static void Measure(BenchmarkReport& Report, const char* Label, HtmlParser::Parser& Parser, const std::string& Html)
+{
+    std::optional<HtmlParser::DOM> DOM;
+    const double Seconds = Report.Measure(Label, 1, Html.size(), [&] { DOM.emplace(Parser.Parse(Html)); });
+
+    std::size_t TextBytes = 0;
+    const std::size_t NodeCount = CountNodes(DOM->Root(), TextBytes);
+    std::cout << Label << ": " << NodeCount << " nodes, " << TextBytes / 1024 << " KB of text, parsed in " << Seconds << " seconds.\n";
+}
+
+int main()
+{
+    // Indented markup as produced by templates and formatters
+    const std::size_t ItemCount = 50000;
+    std::ostringstream HtmlStream;
+    HtmlStream << "<html>\n  <head>\n    <title>Listing</title>\n  </head>\n  <body>\n    <ul>\n";
+    for (std::size_t i = 0; i < ItemCount; ++i)
+    {
+        HtmlStream << "      <li>\n        <a href=\"/item/" << i << "\">\n          Item " << i << "\n        </a>\n        <span>Details</span>\n      </li>\n";
+    }
+    HtmlStream << "    </ul>\n    <pre>\n  keep\n    </pre>\n  </body>\n</html>\n";
+    const std::string Html = HtmlStream.str();
+
+    HtmlParser::Parser Parser;
+    BenchmarkReport Report("PrettyPrintedParseBenchmark");
+    Measure(Report, "Whitespace kept", Parser, Html);
+
+    HtmlParser::DiscardOptions Options;
+    Options.WhitespaceText = true;
+    Parser.SetDiscardOptions(Options);
+    Measure(Report, "Whitespace discarded", Parser, Html);
+    Report.Write();
+
+    return 0;
+}
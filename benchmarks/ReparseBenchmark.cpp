@@ -0,0 +1,58 @@
+#include <HtmlParser/Parser.hpp>
+#include <iostream>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+int main()
+{
+    std::ostringstream HtmlStream;
+    HtmlStream << "<html><head><title>Editor</title></head><body><main>";
+    for (std::size_t i = 0; HtmlStream.tellp() < 1024 * 1024; ++i)
+    {
+        HtmlStream << "<section id=\"s" << i << "\"><h2>Section " << i << "</h2><p class=\"body\">Paragraph <b>" << i << "</b> of the document.</p></section>\n";
+    }
+    HtmlStream << "</main></body></html>";
+    const std::string Html = HtmlStream.str();
+
+    HtmlParser::Parser Parser;
+    Parser.SetTrackSourceSpans(true);
+    BenchmarkReport Report("ReparseBenchmark");
+    const std::size_t EditCount = 200;
+
+    // Typing into a paragraph, one character at a time. Nodes after the edit move in the source, so the
+    // cost grows with the distance from the end of the document.
+    const auto TimeTyping = [&](const std::string& Name, HtmlParser::DOM& DOM, double Position) {
+        std::size_t Offset = DOM.GetSource().find("Paragraph", static_cast<std::size_t>(DOM.GetSource().size() * Position));
+        std::size_t Incremental = 0;
+        const double Seconds = Report.Measure(Name, EditCount, 0, [&] { Incremental += Parser.Reparse(DOM, {Offset++, 0, "x"}); });
+        std::cout << "Reparse per edit at " << Position * 100 << "%: " << Seconds / EditCount * 1000 << " ms (" << Incremental << " of " << EditCount << " incremental).\n";
+    };
+
+    HtmlParser::DOM DOM = Parser.Parse(Html);
+    // The typed text goes between a fixed prefix and suffix, so the source is rebuilt rather than inserted into
+    const std::size_t Offset = Html.find("Paragraph", Html.size() / 2);
+    const std::string Prefix = Html.substr(0, Offset);
+    const std::string Suffix = Html.substr(Offset);
+    std::string Typed;
+    std::string Source;
+    const double FullSeconds = Report.Measure("FullParse", EditCount / 10, Html.size(), [&] {
+        Typed += 'x';
+        Source.assign(Prefix).append(Typed).append(Suffix);
+        HtmlParser::DOM Full = Parser.Parse(Source);
+    });
+
+    std::cout << "Document size: " << Html.size() / 1024 << " KB.\n";
+    std::cout << "Full parse per edit: " << FullSeconds / (EditCount / 10) * 1000 << " ms.\n";
+    for (const double Position : {0.0, 0.5, 0.99})
+    {
+        TimeTyping("Reparse/" + std::to_string(static_cast<int>(Position * 100)), DOM, Position);
+    }
+    Parser.SetZeroCopy(true);
+    HtmlParser::DOM Borrowing = Parser.Parse(Html);
+    std::cout << "With zero-copy values:\n";
+    TimeTyping("ZeroCopyReparse/50", Borrowing, 0.5);
+    Report.Write();
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Serializer.hpp>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+template <typename Function>
+static void Measure(BenchmarkReport& Report, const char* Label, std::uint32_t RunCount, std::size_t InputBytes, Function&& Rewrite)
+{
+    std::size_t OutputSize = 0;
+    const double Seconds = Report.Measure(Label, RunCount, InputBytes, [&] { OutputSize = Rewrite(); }) / RunCount;
+
+    std::cout << Label << ": " << OutputSize / 1024 << " KB in " << Seconds << " seconds (" << OutputSize / Seconds / 1e6 << " MB/s).\n";
+}
+
+int main()
+{
+    // Roughly 10 MB of hand-written looking markup, of which a few attributes get edited
+    const std::size_t RowCount = 55000;
+    std::ostringstream HtmlStream;
+    HtmlStream << "<!DOCTYPE html>\n<html>\n<body>\n<table>\n";
+    for (std::size_t i = 0; i < RowCount; ++i)
+    {
+        HtmlStream << "  <tr class=row data-id='" << i << "'>\n    <td><a href=\"/item?id=" << i << "&amp;view=full\">Item " << i
+                   << "</a></td>\n    <td>Fish &amp; chips &lt;fresh&gt; served daily</td>\n  </tr>\n";
+    }
+    HtmlStream << "</table>\n</body>\n</html>\n";
+    const std::string Html = HtmlStream.str();
+
+    HtmlParser::Parser Parser;
+    Parser.SetTrackSourceSpans(true);
+    const HtmlParser::DOM DOM = Parser.Parse(Html);
+    const HtmlParser::DOM CleanDOM = Parser.Parse(Html);
+
+    HtmlParser::Parser PlainParser;
+    const HtmlParser::DOM PlainDOM = PlainParser.Parse(Html);
+
+    const auto Rows = DOM.GetElementsByTagName("tr");
+    for (std::size_t i = 0; i < Rows.size(); i += Rows.size() / 10)
+    {
+        Rows[i]->SetAttribute("class", "row selected");
+    }
+
+    BenchmarkReport Report("RewriteBenchmark");
+    const std::uint32_t RunCount = 10;
+    std::string Buffer;
+    Measure(Report, "memcpy", RunCount, Html.size(), [&] {
+        Buffer.resize(Html.size());
+        std::memcpy(Buffer.data(), Html.data(), Html.size());
+        return Buffer.size();
+    });
+
+    Measure(Report, "Verbatim rewrite, unmodified", RunCount, Html.size(), [&] {
+        Buffer.clear();
+        HtmlParser::Serializer Writer(Buffer);
+        Writer.SetSource(CleanDOM.GetSource());
+        Writer.WriteInnerHtml(*CleanDOM.Root());
+        return Buffer.size();
+    });
+
+    Measure(Report, "Verbatim rewrite, 10 edits", RunCount, Html.size(), [&] {
+        Buffer.clear();
+        HtmlParser::Serializer Writer(Buffer);
+        Writer.SetSource(DOM.GetSource());
+        Writer.WriteInnerHtml(*DOM.Root());
+        return Buffer.size();
+    });
+
+    Measure(Report, "Full re-serialization", RunCount, Html.size(), [&] {
+        Buffer.clear();
+        HtmlParser::Serializer Writer(Buffer);
+        Writer.WriteInnerHtml(*PlainDOM.Root());
+        return Buffer.size();
+    });
+    Report.Write();
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <HtmlParser/Parser.hpp>
+#include <iostream>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+int main()
+{
+    // Generate a page dominated by minified script and style blocks
+    const std::size_t BlockCount = 50;
+    std::ostringstream HtmlStream;
+
+    HtmlStream << "<html><head>";
+    for (std::size_t i = 0; i < BlockCount; ++i)
+    {
+        HtmlStream << "<style>";
+        for (std::size_t j = 0; j < 200; ++j)
+        {
+            HtmlStream << ".c" << j << ">a:hover{color:#" << j % 10 << "f0}";
+        }
+        HtmlStream << "</style>";
+    }
+    HtmlStream << "</head><body>";
+    for (std::size_t i = 0; i < BlockCount; ++i)
+    {
+        HtmlStream << "<p>Paragraph " << i << "</p><script>";
+        for (std::size_t j = 0; j < 500; ++j)
+        {
+            HtmlStream << "if(a<b&&c>d){e.innerHTML='<div class=\"x" << j << "\">'+f+'</div>'}";
+        }
+        HtmlStream << "</script>";
+    }
+    HtmlStream << "</body></html>";
+
+    const std::string Html = HtmlStream.str();
+    const std::uint32_t ParseCount = 20;
+
+    BenchmarkReport Report("ScriptHeavyParseBenchmark");
+    for (bool Skip : {false, true})
+    {
+        HtmlParser::Parser Parser;
+        Parser.SetSkipRawTextContent(Skip);
+
+        std::size_t NodeCount = 0;
+        const double Seconds = Report.Measure(Skip ? "SkipRawText" : "KeepRawText", ParseCount, Html.size(), [&] {
+            const HtmlParser::DOM DOM = Parser.Parse(Html);
+            NodeCount = 0;
+            DOM.Traverse([&](const std::shared_ptr<HtmlParser::Node>&) { ++NodeCount; });
+        });
+
+        std::cout << (Skip ? "Skipping" : "Keeping") << " raw text: parsed " << Html.size() / 1024 << " KB into " << NodeCount << " nodes, average " << (Seconds / ParseCount) * 1e6 << " microseconds per parse.\n";
+    }
+    Report.Write();
+
+    return 0;
+}
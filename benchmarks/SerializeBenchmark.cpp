@@ -0,0 +1,57 @@
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Serializer.hpp>
+#include <iostream>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+template <typename Function>
+static void Measure(BenchmarkReport& Report, const char* Label, std::uint32_t RunCount, std::size_t InputBytes, std::size_t& OutputSize, Function&& Serialize)
+{
+    const double Seconds = Report.Measure(Label, RunCount, InputBytes, [&] { OutputSize = Serialize(); }) / RunCount;
+
+    std::cout << Label << ": " << OutputSize / 1024 << " KB in " << Seconds << " seconds (" << OutputSize / Seconds / 1e6 << " MB/s).\n";
+}
+
+int main()
+{
+    // Roughly 10 MB of markup with attributes and text that needs escaping
+    const std::size_t RowCount = 55000;
+    std::ostringstream HtmlStream;
+    HtmlStream << "<html><body><table>";
+    for (std::size_t i = 0; i < RowCount; ++i)
+    {
+        HtmlStream << "<tr class=\"row\" data-id=\"" << i << "\"><td><a href=\"/item?id=" << i << "&amp;view=full\">Item " << i
+                   << "</a></td><td>Fish &amp; chips &lt;fresh&gt; served daily</td><td><img src=\"/img/" << i << ".png\" alt=\"\"></td></tr>";
+    }
+    HtmlStream << "</table></body></html>";
+
+    const std::string Html = HtmlStream.str();
+    HtmlParser::Parser Parser;
+    const HtmlParser::DOM DOM = Parser.Parse(Html);
+
+    BenchmarkReport Report("SerializeBenchmark");
+    const std::uint32_t RunCount = 10;
+    std::size_t OutputSize = 0;
+    Measure(Report, "ToHtml", RunCount, Html.size(), OutputSize, [&] { return DOM.ToHtml().size(); });
+
+    std::string Buffer;
+    Measure(Report, "Reused buffer, precomputed size", RunCount, Html.size(), OutputSize, [&] {
+        Buffer.clear();
+        HtmlParser::Serializer Writer(Buffer);
+        Writer.SetPrecomputeSize(true);
+        Writer.WriteInnerHtml(*DOM.Root());
+        return Buffer.size();
+    });
+
+    Measure(Report, "Chunked callback", RunCount, Html.size(), OutputSize, [&] {
+        std::size_t Written = 0;
+        HtmlParser::Serializer Writer([&](std::string_view Chunk) { Written += Chunk.size(); });
+        Writer.WriteInnerHtml(*DOM.Root());
+        Writer.Flush();
+        return Written;
+    });
+    Report.Write();
+
+    return 0;
+}
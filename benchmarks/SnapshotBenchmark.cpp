@@ -0,0 +1,78 @@
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Snapshot.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+
+int main()
+{
+    // A small corpus of listing pages, each parsed once and cached as a snapshot
+    const std::size_t PageCount = 20;
+    const auto Directory = std::filesystem::temp_directory_path() / "HtmlParserSnapshotBenchmark";
+    std::filesystem::create_directories(Directory);
+
+    HtmlParser::Parser Parser;
+    std::vector<std::string> HtmlPaths;
+    std::vector<std::string> SnapshotPaths;
+    std::size_t HtmlBytes = 0;
+    std::size_t SnapshotBytes = 0;
+    for (std::size_t Page = 0; Page < PageCount; ++Page)
+    {
+        std::ostringstream HtmlStream;
+        HtmlStream << "<!DOCTYPE html><html><head><title>Page " << Page << "</title></head><body><ul id=\"items\">";
+        for (std::size_t i = 0; i < 5000; ++i)
+        {
+            HtmlStream << "<li class=\"item item-" << i % 7 << "\" data-id=\"" << i << "\"><a href=\"/page/" << Page << "/item/" << i << "\">Item " << i
+                       << "</a> <span class=\"price\">" << i * 3 % 100 << ".99</span></li>";
+        }
+        HtmlStream << "</ul></body></html>";
+
+        HtmlPaths.push_back((Directory / ("page" + std::to_string(Page) + ".html")).string());
+        SnapshotPaths.push_back((Directory / ("page" + std::to_string(Page) + ".snap")).string());
+        std::ofstream(HtmlPaths.back(), std::ios::binary) << HtmlStream.str();
+        Parser.Parse(HtmlStream.str()).SaveSnapshot(SnapshotPaths.back());
+        HtmlBytes += std::filesystem::file_size(HtmlPaths.back());
+        SnapshotBytes += std::filesystem::file_size(SnapshotPaths.back());
+    }
+
+    BenchmarkReport Report("SnapshotBenchmark");
+    std::size_t Found = 0;
+    const double ParseSeconds = Report.Measure("ParseFile", 1, HtmlBytes, [&] {
+        for (const auto& Path : HtmlPaths)
+        {
+            Found += Parser.ParseFile(Path).GetElementsByClassName("price").size();
+        }
+    });
+    const double LoadSeconds = Report.Measure("LoadSnapshot", 1, SnapshotBytes, [&] {
+        for (const auto& Path : SnapshotPaths)
+        {
+            Found += HtmlParser::DOM::LoadSnapshot(Path).GetElementsByClassName("price").size();
+        }
+    });
+    const double OpenSeconds = Report.Measure("Open", 1, SnapshotBytes, [&] {
+        for (const auto& Path : SnapshotPaths)
+        {
+            Found += HtmlParser::Snapshot::Open(Path).GetElementsByClassName("price").size();
+        }
+    });
+    const double OpenOnlySeconds = Report.Measure("OpenOnly", 1, SnapshotBytes, [&] {
+        for (const auto& Path : SnapshotPaths)
+        {
+            Found += HtmlParser::Snapshot::Open(Path).NodeCount();
+        }
+    });
+
+    std::cout << PageCount << " pages, " << HtmlBytes / 1024 << " KB of HTML, " << SnapshotBytes / 1024 << " KB of snapshots (" << Found << " results).\n";
+    std::cout << "ParseFile and query: " << ParseSeconds << " seconds.\n";
+    std::cout << "LoadSnapshot and query: " << LoadSeconds << " seconds.\n";
+    std::cout << "Snapshot::Open and query: " << OpenSeconds << " seconds.\n";
+    std::cout << "Snapshot::Open only: " << OpenOnlySeconds << " seconds.\n";
+    Report.Write();
+
+    std::filesystem::remove_all(Directory);
+    return 0;
+}
@@ -0,0 +1,324 @@
+#include "Corpus.hpp"
+
+#include <random>
+
+namespace Corpus
+{
+    namespace
+    {
+        const char* const Words[] = {"the",      "market",  "city",    "council", "report",   "season", "data",      "energy",  "price",
+                                     "customer", "network", "release", "policy",  "weather",  "museum", "students",  "river",   "software",
+                                     "growth",   "travel",  "players", "health",  "research", "local",  "quarterly", "results", "community",
+                                     "launch",   "review",  "design",  "history", "future",   "and",    "of",        "with",    "for"};
+
+        // std::mt19937 output is fixed by the standard, unlike the standard distributions
+        class Writer
+        {
+        public:
+            Writer(std::string& Out, std::uint32_t Seed) : m_Out(Out), m_Random(Seed)
+            {
+            }
+
+            std::uint32_t Next(std::uint32_t Bound)
+            {
+                return static_cast<std::uint32_t>(m_Random() % Bound);
+            }
+
+            Writer& operator<<(const char* Text)
+            {
+                m_Out += Text;
+                return *this;
+            }
+
+            Writer& operator<<(const std::string& Text)
+            {
+                m_Out += Text;
+                return *this;
+            }
+
+            Writer& operator<<(std::uint64_t Number)
+            {
+                m_Out += std::to_string(Number);
+                return *this;
+            }
+
+            const char* Word()
+            {
+                return Words[Next(sizeof(Words) / sizeof(Words[0]))];
+            }
+
+            void Sentence(std::uint32_t MinWords, std::uint32_t MaxWords)
+            {
+                const std::uint32_t Count = MinWords + Next(MaxWords - MinWords + 1);
+                for (std::uint32_t i = 0; i < Count; ++i)
+                {
+                    if (i != 0)
+                    {
+                        m_Out += ' ';
+                    }
+                    m_Out += Word();
+                }
+                m_Out += '.';
+            }
+
+            std::size_t Size() const
+            {
+                return m_Out.size();
+            }
+
+        private:
+            std::string& m_Out;
+            std::mt19937 m_Random;
+        };
+
+        void WriteNewsArticle(Writer& Out, std::uint64_t Index)
+        {
+            Out << "<article class=\"story\" id=\"story-" << Index << "\"><header><h2><a href=\"/news/" << Index << "/" << Out.Word() << "-" << Out.Word() << "\">";
+            Out.Sentence(4, 9);
+            Out << "</a></h2><p class=\"byline\">By <span class=\"author\">" << Out.Word() << " " << Out.Word() << "</span> &middot; <time datetime=\"2024-0"
+                << Out.Next(9) + 1 << "-1" << Out.Next(10) << "\">" << Out.Next(12) + 1 << " hours ago</time></p></header>";
+            if (Out.Next(3) == 0)
+            {
+                Out << "<figure><img src=\"/img/" << Index << ".jpg\" alt=\"" << Out.Word() << "\" width=\"640\" height=\"360\"><figcaption>";
+                Out.Sentence(3, 8);
+                Out << "</figcaption></figure>";
+            }
+            const std::uint32_t Paragraphs = 3 + Out.Next(5);
+            for (std::uint32_t i = 0; i < Paragraphs; ++i)
+            {
+                Out << "<p>";
+                Out.Sentence(10, 30);
+                Out << " <a href=\"/topic/" << Out.Word() << "\">" << Out.Word() << "</a> ";
+                if (Out.Next(2) == 0)
+                {
+                    Out << "<em>" << Out.Word() << "</em> &amp; <strong>" << Out.Word() << "</strong> ";
+                }
+                Out.Sentence(8, 25);
+                Out << "</p>\n";
+            }
+            Out << "<aside class=\"related\"><ul>";
+            for (std::uint32_t i = 0; i < 3; ++i)
+            {
+                Out << "<li><a href=\"/news/" << Out.Next(100000) << "\">";
+                Out.Sentence(3, 7);
+                Out << "</a></li>";
+            }
+            Out << "</ul></aside></article>\n";
+        }
+
+        void WriteProduct(Writer& Out, std::uint64_t Index)
+        {
+            Out << "<div class=\"product card" << (Out.Next(5) == 0 ? " sale" : "") << "\" data-sku=\"SKU-" << Index << "\" data-category=\"" << Out.Word()
+                << "\"><a class=\"product-link\" href=\"/p/" << Index << "\"><img class=\"thumb\" src=\"/cdn/p/" << Index << "/320.webp\" loading=\"lazy\" alt=\"" << Out.Word()
+                << "\"></a><h3 class=\"title\"><a href=\"/p/" << Index << "\">" << Out.Word() << " " << Out.Word() << " " << Out.Word()
+                << "</a></h3><div class=\"rating\" aria-label=\"" << Out.Next(5) + 1 << " stars\">";
+            for (std::uint32_t i = 0; i < 5; ++i)
+            {
+                Out << "<span class=\"star\"></span>";
+            }
+            Out << "</div><span class=\"price\">$" << Out.Next(500) << "." << Out.Next(90) + 10 << "</span>";
+            if (Out.Next(3) == 0)
+            {
+                Out << "<span class=\"was\"><s>$" << Out.Next(900) << ".99</s></span>";
+            }
+            Out << "<button type=\"button\" class=\"add-to-cart\" data-sku=\"SKU-" << Index << "\">Add to cart</button></div>\n";
+        }
+
+        void WriteTableRows(Writer& Out, std::uint64_t Index)
+        {
+            for (std::uint32_t Row = 0; Row < 20; ++Row)
+            {
+                Out << "<tr" << (Row % 2 == 0 ? " class=\"odd\"" : "") << "><th scope=\"row\">" << Index * 20 + Row << "</th><td>" << Out.Word() << "</td>";
+                for (std::uint32_t Column = 0; Column < 6; ++Column)
+                {
+                    Out << "<td class=\"num\">" << Out.Next(100000) << "." << Out.Next(100) << "</td>";
+                }
+                Out << "<td><a href=\"/row/" << Index * 20 + Row << "\">details</a></td></tr>\n";
+            }
+        }
+
+        void WriteScriptBlock(Writer& Out, std::uint64_t Index)
+        {
+            if (Out.Next(2) == 0)
+            {
+                Out << "<script>(function(){var m" << Index << "={};";
+                const std::uint32_t Statements = 20 + Out.Next(40);
+                for (std::uint32_t i = 0; i < Statements; ++i)
+                {
+                    Out << "if(a" << i << "<b&&c>d){m" << Index << "['" << Out.Word() << "']='<div class=\"" << Out.Word() << "\">'+e+'</div>';}";
+                }
+                Out << "})();</script>\n";
+            }
+            else
+            {
+                Out << "<style>";
+                const std::uint32_t Rules = 20 + Out.Next(40);
+                for (std::uint32_t i = 0; i < Rules; ++i)
+                {
+                    Out << "." << Out.Word() << "-" << i << ">a:hover{color:#" << Out.Next(0xfff) << ";margin:" << Out.Next(20) << "px}";
+                }
+                Out << "</style>\n";
+            }
+            Out << "<script type=\"application/ld+json\">{\"@type\":\"Thing\",\"name\":\"" << Out.Word() << "\",\"id\":" << Index << "}</script>";
+            Out << "<p class=\"content\">";
+            Out.Sentence(5, 15);
+            Out << "</p>\n";
+        }
+
+        void WriteAttributeHeavy(Writer& Out, std::uint64_t Index)
+        {
+            Out << "<div id=\"w" << Index << "\" class=\"widget widget--" << Out.Word() << " is-" << Out.Word() << " col-" << Out.Next(12) + 1
+                << " mt-" << Out.Next(5) << "\" data-component=\"" << Out.Word() << "\" data-props='{\"index\":" << Index << ",\"mode\":\"" << Out.Word()
+                << "\"}' data-tracking-id=\"t-" << Out.Next(1000000) << "\" style=\"display:flex;gap:" << Out.Next(16) << "px\" role=\"region\" aria-label=\""
+                << Out.Word() << "\" tabindex=\"-1\">";
+            for (std::uint32_t i = 0; i < 4; ++i)
+            {
+                Out << "<span class=\"icon icon-" << Out.Word() << "\" aria-hidden=\"true\" data-size=\"" << Out.Next(4) * 8 << "\" title=\"" << Out.Word()
+                    << "\"></span><input type=\"checkbox\" name=\"f" << Index << "-" << i << "\" value=\"" << Out.Word() << "\" data-bind=\"" << Out.Word()
+                    << "\" disabled>";
+            }
+            Out << "<a href=\"/w/" << Index << "\" rel=\"noopener noreferrer\" target=\"_blank\" hreflang=\"en\" data-event=\"click\">" << Out.Word() << "</a></div>\n";
+        }
+
+        // Markup as found on old or hand-edited pages: unclosed and misnested elements, stray end tags,
+        // unquoted attributes and tables with misplaced content
+        void WriteTagSoup(Writer& Out, std::uint64_t Index)
+        {
+            switch (Out.Next(6))
+            {
+            case 0:
+                Out << "<p>";
+                Out.Sentence(5, 15);
+                Out << "<p><b>" << Out.Word() << " <i>" << Out.Word() << "</b> " << Out.Word() << "</i>\n";
+                break;
+            case 1:
+                Out << "<ul><li>" << Out.Word() << "<li>" << Out.Word() << "<li><a href=/x/" << Index << ">" << Out.Word() << "</ul>\n";
+                break;
+            case 2:
+                Out << "<table><tr><td>" << Out.Word() << "<td>" << Out.Next(1000) << "<div>" << Out.Word() << "</table>\n";
+                break;
+            case 3:
+                Out << "</span></div><font color=red size=2>" << Out.Word() << "<center>";
+                Out.Sentence(3, 10);
+                Out << "</font></center>\n";
+                break;
+            case 4:
+                Out << "<div class=box id=d" << Index << "><p>" << Out.Word() << "<div>" << Out.Word() << "</p></div>&copy &nbsp " << Out.Word() << "\n";
+                break;
+            default:
+                Out << "<form action=/s><select name=q><option>" << Out.Word() << "<option selected>" << Out.Word() << "</select><input type=text name=t" << Index
+                    << "></form><br></br>\n";
+                break;
+            }
+        }
+    } // namespace
+
+    const char* GetShapeName(Shape Kind)
+    {
+        switch (Kind)
+        {
+        case Shape::News:
+            return "News";
+        case Shape::ECommerce:
+            return "ECommerce";
+        case Shape::Table:
+            return "Table";
+        case Shape::Script:
+            return "Script";
+        case Shape::Attribute:
+            return "Attribute";
+        case Shape::TagSoup:
+            return "TagSoup";
+        }
+        return "";
+    }
+
+    const char* GetShapeSelector(Shape Kind)
+    {
+        switch (Kind)
+        {
+        case Shape::News:
+            return "article p a";
+        case Shape::ECommerce:
+            return "div.product span.price";
+        case Shape::Table:
+            return "tr.odd td.num";
+        case Shape::Script:
+            return "p.content";
+        case Shape::Attribute:
+            return "span[aria-hidden=true]";
+        case Shape::TagSoup:
+            return "li a";
+        }
+        return "";
+    }
+
+    std::string Generate(Shape Kind, std::size_t TargetBytes, std::uint32_t Seed)
+    {
+        std::string Html;
+        Html.reserve(TargetBytes + 4096);
+        Writer Out(Html, Seed * 7919 + static_cast<std::uint32_t>(Kind));
+
+        Out << "<!DOCTYPE html>\n<html lang=\"en\"><head><meta charset=\"utf-8\"><title>" << GetShapeName(Kind) << " page</title></head><body>\n";
+        switch (Kind)
+        {
+        case Shape::News:
+            Out << "<main id=\"content\">\n";
+            break;
+        case Shape::ECommerce:
+            Out << "<section class=\"listing grid\">\n";
+            break;
+        case Shape::Table:
+            Out << "<table class=\"data\"><thead><tr><th>#</th><th>Name</th><th>A</th><th>B</th><th>C</th><th>D</th><th>E</th><th>F</th><th></th></tr></thead><tbody>\n";
+            break;
+        default:
+            break;
+        }
+
+        const std::size_t Footer = 64;
+        for (std::uint64_t Index = 0; Out.Size() + Footer < TargetBytes; ++Index)
+        {
+            switch (Kind)
+            {
+            case Shape::News:
+                WriteNewsArticle(Out, Index);
+                break;
+            case Shape::ECommerce:
+                WriteProduct(Out, Index);
+                break;
+            case Shape::Table:
+                WriteTableRows(Out, Index);
+                break;
+            case Shape::Script:
+                WriteScriptBlock(Out, Index);
+                break;
+            case Shape::Attribute:
+                WriteAttributeHeavy(Out, Index);
+                break;
+            case Shape::TagSoup:
+                WriteTagSoup(Out, Index);
+                break;
+            }
+        }
+
+        switch (Kind)
+        {
+        case Shape::News:
+            Out << "</main>";
+            break;
+        case Shape::ECommerce:
+            Out << "</section>";
+            break;
+        case Shape::Table:
+            Out << "</tbody></table>";
+            break;
+        case Shape::TagSoup:
+            // Leave whatever is still open to the end of input handling
+            return Html;
+        default:
+            break;
+        }
+        Out << "\n</body></html>\n";
+        return Html;
+    }
+} // namespace Corpus
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Deterministic synthetic documents modelled on common kinds of pages. The same shape, size and seed
+// always produce the same bytes, so results stay comparable between runs and machines.
+namespace Corpus
+{
+    enum class Shape
+    {
+        News,
+        ECommerce,
+        Table,
+        Script,
+        Attribute,
+        TagSoup,
+    };
+
+    constexpr Shape AllShapes[] = {Shape::News, Shape::ECommerce, Shape::Table, Shape::Script, Shape::Attribute, Shape::TagSoup};
+
+    const char* GetShapeName(Shape Kind);
+
+    // A selector matching a typical share of the shape's elements
+    const char* GetShapeSelector(Shape Kind);
+
+    // Generates a complete document of at least TargetBytes, exceeding it by at most one repeated unit
+    // of a few KB.
+    std::string Generate(Shape Kind, std::size_t TargetBytes, std::uint32_t Seed = 1);
+} // namespace Corpus
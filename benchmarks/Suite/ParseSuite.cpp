@@ -0,0 +1,186 @@
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Query.hpp>
+#include <HtmlParser/TextExtractor.hpp>
+#include <HtmlParser/Tokenizer.hpp>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "Corpus.hpp"
+
+// Every benchmark reports the input bytes and the DOM nodes of its document per second, so phases can
+// be compared with each other and across document shapes. Tree building includes tokenizing, since the
+// parser pulls tokens as it goes.
+namespace
+{
+    // Benchmarks are registered grouped by document, so only the current document and its tree are
+    // kept; with 100 MB inputs holding more would not fit in memory.
+    struct Document
+    {
+        Corpus::Shape Kind = Corpus::Shape::News;
+        std::size_t TargetBytes = 0;
+        std::string Html;
+        std::size_t NodeCount = 0;
+        std::optional<HtmlParser::DOM> Tree;
+    };
+
+    Document& GetDocument(Corpus::Shape Kind, std::size_t TargetBytes)
+    {
+        static Document Current;
+        if (Current.Html.empty() || Current.Kind != Kind || Current.TargetBytes != TargetBytes)
+        {
+            Current.Tree.reset();
+            Current.Kind = Kind;
+            Current.TargetBytes = TargetBytes;
+            Current.Html = Corpus::Generate(Kind, TargetBytes);
+
+            HtmlParser::Parser Parser;
+            const HtmlParser::DOM Tree = Parser.Parse(Current.Html);
+            Current.NodeCount = 0;
+            Tree.Traverse([&](const std::shared_ptr<HtmlParser::Node>&) { ++Current.NodeCount; });
+        }
+        return Current;
+    }
+
+    // Parsed lazily, after the phases that build their own trees have run
+    const HtmlParser::DOM& GetTree(Document& Input)
+    {
+        if (!Input.Tree)
+        {
+            HtmlParser::Parser Parser;
+            Input.Tree.emplace(Parser.Parse(Input.Html));
+        }
+        return *Input.Tree;
+    }
+
+    void SetRates(benchmark::State& State, const Document& Input)
+    {
+        State.SetBytesProcessed(static_cast<std::int64_t>(State.iterations() * Input.Html.size()));
+        State.counters["nodes/s"] = benchmark::Counter(static_cast<double>(State.iterations() * Input.NodeCount), benchmark::Counter::kIsRate);
+    }
+
+    void Tokenize(benchmark::State& State, Corpus::Shape Kind, std::size_t TargetBytes)
+    {
+        const Document& Input = GetDocument(Kind, TargetBytes);
+        for (auto _ : State)
+        {
+            HtmlParser::Tokenizer Tokenizer(Input.Html);
+            HtmlParser::Token Token;
+            while (Tokenizer.NextToken(Token))
+            {
+                benchmark::DoNotOptimize(Token);
+            }
+        }
+        SetRates(State, Input);
+    }
+
+    // Timed manually so that freeing the tree is left out. A parser keeps the last document it built
+    // until the next Parse call, so each iteration uses its own.
+    void TreeBuild(benchmark::State& State, Corpus::Shape Kind, std::size_t TargetBytes)
+    {
+        const Document& Input = GetDocument(Kind, TargetBytes);
+        for (auto _ : State)
+        {
+            HtmlParser::Parser Parser;
+            const auto StartTime = std::chrono::high_resolution_clock::now();
+            const HtmlParser::DOM Tree = Parser.Parse(Input.Html);
+            const std::chrono::duration<double> Timer = std::chrono::high_resolution_clock::now() - StartTime;
+            State.SetIterationTime(Timer.count());
+        }
+        SetRates(State, Input);
+    }
+
+    void Destroy(benchmark::State& State, Corpus::Shape Kind, std::size_t TargetBytes)
+    {
+        const Document& Input = GetDocument(Kind, TargetBytes);
+        for (auto _ : State)
+        {
+            // A std::optional here trips GCC's -Wmaybe-uninitialized in Release builds
+            std::unique_ptr<HtmlParser::DOM> Tree;
+            {
+                HtmlParser::Parser Parser;
+                Tree = std::make_unique<HtmlParser::DOM>(Parser.Parse(Input.Html));
+            }
+            const auto StartTime = std::chrono::high_resolution_clock::now();
+            Tree.reset();
+            const std::chrono::duration<double> Timer = std::chrono::high_resolution_clock::now() - StartTime;
+            State.SetIterationTime(Timer.count());
+        }
+        SetRates(State, Input);
+    }
+
+    void Query(benchmark::State& State, Corpus::Shape Kind, std::size_t TargetBytes)
+    {
+        Document& Input = GetDocument(Kind, TargetBytes);
+        const HtmlParser::DOM& Tree = GetTree(Input);
+        const std::string Selector = Corpus::GetShapeSelector(Kind);
+        std::size_t Matches = 0;
+        for (auto _ : State)
+        {
+            Matches = HtmlParser::Query(Tree.Root()).Select(Selector).size();
+        }
+        SetRates(State, Input);
+        State.counters["matches"] = static_cast<double>(Matches);
+    }
+
+    void TextExtraction(benchmark::State& State, Corpus::Shape Kind, std::size_t TargetBytes)
+    {
+        Document& Input = GetDocument(Kind, TargetBytes);
+        const HtmlParser::DOM& Tree = GetTree(Input);
+        std::string Text;
+        for (auto _ : State)
+        {
+            Text.clear();
+            HtmlParser::TextExtractor Extractor(Text);
+            Extractor.Write(*Tree.Root());
+            benchmark::DoNotOptimize(Text.data());
+        }
+        SetRates(State, Input);
+    }
+
+    void Serialize(benchmark::State& State, Corpus::Shape Kind, std::size_t TargetBytes)
+    {
+        Document& Input = GetDocument(Kind, TargetBytes);
+        const HtmlParser::DOM& Tree = GetTree(Input);
+        for (auto _ : State)
+        {
+            benchmark::DoNotOptimize(Tree.ToHtml());
+        }
+        SetRates(State, Input);
+    }
+
+    std::string FormatSize(std::size_t Bytes)
+    {
+        return Bytes >= 1024 * 1024 ? std::to_string(Bytes / (1024 * 1024)) + "MB" : std::to_string(Bytes / 1024) + "KB";
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t Sizes[] = {1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 100 * 1024 * 1024};
+    for (const Corpus::Shape Kind : Corpus::AllShapes)
+    {
+        for (const std::size_t TargetBytes : Sizes)
+        {
+            const std::string Suffix = std::string("/") + Corpus::GetShapeName(Kind) + "/" + FormatSize(TargetBytes);
+            // Phases that parse their own trees come first, so the shared tree is only built afterwards
+            benchmark::RegisterBenchmark(("Tokenize" + Suffix).c_str(), Tokenize, Kind, TargetBytes)->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(("TreeBuild" + Suffix).c_str(), TreeBuild, Kind, TargetBytes)->UseManualTime()->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(("Destroy" + Suffix).c_str(), Destroy, Kind, TargetBytes)->UseManualTime()->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(("Query" + Suffix).c_str(), Query, Kind, TargetBytes)->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(("TextExtraction" + Suffix).c_str(), TextExtraction, Kind, TargetBytes)->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(("Serialize" + Suffix).c_str(), Serialize, Kind, TargetBytes)->Unit(benchmark::kMicrosecond);
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
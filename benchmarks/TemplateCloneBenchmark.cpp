@@ -0,0 +1,66 @@
+#include <HtmlParser/Parser.hpp>
+#include <iostream>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+static std::shared_ptr<HtmlParser::Node> DeepCopy(const std::shared_ptr<HtmlParser::Node>& Source)
+{
+    auto Copy = std::make_shared<HtmlParser::Node>(Source->Type);
+    Copy->Tag = Source->Tag;
+    Copy->Text = Source->Text;
+    Copy->Attributes = Source->Attributes;
+    for (const auto& Child : Source->Children)
+    {
+        Copy->AppendChild(DeepCopy(Child));
+    }
+    return Copy;
+}
+
+// Fills in the per-request parts of the template
+static void Customize(HtmlParser::DOM& Variant, std::size_t Request, const bool UseEdit)
+{
+    const auto Writable = [&](const std::shared_ptr<HtmlParser::Node>& Target) { return UseEdit ? Variant.Edit(Target) : Target; };
+    Writable(Variant.GetElementsByTagName("title").front()->Children.front())->SetText("Request " + std::to_string(Request));
+    Writable(Variant.GetElementById("user"))->SetAttribute("data-user", std::to_string(Request % 1000));
+    Writable(Variant.GetElementById("cart")->Children.front())->SetText(std::to_string(Request % 10) + " items");
+}
+
+int main()
+{
+    std::ostringstream HtmlStream;
+    HtmlStream << "<html><head><title>Store</title></head><body><header><span id=\"user\">Guest</span><span id=\"cart\">0 items</span></header><main>";
+    for (std::size_t i = 0; i < 2000; ++i)
+    {
+        HtmlStream << "<div class=\"product\"><h3>Product " << i << "</h3><p class=\"price\">" << i % 100 << ".99</p><a href=\"/buy/" << i << "\">Buy</a></div>";
+    }
+    HtmlStream << "</main></body></html>";
+
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM Template = Parser.Parse(HtmlStream.str());
+    // Both loops include the same three full-tree lookups per variant
+    const std::size_t VariantCount = 2000;
+
+    BenchmarkReport Report("TemplateCloneBenchmark");
+    std::size_t Request = 0;
+    const double DeepCopySeconds = Report.Measure("DeepCopyAndEdit", VariantCount, 0, [&] {
+        HtmlParser::DOM Variant(DeepCopy(Template.Root()));
+        Customize(Variant, Request++, false);
+    });
+
+    Request = 0;
+    const double CloneSeconds = Report.Measure("CloneAndEdit", VariantCount, 0, [&] {
+        HtmlParser::DOM Variant = Template.Clone();
+        Customize(Variant, Request++, true);
+    });
+
+    const double CloneOnlySeconds = Report.Measure("Clone", VariantCount * 100, 0, [&] { HtmlParser::DOM Variant = Template.Clone(); });
+
+    std::cout << VariantCount << " variants of a " << HtmlStream.str().size() / 1024 << " KB template.\n";
+    std::cout << "Deep copy and edit: " << DeepCopySeconds << " seconds.\n";
+    std::cout << "Clone and edit: " << CloneSeconds << " seconds.\n";
+    std::cout << "Clone alone: " << CloneOnlySeconds / (VariantCount * 100) * 1e9 << " ns.\n";
+    Report.Write();
+
+    return 0;
+}
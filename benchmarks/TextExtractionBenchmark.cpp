@@ -0,0 +1,96 @@
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Snapshot.hpp>
+#include <HtmlParser/TextExtractor.hpp>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+// The recursive concatenation Node::GetTextContent used to do, kept for comparison
+static std::string RecursiveTextContent(const HtmlParser::Node& Target)
+{
+    if (Target.Type == HtmlParser::NodeType::Text)
+    {
+        return Target.Text.ToString();
+    }
+    std::string Result;
+    for (const auto& Child : Target.Children)
+    {
+        Result += RecursiveTextContent(*Child);
+    }
+    return Result;
+}
+
+template <typename Function>
+static void Measure(BenchmarkReport& Report, const char* Label, std::uint32_t RunCount, std::size_t InputBytes, Function&& Extract)
+{
+    std::size_t OutputSize = 0;
+    const double Seconds = Report.Measure(Label, RunCount, InputBytes, [&] { OutputSize = Extract(); }) / RunCount;
+
+    std::cout << Label << ": " << OutputSize / 1024 << " KB of text in " << Seconds * 1e3 << " ms (" << OutputSize / Seconds / 1e6 << " MB/s of text, "
+              << InputBytes / Seconds / 1e6 << " MB/s of markup).\n";
+}
+
+int main()
+{
+    // Roughly 1 MB of article markup: nested sections of prose with inline elements, and some script
+    const std::size_t SectionCount = 2100;
+    std::ostringstream HtmlStream;
+    HtmlStream << "<html><head><title>Article</title><style>p { margin: 0 }</style></head><body><main>";
+    for (std::size_t i = 0; i < SectionCount; ++i)
+    {
+        HtmlStream << "<section><h2>Section " << i << "</h2><div class=\"body\"><p>The quick brown fox jumps over the lazy dog while the "
+                   << "<a href=\"/link/" << i << "\">committee</a> reviews the <em>annual</em> report on regional transport.</p>\n"
+                   << "    <p>Figures for the quarter show a steady rise in ridership, with <b>most growth</b> on the night routes and "
+                   << "fewer delays than last year.</p>\n    <ul><li>First point about the budget</li><li>Second point about staffing</li></ul>"
+                   << "<script>track(" << i << ");</script></div></section>\n";
+    }
+    HtmlStream << "</main></body></html>";
+
+    const std::string Html = HtmlStream.str();
+    HtmlParser::Parser Parser;
+    const HtmlParser::DOM DOM = Parser.Parse(Html);
+    const HtmlParser::Node& Root = *DOM.Root();
+
+    BenchmarkReport Report("TextExtractionBenchmark");
+    const std::uint32_t RunCount = 50;
+    std::string Buffer;
+
+    const std::string AllText = Root.GetTextContent();
+    Measure(Report, "memcpy of the text", RunCount, Html.size(), [&] {
+        Buffer.resize(AllText.size());
+        std::memcpy(Buffer.data(), AllText.data(), AllText.size());
+        return Buffer.size();
+    });
+
+    Measure(Report, "Recursive concatenation", RunCount, Html.size(), [&] { return RecursiveTextContent(Root).size(); });
+    Measure(Report, "GetTextContent", RunCount, Html.size(), [&] { return Root.GetTextContent().size(); });
+
+    Measure(Report, "Visible text, reused buffer", RunCount, Html.size(), [&] {
+        Buffer.clear();
+        HtmlParser::TextExtractor Extractor(Buffer);
+        Extractor.Write(Root);
+        return Buffer.size();
+    });
+
+    Measure(Report, "Visible text, chunked callback", RunCount, Html.size(), [&] {
+        std::size_t Written = 0;
+        HtmlParser::TextExtractor Extractor([&](std::string_view Chunk) { Written += Chunk.size(); });
+        Extractor.Write(Root);
+        Extractor.Flush();
+        return Written;
+    });
+
+    const std::string SnapshotBytes = HtmlParser::Snapshot::Write(DOM);
+    const HtmlParser::Snapshot Flat = HtmlParser::Snapshot::FromBytes(SnapshotBytes);
+    Measure(Report, "Visible text from a snapshot", RunCount, Html.size(), [&] {
+        Buffer.clear();
+        HtmlParser::TextExtractor Extractor(Buffer);
+        Extractor.Write(Flat.Root());
+        return Buffer.size();
+    });
+    Report.Write();
+
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <HtmlParser/Tokenizer.hpp>
+#include <iostream>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+static double MeasureTokenize(BenchmarkReport& Report, const std::string& Name, const std::string& Html, std::uint32_t RunCount, std::size_t& TokenCount)
+{
+    return Report.Measure(Name, RunCount, Html.size(), [&] {
+        HtmlParser::Tokenizer Tokenizer(Html);
+        HtmlParser::Token Token;
+        TokenCount = 0;
+        while (Tokenizer.NextToken(Token))
+        {
+            ++TokenCount;
+        }
+    }) / RunCount;
+}
+
+int main()
+{
+    // Tag-heavy markup with attributes and little text, and a text-heavy document for comparison
+    const std::size_t RowCount = 50000;
+    std::ostringstream TagStream;
+    std::ostringstream TextStream;
+    for (std::size_t i = 0; i < RowCount; ++i)
+    {
+        TagStream << "<tr class=\"row odd\" data-index=\"" << i << "\"><td id=cell" << i << "><a href='/item/" << i << "' title=\"Item\">" << i
+                  << "</a></td><td><span class=\"badge\"></span><br/></td></tr>";
+        TextStream << "<p>Paragraph " << i << " contains a longer run of ordinary prose, the way articles and documentation pages do.</p>";
+    }
+
+    const std::string TagHtml = TagStream.str();
+    const std::string TextHtml = TextStream.str();
+    const std::uint32_t RunCount = 20;
+
+    BenchmarkReport Report("TokenizerThroughputBenchmark");
+    std::size_t TagTokens = 0;
+    std::size_t TextTokens = 0;
+    const double TagSeconds = MeasureTokenize(Report, "TagHeavy", TagHtml, RunCount, TagTokens);
+    const double TextSeconds = MeasureTokenize(Report, "TextHeavy", TextHtml, RunCount, TextTokens);
+
+    std::cout << "Tag-heavy input: " << TagHtml.size() / 1024 << " KB, " << TagTokens << " tokens at " << TagHtml.size() / TagSeconds / 1e6 << " MB/s.\n";
+    std::cout << "Text-heavy input: " << TextHtml.size() / 1024 << " KB, " << TextTokens << " tokens at " << TextHtml.size() / TextSeconds / 1e6 << " MB/s.\n";
+    Report.Write();
+
+    return 0;
+}
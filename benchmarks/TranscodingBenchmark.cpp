@@ -0,0 +1,32 @@
+#include <HtmlParser/Encoding.hpp>
+#include <iostream>
+#include <string>
+
+#include "AllocationCounter.hpp"
+
+int main()
+{
+    // Mostly ASCII markup with a non-ASCII character every line, as in typical European pages
+    const std::size_t LineCount = 200000;
+    std::string Utf8Html;
+    std::string Latin1Html;
+    for (std::size_t i = 0; i < LineCount; ++i)
+    {
+        Utf8Html += "<p class=\"entry\">Caf\xC3\xA9 au lait, cr\xC3\xA8me br\xC3\xBBl\xC3\xA9" "e and more text.</p>\n";
+        Latin1Html += "<p class=\"entry\">Caf\xE9 au lait, cr\xE8me br\xFBl\xE9" "e and more text.</p>\n";
+    }
+
+    BenchmarkReport Report("TranscodingBenchmark");
+    const std::uint32_t RunCount = 20;
+    bool Valid = true;
+    const double ValidateSeconds = Report.Measure("IsValidUtf8", RunCount, Utf8Html.size(), [&] { Valid = Valid && HtmlParser::IsValidUtf8(Utf8Html); }) / RunCount;
+    std::size_t OutputSize = 0;
+    const double TranscodeSeconds =
+        Report.Measure("TranscodeToUtf8", RunCount, Latin1Html.size(), [&] { OutputSize = HtmlParser::TranscodeToUtf8(Latin1Html, HtmlParser::Encoding::Windows1252).size(); }) / RunCount;
+
+    std::cout << "UTF-8 validation: " << Utf8Html.size() / 1024 << " KB at " << Utf8Html.size() / ValidateSeconds / 1e9 << " GB/s (valid: " << Valid << ").\n";
+    std::cout << "windows-1252 to UTF-8: " << Latin1Html.size() / 1024 << " KB at " << Latin1Html.size() / TranscodeSeconds / 1e9 << " GB/s (" << OutputSize / 1024 << " KB out).\n";
+    Report.Write();
+
+    return 0;
+}
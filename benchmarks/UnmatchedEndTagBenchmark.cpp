@@ -0,0 +1,40 @@
+#include <HtmlParser/Parser.hpp>
+#include <iostream>
+#include <optional>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+int main()
+{
+    // A deep stack of open elements with a flood of stray end tags inside it, as on badly broken pages
+    const std::size_t Depth = 10000;
+    const std::size_t StrayEndTagCount = 100000;
+    std::ostringstream HtmlStream;
+
+    for (std::size_t i = 0; i < Depth; ++i)
+    {
+        HtmlStream << "<div>";
+    }
+    for (std::size_t i = 0; i < StrayEndTagCount; ++i)
+    {
+        HtmlStream << (i % 2 == 0 ? "</span>" : "</p>");
+    }
+    for (std::size_t i = 0; i < Depth; ++i)
+    {
+        HtmlStream << "</div>";
+    }
+
+    const std::string Html = HtmlStream.str();
+
+    HtmlParser::Parser Parser;
+    BenchmarkReport Report("UnmatchedEndTagBenchmark");
+
+    std::optional<HtmlParser::DOM> DOM;
+    const double Seconds = Report.Measure("Parse", 1, Html.size(), [&] { DOM.emplace(Parser.Parse(Html)); });
+
+    std::cout << "Parsed " << StrayEndTagCount << " unmatched end tags inside " << Depth << " open elements in " << Seconds << " seconds.\n";
+    Report.Write();
+
+    return 0;
+}
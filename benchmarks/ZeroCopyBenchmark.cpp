@@ -0,0 +1,47 @@
+#include <HtmlParser/Parser.hpp>
+#include <iostream>
+#include <optional>
+#include <sstream>
+
+#include "AllocationCounter.hpp"
+
+static void Measure(BenchmarkReport& Report, const char* Label, const std::string& Html, bool ZeroCopy)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetZeroCopy(ZeroCopy);
+
+    const std::uint32_t RunCount = 5;
+    std::optional<HtmlParser::DOM> DOM;
+    const double Seconds = Report.Measure(Label, RunCount, Html.size(), [&] {
+        DOM.reset();
+        DOM.emplace(Parser.Parse(Html));
+    }) / RunCount;
+    const HtmlParser::MemoryBreakdown Usage = DOM->MemoryUsage();
+
+    std::cout << Label << ": parsed in " << Seconds << " seconds, " << Usage.TextBytes / 1024 << " KB of strings outside the "
+              << Html.size() / 1024 << " KB input, " << Usage.TotalBytes() / 1024 << " KB in total, "
+              << Parser.GetScratchUsage().TotalBytes() << " bytes of scratch memory.\n";
+}
+
+int main()
+{
+    // Roughly 10 MB of article-like markup with long text runs and URLs
+    std::ostringstream HtmlStream;
+    HtmlStream << "<html><body>";
+    for (std::size_t i = 0; i < 20000; ++i)
+    {
+        HtmlStream << "<article class=\"post post-" << i << "\" data-author=\"author-" << i % 97 << "\"><h2><a href=\"https://example.com/posts/" << i
+                   << "/a-reasonably-long-slug\">Post number " << i << "</a></h2><p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+                   << "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris.</p>"
+                   << "<p>Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur &amp; more.</p></article>";
+    }
+    HtmlStream << "</body></html>";
+    const std::string Html = HtmlStream.str();
+
+    BenchmarkReport Report("ZeroCopyBenchmark");
+    Measure(Report, "Copying", Html, false);
+    Measure(Report, "Zero-copy", Html, true);
+    Report.Write();
+
+    return 0;
+}
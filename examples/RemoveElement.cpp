@@ -13,6 +13,8 @@ int main()
     )";
 
     HtmlParser::Parser Parser;
+    // Keep the rest of the document byte for byte as written
+    Parser.SetTrackSourceSpans(true);
     HtmlParser::DOM DOM = Parser.Parse(Html);
 
     // Get the <li> element to remove
@@ -25,8 +27,7 @@ int main()
         if (Parent)
         {
             // Remove the element from its parent's children
-            auto& Siblings = Parent->Children;
-            Siblings.erase(std::remove(Siblings.begin(), Siblings.end(), ItemToRemove), Siblings.end());
+            Parent->RemoveChild(ItemToRemove);
             std::cout << "Element removed.\n";
         }
     }
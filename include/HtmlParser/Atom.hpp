@@ -0,0 +1,202 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace HtmlParser
+{
+    class StringValue;
+
+    // Interned name, such as a tag or attribute name. Equal names share one copy in a process-wide pool,
+    // so atoms are pointer-sized and compare by address. Names of HTML elements and attributes are pooled
+    // for good; any other name is freed with its last atom, so names read from arbitrary input do not
+    // accumulate.
+    class Atom
+    {
+        template <typename T>
+        using IsComparable = std::enable_if_t<std::conjunction_v<std::negation<std::is_base_of<Atom, T>>, std::negation<std::is_same<T, StringValue>>, std::is_convertible<const T&, std::string_view>>>;
+
+    public:
+        Atom() : m_Name(&s_Empty)
+        {
+        }
+        Atom(std::string_view Name) : m_Name(Intern(Name))
+        {
+        }
+        Atom(const std::string& Name) : m_Name(Intern(Name))
+        {
+        }
+        Atom(const char* Name) : m_Name(Intern(Name))
+        {
+        }
+        Atom(const Atom& Other) : m_Name(Other.m_Name)
+        {
+            if (!m_Name->Permanent)
+            {
+                m_Name->References.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        Atom(Atom&& Other) noexcept : m_Name(Other.m_Name)
+        {
+            Other.m_Name = &s_Empty;
+        }
+        Atom& operator=(Atom Other) noexcept
+        {
+            std::swap(m_Name, Other.m_Name);
+            return *this;
+        }
+        ~Atom()
+        {
+            if (!m_Name->Permanent)
+            {
+                Release(m_Name);
+            }
+        }
+
+        // Interns the ASCII-lowercase form of Name, copying it only if it has uppercase letters
+        static Atom Lowercase(std::string_view Name);
+
+        // Returns the atom for Name if it has been interned, or the empty atom otherwise. Unlike the
+        // constructors it never adds to the pool, so it suits lookups of names that may come from anywhere.
+        static Atom Find(std::string_view Name);
+
+        std::string_view View() const
+        {
+            return m_Name->Name;
+        }
+
+        operator std::string_view() const
+        {
+            return m_Name->Name;
+        }
+
+        operator const std::string&() const
+        {
+            return m_Name->Name;
+        }
+
+        std::string ToString() const
+        {
+            return m_Name->Name;
+        }
+
+        const char* data() const
+        {
+            return m_Name->Name.data();
+        }
+
+        std::size_t size() const
+        {
+            return m_Name->Name.size();
+        }
+
+        bool empty() const
+        {
+            return m_Name->Name.empty();
+        }
+
+        friend bool operator==(const Atom& Left, const Atom& Right)
+        {
+            return Left.m_Name == Right.m_Name;
+        }
+
+        friend bool operator!=(const Atom& Left, const Atom& Right)
+        {
+            return Left.m_Name != Right.m_Name;
+        }
+
+        // Compares the characters of anything viewable as a string; StringValue provides its own comparisons
+        template <typename T, typename = IsComparable<T>>
+        friend bool operator==(const Atom& Left, const T& Right)
+        {
+            return Left.View() == std::string_view(Right);
+        }
+
+        template <typename T, typename = IsComparable<T>>
+        friend bool operator==(const T& Left, const Atom& Right)
+        {
+            return Right.View() == std::string_view(Left);
+        }
+
+        template <typename T, typename = IsComparable<T>>
+        friend bool operator!=(const Atom& Left, const T& Right)
+        {
+            return Left.View() != std::string_view(Right);
+        }
+
+        template <typename T, typename = IsComparable<T>>
+        friend bool operator!=(const T& Left, const Atom& Right)
+        {
+            return Right.View() != std::string_view(Left);
+        }
+
+        friend std::ostream& operator<<(std::ostream& Stream, const Atom& Value)
+        {
+            return Stream << Value.View();
+        }
+
+        // Hashes the address, so equal names hash alike without reading their characters
+        std::size_t Hash() const
+        {
+            return std::hash<const void*>()(m_Name);
+        }
+
+    private:
+        friend struct KnownNameTable;
+        friend struct NameShard;
+
+        struct PooledName
+        {
+            PooledName(std::string_view Value, bool IsPermanent) : Name(Value), Permanent(IsPermanent), References(0)
+            {
+            }
+
+            std::string Name;
+            // Known names are never freed, and not counted so that threads do not contend on them
+            bool Permanent;
+            mutable std::atomic<std::uint32_t> References;
+        };
+
+        // Both return the name with a reference added for the new atom
+        static const PooledName* Intern(std::string_view Name);
+        // nullptr if Name is not pooled
+        static const PooledName* Lookup(std::string_view Name);
+        static void Release(const PooledName* Name);
+
+        inline static const PooledName s_Empty{std::string_view(), true};
+        const PooledName* m_Name;
+    };
+
+    // Atom holding the ASCII-lowercase form of whatever it is given, so that names compared without
+    // regard to case, such as tags, can still be compared by address
+    class LowercaseAtom : public Atom
+    {
+    public:
+        LowercaseAtom() = default;
+        LowercaseAtom(std::string_view Name) : Atom(Lowercase(Name))
+        {
+        }
+        LowercaseAtom(const std::string& Name) : Atom(Lowercase(Name))
+        {
+        }
+        LowercaseAtom(const char* Name) : Atom(Lowercase(Name))
+        {
+        }
+        LowercaseAtom(const Atom& Name);
+    };
+} // namespace HtmlParser
+
+template <>
+struct std::hash<HtmlParser::Atom>
+{
+    std::size_t operator()(const HtmlParser::Atom& Value) const
+    {
+        return Value.Hash();
+    }
+};
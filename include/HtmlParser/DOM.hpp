@@ -1,34 +1,130 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "Node.hpp"
 
 namespace HtmlParser
 {
+    enum class TruncationReason
+    {
+        None,
+        MaxDepth,
+        MaxNodes,
+        MaxTextLength,
+        Timeout,
+        StopCondition,
+    };
+
+    class Snapshot;
+
+    enum class ChangeType
+    {
+        Added,
+        Removed,
+        // Same type and tag, different text or attributes
+        Modified,
+    };
+
+    // Estimated memory held by a DOM. Sizes of standard library internals follow the common implementations.
+    struct MemoryBreakdown
+    {
+        // Indexed by NodeType
+        std::array<std::size_t, 5> NodeCounts{};
+        std::size_t NodeBytes = 0;
+        // Reference counts allocated along with each node by std::make_shared
+        std::size_t ControlBlockBytes = 0;
+        // Owned text and attribute values; borrowed ones are part of SourceBytes
+        std::size_t TextBytes = 0;
+        // Distinct tag and attribute names, which are interned and shared with other DOMs
+        std::size_t TagBytes = 0;
+        // Buckets and entries of attribute maps
+        std::size_t AttributeMapBytes = 0;
+        std::size_t ChildVectorBytes = 0;
+        // Input kept for source spans or borrowed values
+        std::size_t SourceBytes = 0;
+
+        std::size_t TotalBytes() const
+        {
+            return NodeBytes + ControlBlockBytes + TextBytes + TagBytes + AttributeMapBytes + ChildVectorBytes + SourceBytes;
+        }
+    };
+
+    // One difference found by DOM::Diff. Added has only After set and Removed only Before.
+    struct NodeChange
+    {
+        ChangeType Type;
+        std::shared_ptr<Node> Before;
+        std::shared_ptr<Node> After;
+    };
+
     class DOM
     {
     public:
-        DOM(const std::shared_ptr<Node>& Root);
+        // SourceOwner keeps Source alive for nodes that reference it
+        DOM(const std::shared_ptr<Node>& Root, TruncationReason Truncation = TruncationReason::None, std::string_view Source = {}, std::shared_ptr<const void> SourceOwner = nullptr);
 
         std::shared_ptr<Node> Root() const;
 
+        // Returns a copy sharing every node with this DOM, in constant time. Afterwards modifying a node of
+        // either DOM directly throws until it is replaced with the node returned by Edit. Must not run
+        // concurrently with other calls on this DOM; the clones themselves can be used from different threads.
+        DOM Clone();
+        // Returns Target's node in this DOM after copying it and its ancestors if they are shared with a
+        // clone, so that changing it leaves other clones untouched. Costs O(depth) node copies.
+        std::shared_ptr<Node> Edit(const std::shared_ptr<Node>& Target);
+
+        // A truncated DOM holds the part of the document parsed before a parse limit or stop condition was hit.
+        bool IsTruncated() const;
+        TruncationReason GetTruncationReason() const;
+
+        // Input the DOM was parsed from, kept when the parser tracks source spans or copies nothing; empty otherwise
+        std::string_view GetSource() const;
+
         void Traverse(const std::function<void(const std::shared_ptr<Node>&)>& Visitor) const;
         std::vector<std::shared_ptr<Node>> GetElementsByTagName(const std::string& TagName) const;
         std::vector<std::shared_ptr<Node>> GetElementsByClassName(const std::string& ClassName) const;
         std::shared_ptr<Node> GetElementById(const std::string& Id) const;
 
         std::string ToHtml() const;
+        void ToHtml(std::ostream& Stream) const;
+
+        // Writes a binary snapshot that loads without parsing; see Snapshot for querying one in place
+        void SaveSnapshot(const std::string& Path) const;
+        static DOM LoadSnapshot(const std::string& Path);
+        // Immutable copy of the document in snapshot form, safe to query from many threads at once
+        Snapshot Freeze() const;
+
+        // Walks the tree and adds up the memory it holds
+        MemoryBreakdown MemoryUsage() const;
+
+        // Differences between two versions of a document. Subtrees with equal hashes are skipped, so with
+        // hashes computed up front (Parser::SetComputeHashes) the cost follows the size of the changes.
+        static std::vector<NodeChange> Diff(const DOM& Before, const DOM& After);
 
     private:
         void TraverseImpl(const std::shared_ptr<Node>& ElementNode, const std::function<void(const std::shared_ptr<Node>&)>& Visitor) const;
-        void GetElementsByTagNameImpl(const std::shared_ptr<Node>& ElementNode, const std::string& TagName, std::vector<std::shared_ptr<Node>>& Elements) const;
+        void GetElementsByTagNameImpl(const std::shared_ptr<Node>& ElementNode, const Atom& TagName, std::vector<std::shared_ptr<Node>>& Elements) const;
         void GetElementsByClassNameImpl(const std::shared_ptr<Node>& ElementNode, const std::string& ClassName, std::vector<std::shared_ptr<Node>>& Elements) const;
         void GetElementByIdImpl(const std::shared_ptr<Node>& ElementNode, const std::string& Id, std::shared_ptr<Node>& Result) const;
-        void ToHtmlImpl(const std::shared_ptr<Node>& ElementNode, std::string& Html) const;
+        std::shared_ptr<Node> CopyNode(const Node& Source, const std::shared_ptr<Node>& Parent) const;
+        static void DiffNodes(const std::shared_ptr<Node>& Before, const std::shared_ptr<Node>& After, std::vector<NodeChange>& Changes);
+
+        // Reparse updates the tree in place when it is not shared with clones
+        friend class Parser;
 
     private:
         std::shared_ptr<Node> m_Document;
+        TruncationReason m_Truncation;
+        std::string_view m_Source;
+        std::shared_ptr<const void> m_SourceOwner;
+        // Identifies the nodes this DOM may modify in place; 0 until the DOM is cloned
+        std::uint64_t m_Owner = 0;
     };
 } // namespace HtmlParser
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace HtmlParser
+{
+    enum class Encoding
+    {
+        // Sniff the encoding from the input
+        Auto,
+        Utf8,
+        Utf16LE,
+        Utf16BE,
+        // Single-byte encodings
+        Ibm866,
+        Iso8859_2,
+        Iso8859_3,
+        Iso8859_4,
+        Iso8859_5,
+        Iso8859_6,
+        Iso8859_7,
+        Iso8859_8,
+        Iso8859_10,
+        Iso8859_13,
+        Iso8859_14,
+        Iso8859_15,
+        Iso8859_16,
+        Koi8R,
+        Koi8U,
+        Macintosh,
+        Windows874,
+        Windows1250,
+        Windows1251,
+        Windows1252,
+        Windows1253,
+        Windows1254,
+        Windows1255,
+        Windows1256,
+        Windows1257,
+        Windows1258,
+        XMacCyrillic,
+    };
+
+    // Resolves a charset label such as "latin1" or "Shift_JIS"; returns Auto for unknown or unsupported labels.
+    Encoding EncodingFromLabel(std::string_view Label);
+
+    // Checks for a byte order mark, then prescans the first 1024 bytes for <meta charset>. Defaults to UTF-8.
+    Encoding SniffEncoding(std::string_view Input);
+
+    bool IsValidUtf8(std::string_view Input);
+
+    // Converts input to UTF-8 chunk by chunk. Sequences split across chunks are carried over, a leading byte
+    // order mark is dropped and malformed input is replaced with U+FFFD.
+    class Utf8Transcoder
+    {
+    public:
+        explicit Utf8Transcoder(Encoding Source);
+
+        void Transcode(std::string_view Chunk, std::string& Out);
+        // Flushes an incomplete trailing sequence
+        void Finish(std::string& Out);
+
+    private:
+        std::size_t TranscodeUtf16(std::string_view Input, std::string& Out, bool IsFinal) const;
+
+        Encoding m_Source;
+        bool m_AtStart = true;
+        std::string m_Pending;
+        // Single-byte encodings: UTF-8 bytes of 0x80-0xFF with the length in the last byte
+        char m_UpperHalf[128][4] = {};
+    };
+
+    std::string TranscodeToUtf8(std::string_view Input, Encoding Source);
+} // namespace HtmlParser
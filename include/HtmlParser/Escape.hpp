@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace HtmlParser
+{
+    // Appends text content with &, < and > escaped.
+    void AppendEscapedText(std::string& Out, std::string_view Text);
+
+    // Appends a double-quoted attribute value with &, <, > and " escaped.
+    void AppendEscapedAttribute(std::string& Out, std::string_view Value);
+
+    // Lengths of the escaped forms, for sizing output buffers up front
+    std::size_t EscapedTextLength(std::string_view Text);
+    std::size_t EscapedAttributeLength(std::string_view Value);
+} // namespace HtmlParser
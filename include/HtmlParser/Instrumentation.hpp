@@ -0,0 +1,80 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace HtmlParser
+{
+    // Parts of the library covered by scoped timers
+    enum class InstrumentedPhase
+    {
+        // A whole Parse call, including the tokenizing and insertion modes below
+        Parse,
+        // Producing tokens, whether pulled by the parser or by Tokenizer::Tokenize
+        Tokenize,
+        // Tree construction, by the insertion mode a token was dispatched to
+        InitialMode,
+        BeforeHtmlMode,
+        BeforeHeadMode,
+        InHeadMode,
+        AfterHeadMode,
+        InBodyMode,
+        Select,
+        Serialize,
+        Count,
+    };
+
+    struct PhaseTiming
+    {
+        std::uint64_t Calls = 0;
+        std::uint64_t Nanoseconds = 0;
+    };
+
+    // Timings and counters collected while the library is built with HTMLPARSER_INSTRUMENTATION. In
+    // other builds nothing is recorded and every value stays zero.
+    struct InstrumentationStats
+    {
+        std::array<PhaseTiming, static_cast<std::size_t>(InstrumentedPhase::Count)> Phases{};
+        // Indexed by TokenType
+        std::array<std::uint64_t, 6> TokensByType{};
+        std::uint64_t NodesCreated = 0;
+        std::uint64_t ParseErrors = 0;
+        // Deepest stack of open elements, the document included
+        std::uint64_t MaxStackDepth = 0;
+        // Elements and other nodes a selector was tested against
+        std::uint64_t SelectorNodesVisited = 0;
+
+        const PhaseTiming& GetPhase(InstrumentedPhase Phase) const
+        {
+            return Phases[static_cast<std::size_t>(Phase)];
+        }
+
+        // Adds Other's timings and counts; the maximum stack depth is the larger of the two
+        void Merge(const InstrumentationStats& Other);
+
+        std::string ToJson() const;
+    };
+
+    namespace Instrumentation
+    {
+        constexpr bool Enabled =
+#ifdef HTMLPARSER_INSTRUMENTATION
+            true;
+#else
+            false;
+#endif
+
+        // Everything recorded on the calling thread since it started or was last flushed
+        const InstrumentationStats& GetThreadStats();
+
+        // Moves the calling thread's stats into the process totals. Threads do this when they exit.
+        void FlushThread();
+
+        // Totals of exited and flushed threads plus the calling thread
+        InstrumentationStats GetProcessStats();
+
+        // Clears the process totals and the calling thread's stats
+        void Reset();
+    } // namespace Instrumentation
+} // namespace HtmlParser
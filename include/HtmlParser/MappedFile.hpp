@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace HtmlParser
+{
+    // Read-only memory mapping of a file, advised for sequential access.
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::string& Path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        std::string_view View() const;
+        std::size_t Size() const;
+
+    private:
+        const char* m_Data = nullptr;
+        std::size_t m_Size = 0;
+
+#ifdef _WIN32
+        void* m_FileHandle = nullptr;
+        void* m_MappingHandle = nullptr;
+#endif
+    };
+} // namespace HtmlParser
@@ -1,9 +1,14 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "Atom.hpp"
+#include "StringValue.hpp"
+
 namespace HtmlParser
 {
     enum class NodeType
@@ -15,22 +20,111 @@ namespace HtmlParser
         Doctype,
     };
 
+    // Byte offsets of a parsed node in its source. [Begin, ContentBegin) is the start tag, preceded by any
+    // input the parser ignored just before it; [ContentEnd, End) is the end tag.
+    struct SourceSpan
+    {
+        std::uint32_t Begin = 0;
+        std::uint32_t ContentBegin = 0;
+        std::uint32_t ContentEnd = 0;
+        std::uint32_t End = 0;
+    };
+
+    class DOM;
+
     class Node : public std::enable_shared_from_this<Node>
     {
     public:
         Node(NodeType _Type);
 
         NodeType Type;
-        std::string Tag;
-        std::string Text;
-        std::unordered_map<std::string, std::string> Attributes;
+        // Lowercased when assigned, like parsed tags, so that tags compare by address
+        LowercaseAtom Tag;
+        // Values parsed with Parser::SetZeroCopy may borrow from the DOM's input
+        StringValue Text;
+        std::unordered_map<Atom, StringValue> Attributes;
         std::vector<std::shared_ptr<Node>> Children;
         std::weak_ptr<Node> Parent;
 
+        // The methods below that modify the node throw std::runtime_error if it is shared with a clone of its
+        // DOM; get the node to modify from DOM::Edit instead.
         void AppendChild(const std::shared_ptr<Node>& Child);
+        void RemoveChild(const std::shared_ptr<Node>& Child);
         std::string GetAttribute(const std::string& Name) const;
         void SetAttribute(const std::string& Name, const std::string& Value);
+        void SetText(const std::string& Value);
         bool HasClass(const std::string& ClassName) const;
         std::string GetTextContent() const;
+
+        // Markup of the node itself, and of its children only
+        std::string OuterHtml() const;
+        std::string InnerHtml() const;
+
+        // Source tracking, used to copy unmodified markup verbatim when serializing. The methods above
+        // keep it up to date; call MarkDirty() after changing Tag, Text or Attributes directly.
+        void MarkDirty();
+        void MarkChildrenDirty();
+        bool IsDirty() const;
+        bool HasDirtyDescendants() const;
+        bool HasSourceSpan() const;
+        const SourceSpan& GetSourceSpan() const;
+        void SetSourceSpan(const SourceSpan& Span);
+
+        // Structural hash of the node and its subtree, covering type, tag, text, attributes in any order and
+        // children in order. Computed on first use and kept until the subtree is marked modified.
+        std::uint64_t GetHash() const;
+
+    private:
+        friend class DOM;
+        friend class Parser;
+        friend class Snapshot;
+
+        enum Flags : std::uint8_t
+        {
+            Dirty = 1,
+            DirtyDescendants = 2,
+            Unsourced = 4,
+            // Set by DOM::Clone on the root: the node and its descendants are shared with another DOM
+            Shared = 8,
+        };
+
+        // Throws if the node or one of its ancestors is marked shared
+        void CheckModifiable();
+        void MarkShared();
+        void MarkAncestorsDirty();
+        // Forgets the hashes of the node and its ancestors
+        void InvalidateHash();
+        // Hashes the node from the hashes of its children, which must all be computed
+        void StoreHash() const;
+
+        SourceSpan m_Span;
+        std::uint8_t m_Flags = Unsourced;
+        // Index in the parent's children when the node was attached, which lets DOM::Edit find it without a
+        // search unless an earlier sibling has been removed since
+        std::uint32_t m_Position = 0;
+        // Clone count at which the node was last found not to be shared; nothing is shared before the first clone
+        std::uint64_t m_CheckedGeneration = 0;
+        // Copyable so that DOM::Edit can copy nodes. Nodes shared by clones may be hashed from several
+        // threads at once; they all store the same value, so relaxed ordering is enough.
+        struct CachedHash
+        {
+            std::atomic<std::uint64_t> Value{0};
+
+            CachedHash() = default;
+            CachedHash(const CachedHash& Other) : Value(Other.Value.load(std::memory_order_relaxed))
+            {
+            }
+            CachedHash& operator=(const CachedHash& Other)
+            {
+                Value.store(Other.Value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                return *this;
+            }
+        };
+
+        // 0 until computed
+        mutable CachedHash m_Hash;
+        // Set on copies made by DOM::Edit: the parsed node all copies descend from, and the DOM that may modify this one
+        std::shared_ptr<const Node> m_Origin;
+        std::uint64_t m_Owner = 0;
     };
 } // namespace HtmlParser
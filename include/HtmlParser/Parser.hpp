@@ -1,24 +1,177 @@
 #pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "DOM.hpp"
+#include "Encoding.hpp"
+#include "Instrumentation.hpp"
 #include "Tokenizer.hpp"
 
 namespace HtmlParser
 {
+    // Budgets for a single parse. Zero means unlimited. When a limit is hit, parsing stops
+    // and the partial DOM is returned marked as truncated.
+    struct ParseLimits
+    {
+        std::size_t MaxDepth = 0;
+        std::size_t MaxNodes = 0;
+        // Applies to each text run, tag name, attribute name and attribute value
+        std::size_t MaxTextLength = 0;
+        std::chrono::nanoseconds Timeout{0};
+    };
+
+    // Ends parsing early once any of the set conditions holds. Elements still open at that point
+    // are left implicitly closed in the returned DOM.
+    struct StopCondition
+    {
+        // Stop once this element has been closed, e.g. "head"
+        std::string AfterElement;
+        // Stop before a token that ends past this input offset (0 = unlimited)
+        std::size_t MaxBytes = 0;
+        // Stop once this many elements have been inserted, implied html/head/body included (0 = unlimited)
+        std::size_t MaxElements = 0;
+        // Checked before each token is processed; a matching token is not inserted
+        std::function<bool(const Token&)> TokenPredicate;
+        // Checked after each node is inserted; a matching node is kept
+        std::function<bool(const std::shared_ptr<Node>&)> NodePredicate;
+    };
+
+    // Content left out of the tree at construction time
+    struct DiscardOptions
+    {
+        // Elements skipped together with everything inside them, e.g. "script", "svg"
+        std::vector<std::string> Elements;
+        bool Comments = false;
+        // Whitespace-only text between tags, outside <pre> and <textarea>
+        bool WhitespaceText = false;
+    };
+
+    // A change to the source of a parsed document: Length bytes at Offset replaced with Text
+    struct SourceEdit
+    {
+        std::size_t Offset = 0;
+        std::size_t Length = 0;
+        std::string_view Text;
+    };
+
+    // Working memory of a parse besides the DOM it builds
+    struct ScratchUsage
+    {
+        // Deepest the stack of open elements got, the document included
+        std::size_t MaxOpenElements = 0;
+        // Stack of open elements and per-tag open counts
+        std::size_t OpenElementBytes = 0;
+        std::size_t TokenizerBytes = 0;
+        // Whitespace held back by DiscardOptions::WhitespaceText
+        std::size_t PendingWhitespaceBytes = 0;
+
+        std::size_t TotalBytes() const
+        {
+            return OpenElementBytes + TokenizerBytes + PendingWhitespaceBytes;
+        }
+    };
+
     class Parser
     {
     public:
         Parser();
 
-        DOM Parse(const std::string& Input);
+        DOM Parse(std::string_view Input);
+
+        // Parses input kept alive by InputOwner. A DOM that needs its input after parsing holds on to
+        // InputOwner instead of copying the input.
+        DOM Parse(std::string_view Input, std::shared_ptr<const void> InputOwner);
+
+        // Parses a file directly from a read-only memory mapping.
+        DOM ParseFile(const std::string& Path);
+
+        // Applies Edit to the source of a DOM parsed with source spans and updates the tree to what parsing
+        // the edited source would give. When the edit lies inside the contents of an element closed by its
+        // own end tag, only those contents are parsed again and every node outside the element is kept;
+        // otherwise the whole source is parsed. Returns true if the tree was updated incrementally. The parser
+        // settings must be the ones the DOM was parsed with.
+        bool Reparse(DOM& Tree, const SourceEdit& Edit);
 
         void SetStrict(bool Strict)
         {
             m_IsStrict = Strict;
         }
 
+        void SetLimits(const ParseLimits& Limits)
+        {
+            m_Limits = Limits;
+        }
+
+        void SetStopCondition(const StopCondition& Condition);
+
+        // Drops the contents of <script>, <style> and other raw text elements without storing them
+        void SetSkipRawTextContent(bool Skip)
+        {
+            m_SkipRawTextContent = Skip;
+        }
+
+        void SetDiscardOptions(const DiscardOptions& Options);
+
+        // Character references in text and attribute values are decoded unless disabled
+        void SetDecodeEntities(bool Decode)
+        {
+            m_DecodeEntities = Decode;
+        }
+
+        // Input is taken as UTF-8 unless set otherwise. Auto sniffs the byte order mark and <meta charset>;
+        // anything other than valid UTF-8 is then transcoded before tokenizing.
+        void SetInputEncoding(Encoding InputEncoding)
+        {
+            m_InputEncoding = InputEncoding;
+        }
+
+        // Records where each node came from and keeps the input in the DOM, so that serializing copies
+        // unmodified markup verbatim. Inputs over 4 GiB are parsed without spans.
+        void SetTrackSourceSpans(bool Track)
+        {
+            m_TrackSourceSpans = Track;
+        }
+
+        // Text and attribute values that appear in the input unchanged reference it instead of being
+        // copied; the DOM keeps the input alive. Values are copied once they are modified.
+        void SetZeroCopy(bool ZeroCopy)
+        {
+            m_ZeroCopy = ZeroCopy;
+        }
+
+        // Peak working memory of the last Parse or Reparse
+        const ScratchUsage& GetScratchUsage() const
+        {
+            return m_ScratchUsage;
+        }
+
+        // Timings and counters of the last Parse or Reparse, when built with HTMLPARSER_INSTRUMENTATION
+        const InstrumentationStats& GetInstrumentationStats() const
+        {
+            return m_InstrumentationStats;
+        }
+
+        // Computes the hash of every node in one bottom-up pass after parsing, ahead of DOM::Diff
+        void SetComputeHashes(bool Compute)
+        {
+            m_ComputeHashes = Compute;
+        }
+
     private:
+        std::string_view DecodeInput(std::string_view Input, std::string& Buffer) const;
+
+        // Copies Value unless the DOM can reference the input
+        StringValue KeepValue(const StringValue& Value) const;
+
+        void ProcessToken(Token& Token);
+
         void InsertionModeInitial(const Token& Token);
         void InsertionModeBeforeHtml(const Token& Token);
         void InsertionModeBeforeHead(const Token& Token);
@@ -30,12 +183,27 @@ namespace HtmlParser
 
         std::shared_ptr<Node> CurrentNode();
 
+        bool ReserveNode();
+        void OnNodeInserted(const std::shared_ptr<Node>& InsertedNode);
+        // EndTag is the token that closed the element, if any
+        void PopElement(const Token* EndTag = nullptr);
+        void AppendNode(const std::shared_ptr<Node>& Parent, const std::shared_ptr<Node>& Child, const Token& Token);
+        void FinishSourceSpans(std::size_t InputSize);
+        void FinishScratchUsage(const Tokenizer& Instance);
+
+        bool CanReparseIncrementally(const DOM& Tree) const;
+        // Parses Source up to RegionEnd as the new contents of Element, into Replacement
+        bool ReparseElement(const std::shared_ptr<Node>& Element, const std::shared_ptr<Node>& Replacement, std::string_view Source, std::size_t RegionEnd);
+
         void InsertElement(const Token& Token);
         void InsertCharacter(const Token& Token);
+        void InsertComment(const Token& Token);
         void CloseElement(const Token& Token);
 
         std::shared_ptr<Node> Document;
         std::vector<std::shared_ptr<Node>> OpenElements;
+        // Number of open elements per tag name
+        std::unordered_map<Atom, std::size_t> m_OpenCounts;
 
         enum class InsertionMode
         {
@@ -52,5 +220,34 @@ namespace HtmlParser
 
         bool m_IsStrict = false;
         bool m_IsFragment = false;
+        bool m_SkipRawTextContent = false;
+        bool m_DecodeEntities = true;
+        Encoding m_InputEncoding = Encoding::Utf8;
+
+        bool m_ZeroCopy = false;
+        bool m_ComputeHashes = false;
+        bool m_TrackSourceSpans = false;
+        bool m_RecordingSpans = false;
+        // End of the input covered by the nodes inserted so far; input the parser ignores after it is
+        // attached to the next node, unless some was discarded, which leaves a gap
+        std::size_t m_SourceCursor = 0;
+        bool m_SourceGap = false;
+        // Source made by the last Reparse, edited in place by the next one while only its DOM holds it
+        std::weak_ptr<std::string> m_EditBuffer;
+
+        DiscardOptions m_DiscardOptions;
+        std::unordered_set<std::string> m_DiscardedElements;
+        std::size_t m_PreformattedDepth = 0;
+        std::string m_PendingWhitespace;
+
+        ParseLimits m_Limits;
+        std::size_t m_NodeCount = 0;
+        StopCondition m_StopCondition;
+        Atom m_StopAfterElement;
+        std::size_t m_ElementCount = 0;
+        TruncationReason m_Truncation = TruncationReason::None;
+
+        ScratchUsage m_ScratchUsage;
+        InstrumentationStats m_InstrumentationStats;
     };
 } // namespace HtmlParser
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "Node.hpp"
+
+namespace HtmlParser
+{
+    // Writes markup straight into a sink without building intermediate strings.
+    class Serializer
+    {
+    public:
+        static constexpr std::size_t DefaultChunkSize = 64 * 1024;
+
+        // Appends to Out, which can be reused across calls
+        explicit Serializer(std::string& Out);
+        // Buffers output and writes it out in chunks of about ChunkSize bytes
+        explicit Serializer(std::ostream& Stream, std::size_t ChunkSize = DefaultChunkSize);
+        // Throws std::invalid_argument if Writer is empty
+        explicit Serializer(std::function<void(std::string_view)> Writer, std::size_t ChunkSize = DefaultChunkSize);
+        ~Serializer();
+
+        Serializer(const Serializer&) = delete;
+        Serializer& operator=(const Serializer&) = delete;
+
+        // Measures the output first so a string sink grows with a single allocation
+        void SetPrecomputeSize(bool Precompute)
+        {
+            m_PrecomputeSize = Precompute;
+        }
+
+        // Input the nodes were parsed from. Nodes with a source span that have not been modified since
+        // are copied from it verbatim instead of being re-serialized.
+        void SetSource(std::string_view Source)
+        {
+            m_Source = Source;
+        }
+
+        void WriteOuterHtml(const Node& Target);
+        void WriteInnerHtml(const Node& Target);
+        void Flush();
+
+        // Exact length of the markup WriteOuterHtml and WriteInnerHtml produce
+        static std::size_t OuterHtmlSize(const Node& Target);
+        static std::size_t InnerHtmlSize(const Node& Target);
+
+    private:
+        void WriteNode(const Node& Target, bool Sourced);
+        // Following is the source offset the output continues from after the last child, if it is copied
+        void WriteChildren(const Node& Target, bool Sourced, std::uint32_t Following);
+        void WriteSource(std::uint32_t Begin, std::uint32_t End);
+        void FlushSource();
+        bool ShouldPrecomputeSize() const;
+        void FlushIfFull();
+
+        std::string* m_Out;
+        std::string m_Buffer;
+        std::ostream* m_Stream = nullptr;
+        std::function<void(std::string_view)> m_Writer;
+        std::size_t m_ChunkSize = 0;
+        std::string_view m_Source;
+        // Source bytes still to be copied
+        std::uint32_t m_CopyBegin = 0;
+        std::uint32_t m_CopyEnd = 0;
+        bool m_PrecomputeSize = false;
+    };
+} // namespace HtmlParser
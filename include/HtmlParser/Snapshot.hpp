@@ -0,0 +1,151 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DOM.hpp"
+
+namespace HtmlParser
+{
+    class Snapshot;
+    class TextExtractor;
+
+    // Handle to a node stored in a snapshot; only valid while the Snapshot it came from is alive.
+    class SnapshotNode
+    {
+    public:
+        SnapshotNode() = default;
+
+        explicit operator bool() const
+        {
+            return m_Snapshot != nullptr;
+        }
+
+        // Position in document order, 0 being the document itself
+        std::uint32_t Index() const
+        {
+            return m_Index;
+        }
+
+        NodeType Type() const;
+        std::string_view Tag() const;
+        std::string_view Text() const;
+
+        SnapshotNode Parent() const;
+        SnapshotNode FirstChild() const;
+        SnapshotNode NextSibling() const;
+        std::vector<SnapshotNode> Children() const;
+
+        // Attributes are stored sorted by name
+        std::size_t AttributeCount() const;
+        std::string_view AttributeName(std::size_t Position) const;
+        std::string_view AttributeValue(std::size_t Position) const;
+        bool HasAttribute(std::string_view Name) const;
+        std::string_view GetAttribute(std::string_view Name) const;
+        bool HasClass(std::string_view ClassName) const;
+
+        std::string GetTextContent() const;
+
+        // Same selector syntax as Query, matching this node and its descendants
+        std::vector<SnapshotNode> Select(const std::string& Selector) const;
+        SnapshotNode SelectFirst(const std::string& Selector) const;
+
+    private:
+        friend class Snapshot;
+        friend class TextExtractor;
+        SnapshotNode(const Snapshot* Owner, std::uint32_t Index) : m_Snapshot(Owner), m_Index(Index)
+        {
+        }
+
+        const Snapshot* m_Snapshot = nullptr;
+        std::uint32_t m_Index = 0;
+    };
+
+    // Read-only DOM stored in a flat binary image: a header followed by node, attribute and string tables
+    // that refer to each other by index and offset only. Opening one validates the header and nothing
+    // else, so it costs the same for any document size; accessors check every index they follow.
+    // Nothing is written after construction and handles are not reference counted, so any number of
+    // threads may query one snapshot, such as a frozen DOM, without synchronization.
+    class Snapshot
+    {
+    public:
+        static constexpr std::uint32_t FormatVersion = 1;
+
+        // Writes a snapshot of the DOM
+        static void Write(const DOM& Document, std::ostream& Stream);
+        static std::string Write(const DOM& Document);
+
+        // Throws std::runtime_error unless Bytes holds a snapshot of this format version. Owner keeps
+        // Bytes alive for as long as the snapshot and its copies are used.
+        static Snapshot FromBytes(std::string_view Bytes, std::shared_ptr<const void> Owner = nullptr);
+        // Memory-maps a snapshot file
+        static Snapshot Open(const std::string& Path);
+
+        std::size_t NodeCount() const;
+        SnapshotNode Root() const;
+        SnapshotNode NodeAt(std::uint32_t Index) const;
+        TruncationReason GetTruncationReason() const;
+
+        // Visits every node in document order
+        void Traverse(const std::function<void(const SnapshotNode&)>& Visitor) const;
+        std::vector<SnapshotNode> GetElementsByTagName(std::string_view TagName) const;
+        std::vector<SnapshotNode> GetElementsByClassName(std::string_view ClassName) const;
+        SnapshotNode GetElementById(std::string_view Id) const;
+        std::vector<SnapshotNode> Select(const std::string& Selector) const;
+        SnapshotNode SelectFirst(const std::string& Selector) const;
+
+        // Builds Node objects whose text and attribute values reference the snapshot data
+        DOM ToDOM() const;
+
+    private:
+        friend class SnapshotNode;
+        friend class TextExtractor;
+
+        struct StringRef
+        {
+            std::uint32_t Offset;
+            std::uint32_t Length;
+        };
+
+        struct NodeRecord
+        {
+            std::uint8_t Type;
+            std::uint8_t Reserved[3];
+            std::uint32_t Parent;
+            // Nodes are stored in document order, so descendants are [Index + 1, SubtreeEnd)
+            std::uint32_t SubtreeEnd;
+            std::uint32_t NextSibling;
+            StringRef Tag;
+            StringRef Text;
+            std::uint32_t FirstAttribute;
+            std::uint32_t AttributeCount;
+        };
+
+        struct AttributeRecord
+        {
+            StringRef Name;
+            StringRef Value;
+        };
+
+        Snapshot() = default;
+
+        NodeRecord ReadNode(std::uint32_t Index) const;
+        AttributeRecord ReadAttribute(std::uint32_t Index) const;
+        std::string_view ReadString(const StringRef& Ref) const;
+
+        std::string_view m_Bytes;
+        std::shared_ptr<const void> m_Owner;
+        std::uint32_t m_NodeCount = 0;
+        std::uint32_t m_AttributeCount = 0;
+        std::size_t m_NodeTable = 0;
+        std::size_t m_AttributeTable = 0;
+        std::size_t m_StringTable = 0;
+        std::size_t m_StringBytes = 0;
+        TruncationReason m_Truncation = TruncationReason::None;
+    };
+} // namespace HtmlParser
@@ -0,0 +1,138 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace HtmlParser
+{
+    // Text that either owns its bytes or borrows them from a buffer kept alive elsewhere, such as the
+    // input a DOM was parsed from. Borrowed values are copied into owned storage when they are modified.
+    class StringValue
+    {
+    public:
+        StringValue() = default;
+        StringValue(std::string Value) : m_Owned(std::move(Value))
+        {
+        }
+        StringValue(const char* Value) : m_Owned(Value)
+        {
+        }
+
+        // The bytes must outlive the value and all copies of it
+        static StringValue Borrow(std::string_view View)
+        {
+            StringValue Value;
+            Value.m_Borrowed = View.empty() ? std::string_view() : View;
+            return Value;
+        }
+
+        bool IsBorrowed() const
+        {
+            return m_Borrowed.data() != nullptr;
+        }
+
+        // Copies borrowed bytes into storage of its own
+        void MakeOwned()
+        {
+            if (IsBorrowed())
+            {
+                m_Owned.assign(m_Borrowed);
+                m_Borrowed = std::string_view();
+            }
+        }
+
+        std::string_view View() const
+        {
+            return IsBorrowed() ? m_Borrowed : std::string_view(m_Owned);
+        }
+
+        operator std::string_view() const
+        {
+            return View();
+        }
+
+        std::string ToString() const
+        {
+            return std::string(View());
+        }
+
+        const char* data() const
+        {
+            return View().data();
+        }
+
+        std::size_t size() const
+        {
+            return View().size();
+        }
+
+        bool empty() const
+        {
+            return View().empty();
+        }
+
+        // Bytes allocated for owned storage; short strings are stored inline and borrowed ones elsewhere
+        std::size_t HeapBytes() const
+        {
+            const char* Bytes = m_Owned.data();
+            const char* Inline = reinterpret_cast<const char*>(&m_Owned);
+            return Bytes >= Inline && Bytes < Inline + sizeof(m_Owned) ? 0 : m_Owned.capacity() + 1;
+        }
+
+        void RemovePrefix(std::size_t Count)
+        {
+            if (IsBorrowed())
+            {
+                m_Borrowed.remove_prefix(Count);
+            }
+            else
+            {
+                m_Owned.erase(0, Count);
+            }
+        }
+
+        StringValue& operator+=(std::string_view Suffix)
+        {
+            MakeOwned();
+            m_Owned += Suffix;
+            return *this;
+        }
+
+        // Compares with anything viewable as a string, including other values
+        template <typename T, typename = std::enable_if_t<std::is_convertible_v<const T&, std::string_view>>>
+        friend bool operator==(const StringValue& Left, const T& Right)
+        {
+            return Left.View() == std::string_view(Right);
+        }
+
+        template <typename T, typename = std::enable_if_t<std::is_convertible_v<const T&, std::string_view> && !std::is_same_v<T, StringValue>>>
+        friend bool operator==(const T& Left, const StringValue& Right)
+        {
+            return Right == Left;
+        }
+
+        template <typename T>
+        friend auto operator!=(const StringValue& Left, const T& Right) -> decltype(Left == Right)
+        {
+            return !(Left == Right);
+        }
+
+        template <typename T, typename = std::enable_if_t<!std::is_same_v<T, StringValue>>>
+        friend auto operator!=(const T& Left, const StringValue& Right) -> decltype(Right == Left)
+        {
+            return !(Right == Left);
+        }
+
+        friend std::ostream& operator<<(std::ostream& Stream, const StringValue& Value)
+        {
+            return Stream << Value.View();
+        }
+
+    private:
+        std::string m_Owned;
+        // Non-null while the value is borrowed
+        std::string_view m_Borrowed;
+    };
+} // namespace HtmlParser
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Node.hpp"
+#include "Snapshot.hpp"
+
+namespace HtmlParser
+{
+    struct TextOptions
+    {
+        // Leaves out head, script, style, template and noscript elements and elements with a hidden attribute
+        bool SkipInvisible = true;
+        // Turns each run of whitespace into one space and drops it at the start and end of lines, except
+        // inside pre and textarea
+        bool CollapseWhitespace = true;
+        // Puts block-level elements such as p, div, li and tr on lines of their own, a line break for br
+        // and a space between table cells
+        bool BlockSeparators = true;
+        // Decodes character references in text parsed with Parser::SetDecodeEntities(false)
+        bool DecodeEntities = false;
+    };
+
+    // Writes the text of a subtree straight into a sink, in one pass over the tree and without intermediate
+    // strings. The defaults give the text a reader sees; with every option off it is the concatenation of
+    // all text nodes, as returned by Node::GetTextContent.
+    class TextExtractor
+    {
+    public:
+        static constexpr std::size_t DefaultChunkSize = 64 * 1024;
+
+        // Appends to Out, which can be reused across calls
+        explicit TextExtractor(std::string& Out);
+        // Buffers output and writes it out in chunks of about ChunkSize bytes
+        explicit TextExtractor(std::ostream& Stream, std::size_t ChunkSize = DefaultChunkSize);
+        // Throws std::invalid_argument if Writer is empty
+        explicit TextExtractor(std::function<void(std::string_view)> Writer, std::size_t ChunkSize = DefaultChunkSize);
+        ~TextExtractor();
+
+        TextExtractor(const TextExtractor&) = delete;
+        TextExtractor& operator=(const TextExtractor&) = delete;
+
+        void SetOptions(const TextOptions& Options)
+        {
+            m_Options = Options;
+        }
+
+        // Writes the text of Target and its descendants. Separators pending at the end are dropped, so
+        // consecutive calls are not separated from each other.
+        void Write(const Node& Target);
+        // Reads the snapshot's node table in order, which avoids the pointer chasing of a Node tree
+        void Write(const SnapshotNode& Target);
+        void Flush();
+
+    private:
+        struct Frame
+        {
+            const Node* Target;
+            std::size_t NextChild;
+            std::uint8_t Kind;
+        };
+
+        struct SnapshotFrame
+        {
+            std::uint32_t SubtreeEnd;
+            std::uint8_t Kind;
+        };
+
+        void Begin();
+        void End();
+        // Plain concatenation needs nothing from elements, so they are not classified
+        bool NeedsKinds() const;
+        // Returns false if the element is left out
+        bool Enter(std::uint8_t Kind);
+        void Leave(std::uint8_t Kind);
+        void WriteText(std::string_view Text, bool InRawText);
+        void WriteCollapsed(std::string_view Text);
+        void WritePendingSeparator();
+        void FlushIfFull();
+
+        TextOptions m_Options;
+        std::string* m_Out;
+        std::string m_Buffer;
+        std::ostream* m_Stream = nullptr;
+        std::function<void(std::string_view)> m_Writer;
+        std::size_t m_ChunkSize = 0;
+        // Kept between calls so that repeated extraction does not allocate
+        std::vector<Frame> m_Stack;
+        std::vector<SnapshotFrame> m_SnapshotStack;
+        std::string m_Decoded;
+        std::size_t m_PreformattedDepth = 0;
+        std::size_t m_RawTextDepth = 0;
+        bool m_AtLineStart = true;
+        bool m_PendingSpace = false;
+        bool m_PendingNewline = false;
+    };
+} // namespace HtmlParser
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "Atom.hpp"
+#include "StringValue.hpp"
+
 namespace HtmlParser
 {
     enum class TokenType
@@ -16,21 +22,54 @@ namespace HtmlParser
         EOFToken
     };
 
+    // Data and attribute values borrow from the tokenizer's input wherever they appear in it unchanged.
     struct Token
     {
         TokenType Type;
-        std::string Data;
-        std::unordered_map<std::string, std::string> Attributes;
+        StringValue Data;
+        // Tag name of start and end tags
+        LowercaseAtom Name;
+        std::unordered_map<Atom, StringValue> Attributes;
         bool SelfClosing = false;
+        // Byte range of the token in the input; both are 0 for tokens that do not come from the input
+        std::size_t Begin = 0;
+        std::size_t End = 0;
     };
 
     class Tokenizer
     {
     public:
-        Tokenizer(const std::string& InputStr);
+        // The input is not copied and must outlive the tokenizer and the tokens it produces.
+        Tokenizer(std::string_view InputStr);
         void Tokenize();
         const std::vector<Token>& GetTokens() const;
 
+        // Produces the next token on demand; returns false once the input is exhausted.
+        bool NextToken(Token& Out);
+
+        // Stops tokenizing once a text run, tag name or attribute exceeds MaxLength bytes (0 = unlimited).
+        void SetMaxTokenLength(std::size_t MaxLength);
+        bool LimitExceeded() const;
+
+        std::size_t GetPosition() const;
+        // Continues in the data state at Position, as if the input before it had been tokenized
+        void Seek(std::size_t Position);
+
+        // Scans past the contents of raw text elements such as <script> and <style> without emitting them.
+        void SetSkipRawTextContent(bool Skip);
+
+        // Fast-forwards past these elements (lowercase names) and everything inside them without emitting tokens.
+        void SetDiscardedElements(const std::unordered_set<std::string>& Elements);
+        void SetDiscardComments(bool Discard);
+        // Number of elements, comments and raw text runs skipped so far because of the options above
+        std::size_t GetDiscardCount() const;
+
+        // Decodes character references such as &amp; and &#x27; in text and attribute values (on by default).
+        void SetDecodeCharacterReferences(bool Decode);
+
+        // Memory held besides the input: buffered tokens and the attribute being read
+        std::size_t GetScratchBytes() const;
+
     private:
         enum class State
         {
@@ -48,38 +87,70 @@ namespace HtmlParser
             AttributeValueUnquoted,
             AfterAttributeValueQuoted,
             AfterAttributeValueUnquoted,
+            RawText,
         };
 
-        void EmitToken(const Token& Token);
-        void ReconsumeChar();
+        void Step();
+        void EmitToken(Token&& Token);
+        void EmitCurrentTag();
+        bool ExceedsLimit(std::size_t Length);
+        void AssignText(StringValue& Out, std::string_view Text) const;
+        void AppendCharacterReference();
+        void CommitAttribute(StringValue Value);
+
+        // Byte runs are classified with the tables in CharacterClasses.hpp
+        std::size_t ScanUntil(std::size_t From, std::uint8_t Class) const;
+        std::size_t SkipWhitespace(std::size_t From) const;
+        // Appends bytes up to the next one in EndClass; returns false at the end of input or on a limit
+        bool AppendRun(std::string& Out, std::uint8_t EndClass);
 
-        bool IsWhitespace(char c) const;
-        bool IsAlpha(char c) const;
+        void HandleMarkupDeclaration();
+        void SkipDiscardedElement();
+        bool MatchesTagName(std::size_t Position, std::string_view TagName) const;
+        std::size_t FindEndTag(std::size_t From, std::string_view TagName) const;
+        std::size_t FindTagEnd(std::size_t From, bool& SelfClosing) const;
 
         // State handling functions
-        void HandleDataState(char c);
-        void HandleTagOpenState(char c);
-        void HandleTagNameState(char c);
-        void HandleEndTagOpenState(char c);
-        void HandleSelfClosingStartTagState(char c);
-        void HandleBeforeAttributeNameState(char c);
-        void HandleAttributeNameState(char c);
-        void HandleAfterAttributeNameState(char c);
-        void HandleBeforeAttributeValueState(char c);
-        void HandleAttributeValueDoubleQuotedState(char c);
-        void HandleAttributeValueSingleQuotedState(char c);
-        void HandleAttributeValueUnquotedState(char c);
-        void HandleAfterAttributeValueQuotedState(char c);
-        void HandleAfterAttributeValueUnquotedState(char c);
-
-        std::string m_Input;
+        void HandleDataState();
+        void HandleTagOpenState();
+        void HandleTagNameState();
+        void HandleEndTagOpenState();
+        void HandleSelfClosingStartTagState();
+        void HandleBeforeAttributeNameState();
+        void HandleAttributeNameState();
+        void HandleAfterAttributeNameState();
+        void HandleBeforeAttributeValueState();
+        void HandleAttributeValueDoubleQuotedState();
+        void HandleAttributeValueSingleQuotedState();
+        void HandleAttributeValueQuoted(std::uint8_t EndClass);
+        void HandleAttributeValueUnquotedState();
+        void HandleAfterAttributeValueState();
+        void HandleRawTextState();
+
+        std::string_view m_Input;
         size_t m_Position;
         State m_CurrentState;
+        // Start of the token being built
+        size_t m_TokenBegin = 0;
 
         Token m_CurrentToken;
         std::string m_CurrentAttributeName;
         std::string m_CurrentAttributeValue;
 
         std::vector<Token> m_Tokens;
+        std::vector<Token> m_PendingTokens;
+        std::size_t m_PendingIndex = 0;
+
+        // Lowercase name of the raw text element whose contents are being scanned
+        Atom m_RawTextTag;
+        bool m_SkipRawTextContent = false;
+
+        std::unordered_set<Atom> m_DiscardedElements;
+        bool m_DiscardComments = false;
+        std::size_t m_DiscardCount = 0;
+        bool m_DecodeCharacterReferences = true;
+
+        std::size_t m_MaxTokenLength = 0;
+        bool m_LimitExceeded = false;
     };
 } // namespace HtmlParser
\ No newline at end of file
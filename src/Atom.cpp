@@ -0,0 +1,175 @@
+#include <HtmlParser/Atom.hpp>
+#include <array>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "CharacterClasses.hpp"
+#include "KnownNames.hpp"
+
+namespace HtmlParser
+{
+    namespace
+    {
+        struct NameHash
+        {
+            std::size_t operator()(std::string_view Name) const
+            {
+                return std::hash<std::string_view>()(Name);
+            }
+        };
+
+        bool HasUppercase(std::string_view Name)
+        {
+            for (char c : Name)
+            {
+                if (CharacterClasses::ToLower(c) != c)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    } // namespace
+
+    // Known names are looked up without a lock: the table is built once and only read afterwards
+    struct KnownNameTable
+    {
+        std::deque<Atom::PooledName> Storage;
+        std::unordered_map<std::string_view, const Atom::PooledName*, NameHash> Names;
+
+        KnownNameTable()
+        {
+            for (std::string_view Name : KnownNames)
+            {
+                if (Names.find(Name) == Names.end())
+                {
+                    const Atom::PooledName& Entry = Storage.emplace_back(Name, true);
+                    Names.emplace(Entry.Name, &Entry);
+                }
+            }
+        }
+    };
+
+    // Other names are reference-counted. The pool is split so that threads interning different names
+    // rarely wait on the same lock.
+    struct NameShard
+    {
+        std::shared_mutex Mutex;
+        std::unordered_map<std::string_view, std::unique_ptr<Atom::PooledName>, NameHash> Names;
+    };
+
+    namespace
+    {
+        const KnownNameTable& Known()
+        {
+            static const KnownNameTable Table;
+            return Table;
+        }
+
+        NameShard& ShardOf(std::string_view Name)
+        {
+            static std::array<NameShard, 16> Pool;
+            return Pool[NameHash()(Name) % Pool.size()];
+        }
+    } // namespace
+
+    const Atom::PooledName* Atom::Lookup(std::string_view Name)
+    {
+        if (Name.empty())
+        {
+            return &s_Empty;
+        }
+        const auto& KnownNames = Known().Names;
+        auto Permanent = KnownNames.find(Name);
+        if (Permanent != KnownNames.end())
+        {
+            return Permanent->second;
+        }
+
+        NameShard& Shard = ShardOf(Name);
+        std::shared_lock Lock(Shard.Mutex);
+        auto Found = Shard.Names.find(Name);
+        if (Found == Shard.Names.end())
+        {
+            return nullptr;
+        }
+        // Names in the pool have atoms, and the last one can only go away under the exclusive lock
+        Found->second->References.fetch_add(1, std::memory_order_relaxed);
+        return Found->second.get();
+    }
+
+    const Atom::PooledName* Atom::Intern(std::string_view Name)
+    {
+        if (const PooledName* Pooled = Lookup(Name))
+        {
+            return Pooled;
+        }
+
+        NameShard& Shard = ShardOf(Name);
+        std::unique_lock Lock(Shard.Mutex);
+        auto Found = Shard.Names.find(Name);
+        if (Found == Shard.Names.end())
+        {
+            auto Created = std::make_unique<PooledName>(Name, false);
+            Found = Shard.Names.emplace(Created->Name, std::move(Created)).first;
+        }
+        Found->second->References.fetch_add(1, std::memory_order_relaxed);
+        return Found->second.get();
+    }
+
+    void Atom::Release(const PooledName* Name)
+    {
+        // References other than the last are dropped without locking
+        std::uint32_t Count = Name->References.load(std::memory_order_relaxed);
+        while (Count > 1)
+        {
+            if (Name->References.compare_exchange_weak(Count, Count - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+
+        // The last one is dropped under the exclusive lock, so no lookup can revive the name meanwhile
+        NameShard& Shard = ShardOf(Name->Name);
+        std::unique_lock Lock(Shard.Mutex);
+        if (Name->References.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            // The key views the name being freed, so the entry is erased by position
+            Shard.Names.erase(Shard.Names.find(Name->Name));
+        }
+    }
+
+    Atom Atom::Find(std::string_view Name)
+    {
+        Atom Result;
+        if (const PooledName* Pooled = Lookup(Name))
+        {
+            Result.m_Name = Pooled;
+        }
+        return Result;
+    }
+
+    Atom Atom::Lowercase(std::string_view Name)
+    {
+        for (std::size_t i = 0; i < Name.size(); ++i)
+        {
+            if (CharacterClasses::ToLower(Name[i]) != Name[i])
+            {
+                std::string Lower(Name);
+                for (std::size_t j = i; j < Lower.size(); ++j)
+                {
+                    Lower[j] = CharacterClasses::ToLower(Lower[j]);
+                }
+                return Atom(Lower);
+            }
+        }
+        return Atom(Name);
+    }
+
+    LowercaseAtom::LowercaseAtom(const Atom& Name) : Atom(HasUppercase(Name) ? Lowercase(Name) : Name)
+    {
+    }
+} // namespace HtmlParser
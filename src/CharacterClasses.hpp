@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace HtmlParser::CharacterClasses
+{
+    // Bit flags; a byte can belong to several classes. Non-ASCII bytes belong to none.
+    enum : std::uint8_t
+    {
+        Whitespace = 1 << 0,
+        Alpha = 1 << 1,
+        // Ends a tag name: whitespace, '/' and '>'
+        TagNameEnd = 1 << 2,
+        // Ends an attribute name: whitespace, '/', '>' and '='
+        AttributeNameEnd = 1 << 3,
+        // Ends a run inside a double quoted value: '"' and '&'
+        DoubleQuotedValueEnd = 1 << 4,
+        SingleQuotedValueEnd = 1 << 5,
+        // Ends a run inside an unquoted value: whitespace, '>', '&' and NUL
+        UnquotedValueEnd = 1 << 6,
+    };
+
+    constexpr std::array<std::uint8_t, 256> BuildTable()
+    {
+        std::array<std::uint8_t, 256> Table{};
+        for (unsigned char c : {' ', '\t', '\n', '\r', '\f'})
+        {
+            Table[c] |= Whitespace | TagNameEnd | AttributeNameEnd | UnquotedValueEnd;
+        }
+        for (int c = 'a'; c <= 'z'; ++c)
+        {
+            Table[c] |= Alpha;
+            Table[c - 'a' + 'A'] |= Alpha;
+        }
+        Table['/'] |= TagNameEnd | AttributeNameEnd;
+        Table['>'] |= TagNameEnd | AttributeNameEnd | UnquotedValueEnd;
+        Table['='] |= AttributeNameEnd;
+        Table['"'] |= DoubleQuotedValueEnd;
+        Table['\''] |= SingleQuotedValueEnd;
+        Table['&'] |= DoubleQuotedValueEnd | SingleQuotedValueEnd | UnquotedValueEnd;
+        Table[0] |= UnquotedValueEnd;
+        return Table;
+    }
+
+    constexpr std::array<char, 256> BuildLowerTable()
+    {
+        std::array<char, 256> Table{};
+        for (int c = 0; c < 256; ++c)
+        {
+            Table[c] = static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+        }
+        return Table;
+    }
+
+    inline constexpr std::array<std::uint8_t, 256> Table = BuildTable();
+    inline constexpr std::array<char, 256> LowerTable = BuildLowerTable();
+
+    inline bool Is(char c, std::uint8_t Class)
+    {
+        return (Table[static_cast<unsigned char>(c)] & Class) != 0;
+    }
+
+    // ASCII-only, independent of the C locale
+    inline char ToLower(char c)
+    {
+        return LowerTable[static_cast<unsigned char>(c)];
+    }
+} // namespace HtmlParser::CharacterClasses
@@ -0,0 +1,176 @@
+#include <algorithm>
+
+#include "CharacterReferences.hpp"
+#include "NamedCharacterReferences.hpp"
+
+namespace HtmlParser::CharacterReferences
+{
+    static bool IsAsciiAlphanumeric(char c)
+    {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    static bool IsHexDigit(char c)
+    {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    // Numeric references to C1 controls are interpreted as windows-1252
+    static std::uint32_t ReplaceC1Control(std::uint32_t CodePoint)
+    {
+        static constexpr std::uint16_t Replacements[32] = {
+            0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021, 0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+            0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014, 0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178,
+        };
+        return Replacements[CodePoint - 0x80];
+    }
+
+    static std::size_t DecodeNumericReference(std::string_view Input, std::size_t Position, std::string& Out)
+    {
+        // Input[Position] is '&' and Input[Position + 1] is '#'
+        std::size_t i = Position + 2;
+        const bool IsHex = i < Input.size() && (Input[i] == 'x' || Input[i] == 'X');
+        if (IsHex)
+        {
+            ++i;
+        }
+
+        const std::size_t DigitsStart = i;
+        std::uint32_t CodePoint = 0;
+        while (i < Input.size() && (IsHex ? IsHexDigit(Input[i]) : (Input[i] >= '0' && Input[i] <= '9')))
+        {
+            char c = Input[i];
+            std::uint32_t Digit = c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+            // Saturate; anything past U+10FFFF is replaced anyway
+            CodePoint = std::min<std::uint32_t>(CodePoint * (IsHex ? 16 : 10) + Digit, 0x110000);
+            ++i;
+        }
+        if (i == DigitsStart)
+        {
+            return 0;
+        }
+        if (i < Input.size() && Input[i] == ';')
+        {
+            ++i;
+        }
+
+        if (CodePoint == 0 || CodePoint > 0x10FFFF || (CodePoint >= 0xD800 && CodePoint <= 0xDFFF))
+        {
+            CodePoint = 0xFFFD;
+        }
+        else if (CodePoint >= 0x80 && CodePoint <= 0x9F)
+        {
+            CodePoint = ReplaceC1Control(CodePoint);
+        }
+        AppendUtf8(CodePoint, Out);
+        return i - Position;
+    }
+
+    static std::size_t DecodeNamedReference(std::string_view Input, std::size_t Position, bool InAttribute, std::string& Out)
+    {
+        // Walk the trie as far as the input allows, remembering the longest complete name
+        std::uint32_t CurrentNode = 0;
+        std::uint32_t MatchedNode = 0;
+        std::size_t MatchedEnd = 0;
+        for (std::size_t i = Position + 1; i < Input.size(); ++i)
+        {
+            const char* First = EdgeChars + NodeEdgeStart[CurrentNode];
+            const char* Last = EdgeChars + NodeEdgeStart[CurrentNode + 1];
+            const char* Edge = std::lower_bound(First, Last, Input[i]);
+            if (Edge == Last || *Edge != Input[i])
+            {
+                break;
+            }
+            CurrentNode = static_cast<std::uint32_t>(Edge - EdgeChars) + 1;
+            if (NodeValue[CurrentNode] != 0)
+            {
+                MatchedNode = CurrentNode;
+                MatchedEnd = i + 1;
+            }
+        }
+
+        if (MatchedNode == 0)
+        {
+            return 0;
+        }
+        // Legacy names without ';' are left alone inside attribute values when followed by '=' or an alphanumeric
+        if (InAttribute && Input[MatchedEnd - 1] != ';' && MatchedEnd < Input.size() && (Input[MatchedEnd] == '=' || IsAsciiAlphanumeric(Input[MatchedEnd])))
+        {
+            return 0;
+        }
+
+        const CodePoints& Value = Values[NodeValue[MatchedNode]];
+        AppendUtf8(Value.First, Out);
+        if (Value.Second != 0)
+        {
+            AppendUtf8(Value.Second, Out);
+        }
+        return MatchedEnd - Position;
+    }
+
+    std::size_t DecodeReference(std::string_view Input, std::size_t Position, bool InAttribute, std::string& Out)
+    {
+        if (Position + 1 >= Input.size())
+        {
+            return 0;
+        }
+        if (Input[Position + 1] == '#')
+        {
+            return DecodeNumericReference(Input, Position, Out);
+        }
+        if (IsAsciiAlphanumeric(Input[Position + 1]))
+        {
+            return DecodeNamedReference(Input, Position, InAttribute, Out);
+        }
+        return 0;
+    }
+
+    void DecodeReferences(std::string_view Input, bool InAttribute, std::string& Out)
+    {
+        std::size_t Position = 0;
+        while (true)
+        {
+            std::size_t Ampersand = Input.find('&', Position);
+            if (Ampersand == std::string_view::npos)
+            {
+                Out.append(Input.data() + Position, Input.size() - Position);
+                return;
+            }
+            Out.append(Input.data() + Position, Ampersand - Position);
+
+            std::size_t Consumed = DecodeReference(Input, Ampersand, InAttribute, Out);
+            if (Consumed == 0)
+            {
+                Out.push_back('&');
+                Consumed = 1;
+            }
+            Position = Ampersand + Consumed;
+        }
+    }
+
+    void AppendUtf8(std::uint32_t CodePoint, std::string& Out)
+    {
+        if (CodePoint < 0x80)
+        {
+            Out.push_back(static_cast<char>(CodePoint));
+        }
+        else if (CodePoint < 0x800)
+        {
+            Out.push_back(static_cast<char>(0xC0 | (CodePoint >> 6)));
+            Out.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+        }
+        else if (CodePoint < 0x10000)
+        {
+            Out.push_back(static_cast<char>(0xE0 | (CodePoint >> 12)));
+            Out.push_back(static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F)));
+            Out.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+        }
+        else
+        {
+            Out.push_back(static_cast<char>(0xF0 | (CodePoint >> 18)));
+            Out.push_back(static_cast<char>(0x80 | ((CodePoint >> 12) & 0x3F)));
+            Out.push_back(static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F)));
+            Out.push_back(static_cast<char>(0x80 | (CodePoint & 0x3F)));
+        }
+    }
+} // namespace HtmlParser::CharacterReferences
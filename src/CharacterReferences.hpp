@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace HtmlParser::CharacterReferences
+{
+    // Decodes the character reference whose '&' is at Position, appending the result to Out.
+    // Returns the number of input bytes consumed, or 0 if no reference starts there.
+    std::size_t DecodeReference(std::string_view Input, std::size_t Position, bool InAttribute, std::string& Out);
+
+    // Appends Input to Out with every character reference decoded.
+    void DecodeReferences(std::string_view Input, bool InAttribute, std::string& Out);
+
+    void AppendUtf8(std::uint32_t CodePoint, std::string& Out);
+} // namespace HtmlParser::CharacterReferences
@@ -1,11 +1,18 @@
 #include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Serializer.hpp>
+#include <HtmlParser/Snapshot.hpp>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
 #include <unordered_set>
 
+#include "Probes.hpp"
 #include "Utilities.hpp"
 
 namespace HtmlParser
 {
-    DOM::DOM(const std::shared_ptr<Node>& Root) : m_Document(Root)
+    DOM::DOM(const std::shared_ptr<Node>& Root, TruncationReason Truncation, std::string_view Source, std::shared_ptr<const void> SourceOwner) : m_Document(Root), m_Truncation(Truncation), m_Source(Source), m_SourceOwner(std::move(SourceOwner))
     {
     }
 
@@ -14,6 +21,97 @@ namespace HtmlParser
         return m_Document;
     }
 
+    DOM DOM::Clone()
+    {
+        static std::atomic<std::uint64_t> NextOwner{1};
+
+        // Nodes this DOM modified in place so far become shared as well
+        m_Document->MarkShared();
+        m_Owner = NextOwner++;
+        DOM Copy(*this);
+        Copy.m_Owner = NextOwner++;
+        return Copy;
+    }
+
+    std::shared_ptr<Node> DOM::Edit(const std::shared_ptr<Node>& Target)
+    {
+        if (m_Owner == 0)
+        {
+            return Target;
+        }
+
+        // A shared node's Parent is where it was parsed or copied, not necessarily its parent in this DOM,
+        // so record the ancestors and find their counterparts here from the root down by identity
+        struct Step
+        {
+            const Node* Identity;
+            std::uint32_t Position;
+        };
+        const auto Identity = [](const Node* Candidate) { return Candidate->m_Origin ? Candidate->m_Origin.get() : Candidate; };
+        std::vector<Step> Path;
+        for (auto Ancestor = Target; Ancestor; Ancestor = Ancestor->Parent.lock())
+        {
+            Path.push_back({Identity(Ancestor.get()), Ancestor->m_Position});
+        }
+        if (Path.back().Identity != Identity(m_Document.get()))
+        {
+            throw std::runtime_error("Node is not part of this DOM");
+        }
+
+        if (m_Document->m_Owner != m_Owner)
+        {
+            m_Document = CopyNode(*m_Document, nullptr);
+        }
+        std::shared_ptr<Node> Current = m_Document;
+        for (auto Next = Path.rbegin() + 1; Next != Path.rend(); ++Next)
+        {
+            // Copies keep the position of the node they replace, so the child is only searched for after an
+            // earlier sibling was removed
+            auto& Children = Current->Children;
+            auto Child = Children.begin() + std::min<std::size_t>(Next->Position, Children.size());
+            if (Child == Children.end() || Identity(Child->get()) != Next->Identity)
+            {
+                Child = std::find_if(Children.begin(), Children.end(), [&](const std::shared_ptr<Node>& Candidate) { return Identity(Candidate.get()) == Next->Identity; });
+            }
+            if (Child == Children.end())
+            {
+                throw std::runtime_error("Node is not part of this DOM");
+            }
+            if ((*Child)->m_Owner != m_Owner)
+            {
+                *Child = CopyNode(**Child, Current);
+            }
+            Current = *Child;
+        }
+        return Current;
+    }
+
+    std::shared_ptr<Node> DOM::CopyNode(const Node& Source, const std::shared_ptr<Node>& Parent) const
+    {
+        // Children stay shared; their Parent keeps pointing at the node they came from
+        auto Copy = std::make_shared<Node>(Source);
+        Copy->Parent = Parent;
+        Copy->m_Flags &= ~Node::Shared;
+        Copy->m_Origin = Source.m_Origin ? Source.m_Origin : Source.shared_from_this();
+        Copy->m_Owner = m_Owner;
+        return Copy;
+    }
+
+    bool DOM::IsTruncated() const
+    {
+        return m_Truncation != TruncationReason::None;
+    }
+
+    TruncationReason DOM::GetTruncationReason() const
+    {
+        return m_Truncation;
+    }
+
+    std::string_view DOM::GetSource() const
+    {
+        return m_Source;
+    }
+
     void DOM::Traverse(const std::function<void(const std::shared_ptr<Node>&)>& Visitor) const
     {
         TraverseImpl(m_Document, Visitor);
@@ -31,13 +129,18 @@ namespace HtmlParser
     std::vector<std::shared_ptr<Node>> DOM::GetElementsByTagName(const std::string& TagName) const
     {
         std::vector<std::shared_ptr<Node>> Elements;
-        GetElementsByTagNameImpl(m_Document, TagName, Elements);
+        // Tags are lowercase atoms; if the name is not pooled, no element has it
+        const Atom Name = Atom::Find(Utils::ToLower(TagName));
+        if (!Name.empty())
+        {
+            GetElementsByTagNameImpl(m_Document, Name, Elements);
+        }
         return Elements;
     }
 
-    void DOM::GetElementsByTagNameImpl(const std::shared_ptr<Node>& ElementNode, const std::string& TagName, std::vector<std::shared_ptr<Node>>& Elements) const
+    void DOM::GetElementsByTagNameImpl(const std::shared_ptr<Node>& ElementNode, const Atom& TagName, std::vector<std::shared_ptr<Node>>& Elements) const
     {
-        if (ElementNode->Type == NodeType::Element && Utils::ToLower(ElementNode->Tag) == Utils::ToLower(TagName))
+        if (ElementNode->Type == NodeType::Element && ElementNode->Tag == TagName)
         {
             Elements.push_back(ElementNode);
         }
@@ -80,7 +183,8 @@ namespace HtmlParser
 
         if (ElementNode->Type == NodeType::Element)
         {
-            auto it = ElementNode->Attributes.find("id");
+            static const Atom IdName("id");
+            auto it = ElementNode->Attributes.find(IdName);
             if (it != ElementNode->Attributes.end() && it->second == Id)
             {
                 Result = ElementNode;
@@ -97,68 +201,177 @@ namespace HtmlParser
 
     std::string DOM::ToHtml() const
     {
+        HTMLPARSER_TIME_SCOPE(Serialize);
         std::string Html;
-        for (const auto& Child : m_Document->Children)
-        {
-            ToHtmlImpl(Child, Html);
-        }
+        Serializer Writer(Html);
+        Writer.SetSource(GetSource());
+        Writer.WriteInnerHtml(*m_Document);
         return Html;
     }
 
-    void DOM::ToHtmlImpl(const std::shared_ptr<Node>& ElementNode, std::string& Html) const
+    void DOM::ToHtml(std::ostream& Stream) const
     {
-        static const std::unordered_set<std::string> VoidElements = {"area", "base", "br", "col", "embed", "hr", "img", "input", "link", "meta", "param", "source", "track", "wbr"};
+        HTMLPARSER_TIME_SCOPE(Serialize);
+        Serializer Writer(Stream);
+        Writer.SetSource(GetSource());
+        Writer.WriteInnerHtml(*m_Document);
+    }
 
-        switch (ElementNode->Type)
+    void DOM::SaveSnapshot(const std::string& Path) const
+    {
+        std::ofstream File(Path, std::ios::binary);
+        if (!File)
         {
-        case NodeType::Element:
+            throw std::runtime_error("Failed to open file: " + Path);
+        }
+        Snapshot::Write(*this, File);
+        if (!File)
         {
-            Html += "<" + ElementNode->Tag;
+            throw std::runtime_error("Failed to write file: " + Path);
+        }
+    }
+
+    DOM DOM::LoadSnapshot(const std::string& Path)
+    {
+        return Snapshot::Open(Path).ToDOM();
+    }
+
+    Snapshot DOM::Freeze() const
+    {
+        auto Bytes = std::make_shared<const std::string>(Snapshot::Write(*this));
+        return Snapshot::FromBytes(*Bytes, Bytes);
+    }
+
+    MemoryBreakdown DOM::MemoryUsage() const
+    {
+        // A vtable pointer and two counts, as laid out by libstdc++
+        static constexpr std::size_t ControlBlockSize = sizeof(void*) + 2 * sizeof(int);
+        // A map entry is a separate allocation holding the next pointer, the pair and the cached hash
+        static constexpr std::size_t AttributeEntrySize = sizeof(void*) + sizeof(std::pair<const Atom, StringValue>) + sizeof(std::size_t);
 
-            for (const auto& Attribute : ElementNode->Attributes)
+        MemoryBreakdown Usage;
+        std::unordered_set<const char*> Names;
+        const auto AddName = [&](const Atom& Name) {
+            if (Names.insert(Name.data()).second)
             {
-                Html += " " + Attribute.first + "=\"" + Utils::EscapeHtml(Attribute.second) + "\"";
+                // Short names are stored inside the string
+                const std::string& Stored = Name;
+                const char* Inline = reinterpret_cast<const char*>(&Stored);
+                const bool IsInline = Stored.data() >= Inline && Stored.data() < Inline + sizeof(std::string);
+                Usage.TagBytes += sizeof(std::string) + (IsInline ? 0 : Stored.capacity() + 1);
             }
+        };
 
-            if (VoidElements.count(Utils::ToLower(ElementNode->Tag)) > 0)
+        Traverse([&](const std::shared_ptr<Node>& Current) {
+            ++Usage.NodeCounts[static_cast<std::size_t>(Current->Type)];
+            Usage.NodeBytes += sizeof(Node);
+            Usage.ControlBlockBytes += ControlBlockSize;
+            Usage.TextBytes += Current->Text.HeapBytes();
+            Usage.ChildVectorBytes += Current->Children.capacity() * sizeof(std::shared_ptr<Node>);
+            if (Current->Type == NodeType::Element)
             {
-                // Void element, no closing tag
-                Html += ">";
+                AddName(Current->Tag);
             }
-            else
-            {
-                Html += ">";
-
-                // Recursively serialize child nodes
-                for (const auto& Child : ElementNode->Children)
-                {
-                    ToHtmlImpl(Child, Html);
-                }
 
-                Html += "</" + ElementNode->Tag + ">";
+            const auto& Attributes = Current->Attributes;
+            // An empty map uses a single bucket stored inline
+            Usage.AttributeMapBytes += (Attributes.bucket_count() > 1 ? Attributes.bucket_count() * sizeof(void*) : 0) + Attributes.size() * AttributeEntrySize;
+            for (const auto& Attribute : Attributes)
+            {
+                AddName(Attribute.first);
+                Usage.TextBytes += Attribute.second.HeapBytes();
             }
-            break;
-        }
-        case NodeType::Text:
-        {
-            Html += Utils::EscapeHtml(ElementNode->Text);
-            break;
-        }
-        case NodeType::Comment:
+        });
+        if (m_SourceOwner)
         {
-            Html += "<!--" + ElementNode->Text + "-->";
-            break;
+            Usage.SourceBytes = m_Source.size();
         }
-        case NodeType::Doctype:
+        return Usage;
+    }
+
+    std::vector<NodeChange> DOM::Diff(const DOM& Before, const DOM& After)
+    {
+        std::vector<NodeChange> Changes;
+        DiffNodes(Before.m_Document, After.m_Document, Changes);
+        return Changes;
+    }
+
+    void DOM::DiffNodes(const std::shared_ptr<Node>& Before, const std::shared_ptr<Node>& After, std::vector<NodeChange>& Changes)
+    {
+        // Pairs still to compare, and removals and additions waiting for the changes found before them.
+        // Items are popped from the back, so each node's items are pushed in reverse; this keeps the
+        // changes in document order without recursing per level.
+        struct Pending
         {
-            Html += "<!DOCTYPE " + ElementNode->Text + ">";
-            break;
-        }
-        case NodeType::Document:
+            std::shared_ptr<Node> Before;
+            std::shared_ptr<Node> After;
+        };
+        std::vector<Pending> Work{{Before, After}};
+        while (!Work.empty())
         {
-            // Should not reach here
-            break;
-        }
+            const Pending Item = std::move(Work.back());
+            Work.pop_back();
+            if (!Item.After)
+            {
+                Changes.push_back({ChangeType::Removed, Item.Before, nullptr});
+                continue;
+            }
+            if (!Item.Before)
+            {
+                Changes.push_back({ChangeType::Added, nullptr, Item.After});
+                continue;
+            }
+
+            if (Item.Before->GetHash() == Item.After->GetHash())
+            {
+                continue;
+            }
+            if (Item.Before->Text != Item.After->Text || Item.Before->Attributes != Item.After->Attributes)
+            {
+                Changes.push_back({ChangeType::Modified, Item.Before, Item.After});
+            }
+
+            // Unchanged children at either end are skipped by hash; the rest are paired up in order while
+            // they have the same type and tag
+            const auto& Old = Item.Before->Children;
+            const auto& New = Item.After->Children;
+            std::size_t Prefix = 0;
+            while (Prefix < Old.size() && Prefix < New.size() && Old[Prefix]->GetHash() == New[Prefix]->GetHash())
+            {
+                ++Prefix;
+            }
+            std::size_t OldEnd = Old.size();
+            std::size_t NewEnd = New.size();
+            while (OldEnd > Prefix && NewEnd > Prefix && Old[OldEnd - 1]->GetHash() == New[NewEnd - 1]->GetHash())
+            {
+                --OldEnd;
+                --NewEnd;
+            }
+
+            const std::size_t First = Work.size();
+            std::size_t i = Prefix;
+            std::size_t j = Prefix;
+            for (; i < OldEnd && j < NewEnd; ++i, ++j)
+            {
+                if (Old[i]->Type == New[j]->Type && Old[i]->Tag == New[j]->Tag)
+                {
+                    Work.push_back({Old[i], New[j]});
+                }
+                else
+                {
+                    Work.push_back({Old[i], nullptr});
+                    Work.push_back({nullptr, New[j]});
+                }
+            }
+            for (; i < OldEnd; ++i)
+            {
+                Work.push_back({Old[i], nullptr});
+            }
+            for (; j < NewEnd; ++j)
+            {
+                Work.push_back({nullptr, New[j]});
+            }
+            std::reverse(Work.begin() + static_cast<std::ptrdiff_t>(First), Work.end());
         }
     }
-} // namespace HtmlParser
\ No newline at end of file
+} // namespace HtmlParser
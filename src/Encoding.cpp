@@ -0,0 +1,728 @@
+#include "CharacterReferences.hpp"
+#include "EncodingTables.hpp"
+#include "Simd.hpp"
+#include <HtmlParser/Encoding.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <unordered_map>
+
+namespace HtmlParser
+{
+    namespace
+    {
+        constexpr std::string_view ReplacementCharacter = "\xEF\xBF\xBD";
+        constexpr std::size_t PrescanLength = 1024;
+
+        bool IsSingleByte(Encoding Source)
+        {
+            return Source >= Encoding::Ibm866 && Source <= Encoding::XMacCyrillic;
+        }
+
+        bool IsAsciiWhitespace(char Ch)
+        {
+            return Ch == ' ' || Ch == '\t' || Ch == '\n' || Ch == '\f' || Ch == '\r';
+        }
+
+        char ToLowerAscii(char Ch)
+        {
+            return (Ch >= 'A' && Ch <= 'Z') ? static_cast<char>(Ch - 'A' + 'a') : Ch;
+        }
+
+        bool StartsWithIgnoreCase(std::string_view Input, std::size_t Position, std::string_view Prefix)
+        {
+            if (Input.size() - Position < Prefix.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < Prefix.size(); ++i)
+            {
+                if (ToLowerAscii(Input[Position + i]) != Prefix[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Length of the maximal subpart of an ill-formed or incomplete sequence, and whether it ran into the end
+        // of the input.
+        std::size_t MaximalSubpart(const unsigned char* Data, std::size_t Size, bool& ReachedEnd)
+        {
+            unsigned char Lead = Data[0];
+            std::size_t Needed;
+            unsigned char Lower = 0x80;
+            unsigned char Upper = 0xBF;
+            if (Lead >= 0xC2 && Lead <= 0xDF)
+            {
+                Needed = 1;
+            }
+            else if (Lead >= 0xE0 && Lead <= 0xEF)
+            {
+                Needed = 2;
+                Lower = Lead == 0xE0 ? 0xA0 : 0x80;
+                Upper = Lead == 0xED ? 0x9F : 0xBF;
+            }
+            else if (Lead >= 0xF0 && Lead <= 0xF4)
+            {
+                Needed = 3;
+                Lower = Lead == 0xF0 ? 0x90 : 0x80;
+                Upper = Lead == 0xF4 ? 0x8F : 0xBF;
+            }
+            else
+            {
+                ReachedEnd = false;
+                return 0;
+            }
+
+            std::size_t Length = 1;
+            for (std::size_t i = 0; i < Needed; ++i, ++Length)
+            {
+                if (Length >= Size)
+                {
+                    ReachedEnd = true;
+                    return Length;
+                }
+                unsigned char Byte = Data[Length];
+                if (Byte < Lower || Byte > Upper)
+                {
+                    break;
+                }
+                Lower = 0x80;
+                Upper = 0xBF;
+            }
+            ReachedEnd = false;
+            return Length;
+        }
+
+        // Length of the longest prefix made of complete, well-formed sequences
+        std::size_t ValidUtf8Length(const char* Data, std::size_t Size)
+        {
+            const auto* Bytes = reinterpret_cast<const unsigned char*>(Data);
+            std::size_t i = 0;
+            while (i < Size)
+            {
+                i += Simd::AsciiPrefixLength(Data + i, Size - i);
+                // Consume multi-byte sequences until the next ASCII byte
+                while (i < Size && Bytes[i] >= 0x80)
+                {
+                    bool ReachedEnd;
+                    std::size_t Length = MaximalSubpart(Bytes + i, Size - i, ReachedEnd);
+                    std::size_t Expected = Bytes[i] < 0xE0 ? 2 : Bytes[i] < 0xF0 ? 3 : 4;
+                    if (ReachedEnd || Length != Expected)
+                    {
+                        return i;
+                    }
+                    i += Length;
+                }
+            }
+            return Size;
+        }
+
+        // Returns the number of bytes consumed; an incomplete trailing sequence is left unconsumed unless IsFinal
+        std::size_t DecodeUtf8(std::string_view Input, std::string& Out, bool IsFinal)
+        {
+            const auto* Bytes = reinterpret_cast<const unsigned char*>(Input.data());
+            std::size_t i = 0;
+            while (true)
+            {
+                std::size_t Valid = ValidUtf8Length(Input.data() + i, Input.size() - i);
+                Out.append(Input.data() + i, Valid);
+                i += Valid;
+                if (i == Input.size())
+                {
+                    return i;
+                }
+
+                bool ReachedEnd;
+                std::size_t Length = MaximalSubpart(Bytes + i, Input.size() - i, ReachedEnd);
+                if (ReachedEnd && !IsFinal)
+                {
+                    return i;
+                }
+                Out += ReplacementCharacter;
+                i += std::max<std::size_t>(Length, 1);
+            }
+        }
+
+        Encoding EncodingFromByteOrderMark(std::string_view Input)
+        {
+            if (Input.size() >= 3 && Input.compare(0, 3, "\xEF\xBB\xBF") == 0)
+            {
+                return Encoding::Utf8;
+            }
+            if (Input.size() >= 2 && Input.compare(0, 2, "\xFF\xFE") == 0)
+            {
+                return Encoding::Utf16LE;
+            }
+            if (Input.size() >= 2 && Input.compare(0, 2, "\xFE\xFF") == 0)
+            {
+                return Encoding::Utf16BE;
+            }
+            return Encoding::Auto;
+        }
+
+        std::size_t ByteOrderMarkLength(std::string_view Input, Encoding Source)
+        {
+            if (EncodingFromByteOrderMark(Input) != Source)
+            {
+                return 0;
+            }
+            return Source == Encoding::Utf8 ? 3 : 2;
+        }
+
+        // Reads the value of a charset= parameter in a Content-Type string
+        std::string_view CharsetFromContentType(std::string_view Content)
+        {
+            std::size_t Position = 0;
+            while (Position < Content.size())
+            {
+                if (!StartsWithIgnoreCase(Content, Position, "charset"))
+                {
+                    ++Position;
+                    continue;
+                }
+                Position += 7;
+                while (Position < Content.size() && IsAsciiWhitespace(Content[Position]))
+                {
+                    ++Position;
+                }
+                if (Position >= Content.size() || Content[Position] != '=')
+                {
+                    continue;
+                }
+                ++Position;
+                while (Position < Content.size() && IsAsciiWhitespace(Content[Position]))
+                {
+                    ++Position;
+                }
+                if (Position >= Content.size())
+                {
+                    return {};
+                }
+                if (Content[Position] == '"' || Content[Position] == '\'')
+                {
+                    std::size_t End = Content.find(Content[Position], Position + 1);
+                    if (End == std::string_view::npos)
+                    {
+                        return {};
+                    }
+                    return Content.substr(Position + 1, End - Position - 1);
+                }
+                std::size_t End = Position;
+                while (End < Content.size() && !IsAsciiWhitespace(Content[End]) && Content[End] != ';')
+                {
+                    ++End;
+                }
+                return Content.substr(Position, End - Position);
+            }
+            return {};
+        }
+
+        // Reads one attribute of a tag during the prescan; returns false at the end of the tag
+        bool ReadPrescanAttribute(std::string_view Input, std::size_t& Position, std::string& Name, std::string_view& Value)
+        {
+            while (Position < Input.size() && (IsAsciiWhitespace(Input[Position]) || Input[Position] == '/'))
+            {
+                ++Position;
+            }
+            if (Position >= Input.size() || Input[Position] == '>')
+            {
+                return false;
+            }
+
+            Name.clear();
+            while (Position < Input.size() && !IsAsciiWhitespace(Input[Position]) && Input[Position] != '=' && Input[Position] != '/' && Input[Position] != '>')
+            {
+                Name += ToLowerAscii(Input[Position++]);
+            }
+            Value = {};
+            while (Position < Input.size() && IsAsciiWhitespace(Input[Position]))
+            {
+                ++Position;
+            }
+            if (Position >= Input.size() || Input[Position] != '=')
+            {
+                return true;
+            }
+            ++Position;
+            while (Position < Input.size() && IsAsciiWhitespace(Input[Position]))
+            {
+                ++Position;
+            }
+            if (Position < Input.size() && (Input[Position] == '"' || Input[Position] == '\''))
+            {
+                char Quote = Input[Position++];
+                std::size_t End = Input.find(Quote, Position);
+                if (End == std::string_view::npos)
+                {
+                    Position = Input.size();
+                    return false;
+                }
+                Value = Input.substr(Position, End - Position);
+                Position = End + 1;
+                return true;
+            }
+            std::size_t Start = Position;
+            while (Position < Input.size() && !IsAsciiWhitespace(Input[Position]) && Input[Position] != '>')
+            {
+                ++Position;
+            }
+            Value = Input.substr(Start, Position - Start);
+            return true;
+        }
+
+        Encoding EncodingFromMetaTag(std::string_view Input, std::size_t& Position)
+        {
+            bool IsContentType = false;
+            Encoding FromCharset = Encoding::Auto;
+            Encoding FromContent = Encoding::Auto;
+            std::string Name;
+            std::string_view Value;
+            while (ReadPrescanAttribute(Input, Position, Name, Value))
+            {
+                if (Name == "charset" && FromCharset == Encoding::Auto)
+                {
+                    FromCharset = EncodingFromLabel(Value);
+                }
+                else if (Name == "http-equiv")
+                {
+                    IsContentType = Value.size() == 12 && StartsWithIgnoreCase(Value, 0, "content-type");
+                }
+                else if (Name == "content" && FromContent == Encoding::Auto)
+                {
+                    FromContent = EncodingFromLabel(CharsetFromContentType(Value));
+                }
+            }
+
+            Encoding Result = FromCharset != Encoding::Auto ? FromCharset : IsContentType ? FromContent : Encoding::Auto;
+            // A document that could declare its charset in ASCII is not UTF-16
+            if (Result == Encoding::Utf16LE || Result == Encoding::Utf16BE)
+            {
+                Result = Encoding::Utf8;
+            }
+            return Result;
+        }
+
+        Encoding PrescanForMetaCharset(std::string_view Input)
+        {
+            Input = Input.substr(0, std::min(Input.size(), PrescanLength));
+            std::size_t Position = 0;
+            while ((Position = Input.find('<', Position)) != std::string_view::npos)
+            {
+                if (Input.compare(Position, 4, "<!--") == 0)
+                {
+                    std::size_t End = Input.find("-->", Position + 4);
+                    if (End == std::string_view::npos)
+                    {
+                        break;
+                    }
+                    Position = End + 3;
+                }
+                else if (StartsWithIgnoreCase(Input, Position, "<meta") && Position + 5 < Input.size() && (IsAsciiWhitespace(Input[Position + 5]) || Input[Position + 5] == '/'))
+                {
+                    Position += 5;
+                    Encoding Result = EncodingFromMetaTag(Input, Position);
+                    if (Result != Encoding::Auto)
+                    {
+                        return Result;
+                    }
+                }
+                else if (Position + 1 < Input.size() && (Input[Position + 1] == '/' || Input[Position + 1] == '!' || Input[Position + 1] == '?' || std::isalpha(static_cast<unsigned char>(Input[Position + 1]))))
+                {
+                    // Skip other tags, including any quoted '>' in their attributes
+                    Position += 2;
+                    std::string Name;
+                    std::string_view Value;
+                    while (ReadPrescanAttribute(Input, Position, Name, Value))
+                    {
+                    }
+                }
+                else
+                {
+                    ++Position;
+                }
+            }
+            return Encoding::Auto;
+        }
+    } // namespace
+
+    Encoding EncodingFromLabel(std::string_view Label)
+    {
+        static const std::unordered_map<std::string, Encoding> Labels = {
+            {"unicode-1-1-utf-8", Encoding::Utf8},
+            {"unicode11utf8", Encoding::Utf8},
+            {"unicode20utf8", Encoding::Utf8},
+            {"utf-8", Encoding::Utf8},
+            {"utf8", Encoding::Utf8},
+            {"x-unicode20utf8", Encoding::Utf8},
+            {"csunicode", Encoding::Utf16LE},
+            {"iso-10646-ucs-2", Encoding::Utf16LE},
+            {"ucs-2", Encoding::Utf16LE},
+            {"unicode", Encoding::Utf16LE},
+            {"unicodefeff", Encoding::Utf16LE},
+            {"utf-16", Encoding::Utf16LE},
+            {"utf-16le", Encoding::Utf16LE},
+            {"unicodefffe", Encoding::Utf16BE},
+            {"utf-16be", Encoding::Utf16BE},
+            {"866", Encoding::Ibm866},
+            {"cp866", Encoding::Ibm866},
+            {"csibm866", Encoding::Ibm866},
+            {"ibm866", Encoding::Ibm866},
+            {"csisolatin2", Encoding::Iso8859_2},
+            {"iso-8859-2", Encoding::Iso8859_2},
+            {"iso-ir-101", Encoding::Iso8859_2},
+            {"iso8859-2", Encoding::Iso8859_2},
+            {"iso88592", Encoding::Iso8859_2},
+            {"iso_8859-2", Encoding::Iso8859_2},
+            {"l2", Encoding::Iso8859_2},
+            {"latin2", Encoding::Iso8859_2},
+            {"csisolatin3", Encoding::Iso8859_3},
+            {"iso-8859-3", Encoding::Iso8859_3},
+            {"iso8859-3", Encoding::Iso8859_3},
+            {"iso88593", Encoding::Iso8859_3},
+            {"iso_8859-3", Encoding::Iso8859_3},
+            {"l3", Encoding::Iso8859_3},
+            {"latin3", Encoding::Iso8859_3},
+            {"csisolatin4", Encoding::Iso8859_4},
+            {"iso-8859-4", Encoding::Iso8859_4},
+            {"iso8859-4", Encoding::Iso8859_4},
+            {"iso88594", Encoding::Iso8859_4},
+            {"iso_8859-4", Encoding::Iso8859_4},
+            {"l4", Encoding::Iso8859_4},
+            {"latin4", Encoding::Iso8859_4},
+            {"csisolatincyrillic", Encoding::Iso8859_5},
+            {"cyrillic", Encoding::Iso8859_5},
+            {"iso-8859-5", Encoding::Iso8859_5},
+            {"iso8859-5", Encoding::Iso8859_5},
+            {"iso88595", Encoding::Iso8859_5},
+            {"iso_8859-5", Encoding::Iso8859_5},
+            {"arabic", Encoding::Iso8859_6},
+            {"asmo-708", Encoding::Iso8859_6},
+            {"csiso88596e", Encoding::Iso8859_6},
+            {"csiso88596i", Encoding::Iso8859_6},
+            {"csisolatinarabic", Encoding::Iso8859_6},
+            {"ecma-114", Encoding::Iso8859_6},
+            {"iso-8859-6", Encoding::Iso8859_6},
+            {"iso-8859-6-e", Encoding::Iso8859_6},
+            {"iso-8859-6-i", Encoding::Iso8859_6},
+            {"iso8859-6", Encoding::Iso8859_6},
+            {"iso88596", Encoding::Iso8859_6},
+            {"iso_8859-6", Encoding::Iso8859_6},
+            {"csisolatingreek", Encoding::Iso8859_7},
+            {"ecma-118", Encoding::Iso8859_7},
+            {"elot_928", Encoding::Iso8859_7},
+            {"greek", Encoding::Iso8859_7},
+            {"greek8", Encoding::Iso8859_7},
+            {"iso-8859-7", Encoding::Iso8859_7},
+            {"iso8859-7", Encoding::Iso8859_7},
+            {"iso88597", Encoding::Iso8859_7},
+            {"iso_8859-7", Encoding::Iso8859_7},
+            {"sun_eu_greek", Encoding::Iso8859_7},
+            {"csiso88598e", Encoding::Iso8859_8},
+            {"csisolatinhebrew", Encoding::Iso8859_8},
+            {"hebrew", Encoding::Iso8859_8},
+            {"iso-8859-8", Encoding::Iso8859_8},
+            {"iso-8859-8-e", Encoding::Iso8859_8},
+            {"iso-8859-8-i", Encoding::Iso8859_8},
+            {"iso8859-8", Encoding::Iso8859_8},
+            {"iso88598", Encoding::Iso8859_8},
+            {"iso_8859-8", Encoding::Iso8859_8},
+            {"logical", Encoding::Iso8859_8},
+            {"visual", Encoding::Iso8859_8},
+            {"csisolatin6", Encoding::Iso8859_10},
+            {"iso-8859-10", Encoding::Iso8859_10},
+            {"iso-ir-157", Encoding::Iso8859_10},
+            {"iso8859-10", Encoding::Iso8859_10},
+            {"iso885910", Encoding::Iso8859_10},
+            {"l6", Encoding::Iso8859_10},
+            {"latin6", Encoding::Iso8859_10},
+            {"iso-8859-13", Encoding::Iso8859_13},
+            {"iso8859-13", Encoding::Iso8859_13},
+            {"iso885913", Encoding::Iso8859_13},
+            {"iso-8859-14", Encoding::Iso8859_14},
+            {"iso8859-14", Encoding::Iso8859_14},
+            {"iso885914", Encoding::Iso8859_14},
+            {"csisolatin9", Encoding::Iso8859_15},
+            {"iso-8859-15", Encoding::Iso8859_15},
+            {"iso8859-15", Encoding::Iso8859_15},
+            {"iso885915", Encoding::Iso8859_15},
+            {"iso_8859-15", Encoding::Iso8859_15},
+            {"l9", Encoding::Iso8859_15},
+            {"iso-8859-16", Encoding::Iso8859_16},
+            {"cskoi8r", Encoding::Koi8R},
+            {"koi", Encoding::Koi8R},
+            {"koi8", Encoding::Koi8R},
+            {"koi8-r", Encoding::Koi8R},
+            {"koi8_r", Encoding::Koi8R},
+            {"koi8-ru", Encoding::Koi8U},
+            {"koi8-u", Encoding::Koi8U},
+            {"csmacintosh", Encoding::Macintosh},
+            {"mac", Encoding::Macintosh},
+            {"macintosh", Encoding::Macintosh},
+            {"x-mac-roman", Encoding::Macintosh},
+            {"dos-874", Encoding::Windows874},
+            {"iso-8859-11", Encoding::Windows874},
+            {"iso8859-11", Encoding::Windows874},
+            {"iso885911", Encoding::Windows874},
+            {"tis-620", Encoding::Windows874},
+            {"windows-874", Encoding::Windows874},
+            {"cp1250", Encoding::Windows1250},
+            {"windows-1250", Encoding::Windows1250},
+            {"x-cp1250", Encoding::Windows1250},
+            {"cp1251", Encoding::Windows1251},
+            {"windows-1251", Encoding::Windows1251},
+            {"x-cp1251", Encoding::Windows1251},
+            {"ansi_x3.4-1968", Encoding::Windows1252},
+            {"ascii", Encoding::Windows1252},
+            {"cp1252", Encoding::Windows1252},
+            {"cp819", Encoding::Windows1252},
+            {"csisolatin1", Encoding::Windows1252},
+            {"ibm819", Encoding::Windows1252},
+            {"iso-8859-1", Encoding::Windows1252},
+            {"iso-ir-100", Encoding::Windows1252},
+            {"iso8859-1", Encoding::Windows1252},
+            {"iso88591", Encoding::Windows1252},
+            {"iso_8859-1", Encoding::Windows1252},
+            {"l1", Encoding::Windows1252},
+            {"latin1", Encoding::Windows1252},
+            {"us-ascii", Encoding::Windows1252},
+            {"windows-1252", Encoding::Windows1252},
+            {"x-cp1252", Encoding::Windows1252},
+            {"cp1253", Encoding::Windows1253},
+            {"windows-1253", Encoding::Windows1253},
+            {"x-cp1253", Encoding::Windows1253},
+            {"cp1254", Encoding::Windows1254},
+            {"csisolatin5", Encoding::Windows1254},
+            {"iso-8859-9", Encoding::Windows1254},
+            {"iso-ir-148", Encoding::Windows1254},
+            {"iso8859-9", Encoding::Windows1254},
+            {"iso88599", Encoding::Windows1254},
+            {"iso_8859-9", Encoding::Windows1254},
+            {"l5", Encoding::Windows1254},
+            {"latin5", Encoding::Windows1254},
+            {"windows-1254", Encoding::Windows1254},
+            {"x-cp1254", Encoding::Windows1254},
+            {"cp1255", Encoding::Windows1255},
+            {"windows-1255", Encoding::Windows1255},
+            {"x-cp1255", Encoding::Windows1255},
+            {"cp1256", Encoding::Windows1256},
+            {"windows-1256", Encoding::Windows1256},
+            {"x-cp1256", Encoding::Windows1256},
+            {"cp1257", Encoding::Windows1257},
+            {"windows-1257", Encoding::Windows1257},
+            {"x-cp1257", Encoding::Windows1257},
+            {"cp1258", Encoding::Windows1258},
+            {"windows-1258", Encoding::Windows1258},
+            {"x-cp1258", Encoding::Windows1258},
+            {"x-mac-cyrillic", Encoding::XMacCyrillic},
+            {"x-mac-ukrainian", Encoding::XMacCyrillic},
+        };
+
+        while (!Label.empty() && IsAsciiWhitespace(Label.front()))
+        {
+            Label.remove_prefix(1);
+        }
+        while (!Label.empty() && IsAsciiWhitespace(Label.back()))
+        {
+            Label.remove_suffix(1);
+        }
+
+        std::string Key(Label.size(), '\0');
+        std::transform(Label.begin(), Label.end(), Key.begin(), ToLowerAscii);
+        auto It = Labels.find(Key);
+        return It != Labels.end() ? It->second : Encoding::Auto;
+    }
+
+    Encoding SniffEncoding(std::string_view Input)
+    {
+        Encoding Result = EncodingFromByteOrderMark(Input);
+        if (Result == Encoding::Auto)
+        {
+            Result = PrescanForMetaCharset(Input);
+        }
+        return Result == Encoding::Auto ? Encoding::Utf8 : Result;
+    }
+
+    bool IsValidUtf8(std::string_view Input)
+    {
+        return ValidUtf8Length(Input.data(), Input.size()) == Input.size();
+    }
+
+    Utf8Transcoder::Utf8Transcoder(Encoding Source)
+        : m_Source(Source == Encoding::Auto ? Encoding::Utf8 : Source)
+    {
+        if (!IsSingleByte(m_Source))
+        {
+            return;
+        }
+
+        const auto& Table = EncodingTables::SingleByteUpperHalf[static_cast<int>(m_Source) - static_cast<int>(Encoding::Ibm866)];
+        for (int i = 0; i < 128; ++i)
+        {
+            std::string Utf8;
+            CharacterReferences::AppendUtf8(Table[i], Utf8);
+            std::copy(Utf8.begin(), Utf8.end(), m_UpperHalf[i]);
+            m_UpperHalf[i][3] = static_cast<char>(Utf8.size());
+        }
+    }
+
+    void Utf8Transcoder::Transcode(std::string_view Chunk, std::string& Out)
+    {
+        if (m_AtStart)
+        {
+            // Wait until a possible byte order mark is complete
+            if (m_Pending.size() + Chunk.size() < 3 && (m_Source == Encoding::Utf8 || m_Pending.size() + Chunk.size() < 2))
+            {
+                m_Pending.append(Chunk);
+                return;
+            }
+            m_AtStart = false;
+            if (!m_Pending.empty())
+            {
+                std::string Buffered = std::move(m_Pending);
+                m_Pending.clear();
+                Buffered.append(Chunk);
+                Buffered.erase(0, ByteOrderMarkLength(Buffered, m_Source));
+                Transcode(Buffered, Out);
+                return;
+            }
+            Chunk.remove_prefix(ByteOrderMarkLength(Chunk, m_Source));
+        }
+
+        if (IsSingleByte(m_Source))
+        {
+            std::size_t i = 0;
+            while (i < Chunk.size())
+            {
+                std::size_t Ascii = Simd::AsciiPrefixLength(Chunk.data() + i, Chunk.size() - i);
+                Out.append(Chunk.data() + i, Ascii);
+                i += Ascii;
+                for (; i < Chunk.size() && static_cast<unsigned char>(Chunk[i]) >= 0x80; ++i)
+                {
+                    const char* Sequence = m_UpperHalf[static_cast<unsigned char>(Chunk[i]) - 0x80];
+                    Out.append(Sequence, static_cast<std::size_t>(Sequence[3]));
+                }
+            }
+            return;
+        }
+
+        if (!m_Pending.empty())
+        {
+            if (m_Source != Encoding::Utf8)
+            {
+                std::string Buffered = std::move(m_Pending);
+                m_Pending.clear();
+                Buffered.append(Chunk);
+                std::size_t Consumed = TranscodeUtf16(Buffered, Out, false);
+                m_Pending.assign(Buffered, Consumed);
+                return;
+            }
+
+            // A pending UTF-8 sequence needs at most three more bytes
+            std::string Buffered = m_Pending;
+            Buffered.append(Chunk.substr(0, 3));
+            std::size_t Consumed = DecodeUtf8(Buffered, Out, false);
+            if (Consumed == 0)
+            {
+                m_Pending = std::move(Buffered);
+                return;
+            }
+            Chunk.remove_prefix(Consumed - m_Pending.size());
+            m_Pending.clear();
+        }
+
+        std::size_t Consumed = m_Source == Encoding::Utf8 ? DecodeUtf8(Chunk, Out, false) : TranscodeUtf16(Chunk, Out, false);
+        m_Pending.assign(Chunk.substr(Consumed));
+    }
+
+    void Utf8Transcoder::Finish(std::string& Out)
+    {
+        if (m_AtStart)
+        {
+            m_AtStart = false;
+            std::string Buffered = std::move(m_Pending);
+            m_Pending.clear();
+            Buffered.erase(0, ByteOrderMarkLength(Buffered, m_Source));
+            Transcode(Buffered, Out);
+        }
+        if (m_Pending.empty())
+        {
+            return;
+        }
+        if (m_Source == Encoding::Utf8)
+        {
+            DecodeUtf8(m_Pending, Out, true);
+        }
+        else
+        {
+            TranscodeUtf16(m_Pending, Out, true);
+        }
+        m_Pending.clear();
+    }
+
+    std::size_t Utf8Transcoder::TranscodeUtf16(std::string_view Input, std::string& Out, bool IsFinal) const
+    {
+        const auto* Bytes = reinterpret_cast<const unsigned char*>(Input.data());
+        bool IsBigEndian = m_Source == Encoding::Utf16BE;
+        auto ReadUnit = [&](std::size_t Offset) -> std::uint32_t
+        {
+            return IsBigEndian ? (Bytes[Offset] << 8) | Bytes[Offset + 1] : (Bytes[Offset + 1] << 8) | Bytes[Offset];
+        };
+
+        std::size_t i = 0;
+        while (i + 2 <= Input.size())
+        {
+            std::uint32_t Unit = ReadUnit(i);
+            if (Unit < 0xD800 || Unit > 0xDFFF)
+            {
+                CharacterReferences::AppendUtf8(Unit, Out);
+                i += 2;
+                continue;
+            }
+            if (Unit >= 0xDC00)
+            {
+                Out += ReplacementCharacter;
+                i += 2;
+                continue;
+            }
+            if (i + 4 > Input.size())
+            {
+                if (!IsFinal)
+                {
+                    return i;
+                }
+                Out += ReplacementCharacter;
+                i += 2;
+                continue;
+            }
+            std::uint32_t Low = ReadUnit(i + 2);
+            if (Low < 0xDC00 || Low > 0xDFFF)
+            {
+                // The unpaired high surrogate is replaced and the next unit decoded on its own
+                Out += ReplacementCharacter;
+                i += 2;
+                continue;
+            }
+            CharacterReferences::AppendUtf8(0x10000 + ((Unit - 0xD800) << 10) + (Low - 0xDC00), Out);
+            i += 4;
+        }
+
+        if (i < Input.size() && IsFinal)
+        {
+            Out += ReplacementCharacter;
+            return Input.size();
+        }
+        return i;
+    }
+
+    std::string TranscodeToUtf8(std::string_view Input, Encoding Source)
+    {
+        std::string Out;
+        Out.reserve(Input.size() + Input.size() / 8);
+        Utf8Transcoder Transcoder(Source);
+        Transcoder.Transcode(Input, Out);
+        Transcoder.Finish(Out);
+        return Out;
+    }
+} // namespace HtmlParser
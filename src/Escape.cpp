@@ -0,0 +1,161 @@
+#include <HtmlParser/Escape.hpp>
+
+#include "Simd.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace HtmlParser
+{
+    namespace
+    {
+        constexpr std::string_view EscapeSequence(char c)
+        {
+            switch (c)
+            {
+            case '&':
+                return "&amp;";
+            case '<':
+                return "&lt;";
+            case '>':
+                return "&gt;";
+            case '"':
+                return "&quot;";
+            default:
+                return {};
+            }
+        }
+
+        // Bytes of a clean span after which scanning switches back from scalar to vector
+        constexpr std::size_t DenseWindow = 16;
+        constexpr std::size_t DenseBlockSize = 64;
+        constexpr std::size_t MaxEscapeLength = 6;
+
+        // Escape sequences padded so each can be copied with one fixed-size memcpy
+        struct PaddedEscape
+        {
+            char Bytes[8];
+            std::size_t Length;
+        };
+
+        constexpr std::array<PaddedEscape, 256> BuildPaddedEscapes()
+        {
+            std::array<PaddedEscape, 256> Table{};
+            for (int c = 0; c < 256; ++c)
+            {
+                const std::string_view Sequence = EscapeSequence(static_cast<char>(c));
+                for (std::size_t i = 0; i < Sequence.size(); ++i)
+                {
+                    Table[c].Bytes[i] = Sequence[i];
+                }
+                Table[c].Length = Sequence.size();
+            }
+            return Table;
+        }
+
+        constexpr std::array<PaddedEscape, 256> PaddedEscapes = BuildPaddedEscapes();
+
+        template <char... Set>
+        constexpr std::array<bool, 256> BuildEscapeTable()
+        {
+            std::array<bool, 256> Table{};
+            ((Table[static_cast<unsigned char>(Set)] = true), ...);
+            return Table;
+        }
+
+        // Clean spans are found a vector at a time and copied in one append. Where escapes come close
+        // together the vector scan would restart every few bytes, so those stretches are walked byte by byte.
+        template <char... Set>
+        void AppendEscaped(std::string& Out, std::string_view Text)
+        {
+            static constexpr std::array<bool, 256> NeedsEscape = BuildEscapeTable<Set...>();
+            const char* Data = Text.data();
+            const std::size_t Size = Text.size();
+
+            std::size_t Position = 0;
+            while (Position < Size)
+            {
+                const std::size_t Next = Position + Simd::FindFirstOf<Set...>(Data + Position, Size - Position);
+                Out.append(Data + Position, Next - Position);
+                if (Next == Size)
+                {
+                    return;
+                }
+
+                // Write straight into the string, sized for the worst case of each block
+                std::size_t Written = Out.size();
+                std::size_t LastEscape = Next;
+                std::size_t i = Next;
+                while (i < Size && i - LastEscape <= DenseWindow)
+                {
+                    const std::size_t BlockEnd = std::min(Size, i + DenseBlockSize);
+                    Out.resize(Written + (BlockEnd - i) * MaxEscapeLength + sizeof(PaddedEscape::Bytes));
+                    char* Dest = Out.data() + Written;
+                    for (; i < BlockEnd && i - LastEscape <= DenseWindow; ++i)
+                    {
+                        const char c = Data[i];
+                        if (NeedsEscape[static_cast<unsigned char>(c)])
+                        {
+                            const PaddedEscape& Escape = PaddedEscapes[static_cast<unsigned char>(c)];
+                            std::memcpy(Dest, Escape.Bytes, sizeof(Escape.Bytes));
+                            Dest += Escape.Length;
+                            LastEscape = i;
+                        }
+                        else
+                        {
+                            *Dest++ = c;
+                        }
+                    }
+                    Written = static_cast<std::size_t>(Dest - Out.data());
+                }
+                Out.resize(Written);
+                Position = i;
+            }
+        }
+
+        template <char... Set>
+        std::size_t EscapedLength(std::string_view Text)
+        {
+            static constexpr std::array<bool, 256> NeedsEscape = BuildEscapeTable<Set...>();
+            const char* Data = Text.data();
+            const std::size_t Size = Text.size();
+
+            std::size_t Length = Size;
+            std::size_t Position = 0;
+            while (Position < Size)
+            {
+                Position += Simd::FindFirstOf<Set...>(Data + Position, Size - Position);
+                std::size_t LastEscape = Position;
+                for (; Position < Size && Position - LastEscape <= DenseWindow; ++Position)
+                {
+                    if (NeedsEscape[static_cast<unsigned char>(Data[Position])])
+                    {
+                        Length += EscapeSequence(Data[Position]).size() - 1;
+                        LastEscape = Position;
+                    }
+                }
+            }
+            return Length;
+        }
+    } // namespace
+
+    void AppendEscapedText(std::string& Out, std::string_view Text)
+    {
+        AppendEscaped<'&', '<', '>'>(Out, Text);
+    }
+
+    void AppendEscapedAttribute(std::string& Out, std::string_view Value)
+    {
+        AppendEscaped<'&', '<', '>', '"'>(Out, Value);
+    }
+
+    std::size_t EscapedTextLength(std::string_view Text)
+    {
+        return EscapedLength<'&', '<', '>'>(Text);
+    }
+
+    std::size_t EscapedAttributeLength(std::string_view Value)
+    {
+        return EscapedLength<'&', '<', '>', '"'>(Value);
+    }
+} // namespace HtmlParser
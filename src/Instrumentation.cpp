@@ -0,0 +1,120 @@
+#include <HtmlParser/Instrumentation.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+
+#include "Probes.hpp"
+
+namespace HtmlParser
+{
+    namespace
+    {
+        const char* const PhaseNames[] = {"parse", "tokenize", "initial_mode", "before_html_mode", "before_head_mode", "in_head_mode", "after_head_mode", "in_body_mode", "select", "serialize"};
+        const char* const TokenTypeNames[] = {"doctype", "start_tag", "end_tag", "comment", "character", "eof"};
+
+        struct ProcessTotals
+        {
+            std::mutex Mutex;
+            InstrumentationStats Stats;
+        };
+
+        // Never destroyed, since threads flush into it from thread_local destructors that may run after
+        // static destructors
+        ProcessTotals& GetTotals()
+        {
+            static ProcessTotals* Totals = new ProcessTotals();
+            return *Totals;
+        }
+
+        struct ThreadSlot
+        {
+            InstrumentationStats Stats;
+
+            ~ThreadSlot()
+            {
+                if (Instrumentation::Enabled)
+                {
+                    ProcessTotals& Totals = GetTotals();
+                    std::lock_guard<std::mutex> Lock(Totals.Mutex);
+                    Totals.Stats.Merge(Stats);
+                }
+            }
+        };
+
+        thread_local ThreadSlot t_Slot;
+    } // namespace
+
+    void InstrumentationStats::Merge(const InstrumentationStats& Other)
+    {
+        for (std::size_t i = 0; i < Phases.size(); ++i)
+        {
+            Phases[i].Calls += Other.Phases[i].Calls;
+            Phases[i].Nanoseconds += Other.Phases[i].Nanoseconds;
+        }
+        for (std::size_t i = 0; i < TokensByType.size(); ++i)
+        {
+            TokensByType[i] += Other.TokensByType[i];
+        }
+        NodesCreated += Other.NodesCreated;
+        ParseErrors += Other.ParseErrors;
+        MaxStackDepth = std::max(MaxStackDepth, Other.MaxStackDepth);
+        SelectorNodesVisited += Other.SelectorNodesVisited;
+    }
+
+    std::string InstrumentationStats::ToJson() const
+    {
+        std::ostringstream Json;
+        Json << "{\"phases\":{";
+        for (std::size_t i = 0; i < Phases.size(); ++i)
+        {
+            Json << (i == 0 ? "" : ",") << "\"" << PhaseNames[i] << "\":{\"calls\":" << Phases[i].Calls << ",\"nanoseconds\":" << Phases[i].Nanoseconds << "}";
+        }
+        Json << "},\"tokens\":{";
+        for (std::size_t i = 0; i < TokensByType.size(); ++i)
+        {
+            Json << (i == 0 ? "" : ",") << "\"" << TokenTypeNames[i] << "\":" << TokensByType[i];
+        }
+        Json << "},\"nodes_created\":" << NodesCreated << ",\"parse_errors\":" << ParseErrors << ",\"max_stack_depth\":" << MaxStackDepth
+             << ",\"selector_nodes_visited\":" << SelectorNodesVisited << "}";
+        return Json.str();
+    }
+
+    namespace Instrumentation
+    {
+        InstrumentationStats& MutableThreadStats()
+        {
+            return t_Slot.Stats;
+        }
+
+        const InstrumentationStats& GetThreadStats()
+        {
+            return t_Slot.Stats;
+        }
+
+        void FlushThread()
+        {
+            ProcessTotals& Totals = GetTotals();
+            std::lock_guard<std::mutex> Lock(Totals.Mutex);
+            Totals.Stats.Merge(t_Slot.Stats);
+            t_Slot.Stats = InstrumentationStats();
+        }
+
+        InstrumentationStats GetProcessStats()
+        {
+            ProcessTotals& Totals = GetTotals();
+            std::lock_guard<std::mutex> Lock(Totals.Mutex);
+            InstrumentationStats Result = Totals.Stats;
+            Result.Merge(t_Slot.Stats);
+            return Result;
+        }
+
+        void Reset()
+        {
+            ProcessTotals& Totals = GetTotals();
+            std::lock_guard<std::mutex> Lock(Totals.Mutex);
+            Totals.Stats = InstrumentationStats();
+            t_Slot.Stats = InstrumentationStats();
+        }
+    } // namespace Instrumentation
+} // namespace HtmlParser
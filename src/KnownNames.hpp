@@ -0,0 +1,52 @@
+#pragma once
+#include <string_view>
+
+namespace HtmlParser
+{
+    // Tag and attribute names of HTML, SVG and MathML in the lowercase form the tokenizer produces, plus
+    // common ARIA attributes. Atoms for these are created once and never freed; every other name is
+    // reference-counted and leaves the pool with its last atom.
+    inline constexpr std::string_view KnownNames[] = {
+        // Elements
+        "a", "abbr", "acronym", "address", "applet", "area", "article", "aside", "audio", "b", "base", "basefont", "bdi", "bdo",
+        "bgsound", "big", "blink", "blockquote", "body", "br", "button", "canvas", "caption", "center", "cite", "code", "col",
+        "colgroup", "data", "datalist", "dd", "del", "details", "dfn", "dialog", "dir", "div", "dl", "dt", "em", "embed", "fieldset",
+        "figcaption", "figure", "font", "footer", "form", "frame", "frameset", "h1", "h2", "h3", "h4", "h5", "h6", "head", "header",
+        "hgroup", "hr", "html", "i", "iframe", "image", "img", "input", "ins", "isindex", "kbd", "keygen", "label", "legend", "li",
+        "link", "listing", "main", "map", "mark", "marquee", "menu", "menuitem", "meta", "meter", "nav", "nobr", "noembed",
+        "noframes", "noscript", "object", "ol", "optgroup", "option", "output", "p", "param", "picture", "plaintext", "pre",
+        "progress", "q", "rb", "rp", "rt", "rtc", "ruby", "s", "samp", "script", "search", "section", "select", "slot", "small",
+        "source", "spacer", "span", "strike", "strong", "style", "sub", "summary", "sup", "table", "tbody", "td", "template",
+        "textarea", "tfoot", "th", "thead", "time", "title", "tr", "track", "tt", "u", "ul", "var", "video", "wbr", "xmp",
+        // SVG and MathML elements
+        "svg", "g", "defs", "symbol", "use", "path", "rect", "circle", "ellipse", "line", "polyline", "polygon", "text", "tspan",
+        "textpath", "lineargradient", "radialgradient", "stop", "clippath", "mask", "pattern", "marker", "filter",
+        "foreignobject", "desc", "metadata", "view", "math", "mi", "mn", "mo", "ms", "mtext", "mrow", "mfrac", "msqrt", "mroot",
+        "msub", "msup", "msubsup", "mtable", "mtr", "mtd", "annotation", "annotation-xml", "semantics",
+        // Attributes
+        "abbr", "accept", "accept-charset", "accesskey", "action", "align", "alink", "allow", "allowfullscreen", "alt", "archive",
+        "as", "async", "autocapitalize", "autocomplete", "autofocus", "autoplay", "background", "bgcolor", "blocking", "border",
+        "cellpadding", "cellspacing", "charset", "checked", "cite", "class", "clear", "color", "cols", "colspan", "compact",
+        "content", "contenteditable", "controls", "coords", "crossorigin", "datetime", "decoding", "default", "defer", "dirname",
+        "disabled", "download", "draggable", "enctype", "enterkeyhint", "face", "fetchpriority", "for", "form", "formaction",
+        "formenctype", "formmethod", "formnovalidate", "formtarget", "frameborder", "headers", "height", "hidden", "high", "href",
+        "hreflang", "hspace", "http-equiv", "id", "imagesizes", "imagesrcset", "inert", "inputmode", "integrity", "is", "ismap",
+        "itemid", "itemprop", "itemref", "itemscope", "itemtype", "kind", "lang", "language", "list", "loading", "loop", "low",
+        "manifest", "marginheight", "marginwidth", "max", "maxlength", "media", "method", "min", "minlength", "multiple", "muted",
+        "name", "nomodule", "nonce", "noshade", "novalidate", "nowrap", "onabort", "onblur", "onchange", "onclick",
+        "oncontextmenu", "ondblclick", "onerror", "onfocus", "oninput", "onkeydown", "onkeypress", "onkeyup", "onload",
+        "onmousedown", "onmousemove", "onmouseout", "onmouseover", "onmouseup", "onreset", "onresize", "onscroll", "onsubmit",
+        "onunload", "open", "optimum", "part", "ping", "placeholder", "playsinline", "popover", "poster", "preload", "property",
+        "readonly", "referrerpolicy", "rel", "required", "rev", "reversed", "role", "rows", "rowspan", "sandbox", "scope",
+        "scrolling", "selected", "shape", "size", "sizes", "span", "spellcheck", "src", "srcdoc", "srclang", "srcset", "start",
+        "step", "style", "tabindex", "target", "title", "translate", "type", "usemap", "valign", "value", "version", "vspace",
+        "width", "wrap", "xmlns", "xmlns:xlink", "xlink:href", "xml:lang",
+        // SVG attributes
+        "viewbox", "preserveaspectratio", "d", "fill", "fill-opacity", "fill-rule", "clip-rule", "stroke", "stroke-width",
+        "stroke-linecap", "stroke-linejoin", "stroke-opacity", "stroke-dasharray", "opacity", "transform", "x", "y", "x1", "y1",
+        "x2", "y2", "cx", "cy", "r", "rx", "ry", "points", "offset", "stop-color", "focusable",
+        // ARIA
+        "aria-checked", "aria-controls", "aria-current", "aria-describedby", "aria-disabled", "aria-expanded", "aria-haspopup",
+        "aria-hidden", "aria-label", "aria-labelledby", "aria-live", "aria-modal", "aria-pressed", "aria-selected",
+    };
+} // namespace HtmlParser
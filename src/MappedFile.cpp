@@ -0,0 +1,128 @@
+#include <HtmlParser/MappedFile.hpp>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace HtmlParser
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& Path)
+    {
+        HANDLE File = CreateFileA(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (File == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Failed to open file: " + Path);
+        }
+
+        LARGE_INTEGER FileSize;
+        if (!GetFileSizeEx(File, &FileSize))
+        {
+            CloseHandle(File);
+            throw std::runtime_error("Failed to stat file: " + Path);
+        }
+
+        m_FileHandle = File;
+        m_Size = static_cast<std::size_t>(FileSize.QuadPart);
+        if (m_Size == 0)
+        {
+            // Empty files cannot be mapped
+            return;
+        }
+
+        HANDLE Mapping = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!Mapping)
+        {
+            CloseHandle(File);
+            throw std::runtime_error("Failed to map file: " + Path);
+        }
+        m_MappingHandle = Mapping;
+
+        m_Data = static_cast<const char*>(MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_Data)
+        {
+            CloseHandle(Mapping);
+            CloseHandle(File);
+            throw std::runtime_error("Failed to map file: " + Path);
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_Data)
+        {
+            UnmapViewOfFile(m_Data);
+        }
+        if (m_MappingHandle)
+        {
+            CloseHandle(m_MappingHandle);
+        }
+        if (m_FileHandle)
+        {
+            CloseHandle(m_FileHandle);
+        }
+    }
+#else
+    MappedFile::MappedFile(const std::string& Path)
+    {
+        int File = open(Path.c_str(), O_RDONLY);
+        if (File < 0)
+        {
+            throw std::runtime_error("Failed to open file: " + Path);
+        }
+
+        struct stat FileStat;
+        if (fstat(File, &FileStat) != 0)
+        {
+            close(File);
+            throw std::runtime_error("Failed to stat file: " + Path);
+        }
+
+        m_Size = static_cast<std::size_t>(FileStat.st_size);
+        if (m_Size == 0)
+        {
+            // Empty files cannot be mapped
+            close(File);
+            return;
+        }
+
+        void* Mapping = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, File, 0);
+        // The mapping keeps its own reference to the file
+        close(File);
+        if (Mapping == MAP_FAILED)
+        {
+            throw std::runtime_error("Failed to map file: " + Path);
+        }
+
+        madvise(Mapping, m_Size, MADV_SEQUENTIAL);
+        m_Data = static_cast<const char*>(Mapping);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_Data)
+        {
+            munmap(const_cast<char*>(m_Data), m_Size);
+        }
+    }
+#endif
+
+    std::string_view MappedFile::View() const
+    {
+        return std::string_view(m_Data, m_Data ? m_Size : 0);
+    }
+
+    std::size_t MappedFile::Size() const
+    {
+        return m_Size;
+    }
+} // namespace HtmlParser
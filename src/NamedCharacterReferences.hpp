@@ -0,0 +1,2514 @@
+#pragma once
+#include <cstdint>
+
+// Generated by tools/GenerateNamedCharacterReferences.py; do not edit.
+
+namespace HtmlParser::CharacterReferences
+{
+    struct CodePoints
+    {
+        std::uint32_t First;
+        std::uint32_t Second;
+    };
+
+    inline constexpr std::uint32_t NodeCount = 9854;
+
+    inline constexpr std::uint16_t NodeEdgeStart[] = {
+        0, 52, 68, 76, 90, 101, 117, 122, 134, 142, 156, 161, 168, 179, 187, 196, 210, 219, 223, 235, 248, 259, 273, 282,
+        287, 291, 300, 308, 324, 340, 355, 374, 392, 404, 421, 431, 446, 452, 460, 483, 497, 521, 539, 551, 557, 578, 597, 610,
+        628, 643, 650, 664, 672, 682, 683, 684, 685, 686, 688, 689, 690, 691, 692, 693, 695, 696, 697, 699, 700, 701, 703, 704,
+        707, 708, 709, 710, 711, 712, 713, 714, 717, 721, 722, 724, 725, 726, 727, 728, 732, 733, 734, 735, 737, 738, 739, 740,
+        743, 745, 746, 747, 749, 753, 755, 756, 757, 758, 761, 762, 763, 764, 765, 767, 769, 770, 771, 773, 774, 775, 777, 778,
+        779, 780, 783, 784, 785, 786, 787, 788, 791, 792, 793, 794, 795, 796, 797, 798, 799, 801, 802, 803, 804, 806, 808, 809,
+        810, 811, 812, 813, 815, 816, 817, 818, 821, 823, 826, 827, 828, 830, 832, 833, 834, 836, 837, 838, 839, 840, 842, 843,
+        844, 845, 846, 847, 852, 855, 857, 858, 860, 861, 864, 867, 868, 869, 870, 872, 873, 874, 875, 876, 877, 878, 879, 882,
+        885, 886, 890, 891, 892, 893, 894, 895, 897, 898, 899, 900, 903, 904, 905, 906, 908, 909, 910, 911, 912, 913, 914, 915,
+        916, 917, 919, 923, 925, 926, 927, 928, 929, 930, 931, 934, 937, 939, 940, 941, 942, 944, 945, 947, 948, 950, 951, 952,
+        957, 958, 959, 960, 961, 962, 964, 965, 966, 970, 971, 972, 974, 976, 979, 980, 982, 983, 984, 985, 987, 989, 990, 992,
+        993, 994, 995, 996, 998, 1000, 1008, 1009, 1010, 1011, 1012, 1013, 1014, 1015, 1016, 1018, 1019, 1020, 1021, 1022, 1023, 1024, 1025, 1026,
+        1027, 1028, 1029, 1030, 1031, 1032, 1033, 1034, 1035, 1037, 1038, 1039, 1040, 1041, 1042, 1043, 1045, 1046, 1048, 1049, 1050, 1051, 1052, 1053,
+        1059, 1060, 1062, 1063, 1065, 1067, 1069, 1071, 1078, 1079, 1082, 1083, 1084, 1086, 1087, 1089, 1090, 1092, 1093, 1098, 1099, 1100, 1101, 1104,
+        1106, 1110, 1111, 1113, 1117, 1119, 1122, 1126, 1127, 1130, 1131, 1134, 1135, 1136, 1140, 1142, 1144, 1145, 1152, 1154, 1155, 1156, 1157, 1161,
+        1163, 1165, 1168, 1171, 1173, 1174, 1179, 1180, 1181, 1186, 1188, 1191, 1193, 1195, 1196, 1198, 1200, 1202, 1206, 1207, 1208, 1210, 1213, 1217,
+        1220, 1222, 1224, 1227, 1231, 1233, 1236, 1238, 1240, 1243, 1244, 1245, 1246, 1249, 1250, 1251, 1254, 1255, 1257, 1258, 1260, 1261, 1263, 1266,
+        1267, 1269, 1270, 1274, 1275, 1277, 1278, 1279, 1283, 1287, 1288, 1289, 1291, 1297, 1299, 1300, 1304, 1305, 1306, 1309, 1310, 1311, 1316, 1319,
+        1321, 1322, 1325, 1327, 1329, 1330, 1334, 1335, 1338, 1343, 1347, 1348, 1349, 1351, 1353, 1355, 1357, 1358, 1359, 1360, 1362, 1363, 1364, 1366,
+        1367, 1368, 1369, 1370, 1371, 1372, 1375, 1376, 1378, 1379, 1388, 1391, 1395, 1399, 1404, 1407, 1409, 1411, 1412, 1417, 1419, 1423, 1431, 1432,
+        1437, 1443, 1451, 1452, 1454, 1455, 1459, 1461, 1462, 1463, 1464, 1465, 1468, 1470, 1471, 1473, 1474, 1476, 1479, 1481, 1484, 1485, 1487, 1492,
+        1494, 1499, 1500, 1507, 1508, 1512, 1515, 1518, 1519, 1526, 1527, 1529, 1532, 1536, 1543, 1547, 1549, 1558, 1561, 1562, 1564, 1566, 1571, 1572,
+        1574, 1577, 1579, 1580, 1584, 1587, 1588, 1591, 1598, 1601, 1602, 1603, 1604, 1605, 1606, 1607, 1608, 1611, 1614, 1616, 1617, 1620, 1630, 1632,
+        1633, 1634, 1635, 1636, 1637, 1638, 1641, 1644, 1645, 1646, 1653, 1656, 1660, 1664, 1667, 1670, 1672, 1675, 1678, 1679, 1680, 1684, 1686, 1687,
+        1691, 1694, 1695, 1696, 1697, 1698, 1708, 1709, 1716, 1717, 1721, 1723, 1724, 1728, 1731, 1732, 1735, 1736, 1740, 1742, 1747, 1750, 1751, 1753,
+        1754, 1757, 1758, 1759, 1760, 1764, 1767, 1770, 1771, 1774, 1777, 1779, 1780, 1781, 1783, 1784, 1786, 1789, 1791, 1792, 1794, 1796, 1798, 1800,
+        1806, 1809, 1810, 1813, 1815, 1816, 1817, 1818, 1819, 1821, 1822, 1823, 1826, 1827, 1828, 1829, 1830, 1831, 1832, 1834, 1835, 1836, 1838, 1839,
+        1840, 1841, 1843, 1844, 1847, 1848, 1849, 1851, 1852, 1854, 1855, 1856, 1859, 1861, 1863, 1865, 1866, 1867, 1868, 1870, 1871, 1872, 1873, 1874,
+        1875, 1877, 1878, 1880, 1881, 1883, 1884, 1885, 1886, 1887, 1888, 1890, 1891, 1892, 1893, 1894, 1895, 1896, 1897, 1898, 1899, 1900, 1901, 1902,
+        1903, 1904, 1905, 1906, 1907, 1908, 1909, 1910, 1912, 1913, 1914, 1915, 1916, 1917, 1918, 1919, 1920, 1921, 1922, 1923, 1924, 1926, 1927, 1928,
+        1929, 1930, 1931, 1932, 1933, 1934, 1935, 1936, 1937, 1939, 1940, 1943, 1945, 1946, 1947, 1948, 1950, 1950, 1951, 1952, 1953, 1954, 1955, 1956,
+        1957, 1958, 1959, 1961, 1962, 1964, 1965, 1966, 1969, 1970, 1971, 1972, 1973, 1974, 1975, 1976, 1977, 1978, 1979, 1980, 1981, 1982, 1983, 1984,
+        1985, 1986, 1987, 1988, 1990, 1991, 1992, 1993, 1994, 1995, 1996, 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004, 2004, 2005, 2006, 2007, 2008,
+        2009, 2010, 2011, 2011, 2012, 2013, 2014, 2014, 2015, 2016, 2017, 2018, 2019, 2020, 2021, 2022, 2023, 2024, 2025, 2026, 2027, 2028, 2029, 2030,
+        2031, 2032, 2033, 2034, 2034, 2036, 2037, 2039, 2040, 2041, 2042, 2043, 2044, 2045, 2046, 2047, 2048, 2049, 2050, 2051, 2052, 2053, 2054, 2055,
+        2056, 2057, 2058, 2059, 2060, 2061, 2062, 2063, 2063, 2064, 2065, 2066, 2067, 2068, 2069, 2070, 2071, 2072, 2073, 2074, 2074, 2075, 2076, 2077,
+        2078, 2079, 2080, 2081, 2082, 2082, 2083, 2084, 2085, 2086, 2087, 2088, 2089, 2090, 2090, 2091, 2092, 2093, 2094, 2095, 2096, 2097, 2098, 2099,
+        2100, 2101, 2102, 2115, 2116, 2117, 2117, 2118, 2119, 2120, 2121, 2122, 2123, 2124, 2125, 2126, 2127, 2128, 2129, 2129, 2130, 2131, 2133, 2134,
+        2135, 2136, 2137, 2138, 2139, 2139, 2140, 2141, 2142, 2142, 2143, 2144, 2146, 2147, 2148, 2149, 2150, 2151, 2152, 2153, 2154, 2155, 2156, 2157,
+        2158, 2159, 2160, 2160, 2161, 2162, 2163, 2164, 2165, 2166, 2167, 2168, 2169, 2170, 2171, 2172, 2173, 2174, 2174, 2175, 2176, 2177, 2178, 2179,
+        2180, 2181, 2182, 2183, 2184, 2185, 2186, 2187, 2189, 2191, 2192, 2195, 2196, 2197, 2198, 2199, 2200, 2201, 2202, 2203, 2204, 2205, 2207, 2209,
+        2210, 2211, 2212, 2213, 2214, 2215, 2216, 2218, 2219, 2220, 2221, 2222, 2223, 2224, 2225, 2226, 2227, 2228, 2229, 2230, 2231, 2232, 2233, 2234,
+        2235, 2236, 2237, 2238, 2239, 2240, 2241, 2242, 2243, 2244, 2245, 2248, 2249, 2250, 2251, 2252, 2253, 2254, 2255, 2256, 2257, 2258, 2258, 2259,
+        2260, 2261, 2262, 2263, 2264, 2265, 2266, 2267, 2268, 2269, 2270, 2271, 2272, 2273, 2274, 2275, 2276, 2277, 2278, 2279, 2280, 2281, 2282, 2282,
+        2283, 2284, 2285, 2286, 2287, 2288, 2288, 2289, 2290, 2292, 2293, 2295, 2296, 2301, 2308, 2309, 2310, 2310, 2311, 2312, 2313, 2314, 2315, 2316,
+        2317, 2318, 2319, 2320, 2321, 2322, 2323, 2324, 2325, 2326, 2328, 2329, 2330, 2331, 2332, 2333, 2334, 2335, 2336, 2339, 2340, 2347, 2348, 2350,
+        2352, 2353, 2355, 2356, 2357, 2359, 2360, 2372, 2373, 2374, 2375, 2376, 2377, 2378, 2379, 2380, 2381, 2382, 2388, 2390, 2392, 2393, 2394, 2395,
+        2396, 2397, 2398, 2399, 2400, 2401, 2402, 2403, 2410, 2411, 2412, 2414, 2416, 2419, 2420, 2421, 2422, 2424, 2425, 2426, 2428, 2429, 2435, 2439,
+        2440, 2441, 2442, 2443, 2444, 2445, 2446, 2447, 2448, 2449, 2450, 2451, 2452, 2453, 2454, 2454, 2456, 2457, 2458, 2459, 2460, 2461, 2462, 2463,
+        2464, 2465, 2466, 2467, 2470, 2471, 2473, 2474, 2475, 2480, 2481, 2482, 2483, 2485, 2487, 2488, 2489, 2490, 2491, 2492, 2493, 2494, 2495, 2496,
+        2497, 2498, 2499, 2500, 2501, 2502, 2503, 2504, 2505, 2505, 2506, 2507, 2507, 2508, 2510, 2510, 2511, 2512, 2514, 2515, 2516, 2517, 2518, 2519,
+        2520, 2521, 2522, 2523, 2524, 2526, 2528, 2531, 2532, 2533, 2534, 2535, 2536, 2537, 2538, 2539, 2540, 2541, 2542, 2543, 2545, 2546, 2547, 2548,
+        2549, 2551, 2552, 2553, 2554, 2555, 2556, 2557, 2558, 2559, 2561, 2562, 2564, 2565, 2566, 2566, 2567, 2568, 2569, 2570, 2571, 2572, 2573, 2574,
+        2574, 2575, 2578, 2582, 2583, 2583, 2584, 2585, 2586, 2586, 2587, 2588, 2589, 2590, 2591, 2593, 2594, 2595, 2596, 2597, 2598, 2598, 2600, 2601,
+        2602, 2603, 2608, 2609, 2610, 2611, 2612, 2613, 2614, 2616, 2617, 2618, 2619, 2620, 2621, 2622, 2624, 2625, 2626, 2627, 2628, 2629, 2630, 2631,
+        2632, 2633, 2634, 2635, 2635, 2636, 2637, 2638, 2639, 2640, 2641, 2642, 2642, 2644, 2645, 2646, 2647, 2650, 2651, 2652, 2652, 2653, 2654, 2655,
+        2660, 2661, 2662, 2663, 2664, 2665, 2666, 2667, 2668, 2668, 2669, 2670, 2671, 2672, 2673, 2674, 2675, 2676, 2677, 2678, 2679, 2680, 2681, 2682,
+        2683, 2684, 2685, 2686, 2687, 2688, 2689, 2690, 2691, 2692, 2692, 2693, 2694, 2695, 2696, 2697, 2698, 2699, 2700, 2701, 2702, 2705, 2706, 2707,
+        2709, 2710, 2712, 2713, 2714, 2715, 2716, 2718, 2719, 2719, 2720, 2721, 2724, 2729, 2730, 2731, 2732, 2732, 2733, 2734, 2735, 2736, 2736, 2737,
+        2738, 2739, 2740, 2741, 2742, 2743, 2744, 2746, 2747, 2749, 2750, 2751, 2752, 2755, 2756, 2758, 2761, 2762, 2763, 2764, 2765, 2766, 2767, 2768,
+        2769, 2770, 2771, 2773, 2774, 2774, 2776, 2777, 2778, 2779, 2780, 2781, 2783, 2785, 2786, 2787, 2788, 2789, 2791, 2793, 2794, 2795, 2796, 2797,
+        2798, 2799, 2800, 2801, 2805, 2806, 2807, 2808, 2809, 2810, 2811, 2811, 2812, 2813, 2813, 2814, 2815, 2816, 2818, 2819, 2820, 2822, 2823, 2824,
+        2825, 2826, 2827, 2828, 2833, 2834, 2835, 2836, 2838, 2839, 2840, 2841, 2842, 2843, 2843, 2844, 2845, 2846, 2847, 2849, 2850, 2851, 2852, 2855,
+        2856, 2858, 2859, 2860, 2861, 2861, 2863, 2864, 2865, 2866, 2867, 2868, 2869, 2873, 2874, 2876, 2877, 2878, 2881, 2882, 2883, 2886, 2887, 2888,
+        2889, 2890, 2894, 2895, 2896, 2897, 2898, 2899, 2902, 2903, 2904, 2905, 2906, 2906, 2909, 2910, 2911, 2912, 2913, 2915, 2916, 2919, 2921, 2922,
+        2923, 2924, 2925, 2925, 2926, 2927, 2928, 2929, 2930, 2931, 2932, 2933, 2934, 2935, 2936, 2937, 2938, 2939, 2940, 2941, 2942, 2943, 2944, 2946,
+        2947, 2948, 2949, 2950, 2953, 2954, 2955, 2956, 2957, 2957, 2958, 2962, 2963, 2964, 2965, 2966, 2967, 2968, 2969, 2971, 2972, 2973, 2977, 2978,
+        2983, 2984, 2986, 2987, 2988, 2988, 2989, 2990, 2991, 2992, 2992, 2993, 2994, 2995, 2995, 2996, 2997, 2998, 3000, 3001, 3004, 3007, 3008, 3009,
+        3010, 3011, 3012, 3013, 3014, 3015, 3016, 3017, 3018, 3019, 3020, 3021, 3022, 3023, 3024, 3025, 3027, 3028, 3029, 3030, 3031, 3032, 3034, 3035,
+        3036, 3038, 3039, 3041, 3042, 3043, 3044, 3045, 3046, 3047, 3048, 3049, 3050, 3051, 3052, 3053, 3054, 3056, 3057, 3058, 3059, 3060, 3061, 3062,
+        3063, 3064, 3066, 3067, 3070, 3071, 3072, 3073, 3074, 3075, 3076, 3077, 3079, 3080, 3081, 3082, 3083, 3083, 3084, 3085, 3085, 3086, 3088, 3089,
+        3091, 3092, 3095, 3096, 3097, 3098, 3099, 3100, 3101, 3102, 3103, 3104, 3105, 3106, 3108, 3109, 3111, 3112, 3113, 3114, 3122, 3123, 3125, 3126,
+        3128, 3130, 3131, 3133, 3134, 3136, 3138, 3139, 3142, 3143, 3144, 3145, 3146, 3147, 3148, 3150, 3159, 3160, 3161, 3162, 3175, 3176, 3177, 3178,
+        3179, 3180, 3181, 3182, 3183, 3184, 3185, 3186, 3187, 3188, 3190, 3192, 3194, 3195, 3196, 3197, 3198, 3199, 3203, 3204, 3205, 3206, 3213, 3214,
+        3216, 3217, 3218, 3219, 3220, 3221, 3222, 3223, 3224, 3226, 3227, 3228, 3229, 3230, 3231, 3232, 3233, 3234, 3235, 3236, 3238, 3239, 3240, 3241,
+        3242, 3243, 3244, 3245, 3246, 3247, 3248, 3249, 3251, 3252, 3253, 3254, 3255, 3256, 3257, 3258, 3259, 3260, 3261, 3262, 3263, 3264, 3271, 3272,
+        3273, 3276, 3277, 3279, 3280, 3281, 3282, 3283, 3284, 3285, 3286, 3288, 3289, 3290, 3292, 3293, 3294, 3295, 3295, 3295, 3296, 3297, 3298, 3299,
+        3300, 3301, 3302, 3303, 3304, 3304, 3305, 3306, 3307, 3308, 3309, 3311, 3312, 3313, 3314, 3315, 3316, 3317, 3318, 3319, 3320, 3322, 3323, 3324,
+        3325, 3326, 3327, 3328, 3329, 3330, 3331, 3332, 3333, 3334, 3335, 3336, 3337, 3338, 3339, 3340, 3341, 3342, 3343, 3344, 3345, 3345, 3346, 3347,
+        3348, 3348, 3348, 3349, 3350, 3351, 3351, 3352, 3353, 3354, 3355, 3356, 3357, 3358, 3359, 3360, 3361, 3362, 3362, 3363, 3364, 3365, 3365, 3366,
+        3367, 3368, 3369, 3370, 3371, 3372, 3372, 3373, 3374, 3375, 3376, 3377, 3378, 3379, 3380, 3381, 3381, 3381, 3382, 3383, 3384, 3385, 3386, 3387,
+        3388, 3389, 3390, 3391, 3392, 3393, 3393, 3394, 3395, 3396, 3397, 3398, 3399, 3400, 3401, 3402, 3402, 3402, 3403, 3403, 3404, 3405, 3406, 3407,
+        3407, 3408, 3409, 3410, 3416, 3417, 3418, 3418, 3418, 3419, 3420, 3421, 3421, 3422, 3422, 3423, 3424, 3425, 3426, 3427, 3428, 3429, 3430, 3431,
+        3432, 3433, 3433, 3434, 3435, 3436, 3436, 3436, 3437, 3438, 3439, 3440, 3441, 3442, 3443, 3444, 3445, 3446, 3446, 3447, 3447, 3448, 3449, 3450,
+        3451, 3452, 3452, 3453, 3453, 3454, 3455, 3456, 3457, 3458, 3460, 3461, 3462, 3463, 3464, 3465, 3465, 3466, 3466, 3467, 3468, 3469, 3470, 3470,
+        3472, 3473, 3474, 3475, 3476, 3477, 3478, 3479, 3480, 3481, 3481, 3481, 3482, 3483, 3484, 3485, 3486, 3487, 3488, 3489, 3489, 3489, 3490, 3491,
+        3492, 3493, 3494, 3495, 3496, 3497, 3498, 3499, 3499, 3509, 3515, 3515, 3516, 3517, 3521, 3522, 3523, 3524, 3524, 3525, 3525, 3525, 3526, 3527,
+        3527, 3528, 3529, 3530, 3531, 3532, 3533, 3534, 3534, 3535, 3536, 3537, 3537, 3538, 3539, 3540, 3540, 3542, 3543, 3546, 3547, 3548, 3549, 3550,
+        3551, 3553, 3555, 3556, 3557, 3558, 3559, 3560, 3561, 3562, 3562, 3563, 3563, 3564, 3565, 3566, 3567, 3568, 3569, 3570, 3571, 3572, 3573, 3574,
+        3576, 3577, 3577, 3577, 3577, 3578, 3579, 3580, 3581, 3582, 3583, 3584, 3585, 3585, 3586, 3586, 3587, 3588, 3589, 3589, 3590, 3591, 3593, 3594,
+        3595, 3595, 3596, 3596, 3596, 3597, 3598, 3599, 3600, 3601, 3601, 3602, 3603, 3604, 3605, 3606, 3607, 3608, 3609, 3609, 3609, 3610, 3611, 3612,
+        3613, 3614, 3615, 3616, 3617, 3617, 3618, 3619, 3620, 3620, 3620, 3621, 3622, 3623, 3624, 3625, 3626, 3626, 3626, 3627, 3628, 3628, 3628, 3629,
+        3630, 3631, 3632, 3633, 3634, 3635, 3636, 3637, 3638, 3640, 3641, 3642, 3643, 3643, 3644, 3644, 3645, 3646, 3647, 3648, 3649, 3650, 3651, 3652,
+        3653, 3654, 3655, 3656, 3657, 3659, 3660, 3661, 3662, 3663, 3664, 3665, 3665, 3666, 3666, 3667, 3669, 3670, 3670, 3671, 3672, 3673, 3674, 3675,
+        3675, 3676, 3677, 3677, 3678, 3679, 3680, 3681, 3682, 3683, 3684, 3684, 3684, 3685, 3686, 3687, 3688, 3689, 3690, 3690, 3691, 3692, 3693, 3693,
+        3694, 3695, 3696, 3697, 3697, 3697, 3698, 3699, 3699, 3700, 3700, 3701, 3702, 3703, 3704, 3705, 3706, 3706, 3706, 3707, 3708, 3709, 3710, 3710,
+        3711, 3712, 3713, 3714, 3716, 3717, 3718, 3719, 3719, 3720, 3720, 3721, 3722, 3723, 3724, 3725, 3725, 3726, 3727, 3728, 3729, 3730, 3731, 3735,
+        3736, 3737, 3739, 3740, 3740, 3741, 3742, 3743, 3744, 3745, 3746, 3747, 3748, 3748, 3751, 3754, 3756, 3757, 3758, 3759, 3760, 3761, 3762, 3763,
+        3765, 3766, 3767, 3767, 3768, 3769, 3770, 3770, 3771, 3772, 3776, 3781, 3785, 3792, 3793, 3797, 3802, 3803, 3804, 3805, 3809, 3816, 3817, 3818,
+        3819, 3820, 3821, 3823, 3826, 3828, 3831, 3832, 3832, 3833, 3834, 3836, 3837, 3838, 3839, 3840, 3841, 3842, 3843, 3844, 3845, 3846, 3847, 3848,
+        3850, 3850, 3851, 3852, 3852, 3852, 3853, 3856, 3857, 3858, 3859, 3860, 3861, 3862, 3863, 3866, 3868, 3869, 3870, 3871, 3873, 3874, 3875, 3876,
+        3878, 3880, 3881, 3882, 3883, 3884, 3885, 3885, 3886, 3888, 3889, 3890, 3891, 3892, 3893, 3894, 3895, 3896, 3897, 3898, 3899, 3900, 3901, 3902,
+        3903, 3904, 3905, 3907, 3908, 3909, 3910, 3910, 3911, 3912, 3913, 3913, 3914, 3915, 3916, 3916, 3918, 3921, 3921, 3922, 3923, 3923, 3924, 3925,
+        3926, 3927, 3928, 3929, 3930, 3930, 3931, 3932, 3933, 3934, 3935, 3938, 3939, 3940, 3941, 3942, 3943, 3944, 3945, 3946, 3948, 3949, 3950, 3951,
+        3952, 3953, 3954, 3955, 3956, 3957, 3958, 3960, 3961, 3961, 3962, 3963, 3963, 3964, 3964, 3965, 3966, 3966, 3966, 3967, 3968, 3969, 3971, 3971,
+        3972, 3973, 3974, 3976, 3977, 3980, 3981, 3982, 3983, 3984, 3985, 3986, 3987, 3988, 3989, 3990, 3991, 3992, 3993, 3993, 3993, 3994, 3995, 3996,
+        3997, 3998, 3999, 4000, 4000, 4001, 4002, 4003, 4004, 4004, 4005, 4006, 4007, 4008, 4009, 4010, 4011, 4012, 4014, 4015, 4021, 4022, 4023, 4024,
+        4024, 4025, 4026, 4026, 4027, 4028, 4028, 4029, 4029, 4029, 4030, 4031, 4031, 4032, 4033, 4035, 4035, 4035, 4036, 4037, 4037, 4037, 4037, 4037,
+        4039, 4039, 4041, 4042, 4043, 4044, 4045, 4048, 4049, 4050, 4051, 4052, 4053, 4055, 4056, 4057, 4058, 4059, 4060, 4061, 4062, 4063, 4064, 4065,
+        4066, 4069, 4070, 4071, 4072, 4073, 4074, 4074, 4075, 4076, 4077, 4078, 4080, 4081, 4082, 4083, 4084, 4085, 4086, 4087, 4088, 4089, 4089, 4090,
+        4091, 4091, 4091, 4092, 4093, 4094, 4095, 4096, 4097, 4098, 4101, 4102, 4103, 4104, 4105, 4106, 4107, 4107, 4108, 4110, 4111, 4112, 4113, 4114,
+        4115, 4116, 4117, 4118, 4119, 4124, 4125, 4126, 4127, 4128, 4128, 4128, 4129, 4130, 4131, 4132, 4133, 4134, 4135, 4135, 4135, 4136, 4137, 4138,
+        4139, 4140, 4141, 4142, 4143, 4144, 4144, 4145, 4146, 4147, 4148, 4149, 4152, 4152, 4153, 4161, 4161, 4162, 4164, 4165, 4166, 4167, 4169, 4170,
+        4171, 4172, 4173, 4173, 4174, 4175, 4176, 4177, 4178, 4183, 4183, 4183, 4184, 4185, 4185, 4186, 4187, 4189, 4194, 4195, 4196, 4196, 4196, 4198,
+        4199, 4200, 4201, 4202, 4203, 4204, 4205, 4206, 4206, 4208, 4208, 4210, 4211, 4212, 4213, 4214, 4217, 4218, 4219, 4220, 4221, 4222, 4223, 4224,
+        4224, 4225, 4226, 4228, 4229, 4230, 4231, 4231, 4232, 4233, 4234, 4234, 4237, 4238, 4239, 4240, 4241, 4242, 4243, 4244, 4245, 4246, 4247, 4248,
+        4251, 4252, 4253, 4254, 4255, 4256, 4257, 4258, 4260, 4260, 4261, 4262, 4263, 4263, 4264, 4265, 4265, 4265, 4266, 4266, 4267, 4268, 4269, 4270,
+        4271, 4272, 4273, 4274, 4275, 4276, 4277, 4278, 4279, 4279, 4279, 4280, 4281, 4281, 4281, 4282, 4283, 4284, 4285, 4286, 4287, 4288, 4288, 4289,
+        4290, 4291, 4292, 4293, 4294, 4295, 4296, 4297, 4298, 4299, 4300, 4300, 4301, 4302, 4304, 4305, 4306, 4307, 4308, 4309, 4309, 4309, 4309, 4312,
+        4313, 4314, 4314, 4315, 4316, 4317, 4318, 4318, 4319, 4319, 4320, 4321, 4321, 4322, 4323, 4323, 4324, 4327, 4329, 4330, 4330, 4331, 4332, 4333,
+        4333, 4334, 4335, 4339, 4340, 4340, 4341, 4343, 4344, 4345, 4346, 4347, 4347, 4348, 4349, 4350, 4351, 4353, 4354, 4355, 4356, 4360, 4361, 4365,
+        4366, 4367, 4368, 4369, 4369, 4370, 4371, 4372, 4373, 4374, 4375, 4376, 4377, 4378, 4379, 4380, 4382, 4383, 4384, 4385, 4386, 4388, 4389, 4390,
+        4391, 4393, 4393, 4394, 4395, 4396, 4397, 4398, 4399, 4400, 4400, 4401, 4402, 4402, 4403, 4403, 4404, 4405, 4406, 4407, 4408, 4408, 4409, 4410,
+        4411, 4412, 4413, 4414, 4415, 4416, 4417, 4418, 4418, 4419, 4420, 4421, 4422, 4423, 4424, 4424, 4425, 4426, 4427, 4428, 4429, 4430, 4431, 4431,
+        4433, 4435, 4436, 4436, 4437, 4438, 4439, 4440, 4441, 4441, 4441, 4442, 4443, 4444, 4445, 4445, 4447, 4456, 4457, 4458, 4459, 4459, 4460, 4461,
+        4461, 4467, 4468, 4469, 4470, 4471, 4472, 4475, 4477, 4478, 4479, 4480, 4480, 4481, 4481, 4482, 4483, 4484, 4485, 4487, 4488, 4489, 4490, 4491,
+        4492, 4493, 4494, 4495, 4496, 4497, 4498, 4502, 4503, 4514, 4515, 4516, 4517, 4518, 4519, 4521, 4522, 4523, 4524, 4525, 4525, 4526, 4527, 4528,
+        4529, 4533, 4534, 4534, 4535, 4536, 4536, 4538, 4538, 4539, 4540, 4541, 4542, 4543, 4544, 4544, 4545, 4546, 4547, 4548, 4549, 4550, 4551, 4552,
+        4553, 4555, 4556, 4557, 4558, 4559, 4559, 4560, 4561, 4562, 4563, 4567, 4568, 4569, 4570, 4570, 4571, 4572, 4573, 4573, 4574, 4575, 4576, 4577,
+        4578, 4579, 4580, 4580, 4583, 4584, 4586, 4587, 4588, 4589, 4591, 4592, 4592, 4593, 4594, 4595, 4596, 4597, 4597, 4598, 4598, 4599, 4601, 4603,
+        4605, 4606, 4607, 4608, 4609, 4610, 4611, 4612, 4613, 4614, 4614, 4616, 4617, 4617, 4619, 4620, 4621, 4622, 4623, 4624, 4626, 4626, 4627, 4628,
+        4629, 4630, 4631, 4632, 4633, 4635, 4636, 4637, 4637, 4638, 4639, 4641, 4642, 4644, 4645, 4646, 4649, 4655, 4655, 4656, 4657, 4658, 4659, 4659,
+        4660, 4662, 4664, 4665, 4666, 4667, 4669, 4670, 4673, 4674, 4676, 4677, 4678, 4679, 4679, 4680, 4681, 4682, 4682, 4683, 4684, 4684, 4685, 4686,
+        4687, 4688, 4689, 4690, 4691, 4692, 4693, 4694, 4695, 4695, 4696, 4697, 4699, 4700, 4701, 4702, 4703, 4704, 4705, 4706, 4707, 4708, 4709, 4710,
+        4711, 4712, 4713, 4714, 4715, 4716, 4717, 4718, 4719, 4720, 4721, 4722, 4723, 4723, 4724, 4725, 4726, 4727, 4727, 4728, 4730, 4731, 4732, 4733,
+        4734, 4735, 4735, 4736, 4737, 4738, 4739, 4740, 4741, 4744, 4745, 4746, 4747, 4748, 4749, 4750, 4751, 4752, 4754, 4755, 4756, 4757, 4758, 4760,
+        4761, 4762, 4763, 4764, 4765, 4768, 4770, 4772, 4774, 4774, 4775, 4775, 4776, 4777, 4778, 4779, 4780, 4780, 4781, 4783, 4784, 4785, 4786, 4787,
+        4788, 4789, 4790, 4791, 4792, 4793, 4794, 4794, 4795, 4796, 4797, 4798, 4799, 4800, 4801, 4801, 4802, 4803, 4804, 4805, 4806, 4807, 4808, 4809,
+        4810, 4811, 4812, 4813, 4814, 4815, 4816, 4817, 4818, 4819, 4820, 4821, 4822, 4822, 4822, 4822, 4823, 4824, 4825, 4826, 4827, 4828, 4829, 4829,
+        4830, 4831, 4832, 4832, 4833, 4834, 4835, 4836, 4836, 4837, 4838, 4839, 4840, 4841, 4842, 4843, 4844, 4845, 4845, 4846, 4847, 4847, 4848, 4849,
+        4849, 4850, 4850, 4851, 4852, 4853, 4853, 4853, 4854, 4854, 4855, 4855, 4855, 4856, 4857, 4858, 4859, 4860, 4861, 4862, 4862, 4863, 4864, 4865,
+        4866, 4867, 4869, 4870, 4871, 4872, 4872, 4873, 4874, 4875, 4875, 4876, 4877, 4877, 4877, 4877, 4878, 4878, 4879, 4880, 4881, 4882, 4883, 4884,
+        4884, 4885, 4886, 4887, 4888, 4889, 4890, 4891, 4892, 4893, 4893, 4894, 4895, 4896, 4897, 4897, 4898, 4899, 4900, 4902, 4903, 4903, 4904, 4906,
+        4907, 4907, 4907, 4907, 4908, 4909, 4910, 4910, 4911, 4912, 4912, 4912, 4914, 4915, 4916, 4917, 4917, 4917, 4918, 4918, 4919, 4920, 4921, 4922,
+        4922, 4923, 4923, 4924, 4925, 4926, 4926, 4927, 4927, 4928, 4929, 4929, 4930, 4931, 4932, 4933, 4934, 4935, 4936, 4937, 4937, 4937, 4937, 4938,
+        4939, 4939, 4940, 4940, 4940, 4941, 4942, 4942, 4942, 4943, 4944, 4944, 4944, 4944, 4945, 4946, 4946, 4947, 4947, 4948, 4949, 4951, 4952, 4953,
+        4954, 4955, 4957, 4958, 4959, 4960, 4961, 4962, 4963, 4964, 4965, 4966, 4967, 4968, 4969, 4970, 4971, 4972, 4973, 4973, 4975, 4975, 4976, 4977,
+        4978, 4979, 4979, 4979, 4979, 4980, 4981, 4982, 4983, 4984, 4985, 4986, 4987, 4987, 4988, 4989, 4990, 4991, 4992, 4993, 4994, 4995, 4997, 4998,
+        4999, 5000, 5001, 5002, 5005, 5006, 5007, 5007, 5008, 5009, 5010, 5011, 5012, 5013, 5014, 5015, 5016, 5016, 5017, 5017, 5018, 5019, 5020, 5020,
+        5022, 5023, 5024, 5025, 5026, 5026, 5027, 5028, 5029, 5030, 5030, 5030, 5030, 5030, 5031, 5032, 5032, 5032, 5033, 5034, 5035, 5036, 5044, 5044,
+        5045, 5046, 5046, 5047, 5048, 5048, 5049, 5050, 5051, 5052, 5053, 5057, 5058, 5059, 5059, 5059, 5060, 5060, 5060, 5061, 5062, 5063, 5064, 5065,
+        5066, 5067, 5068, 5068, 5069, 5070, 5071, 5072, 5073, 5074, 5078, 5078, 5079, 5079, 5080, 5081, 5081, 5082, 5083, 5084, 5085, 5086, 5087, 5088,
+        5090, 5092, 5093, 5093, 5094, 5095, 5096, 5098, 5099, 5100, 5102, 5102, 5103, 5104, 5104, 5105, 5105, 5106, 5106, 5108, 5109, 5109, 5110, 5111,
+        5111, 5111, 5112, 5113, 5114, 5114, 5114, 5114, 5114, 5114, 5114, 5114, 5115, 5116, 5116, 5116, 5116, 5116, 5117, 5118, 5118, 5119, 5119, 5119,
+        5119, 5120, 5121, 5122, 5123, 5124, 5125, 5126, 5127, 5128, 5129, 5130, 5131, 5131, 5132, 5132, 5132, 5133, 5134, 5136, 5137, 5138, 5139, 5140,
+        5140, 5141, 5141, 5141, 5142, 5143, 5143, 5145, 5146, 5146, 5147, 5148, 5148, 5149, 5150, 5151, 5152, 5153, 5154, 5154, 5155, 5156, 5157, 5158,
+        5159, 5160, 5161, 5161, 5161, 5162, 5163, 5164, 5165, 5166, 5167, 5168, 5169, 5170, 5171, 5172, 5173, 5174, 5175, 5178, 5179, 5180, 5181, 5182,
+        5183, 5184, 5184, 5184, 5185, 5186, 5187, 5188, 5189, 5190, 5190, 5191, 5192, 5193, 5194, 5195, 5196, 5197, 5198, 5198, 5199, 5200, 5201, 5202,
+        5203, 5204, 5205, 5206, 5207, 5208, 5209, 5209, 5210, 5211, 5212, 5213, 5214, 5215, 5216, 5217, 5218, 5219, 5220, 5220, 5221, 5222, 5223, 5224,
+        5225, 5226, 5227, 5228, 5229, 5229, 5230, 5230, 5231, 5231, 5232, 5233, 5233, 5234, 5234, 5235, 5237, 5238, 5239, 5240, 5241, 5242, 5243, 5243,
+        5244, 5245, 5246, 5247, 5248, 5249, 5251, 5251, 5252, 5253, 5253, 5254, 5254, 5256, 5256, 5256, 5257, 5258, 5258, 5259, 5260, 5261, 5263, 5265,
+        5267, 5267, 5268, 5269, 5269, 5270, 5271, 5271, 5272, 5272, 5273, 5274, 5275, 5275, 5275, 5276, 5276, 5277, 5278, 5279, 5280, 5281, 5282, 5283,
+        5284, 5285, 5286, 5287, 5287, 5288, 5291, 5292, 5293, 5294, 5295, 5296, 5297, 5298, 5298, 5298, 5299, 5300, 5300, 5300, 5301, 5302, 5303, 5304,
+        5305, 5306, 5307, 5308, 5309, 5310, 5311, 5312, 5312, 5313, 5314, 5315, 5316, 5317, 5318, 5318, 5319, 5320, 5321, 5321, 5323, 5324, 5325, 5326,
+        5327, 5328, 5329, 5330, 5331, 5332, 5333, 5333, 5333, 5333, 5334, 5335, 5335, 5336, 5337, 5338, 5339, 5339, 5340, 5341, 5341, 5342, 5343, 5344,
+        5344, 5345, 5346, 5346, 5347, 5348, 5349, 5350, 5351, 5352, 5355, 5357, 5357, 5357, 5358, 5358, 5358, 5359, 5360, 5360, 5361, 5362, 5363, 5364,
+        5365, 5366, 5367, 5368, 5370, 5371, 5372, 5373, 5373, 5374, 5374, 5374, 5374, 5374, 5375, 5376, 5377, 5378, 5379, 5380, 5381, 5382, 5383, 5384,
+        5384, 5385, 5386, 5386, 5386, 5387, 5387, 5388, 5389, 5395, 5397, 5400, 5401, 5403, 5404, 5405, 5406, 5406, 5407, 5409, 5410, 5411, 5411, 5411,
+        5412, 5413, 5414, 5414, 5415, 5416, 5416, 5416, 5417, 5417, 5418, 5419, 5419, 5420, 5420, 5420, 5421, 5422, 5422, 5423, 5424, 5425, 5426, 5427,
+        5428, 5429, 5431, 5432, 5433, 5434, 5434, 5434, 5435, 5435, 5436, 5437, 5437, 5438, 5439, 5439, 5440, 5441, 5442, 5443, 5444, 5445, 5446, 5447,
+        5448, 5449, 5449, 5450, 5450, 5451, 5452, 5453, 5454, 5455, 5456, 5456, 5457, 5458, 5459, 5460, 5461, 5462, 5463, 5464, 5465, 5466, 5467, 5468,
+        5468, 5469, 5470, 5472, 5473, 5474, 5475, 5476, 5477, 5478, 5478, 5479, 5479, 5479, 5480, 5481, 5481, 5481, 5482, 5483, 5485, 5486, 5487, 5488,
+        5488, 5489, 5490, 5490, 5490, 5491, 5492, 5494, 5495, 5496, 5496, 5496, 5496, 5496, 5497, 5497, 5498, 5499, 5499, 5500, 5501, 5502, 5503, 5503,
+        5504, 5505, 5506, 5506, 5508, 5509, 5510, 5511, 5512, 5513, 5514, 5515, 5515, 5516, 5517, 5518, 5520, 5521, 5522, 5523, 5524, 5525, 5525, 5525,
+        5527, 5528, 5529, 5529, 5530, 5531, 5532, 5533, 5534, 5534, 5535, 5536, 5537, 5537, 5538, 5539, 5540, 5541, 5542, 5543, 5544, 5545, 5546, 5548,
+        5549, 5549, 5550, 5551, 5552, 5553, 5554, 5555, 5555, 5556, 5556, 5557, 5558, 5559, 5560, 5561, 5562, 5563, 5564, 5565, 5566, 5566, 5567, 5568,
+        5569, 5570, 5571, 5571, 5571, 5572, 5573, 5574, 5576, 5577, 5578, 5578, 5578, 5579, 5580, 5580, 5582, 5583, 5583, 5584, 5585, 5586, 5587, 5588,
+        5589, 5590, 5590, 5591, 5592, 5593, 5594, 5595, 5595, 5596, 5596, 5596, 5596, 5597, 5598, 5599, 5600, 5601, 5602, 5603, 5604, 5605, 5606, 5609,
+        5609, 5609, 5610, 5611, 5611, 5611, 5612, 5613, 5614, 5614, 5616, 5616, 5617, 5618, 5619, 5620, 5621, 5621, 5621, 5622, 5623, 5624, 5626, 5626,
+        5628, 5628, 5629, 5630, 5632, 5632, 5633, 5634, 5635, 5637, 5638, 5639, 5640, 5641, 5642, 5642, 5643, 5644, 5644, 5645, 5645, 5646, 5647, 5648,
+        5648, 5648, 5649, 5650, 5650, 5652, 5652, 5653, 5654, 5654, 5655, 5656, 5658, 5658, 5658, 5662, 5664, 5664, 5665, 5666, 5667, 5668, 5669, 5669,
+        5671, 5672, 5675, 5676, 5678, 5679, 5679, 5679, 5680, 5680, 5682, 5683, 5684, 5686, 5686, 5687, 5688, 5689, 5691, 5691, 5692, 5693, 5694, 5694,
+        5695, 5695, 5696, 5697, 5698, 5699, 5700, 5700, 5701, 5701, 5701, 5702, 5703, 5703, 5703, 5704, 5705, 5706, 5707, 5708, 5709, 5711, 5712, 5713,
+        5713, 5713, 5714, 5715, 5716, 5716, 5716, 5717, 5718, 5719, 5719, 5720, 5721, 5721, 5722, 5723, 5724, 5725, 5726, 5727, 5728, 5728, 5729, 5729,
+        5729, 5730, 5731, 5732, 5734, 5734, 5734, 5735, 5735, 5736, 5736, 5737, 5737, 5738, 5739, 5739, 5740, 5740, 5741, 5742, 5743, 5743, 5744, 5745,
+        5746, 5746, 5747, 5747, 5748, 5749, 5750, 5751, 5752, 5752, 5753, 5754, 5755, 5757, 5758, 5759, 5760, 5761, 5762, 5762, 5763, 5763, 5764, 5764,
+        5765, 5766, 5767, 5770, 5771, 5773, 5773, 5774, 5775, 5775, 5776, 5777, 5778, 5778, 5779, 5780, 5781, 5781, 5782, 5782, 5782, 5783, 5783, 5784,
+        5785, 5787, 5787, 5788, 5788, 5789, 5790, 5790, 5790, 5791, 5792, 5793, 5793, 5794, 5795, 5796, 5797, 5797, 5798, 5800, 5801, 5802, 5803, 5804,
+        5805, 5806, 5807, 5808, 5809, 5811, 5812, 5813, 5815, 5816, 5817, 5818, 5819, 5820, 5820, 5820, 5821, 5823, 5823, 5823, 5824, 5825, 5826, 5826,
+        5827, 5828, 5829, 5831, 5831, 5837, 5837, 5838, 5839, 5840, 5841, 5842, 5843, 5844, 5845, 5846, 5846, 5847, 5848, 5848, 5849, 5850, 5851, 5852,
+        5852, 5852, 5854, 5855, 5856, 5856, 5857, 5858, 5859, 5860, 5861, 5862, 5862, 5863, 5864, 5865, 5866, 5866, 5867, 5868, 5869, 5870, 5870, 5871,
+        5872, 5873, 5874, 5876, 5876, 5876, 5877, 5878, 5879, 5879, 5880, 5881, 5882, 5882, 5884, 5887, 5888, 5888, 5889, 5889, 5890, 5890, 5891, 5892,
+        5893, 5894, 5895, 5896, 5897, 5898, 5898, 5899, 5899, 5900, 5901, 5901, 5902, 5902, 5903, 5903, 5905, 5907, 5910, 5913, 5915, 5915, 5916, 5916,
+        5917, 5918, 5919, 5919, 5920, 5921, 5922, 5922, 5923, 5923, 5924, 5925, 5926, 5927, 5928, 5929, 5930, 5931, 5933, 5933, 5934, 5935, 5936, 5939,
+        5940, 5940, 5940, 5940, 5940, 5940, 5941, 5942, 5942, 5943, 5945, 5946, 5947, 5948, 5949, 5950, 5951, 5952, 5954, 5955, 5956, 5958, 5959, 5960,
+        5961, 5961, 5962, 5963, 5963, 5964, 5966, 5969, 5971, 5972, 5973, 5974, 5975, 5976, 5979, 5979, 5979, 5980, 5981, 5981, 5982, 5982, 5983, 5984,
+        5985, 5986, 5986, 5987, 5988, 5989, 5990, 5991, 5991, 5991, 5992, 5993, 5994, 5995, 5995, 5995, 5996, 5996, 5997, 5998, 5999, 6000, 6001, 6002,
+        6003, 6004, 6005, 6006, 6007, 6008, 6009, 6010, 6011, 6012, 6012, 6013, 6014, 6015, 6016, 6016, 6017, 6018, 6019, 6020, 6021, 6022, 6023, 6023,
+        6024, 6025, 6025, 6026, 6027, 6027, 6028, 6028, 6028, 6029, 6030, 6031, 6032, 6033, 6034, 6035, 6036, 6037, 6037, 6038, 6039, 6041, 6042, 6043,
+        6044, 6045, 6046, 6047, 6048, 6048, 6049, 6050, 6051, 6051, 6052, 6053, 6053, 6055, 6057, 6058, 6059, 6060, 6062, 6063, 6063, 6064, 6064, 6064,
+        6065, 6065, 6066, 6067, 6068, 6069, 6070, 6070, 6070, 6071, 6071, 6072, 6073, 6074, 6075, 6075, 6076, 6077, 6078, 6078, 6079, 6080, 6080, 6081,
+        6081, 6081, 6081, 6081, 6081, 6082, 6083, 6083, 6084, 6084, 6084, 6085, 6085, 6085, 6085, 6085, 6086, 6087, 6087, 6088, 6088, 6088, 6088, 6089,
+        6089, 6090, 6091, 6092, 6093, 6094, 6095, 6095, 6096, 6097, 6098, 6099, 6100, 6101, 6101, 6102, 6103, 6104, 6108, 6109, 6110, 6110, 6111, 6112,
+        6113, 6114, 6115, 6116, 6116, 6117, 6118, 6119, 6119, 6120, 6120, 6121, 6122, 6123, 6124, 6125, 6131, 6132, 6133, 6134, 6135, 6136, 6137, 6138,
+        6139, 6140, 6140, 6141, 6142, 6142, 6143, 6144, 6144, 6145, 6145, 6146, 6147, 6148, 6149, 6151, 6152, 6153, 6153, 6154, 6155, 6156, 6156, 6157,
+        6158, 6158, 6158, 6159, 6160, 6161, 6162, 6163, 6163, 6164, 6164, 6165, 6165, 6166, 6167, 6168, 6169, 6170, 6170, 6171, 6171, 6171, 6172, 6172,
+        6172, 6173, 6174, 6175, 6176, 6177, 6178, 6179, 6180, 6181, 6183, 6184, 6185, 6186, 6187, 6190, 6191, 6192, 6193, 6194, 6195, 6196, 6197, 6198,
+        6199, 6200, 6201, 6202, 6203, 6204, 6205, 6206, 6207, 6208, 6209, 6210, 6211, 6212, 6213, 6214, 6215, 6217, 6218, 6219, 6220, 6221, 6222, 6223,
+        6224, 6225, 6226, 6227, 6228, 6229, 6230, 6231, 6232, 6233, 6234, 6235, 6236, 6237, 6238, 6239, 6240, 6241, 6241, 6242, 6242, 6243, 6244, 6244,
+        6244, 6245, 6246, 6247, 6248, 6249, 6250, 6251, 6252, 6253, 6254, 6255, 6256, 6256, 6257, 6258, 6258, 6259, 6260, 6261, 6262, 6263, 6265, 6266,
+        6267, 6268, 6270, 6271, 6272, 6273, 6274, 6275, 6276, 6277, 6278, 6279, 6280, 6281, 6281, 6282, 6283, 6284, 6285, 6285, 6286, 6290, 6292, 6293,
+        6294, 6295, 6296, 6296, 6296, 6296, 6297, 6298, 6299, 6299, 6300, 6301, 6301, 6302, 6303, 6304, 6305, 6306, 6307, 6308, 6308, 6309, 6309, 6310,
+        6311, 6311, 6313, 6314, 6314, 6315, 6315, 6316, 6317, 6318, 6318, 6319, 6320, 6321, 6322, 6323, 6324, 6324, 6325, 6325, 6325, 6326, 6327, 6328,
+        6329, 6330, 6330, 6330, 6331, 6331, 6332, 6333, 6334, 6335, 6336, 6336, 6336, 6336, 6337, 6338, 6338, 6338, 6338, 6338, 6339, 6340, 6340, 6342,
+        6342, 6343, 6344, 6344, 6345, 6345, 6346, 6348, 6348, 6348, 6349, 6350, 6351, 6351, 6352, 6353, 6354, 6355, 6356, 6358, 6359, 6359, 6359, 6361,
+        6362, 6362, 6363, 6364, 6365, 6366, 6367, 6368, 6369, 6370, 6371, 6372, 6373, 6374, 6375, 6376, 6377, 6378, 6379, 6380, 6380, 6380, 6380, 6380,
+        6380, 6381, 6382, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6383, 6384, 6384,
+        6384, 6384, 6384, 6384, 6384, 6384, 6384, 6385, 6386, 6387, 6387, 6387, 6387, 6387, 6387, 6387, 6387, 6387, 6387, 6387, 6388, 6388, 6389, 6389,
+        6389, 6389, 6390, 6391, 6391, 6391, 6392, 6393, 6394, 6395, 6396, 6397, 6398, 6398, 6398, 6398, 6399, 6400, 6400, 6400, 6401, 6401, 6402, 6403,
+        6403, 6404, 6405, 6407, 6408, 6409, 6410, 6410, 6411, 6411, 6413, 6413, 6414, 6415, 6417, 6418, 6419, 6420, 6421, 6421, 6421, 6421, 6421, 6421,
+        6423, 6423, 6423, 6425, 6426, 6427, 6428, 6429, 6429, 6431, 6432, 6433, 6434, 6435, 6436, 6436, 6436, 6437, 6437, 6438, 6439, 6440, 6440, 6441,
+        6441, 6442, 6443, 6443, 6444, 6444, 6445, 6446, 6446, 6446, 6447, 6447, 6448, 6448, 6450, 6451, 6452, 6453, 6454, 6454, 6455, 6456, 6457, 6458,
+        6459, 6460, 6461, 6462, 6463, 6464, 6465, 6466, 6466, 6466, 6466, 6466, 6467, 6468, 6468, 6469, 6470, 6471, 6471, 6472, 6472, 6473, 6474, 6475,
+        6476, 6476, 6476, 6477, 6478, 6479, 6480, 6480, 6481, 6481, 6482, 6482, 6483, 6484, 6484, 6485, 6486, 6487, 6487, 6488, 6489, 6489, 6489, 6489,
+        6489, 6490, 6491, 6492, 6493, 6494, 6494, 6495, 6495, 6495, 6495, 6495, 6496, 6496, 6497, 6498, 6499, 6500, 6501, 6502, 6503, 6504, 6505, 6506,
+        6507, 6508, 6509, 6510, 6511, 6512, 6512, 6512, 6513, 6513, 6514, 6515, 6515, 6516, 6516, 6518, 6519, 6519, 6520, 6520, 6520, 6520, 6520, 6520,
+        6520, 6520, 6521, 6522, 6523, 6524, 6525, 6526, 6527, 6528, 6529, 6530, 6531, 6532, 6533, 6534, 6534, 6534, 6536, 6537, 6538, 6539, 6540, 6540,
+        6541, 6542, 6543, 6544, 6545, 6546, 6547, 6548, 6549, 6549, 6549, 6550, 6551, 6551, 6552, 6552, 6552, 6552, 6552, 6553, 6554, 6554, 6554, 6555,
+        6555, 6556, 6557, 6558, 6559, 6560, 6561, 6562, 6562, 6562, 6563, 6563, 6564, 6564, 6565, 6565, 6566, 6566, 6566, 6566, 6567, 6567, 6567, 6568,
+        6569, 6570, 6570, 6571, 6571, 6572, 6573, 6574, 6575, 6575, 6576, 6576, 6576, 6577, 6578, 6579, 6580, 6581, 6582, 6583, 6584, 6584, 6584, 6584,
+        6585, 6586, 6586, 6588, 6589, 6590, 6590, 6590, 6591, 6592, 6593, 6594, 6595, 6596, 6597, 6598, 6599, 6599, 6601, 6602, 6603, 6604, 6606, 6607,
+        6608, 6609, 6610, 6610, 6610, 6611, 6611, 6611, 6612, 6613, 6613, 6614, 6616, 6617, 6617, 6617, 6617, 6617, 6617, 6618, 6619, 6620, 6621, 6621,
+        6622, 6623, 6624, 6625, 6626, 6627, 6627, 6628, 6628, 6629, 6629, 6630, 6630, 6630, 6630, 6631, 6632, 6632, 6632, 6633, 6634, 6635, 6636, 6637,
+        6637, 6637, 6638, 6639, 6640, 6640, 6641, 6645, 6646, 6647, 6647, 6648, 6648, 6649, 6650, 6651, 6651, 6652, 6654, 6655, 6656, 6657, 6658, 6658,
+        6659, 6660, 6661, 6662, 6663, 6663, 6664, 6664, 6664, 6665, 6665, 6666, 6666, 6667, 6668, 6669, 6669, 6670, 6670, 6670, 6671, 6671, 6672, 6672,
+        6673, 6674, 6674, 6676, 6676, 6677, 6677, 6677, 6677, 6677, 6677, 6677, 6678, 6679, 6679, 6680, 6680, 6680, 6680, 6681, 6681, 6682, 6683, 6686,
+        6686, 6689, 6690, 6691, 6691, 6692, 6693, 6693, 6694, 6694, 6694, 6695, 6696, 6697, 6697, 6698, 6699, 6701, 6701, 6702, 6702, 6702, 6703, 6704,
+        6704, 6704, 6705, 6705, 6706, 6706, 6706, 6707, 6708, 6709, 6710, 6710, 6711, 6712, 6713, 6714, 6715, 6716, 6717, 6718, 6718, 6718, 6719, 6719,
+        6720, 6721, 6722, 6722, 6722, 6723, 6724, 6724, 6724, 6725, 6725, 6725, 6725, 6726, 6726, 6726, 6726, 6727, 6728, 6728, 6728, 6728, 6728, 6729,
+        6730, 6731, 6732, 6733, 6735, 6735, 6736, 6737, 6737, 6738, 6739, 6740, 6741, 6742, 6742, 6743, 6745, 6746, 6747, 6747, 6748, 6749, 6750, 6750,
+        6751, 6752, 6753, 6754, 6754, 6754, 6755, 6756, 6757, 6758, 6759, 6760, 6761, 6761, 6762, 6762, 6763, 6764, 6765, 6766, 6767, 6767, 6768, 6769,
+        6770, 6771, 6772, 6772, 6773, 6773, 6774, 6774, 6775, 6775, 6776, 6776, 6776, 6777, 6777, 6778, 6778, 6779, 6779, 6780, 6781, 6782, 6783, 6784,
+        6785, 6785, 6786, 6786, 6787, 6787, 6787, 6788, 6789, 6789, 6791, 6792, 6793, 6793, 6794, 6794, 6795, 6796, 6797, 6797, 6798, 6799, 6799, 6799,
+        6800, 6801, 6802, 6803, 6804, 6805, 6806, 6807, 6807, 6807, 6809, 6809, 6809, 6809, 6809, 6809, 6810, 6811, 6812, 6813, 6813, 6814, 6814, 6815,
+        6816, 6817, 6817, 6817, 6818, 6819, 6820, 6820, 6821, 6821, 6822, 6822, 6822, 6823, 6824, 6824, 6824, 6824, 6824, 6825, 6825, 6826, 6827, 6828,
+        6828, 6829, 6829, 6830, 6831, 6832, 6832, 6833, 6834, 6835, 6835, 6835, 6835, 6835, 6836, 6837, 6837, 6838, 6839, 6840, 6840, 6840, 6841, 6842,
+        6844, 6844, 6845, 6845, 6846, 6846, 6847, 6848, 6848, 6849, 6850, 6851, 6852, 6852, 6853, 6854, 6855, 6855, 6856, 6856, 6857, 6858, 6859, 6859,
+        6859, 6860, 6861, 6864, 6865, 6866, 6867, 6868, 6869, 6870, 6871, 6872, 6873, 6874, 6875, 6876, 6877, 6878, 6879, 6880, 6881, 6881, 6881, 6882,
+        6885, 6886, 6887, 6888, 6888, 6889, 6889, 6890, 6891, 6891, 6892, 6893, 6894, 6895, 6896, 6897, 6897, 6898, 6899, 6900, 6901, 6902, 6902, 6903,
+        6903, 6903, 6903, 6905, 6906, 6907, 6908, 6909, 6910, 6910, 6911, 6912, 6913, 6914, 6914, 6915, 6916, 6916, 6917, 6917, 6918, 6919, 6919, 6920,
+        6920, 6920, 6921, 6921, 6922, 6923, 6923, 6923, 6923, 6925, 6926, 6926, 6926, 6926, 6927, 6928, 6929, 6929, 6929, 6930, 6931, 6933, 6934, 6934,
+        6934, 6934, 6935, 6935, 6935, 6936, 6936, 6936, 6937, 6938, 6939, 6940, 6941, 6941, 6942, 6943, 6944, 6945, 6946, 6947, 6948, 6948, 6949, 6949,
+        6950, 6951, 6951, 6951, 6951, 6951, 6951, 6952, 6953, 6954, 6955, 6956, 6956, 6957, 6957, 6958, 6959, 6960, 6960, 6960, 6960, 6960, 6960, 6960,
+        6960, 6961, 6962, 6962, 6962, 6963, 6964, 6964, 6965, 6966, 6966, 6967, 6968, 6969, 6970, 6970, 6970, 6970, 6971, 6971, 6971, 6972, 6972, 6973,
+        6974, 6974, 6974, 6975, 6976, 6976, 6976, 6977, 6978, 6979, 6980, 6981, 6982, 6983, 6984, 6985, 6985, 6986, 6986, 6987, 6988, 6989, 6989, 6990,
+        6990, 6990, 6991, 6992, 6993, 6993, 6994, 6995, 6996, 6998, 6999, 7000, 7001, 7002, 7003, 7004, 7005, 7007, 7008, 7008, 7008, 7008, 7008, 7009,
+        7010, 7011, 7012, 7013, 7014, 7014, 7015, 7016, 7017, 7017, 7018, 7018, 7018, 7018, 7024, 7024, 7025, 7026, 7026, 7027, 7028, 7028, 7028, 7029,
+        7030, 7031, 7032, 7033, 7033, 7033, 7033, 7033, 7033, 7034, 7034, 7034, 7035, 7036, 7037, 7038, 7039, 7040, 7041, 7044, 7045, 7046, 7047, 7048,
+        7049, 7050, 7051, 7052, 7053, 7054, 7055, 7056, 7057, 7058, 7058, 7059, 7060, 7061, 7062, 7063, 7064, 7064, 7065, 7066, 7067, 7067, 7067, 7067,
+        7068, 7069, 7070, 7071, 7072, 7073, 7074, 7075, 7076, 7077, 7078, 7079, 7080, 7082, 7083, 7089, 7090, 7091, 7092, 7093, 7094, 7095, 7096, 7097,
+        7098, 7099, 7099, 7099, 7099, 7099, 7100, 7101, 7101, 7101, 7101, 7102, 7103, 7104, 7105, 7106, 7107, 7108, 7109, 7110, 7110, 7110, 7110, 7110,
+        7112, 7113, 7114, 7115, 7117, 7118, 7119, 7120, 7123, 7124, 7125, 7126, 7127, 7128, 7128, 7128, 7128, 7128, 7128, 7129, 7130, 7131, 7132, 7133,
+        7133, 7134, 7135, 7136, 7136, 7137, 7138, 7139, 7140, 7140, 7140, 7140, 7141, 7142, 7143, 7144, 7145, 7146, 7147, 7147, 7147, 7148, 7148, 7148,
+        7148, 7149, 7150, 7151, 7152, 7155, 7156, 7157, 7158, 7159, 7160, 7161, 7162, 7163, 7163, 7163, 7163, 7164, 7165, 7165, 7165, 7165, 7165, 7166,
+        7166, 7166, 7166, 7167, 7167, 7168, 7168, 7176, 7178, 7178, 7179, 7179, 7179, 7180, 7181, 7181, 7182, 7183, 7184, 7185, 7187, 7187, 7187, 7188,
+        7189, 7189, 7190, 7191, 7191, 7192, 7192, 7193, 7193, 7194, 7195, 7196, 7197, 7198, 7199, 7200, 7200, 7201, 7201, 7202, 7203, 7204, 7205, 7205,
+        7205, 7205, 7206, 7207, 7208, 7208, 7208, 7209, 7209, 7209, 7209, 7209, 7210, 7210, 7210, 7210, 7210, 7210, 7211, 7212, 7213, 7214, 7214, 7215,
+        7220, 7221, 7221, 7222, 7223, 7223, 7224, 7224, 7224, 7225, 7226, 7227, 7227, 7227, 7227, 7228, 7229, 7229, 7230, 7231, 7231, 7231, 7231, 7231,
+        7232, 7234, 7235, 7236, 7236, 7237, 7238, 7238, 7238, 7238, 7239, 7239, 7240, 7241, 7242, 7242, 7244, 7245, 7245, 7246, 7246, 7246, 7246, 7246,
+        7247, 7248, 7249, 7250, 7251, 7252, 7253, 7254, 7255, 7255, 7255, 7255, 7256, 7257, 7257, 7257, 7257, 7257, 7257, 7257, 7258, 7258, 7259, 7259,
+        7259, 7259, 7259, 7260, 7260, 7261, 7263, 7263, 7263, 7264, 7265, 7266, 7267, 7268, 7268, 7268, 7268, 7268, 7269, 7269, 7269, 7269, 7269, 7269,
+        7269, 7269, 7269, 7269, 7269, 7269, 7269, 7269, 7269, 7269, 7269, 7269, 7269, 7270, 7270, 7272, 7272, 7273, 7273, 7274, 7275, 7275, 7275, 7276,
+        7277, 7278, 7278, 7279, 7279, 7279, 7279, 7280, 7280, 7281, 7281, 7281, 7282, 7283, 7283, 7284, 7285, 7285, 7285, 7285, 7285, 7285, 7285, 7285,
+        7285, 7285, 7286, 7287, 7287, 7288, 7288, 7288, 7289, 7290, 7291, 7292, 7292, 7293, 7293, 7293, 7293, 7293, 7293, 7293, 7293, 7293, 7294, 7294,
+        7294, 7294, 7295, 7295, 7295, 7295, 7295, 7296, 7296, 7296, 7296, 7296, 7297, 7298, 7298, 7298, 7298, 7299, 7300, 7301, 7302, 7303, 7304, 7305,
+        7306, 7306, 7308, 7308, 7309, 7310, 7311, 7312, 7313, 7314, 7314, 7314, 7314, 7315, 7315, 7315, 7315, 7316, 7317, 7318, 7319, 7320, 7321, 7321,
+        7322, 7322, 7322, 7323, 7323, 7324, 7324, 7324, 7324, 7324, 7324, 7324, 7324, 7325, 7325, 7326, 7327, 7328, 7329, 7329, 7330, 7331, 7332, 7332,
+        7332, 7333, 7333, 7333, 7333, 7333, 7333, 7334, 7334, 7334, 7334, 7335, 7336, 7337, 7338, 7338, 7338, 7338, 7339, 7341, 7341, 7341, 7341, 7342,
+        7342, 7343, 7343, 7343, 7343, 7344, 7345, 7346, 7347, 7348, 7348, 7348, 7349, 7350, 7351, 7352, 7353, 7354, 7355, 7356, 7356, 7357, 7357, 7358,
+        7358, 7358, 7359, 7359, 7359, 7360, 7361, 7361, 7362, 7363, 7365, 7366, 7368, 7368, 7369, 7369, 7369, 7369, 7369, 7370, 7370, 7371, 7371, 7372,
+        7372, 7373, 7373, 7373, 7373, 7373, 7373, 7374, 7375, 7375, 7376, 7376, 7377, 7377, 7377, 7377, 7378, 7379, 7379, 7379, 7379, 7379, 7380, 7380,
+        7381, 7381, 7382, 7382, 7383, 7384, 7384, 7384, 7384, 7385, 7386, 7387, 7388, 7389, 7389, 7390, 7391, 7392, 7393, 7393, 7393, 7394, 7395, 7396,
+        7396, 7396, 7396, 7396, 7397, 7398, 7399, 7399, 7399, 7400, 7400, 7400, 7401, 7401, 7401, 7401, 7401, 7402, 7402, 7402, 7403, 7403, 7403, 7404,
+        7405, 7405, 7405, 7406, 7406, 7407, 7408, 7408, 7408, 7408, 7409, 7410, 7411, 7412, 7413, 7414, 7415, 7415, 7416, 7416, 7417, 7417, 7418, 7418,
+        7418, 7418, 7418, 7419, 7420, 7420, 7420, 7420, 7420, 7421, 7421, 7422, 7422, 7423, 7423, 7423, 7424, 7425, 7425, 7425, 7425, 7426, 7427, 7428,
+        7428, 7429, 7429, 7429, 7429, 7430, 7430, 7430, 7430, 7431, 7431, 7432, 7432, 7432, 7432, 7432, 7432, 7433, 7433, 7434, 7435, 7436, 7437, 7437,
+        7438, 7439, 7439, 7439, 7439, 7440, 7441, 7441, 7442, 7443, 7444, 7445, 7445, 7446, 7447, 7448, 7449, 7450, 7451, 7452, 7452, 7453, 7454, 7454,
+        7454, 7454, 7454, 7455, 7455, 7455, 7455, 7455, 7455, 7455, 7456, 7457, 7457, 7458, 7459, 7459, 7459, 7459, 7460, 7460, 7460, 7460, 7461, 7461,
+        7462, 7462, 7463, 7464, 7465, 7466, 7466, 7468, 7468, 7468, 7468, 7468, 7468, 7468, 7469, 7469, 7470, 7471, 7472, 7473, 7474, 7474, 7475, 7475,
+        7475, 7476, 7476, 7477, 7478, 7479, 7479, 7480, 7480, 7481, 7482, 7483, 7484, 7485, 7485, 7485, 7485, 7485, 7485, 7485, 7485, 7486, 7486, 7486,
+        7486, 7486, 7486, 7486, 7486, 7486, 7486, 7486, 7486, 7486, 7486, 7487, 7488, 7489, 7489, 7490, 7491, 7491, 7491, 7491, 7492, 7493, 7494, 7495,
+        7496, 7497, 7498, 7499, 7500, 7501, 7502, 7503, 7504, 7504, 7505, 7506, 7507, 7509, 7510, 7511, 7512, 7514, 7515, 7516, 7517, 7520, 7521, 7521,
+        7522, 7523, 7523, 7524, 7525, 7525, 7526, 7527, 7528, 7529, 7530, 7531, 7532, 7533, 7534, 7535, 7536, 7537, 7538, 7539, 7540, 7541, 7542, 7542,
+        7543, 7544, 7545, 7546, 7547, 7548, 7549, 7550, 7552, 7553, 7554, 7554, 7555, 7556, 7557, 7558, 7559, 7560, 7561, 7562, 7563, 7564, 7565, 7566,
+        7567, 7568, 7569, 7570, 7572, 7573, 7575, 7576, 7577, 7578, 7579, 7580, 7581, 7584, 7585, 7586, 7586, 7586, 7587, 7588, 7589, 7590, 7591, 7593,
+        7594, 7595, 7596, 7597, 7598, 7598, 7599, 7600, 7601, 7602, 7603, 7604, 7605, 7606, 7607, 7608, 7609, 7610, 7611, 7615, 7616, 7616, 7617, 7617,
+        7619, 7620, 7621, 7622, 7623, 7627, 7627, 7628, 7630, 7631, 7632, 7633, 7634, 7635, 7636, 7637, 7640, 7641, 7642, 7643, 7644, 7645, 7646, 7647,
+        7648, 7649, 7650, 7651, 7652, 7653, 7654, 7655, 7657, 7658, 7659, 7663, 7664, 7666, 7667, 7668, 7669, 7670, 7671, 7672, 7673, 7674, 7675, 7676,
+        7677, 7678, 7678, 7679, 7680, 7681, 7682, 7683, 7683, 7684, 7685, 7686, 7686, 7690, 7691, 7692, 7692, 7693, 7694, 7695, 7696, 7697, 7698, 7699,
+        7700, 7701, 7701, 7702, 7702, 7703, 7703, 7704, 7705, 7706, 7707, 7707, 7708, 7709, 7710, 7710, 7710, 7710, 7710, 7710, 7711, 7712, 7713, 7713,
+        7714, 7715, 7716, 7717, 7718, 7719, 7719, 7720, 7720, 7721, 7722, 7723, 7723, 7723, 7724, 7725, 7726, 7727, 7728, 7729, 7730, 7731, 7732, 7732,
+        7733, 7733, 7734, 7735, 7735, 7735, 7735, 7735, 7736, 7736, 7737, 7738, 7739, 7740, 7741, 7742, 7742, 7742, 7742, 7742, 7742, 7743, 7743, 7744,
+        7745, 7746, 7746, 7747, 7748, 7749, 7750, 7751, 7752, 7752, 7753, 7754, 7755, 7755, 7755, 7756, 7757, 7757, 7758, 7759, 7760, 7761, 7762, 7763,
+        7763, 7764, 7765, 7765, 7766, 7767, 7768, 7768, 7769, 7769, 7770, 7771, 7772, 7773, 7774, 7775, 7776, 7777, 7778, 7779, 7780, 7780, 7780, 7781,
+        7781, 7781, 7781, 7781, 7781, 7782, 7783, 7784, 7785, 7786, 7787, 7788, 7788, 7789, 7790, 7790, 7791, 7792, 7792, 7792, 7793, 7794, 7795, 7797,
+        7798, 7799, 7800, 7800, 7800, 7801, 7801, 7802, 7802, 7803, 7803, 7804, 7805, 7806, 7807, 7807, 7808, 7809, 7810, 7811, 7811, 7811, 7812, 7813,
+        7813, 7813, 7814, 7815, 7816, 7817, 7818, 7818, 7818, 7818, 7818, 7818, 7818, 7819, 7819, 7819, 7820, 7821, 7822, 7822, 7822, 7822, 7823, 7823,
+        7823, 7824, 7825, 7825, 7825, 7825, 7825, 7825, 7825, 7825, 7825, 7826, 7827, 7827, 7828, 7828, 7829, 7829, 7829, 7829, 7830, 7831, 7832, 7833,
+        7834, 7835, 7835, 7836, 7837, 7838, 7839, 7839, 7839, 7840, 7840, 7840, 7841, 7841, 7841, 7841, 7841, 7842, 7843, 7844, 7845, 7846, 7847, 7848,
+        7849, 7850, 7850, 7851, 7852, 7852, 7853, 7853, 7854, 7855, 7856, 7856, 7856, 7857, 7858, 7859, 7861, 7863, 7865, 7865, 7865, 7865, 7865, 7867,
+        7868, 7869, 7870, 7871, 7872, 7873, 7873, 7873, 7873, 7873, 7873, 7873, 7873, 7873, 7875, 7876, 7876, 7877, 7878, 7879, 7880, 7881, 7881, 7886,
+        7887, 7887, 7887, 7888, 7889, 7890, 7891, 7891, 7892, 7893, 7893, 7894, 7895, 7895, 7896, 7897, 7898, 7899, 7900, 7901, 7902, 7903, 7904, 7904,
+        7904, 7905, 7906, 7907, 7908, 7909, 7910, 7911, 7912, 7913, 7914, 7915, 7916, 7917, 7918, 7919, 7919, 7920, 7921, 7921, 7922, 7923, 7924, 7925,
+        7926, 7927, 7928, 7929, 7930, 7933, 7934, 7935, 7936, 7937, 7939, 7940, 7941, 7942, 7943, 7944, 7945, 7946, 7947, 7948, 7949, 7950, 7951, 7952,
+        7953, 7954, 7955, 7956, 7957, 7958, 7959, 7960, 7960, 7961, 7963, 7964, 7965, 7968, 7969, 7970, 7971, 7972, 7973, 7975, 7976, 7977, 7978, 7979,
+        7980, 7981, 7982, 7983, 7984, 7985, 7986, 7987, 7987, 7988, 7989, 7990, 7991, 7992, 7993, 7994, 7995, 7996, 7997, 7998, 7999, 8000, 8001, 8002,
+        8003, 8004, 8005, 8006, 8007, 8008, 8009, 8010, 8011, 8011, 8012, 8013, 8014, 8015, 8016, 8017, 8018, 8019, 8020, 8021, 8022, 8024, 8025, 8026,
+        8027, 8028, 8030, 8031, 8032, 8032, 8033, 8034, 8035, 8036, 8038, 8039, 8040, 8041, 8041, 8042, 8043, 8043, 8044, 8045, 8046, 8047, 8048, 8049,
+        8050, 8051, 8052, 8053, 8054, 8056, 8057, 8057, 8058, 8059, 8060, 8061, 8062, 8063, 8064, 8065, 8066, 8067, 8068, 8069, 8070, 8071, 8072, 8073,
+        8074, 8075, 8076, 8077, 8078, 8078, 8079, 8080, 8081, 8081, 8081, 8082, 8083, 8084, 8085, 8086, 8087, 8088, 8089, 8089, 8089, 8091, 8092, 8093,
+        8094, 8095, 8096, 8097, 8098, 8099, 8100, 8101, 8102, 8103, 8104, 8105, 8106, 8107, 8107, 8107, 8107, 8107, 8107, 8107, 8107, 8107, 8107, 8107,
+        8107, 8107, 8107, 8108, 8109, 8110, 8110, 8110, 8110, 8111, 8111, 8112, 8112, 8112, 8113, 8114, 8115, 8115, 8115, 8115, 8115, 8116, 8117, 8118,
+        8118, 8118, 8119, 8120, 8121, 8121, 8121, 8122, 8123, 8123, 8124, 8125, 8125, 8126, 8127, 8127, 8128, 8129, 8129, 8129, 8130, 8131, 8132, 8133,
+        8134, 8134, 8134, 8134, 8134, 8135, 8136, 8136, 8137, 8138, 8139, 8139, 8139, 8139, 8139, 8140, 8141, 8142, 8143, 8144, 8144, 8144, 8145, 8146,
+        8146, 8146, 8146, 8146, 8146, 8146, 8146, 8146, 8148, 8149, 8150, 8153, 8154, 8154, 8154, 8155, 8156, 8157, 8157, 8158, 8158, 8159, 8160, 8161,
+        8162, 8164, 8164, 8164, 8165, 8166, 8167, 8167, 8168, 8168, 8169, 8170, 8171, 8171, 8171, 8172, 8173, 8174, 8175, 8175, 8176, 8177, 8178, 8179,
+        8181, 8183, 8185, 8185, 8185, 8186, 8186, 8186, 8187, 8188, 8189, 8189, 8189, 8189, 8189, 8189, 8190, 8190, 8191, 8191, 8192, 8193, 8195, 8196,
+        8197, 8198, 8199, 8200, 8200, 8200, 8200, 8200, 8200, 8201, 8202, 8202, 8203, 8203, 8204, 8204, 8205, 8206, 8207, 8207, 8208, 8210, 8211, 8212,
+        8213, 8213, 8213, 8213, 8214, 8216, 8217, 8217, 8218, 8218, 8218, 8218, 8219, 8220, 8221, 8222, 8222, 8222, 8223, 8224, 8224, 8225, 8227, 8228,
+        8228, 8229, 8229, 8230, 8231, 8231, 8232, 8233, 8233, 8234, 8235, 8235, 8236, 8237, 8237, 8237, 8238, 8239, 8240, 8241, 8243, 8243, 8244, 8244,
+        8245, 8246, 8247, 8248, 8248, 8249, 8252, 8254, 8255, 8256, 8257, 8258, 8258, 8259, 8260, 8260, 8261, 8262, 8263, 8264, 8265, 8266, 8266, 8267,
+        8268, 8269, 8270, 8271, 8272, 8273, 8274, 8275, 8276, 8277, 8278, 8279, 8280, 8281, 8282, 8283, 8283, 8284, 8285, 8286, 8287, 8288, 8289, 8289,
+        8290, 8291, 8292, 8293, 8294, 8295, 8295, 8296, 8297, 8298, 8299, 8300, 8301, 8302, 8303, 8305, 8305, 8306, 8307, 8308, 8309, 8310, 8310, 8311,
+        8312, 8313, 8314, 8315, 8316, 8317, 8318, 8319, 8320, 8320, 8320, 8321, 8322, 8323, 8324, 8325, 8326, 8327, 8327, 8328, 8329, 8330, 8330, 8337,
+        8338, 8339, 8340, 8341, 8342, 8343, 8344, 8345, 8346, 8347, 8348, 8349, 8350, 8351, 8351, 8352, 8353, 8354, 8355, 8356, 8357, 8358, 8359, 8360,
+        8360, 8361, 8362, 8362, 8363, 8364, 8365, 8366, 8368, 8369, 8370, 8371, 8372, 8375, 8376, 8377, 8378, 8379, 8380, 8381, 8382, 8383, 8384, 8385,
+        8386, 8387, 8388, 8389, 8390, 8391, 8392, 8393, 8394, 8395, 8396, 8397, 8398, 8399, 8400, 8401, 8402, 8403, 8404, 8405, 8405, 8406, 8406, 8407,
+        8408, 8409, 8409, 8410, 8411, 8412, 8412, 8413, 8414, 8415, 8416, 8417, 8418, 8419, 8420, 8421, 8422, 8423, 8424, 8425, 8426, 8427, 8427, 8427,
+        8427, 8428, 8429, 8430, 8431, 8431, 8431, 8432, 8433, 8434, 8435, 8436, 8436, 8437, 8438, 8439, 8441, 8442, 8443, 8443, 8444, 8444, 8445, 8446,
+        8447, 8448, 8449, 8450, 8451, 8451, 8451, 8452, 8452, 8452, 8453, 8454, 8454, 8455, 8456, 8457, 8458, 8459, 8460, 8461, 8462, 8462, 8463, 8464,
+        8465, 8466, 8467, 8468, 8469, 8470, 8470, 8471, 8472, 8473, 8474, 8475, 8476, 8476, 8477, 8478, 8478, 8478, 8479, 8479, 8480, 8480, 8481, 8481,
+        8482, 8483, 8484, 8484, 8485, 8486, 8487, 8488, 8488, 8490, 8491, 8492, 8493, 8494, 8495, 8496, 8497, 8498, 8499, 8500, 8500, 8501, 8502, 8503,
+        8504, 8504, 8504, 8505, 8506, 8507, 8508, 8508, 8508, 8509, 8509, 8510, 8511, 8512, 8512, 8513, 8514, 8515, 8516, 8517, 8518, 8519, 8520, 8521,
+        8521, 8522, 8523, 8524, 8525, 8525, 8526, 8527, 8527, 8528, 8529, 8530, 8531, 8532, 8533, 8537, 8538, 8539, 8540, 8541, 8542, 8543, 8544, 8545,
+        8547, 8548, 8549, 8550, 8551, 8552, 8553, 8554, 8555, 8556, 8557, 8558, 8559, 8560, 8560, 8561, 8562, 8563, 8564, 8564, 8565, 8566, 8567, 8568,
+        8569, 8570, 8571, 8572, 8573, 8573, 8574, 8575, 8576, 8576, 8577, 8578, 8579, 8580, 8581, 8582, 8583, 8584, 8585, 8586, 8587, 8588, 8589, 8590,
+        8591, 8591, 8592, 8593, 8594, 8595, 8596, 8597, 8597, 8598, 8599, 8600, 8601, 8602, 8603, 8604, 8605, 8606, 8607, 8609, 8610, 8611, 8612, 8613,
+        8614, 8615, 8615, 8616, 8616, 8617, 8618, 8619, 8620, 8621, 8622, 8623, 8624, 8625, 8626, 8627, 8628, 8629, 8630, 8631, 8632, 8635, 8636, 8637,
+        8639, 8640, 8644, 8646, 8647, 8648, 8649, 8650, 8651, 8652, 8653, 8654, 8655, 8656, 8657, 8658, 8658, 8659, 8660, 8661, 8662, 8663, 8663, 8664,
+        8665, 8666, 8667, 8668, 8669, 8669, 8670, 8671, 8672, 8673, 8674, 8675, 8677, 8677, 8678, 8679, 8680, 8681, 8682, 8683, 8684, 8685, 8686, 8687,
+        8688, 8689, 8690, 8691, 8692, 8693, 8694, 8694, 8694, 8695, 8695, 8695, 8696, 8697, 8697, 8698, 8699, 8700, 8700, 8701, 8702, 8703, 8704, 8705,
+        8706, 8707, 8708, 8709, 8710, 8712, 8713, 8714, 8715, 8717, 8717, 8718, 8719, 8719, 8720, 8721, 8721, 8722, 8723, 8724, 8725, 8726, 8727, 8729,
+        8729, 8730, 8731, 8732, 8733, 8733, 8734, 8735, 8736, 8738, 8739, 8740, 8741, 8742, 8743, 8743, 8743, 8743, 8744, 8745, 8745, 8746, 8747, 8748,
+        8748, 8748, 8749, 8749, 8750, 8751, 8751, 8752, 8753, 8754, 8754, 8754, 8755, 8756, 8756, 8757, 8758, 8759, 8759, 8760, 8761, 8762, 8763, 8764,
+        8765, 8766, 8767, 8767, 8768, 8769, 8769, 8769, 8770, 8771, 8771, 8771, 8772, 8773, 8773, 8774, 8775, 8776, 8777, 8778, 8779, 8780, 8781, 8782,
+        8782, 8782, 8782, 8783, 8784, 8786, 8787, 8788, 8788, 8788, 8789, 8790, 8791, 8792, 8793, 8794, 8795, 8796, 8797, 8798, 8799, 8800, 8801, 8802,
+        8803, 8804, 8805, 8806, 8807, 8808, 8809, 8810, 8811, 8812, 8813, 8814, 8815, 8816, 8817, 8818, 8819, 8820, 8820, 8821, 8822, 8823, 8825, 8826,
+        8827, 8827, 8828, 8829, 8830, 8831, 8832, 8833, 8834, 8835, 8836, 8837, 8838, 8838, 8839, 8840, 8841, 8842, 8843, 8844, 8845, 8848, 8849, 8850,
+        8852, 8853, 8854, 8855, 8856, 8856, 8857, 8858, 8859, 8860, 8861, 8862, 8863, 8864, 8865, 8865, 8866, 8867, 8868, 8869, 8870, 8871, 8872, 8873,
+        8874, 8875, 8876, 8877, 8878, 8879, 8880, 8881, 8882, 8883, 8884, 8885, 8886, 8886, 8887, 8888, 8889, 8890, 8890, 8891, 8892, 8893, 8894, 8895,
+        8896, 8897, 8897, 8898, 8899, 8900, 8900, 8901, 8902, 8903, 8904, 8905, 8906, 8907, 8907, 8908, 8909, 8910, 8911, 8912, 8913, 8914, 8915, 8916,
+        8917, 8918, 8919, 8920, 8921, 8922, 8923, 8924, 8925, 8926, 8927, 8928, 8929, 8929, 8930, 8931, 8931, 8931, 8932, 8933, 8934, 8935, 8935, 8936,
+        8938, 8939, 8939, 8939, 8940, 8941, 8942, 8943, 8944, 8945, 8946, 8947, 8947, 8948, 8948, 8949, 8950, 8950, 8951, 8952, 8953, 8954, 8955, 8955,
+        8956, 8957, 8958, 8958, 8959, 8960, 8961, 8961, 8961, 8961, 8961, 8962, 8963, 8963, 8964, 8965, 8966, 8967, 8968, 8968, 8968, 8969, 8970, 8971,
+        8972, 8973, 8974, 8975, 8976, 8977, 8978, 8979, 8980, 8981, 8982, 8983, 8984, 8985, 8986, 8987, 8987, 8988, 8988, 8989, 8990, 8991, 8991, 8991,
+        8991, 8992, 8994, 8995, 8996, 8997, 8998, 8999, 9000, 9001, 9002, 9003, 9003, 9003, 9003, 9003, 9004, 9006, 9007, 9008, 9009, 9009, 9010, 9011,
+        9013, 9015, 9016, 9017, 9018, 9019, 9020, 9021, 9022, 9023, 9024, 9025, 9027, 9028, 9029, 9030, 9031, 9032, 9033, 9034, 9035, 9036, 9037, 9038,
+        9039, 9040, 9041, 9042, 9042, 9043, 9044, 9045, 9046, 9047, 9048, 9048, 9049, 9050, 9050, 9051, 9052, 9052, 9053, 9054, 9055, 9056, 9056, 9056,
+        9057, 9057, 9057, 9058, 9059, 9060, 9060, 9061, 9062, 9063, 9064, 9065, 9066, 9066, 9067, 9067, 9068, 9069, 9070, 9071, 9071, 9072, 9073, 9074,
+        9075, 9076, 9077, 9078, 9079, 9080, 9081, 9082, 9083, 9084, 9085, 9086, 9087, 9088, 9089, 9090, 9091, 9092, 9092, 9093, 9094, 9095, 9096, 9097,
+        9098, 9099, 9100, 9101, 9101, 9102, 9102, 9103, 9104, 9104, 9105, 9106, 9107, 9108, 9109, 9110, 9111, 9112, 9113, 9114, 9115, 9116, 9117, 9118,
+        9119, 9120, 9121, 9122, 9123, 9124, 9125, 9126, 9127, 9128, 9128, 9129, 9130, 9131, 9132, 9133, 9134, 9134, 9135, 9136, 9137, 9138, 9139, 9142,
+        9143, 9144, 9146, 9147, 9147, 9148, 9149, 9150, 9150, 9151, 9151, 9152, 9153, 9154, 9155, 9156, 9157, 9158, 9158, 9159, 9160, 9161, 9162, 9163,
+        9163, 9164, 9165, 9166, 9167, 9168, 9169, 9169, 9173, 9174, 9175, 9176, 9177, 9178, 9179, 9180, 9181, 9182, 9182, 9183, 9184, 9185, 9186, 9187,
+        9188, 9189, 9190, 9191, 9192, 9193, 9194, 9195, 9196, 9197, 9198, 9199, 9200, 9201, 9202, 9204, 9205, 9206, 9207, 9208, 9209, 9210, 9211, 9212,
+        9213, 9213, 9214, 9215, 9216, 9216, 9216, 9217, 9219, 9220, 9221, 9222, 9223, 9223, 9224, 9224, 9225, 9226, 9227, 9227, 9228, 9229, 9230, 9231,
+        9232, 9233, 9234, 9235, 9236, 9237, 9238, 9238, 9239, 9240, 9241, 9242, 9242, 9244, 9245, 9246, 9247, 9247, 9248, 9249, 9250, 9251, 9252, 9254,
+        9255, 9256, 9257, 9258, 9259, 9260, 9261, 9262, 9263, 9264, 9265, 9266, 9267, 9268, 9269, 9270, 9271, 9273, 9274, 9275, 9275, 9276, 9277, 9278,
+        9279, 9280, 9280, 9281, 9282, 9282, 9283, 9283, 9284, 9285, 9285, 9286, 9287, 9288, 9289, 9290, 9291, 9292, 9293, 9294, 9295, 9296, 9297, 9297,
+        9298, 9299, 9300, 9301, 9302, 9303, 9304, 9305, 9306, 9307, 9308, 9309, 9310, 9311, 9312, 9313, 9314, 9315, 9316, 9317, 9318, 9319, 9320, 9320,
+        9321, 9321, 9322, 9323, 9324, 9325, 9325, 9325, 9326, 9326, 9327, 9328, 9329, 9330, 9330, 9331, 9332, 9333, 9334, 9334, 9335, 9335, 9336, 9337,
+        9338, 9339, 9339, 9340, 9341, 9342, 9343, 9344, 9345, 9346, 9348, 9348, 9349, 9349, 9349, 9350, 9351, 9352, 9352, 9353, 9354, 9355, 9355, 9355,
+        9356, 9357, 9357, 9357, 9358, 9359, 9360, 9361, 9362, 9363, 9364, 9364, 9365, 9366, 9367, 9368, 9368, 9368, 9369, 9369, 9370, 9370, 9371, 9373,
+        9374, 9375, 9376, 9376, 9377, 9378, 9378, 9379, 9379, 9380, 9381, 9382, 9382, 9383, 9385, 9386, 9387, 9388, 9389, 9390, 9391, 9392, 9393, 9393,
+        9393, 9394, 9395, 9395, 9396, 9397, 9398, 9398, 9399, 9399, 9399, 9400, 9401, 9402, 9403, 9404, 9405, 9406, 9407, 9408, 9408, 9409, 9410, 9411,
+        9412, 9413, 9414, 9415, 9416, 9417, 9418, 9419, 9419, 9420, 9421, 9422, 9423, 9424, 9424, 9425, 9426, 9428, 9429, 9430, 9431, 9432, 9433, 9434,
+        9434, 9435, 9435, 9435, 9435, 9436, 9437, 9438, 9439, 9439, 9440, 9440, 9441, 9442, 9443, 9444, 9445, 9446, 9446, 9447, 9447, 9448, 9448, 9449,
+        9449, 9449, 9450, 9451, 9452, 9453, 9454, 9455, 9455, 9456, 9457, 9458, 9459, 9460, 9460, 9461, 9462, 9463, 9466, 9466, 9467, 9468, 9469, 9470,
+        9471, 9472, 9473, 9475, 9476, 9476, 9477, 9478, 9479, 9480, 9481, 9481, 9482, 9482, 9483, 9484, 9484, 9485, 9486, 9487, 9488, 9489, 9490, 9492,
+        9492, 9493, 9494, 9495, 9496, 9497, 9497, 9497, 9497, 9498, 9499, 9500, 9500, 9501, 9502, 9502, 9503, 9504, 9504, 9505, 9506, 9506, 9507, 9508,
+        9509, 9510, 9511, 9512, 9512, 9513, 9513, 9513, 9514, 9515, 9515, 9516, 9516, 9516, 9517, 9518, 9519, 9519, 9520, 9520, 9520, 9521, 9522, 9522,
+        9523, 9523, 9524, 9524, 9525, 9525, 9526, 9527, 9528, 9529, 9530, 9531, 9531, 9532, 9533, 9534, 9534, 9535, 9536, 9537, 9538, 9539, 9539, 9539,
+        9540, 9541, 9542, 9543, 9544, 9545, 9545, 9545, 9546, 9547, 9548, 9549, 9550, 9551, 9552, 9553, 9554, 9555, 9556, 9557, 9557, 9558, 9559, 9560,
+        9561, 9562, 9563, 9564, 9565, 9566, 9567, 9568, 9569, 9570, 9570, 9570, 9571, 9572, 9572, 9572, 9573, 9574, 9575, 9575, 9576, 9577, 9578, 9579,
+        9580, 9581, 9582, 9582, 9583, 9584, 9585, 9585, 9585, 9585, 9586, 9587, 9588, 9589, 9590, 9591, 9592, 9593, 9596, 9596, 9597, 9598, 9599, 9600,
+        9601, 9602, 9603, 9604, 9604, 9605, 9606, 9607, 9608, 9609, 9610, 9611, 9611, 9612, 9613, 9614, 9615, 9616, 9617, 9617, 9618, 9619, 9620, 9621,
+        9622, 9623, 9623, 9624, 9624, 9625, 9626, 9627, 9627, 9628, 9628, 9628, 9629, 9629, 9629, 9630, 9631, 9632, 9632, 9632, 9632, 9633, 9634, 9634,
+        9635, 9636, 9636, 9636, 9636, 9636, 9637, 9638, 9638, 9639, 9640, 9641, 9642, 9643, 9643, 9644, 9644, 9644, 9645, 9646, 9647, 9648, 9649, 9649,
+        9650, 9651, 9651, 9652, 9653, 9654, 9655, 9656, 9656, 9657, 9658, 9659, 9659, 9659, 9660, 9660, 9661, 9662, 9663, 9664, 9665, 9665, 9665, 9666,
+        9667, 9668, 9669, 9670, 9671, 9672, 9672, 9673, 9674, 9675, 9676, 9677, 9678, 9679, 9680, 9681, 9681, 9682, 9683, 9683, 9684, 9685, 9686, 9688,
+        9688, 9689, 9689, 9689, 9690, 9691, 9692, 9693, 9694, 9695, 9696, 9697, 9698, 9699, 9699, 9700, 9701, 9701, 9701, 9702, 9703, 9704, 9705, 9705,
+        9705, 9706, 9707, 9708, 9709, 9709, 9709, 9710, 9711, 9712, 9712, 9712, 9713, 9713, 9713, 9714, 9714, 9715, 9716, 9717, 9718, 9719, 9720, 9721,
+        9722, 9723, 9724, 9724, 9724, 9725, 9725, 9725, 9726, 9727, 9728, 9728, 9729, 9729, 9730, 9730, 9730, 9730, 9730, 9731, 9732, 9733, 9734, 9734,
+        9735, 9736, 9737, 9738, 9738, 9739, 9740, 9741, 9741, 9742, 9742, 9743, 9743, 9744, 9745, 9746, 9746, 9747, 9748, 9748, 9749, 9750, 9751, 9752,
+        9752, 9753, 9754, 9755, 9756, 9757, 9757, 9758, 9758, 9759, 9760, 9760, 9760, 9760, 9761, 9761, 9762, 9763, 9763, 9763, 9764, 9765, 9766, 9767,
+        9768, 9769, 9770, 9771, 9772, 9773, 9774, 9774, 9774, 9775, 9776, 9777, 9777, 9777, 9778, 9778, 9779, 9780, 9781, 9782, 9783, 9783, 9784, 9785,
+        9786, 9787, 9788, 9789, 9790, 9791, 9792, 9792, 9792, 9793, 9794, 9794, 9794, 9794, 9794, 9794, 9795, 9795, 9795, 9796, 9796, 9797, 9798, 9799,
+        9800, 9801, 9802, 9803, 9803, 9804, 9805, 9805, 9806, 9807, 9807, 9807, 9808, 9809, 9810, 9810, 9811, 9812, 9813, 9814, 9814, 9815, 9816, 9817,
+        9818, 9819, 9820, 9820, 9820, 9820, 9820, 9821, 9822, 9823, 9824, 9825, 9825, 9826, 9826, 9826, 9827, 9828, 9828, 9828, 9828, 9828, 9829, 9830,
+        9831, 9831, 9832, 9833, 9833, 9833, 9834, 9834, 9835, 9836, 9836, 9837, 9837, 9837, 9838, 9838, 9838, 9839, 9839, 9840, 9841, 9841, 9842, 9843,
+        9843, 9844, 9845, 9846, 9846, 9846, 9847, 9847, 9848, 9849, 9850, 9851, 9852, 9853, 9853,
+    };
+
+    inline constexpr std::uint16_t NodeValue[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
+        0, 0, 6, 0, 0, 0, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0,
+        0, 0, 0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 13, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 14, 0, 0, 0, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 0, 0, 0, 0,
+        0, 0, 17, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 18, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 19, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 20, 0,
+        0, 0, 0, 0, 0, 21, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 22, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0, 0, 24, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 25, 0, 0, 26, 0, 0, 27, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 28, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 29, 0, 0, 0, 0, 0, 0, 0, 0, 30,
+        0, 0, 0, 0, 7, 0, 0, 0, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 32, 0, 0, 0, 0, 0, 0, 0, 33, 0, 0, 0, 0, 0, 0, 0, 34, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 35, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 36, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 37, 0, 0, 0, 0, 0, 0, 0, 38, 0, 0, 0, 0, 10, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 39, 0, 0, 40, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 41, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 42, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 43, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 44, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 45, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 46, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 47, 0, 0, 0, 0, 48, 0, 0, 0, 49, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 50, 0, 0, 51, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 52, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 53, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 54, 55, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 56, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 57,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0,
+        58, 59, 0, 0, 0, 60, 0, 0, 0, 0, 0, 0, 0, 61, 0, 0, 0, 62, 0, 0, 0, 63, 0, 0,
+        0, 0, 0, 64, 0, 65, 0, 0, 0, 0, 0, 0, 0, 0, 0, 66, 67, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 68, 0, 0, 0, 0, 0, 0, 0, 0, 0, 69, 70, 0, 71, 0, 0, 0, 0, 53,
+        0, 0, 0, 0, 0, 0, 72, 5, 0, 0, 0, 73, 0, 74, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 75, 76, 0, 0, 77, 78, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 79, 0, 80, 0, 0, 0, 0,
+        0, 81, 0, 82, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 83, 0, 8, 0, 0, 0, 0, 84, 0,
+        0, 0, 0, 0, 0, 0, 0, 85, 0, 86, 87, 0, 0, 0, 0, 0, 0, 0, 0, 88, 89, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 90, 0, 0, 91, 0, 0, 0, 0, 0, 0, 92, 0, 93, 94, 0, 0, 95,
+        0, 0, 0, 0, 0, 0, 0, 96, 0, 0, 0, 97, 0, 0, 0, 98, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 99, 0, 100, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 101, 0,
+        0, 102, 103, 104, 0, 0, 0, 0, 0, 0, 0, 0, 105, 106, 107, 0, 0, 0, 16, 0, 0, 0, 0, 0,
+        108, 0, 17, 109, 0, 0, 0, 0, 0, 110, 0, 0, 0, 0, 0, 0, 0, 0, 111, 112, 0, 0, 0, 0,
+        0, 0, 0, 0, 113, 0, 0, 0, 114, 115, 0, 0, 0, 0, 0, 0, 116, 117, 0, 0, 118, 119, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 120, 0, 121, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 122, 0, 0, 123, 0, 124, 0, 0, 0, 125, 0, 0, 0, 0, 0, 126,
+        0, 0, 127, 0, 0, 0, 0, 0, 0, 0, 128, 129, 0, 0, 0, 0, 0, 0, 130, 0, 0, 0, 131, 0,
+        0, 0, 0, 132, 133, 0, 0, 134, 0, 135, 0, 0, 0, 0, 0, 0, 3, 136, 0, 0, 0, 0, 137, 0,
+        0, 0, 0, 0, 0, 0, 0, 138, 0, 139, 0, 0, 0, 0, 0, 140, 0, 0, 141, 0, 0, 0, 0, 0,
+        0, 0, 0, 142, 0, 0, 0, 0, 0, 0, 0, 0, 143, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 144, 0, 0, 0, 145, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 146, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 147,
+        148, 0, 0, 149, 150, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 64, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 151, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 152, 0, 0, 0, 24, 0, 0, 0, 153, 0, 0, 53, 0, 0, 154, 0, 0, 0,
+        0, 0, 0, 0, 155, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 156, 0, 0, 157, 0, 158, 0, 0, 159, 160, 0, 0, 0, 0, 161, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 162, 28, 163, 0, 0, 0,
+        0, 0, 0, 164, 0, 0, 0, 0, 165, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 166,
+        0, 0, 167, 0, 0, 168, 0, 169, 30, 0, 0, 170, 0, 0, 0, 171, 6, 0, 0, 172, 173, 174, 175, 0,
+        176, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 177, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 178, 0, 0,
+        179, 180, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 181, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 182, 0, 183, 184, 0, 0, 0, 0, 0, 0, 0, 185, 186, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 187, 0, 0, 0, 0, 0, 0, 188, 0, 0, 189, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 190, 0, 0, 0, 0, 0, 0, 191, 37, 0, 0, 192, 0, 0, 0, 0, 0, 0, 193, 194, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 195, 0, 196, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 197,
+        0, 0, 0, 0, 0, 0, 198, 0, 0, 0, 92, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 199, 0, 0, 200, 0, 0, 0, 201, 0, 0, 202, 203, 0, 204, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 205, 206, 0, 0, 207, 208, 0, 0, 0, 0, 0, 0, 0, 209, 0, 0,
+        0, 0, 0, 210, 0, 0, 0, 0, 0, 0, 211, 0, 0, 0, 0, 0, 0, 0, 0, 212, 213, 214, 0, 0,
+        0, 215, 0, 0, 0, 0, 216, 0, 42, 0, 0, 217, 0, 0, 218, 0, 0, 0, 0, 219, 0, 0, 0, 43,
+        0, 0, 0, 0, 220, 0, 0, 0, 0, 0, 0, 221, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 222, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 223, 0, 0, 0, 0, 0, 0, 0, 224, 0, 0, 225, 0, 226, 0, 0, 0, 0, 0, 227, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 228, 0, 229, 230, 0, 0, 0, 231, 0, 0, 0, 0, 0, 232, 0, 233, 234,
+        0, 0, 235, 0, 0, 0, 0, 0, 236, 237, 0, 0, 0, 0, 238, 0, 0, 0, 0, 0, 239, 0, 0, 240,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 241, 0, 242, 0, 0, 0, 0, 0, 0, 106, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 243, 0, 0, 0, 0,
+        0, 0, 16, 0, 0, 244, 0, 245, 0, 0, 0, 0, 0, 0, 246, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 110, 0, 0, 0, 0, 0, 0, 0, 0, 247, 0, 0, 0, 248, 0, 0, 0, 0, 0,
+        0, 0, 249, 0, 0, 0, 250, 0, 0, 0, 0, 251, 0, 0, 0, 0, 0, 52, 0, 252, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 253, 0, 0, 254, 0, 0, 0, 0, 0, 0, 0, 255, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 256, 0, 0, 0, 0, 0, 0, 0, 0, 0, 114, 0, 257, 258, 259, 260, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 261, 0, 0, 0, 262, 0, 0, 263, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 264, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 265, 0, 0, 0, 0, 266, 0, 0, 0, 0, 0, 0,
+        0, 53, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 267, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 268, 0, 46, 0, 0, 0, 0, 0, 269, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 270, 0, 0, 0, 0, 0, 0, 0, 271, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 272, 57, 273, 0, 0, 0, 0, 274, 0, 0, 275, 0,
+        0, 0, 276, 0, 0, 0, 0, 277, 0, 278, 0, 0, 279, 0, 0, 0, 0, 280, 0, 281, 282, 0, 0, 61,
+        0, 283, 0, 0, 0, 284, 285, 0, 286, 0, 287, 64, 0, 0, 0, 0, 0, 0, 0, 288, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 289, 0, 0, 0, 290, 0, 0, 291, 292, 293, 0, 294, 0, 0, 0, 0, 0, 0, 295,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 296, 0, 0, 0, 297, 298, 0, 0, 0, 0, 0, 299, 0, 0, 0,
+        300, 301, 76, 0, 0, 0, 302, 0, 0, 303, 304, 0, 0, 0, 0, 305, 306, 0, 307, 0, 0, 0, 0, 308,
+        0, 309, 0, 0, 0, 310, 0, 311, 0, 312, 313, 0, 0, 0, 0, 0, 0, 0, 0, 314, 315, 316, 0, 0,
+        85, 0, 317, 318, 0, 0, 319, 320, 0, 0, 321, 322, 323, 0, 0, 324, 0, 325, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 326, 0, 327, 0, 0, 0,
+        0, 328, 329, 330, 0, 0, 0, 0, 0, 0, 0, 0, 331, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 332, 0, 0, 0, 333, 0, 0, 0, 0, 0, 334, 0, 335, 0, 0, 0, 101, 0,
+        0, 0, 0, 0, 336, 0, 0, 0, 0, 337, 106, 338, 339, 0, 0, 340, 341, 0, 0, 0, 0, 0, 342, 0,
+        0, 343, 0, 0, 344, 0, 0, 0, 0, 0, 0, 0, 0, 345, 346, 0, 347, 348, 0, 0, 0, 0, 0, 349,
+        0, 0, 350, 0, 0, 0, 0, 0, 0, 0, 351, 0, 352, 0, 0, 353, 0, 0, 0, 354, 0, 0, 0, 0,
+        0, 0, 355, 0, 0, 0, 0, 0, 0, 0, 356, 0, 0, 357, 0, 122, 0, 358, 0, 0, 359, 0, 0, 360,
+        361, 0, 0, 0, 362, 363, 364, 365, 366, 367, 368, 0, 0, 369, 370, 371, 372, 0, 0, 373, 0, 374, 375, 376,
+        0, 0, 377, 378, 379, 0, 0, 0, 0, 0, 0, 0, 380, 0, 381, 382, 0, 0, 0, 0, 0, 0, 0, 383,
+        0, 384, 385, 0, 386, 387, 0, 0, 141, 0, 0, 388, 0, 0, 0, 0, 0, 0, 389, 0, 0, 0, 0, 0,
+        0, 0, 390, 391, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 392, 393, 0, 0, 0, 0, 0, 0, 394, 0, 0, 0, 0, 0, 0, 0, 0, 395, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 396, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 397, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 398, 0, 399, 0, 400, 0, 0, 401, 0, 402, 0, 0, 0, 0, 0, 0, 0, 0, 403, 0,
+        0, 0, 0, 0, 0, 0, 404, 405, 0, 147, 0, 406, 0, 407, 408, 0, 0, 409, 0, 0, 0, 0, 0, 0,
+        410, 0, 0, 411, 0, 0, 412, 0, 64, 0, 0, 0, 413, 414, 0, 415, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 416, 0, 0, 0, 0, 0, 0, 0, 0, 0, 417, 418, 0, 0, 419, 420, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 421, 0, 0, 0, 0, 0, 0, 422, 0, 0, 0, 423, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 424, 425, 426, 0, 0, 427, 0, 0, 0, 0, 428, 0, 0, 429, 0, 0, 0, 430,
+        431, 0, 432, 0, 0, 0, 0, 0, 0, 0, 0, 433, 434, 0, 435, 436, 0, 0, 437, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 438, 0, 439, 163, 440, 441, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 442,
+        0, 0, 443, 444, 0, 445, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 446, 0, 0, 0, 0, 447, 29, 0,
+        0, 0, 448, 0, 0, 449, 450, 0, 176, 0, 0, 451, 0, 452, 453, 0, 0, 454, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 455, 179, 0, 456, 0, 0, 457, 0, 0, 458, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 459, 0, 460, 0, 0, 0, 0, 0, 461, 462, 463, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 464,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 465, 0, 466, 467, 0, 0, 468, 34, 0, 0, 0, 0, 0, 0, 182,
+        0, 0, 469, 470, 0, 0, 0, 0, 0, 471, 472, 473, 474, 0, 475, 0, 0, 476, 0, 0, 0, 0, 477, 0,
+        0, 478, 479, 0, 0, 0, 0, 0, 0, 0, 0, 480, 0, 0, 0, 0, 0, 0, 0, 0, 0, 481, 482, 0,
+        0, 0, 483, 0, 0, 0, 0, 0, 36, 0, 0, 0, 484, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        485, 0, 0, 0, 0, 0, 0, 486, 0, 196, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 487, 0, 0, 0,
+        0, 0, 488, 489, 0, 0, 0, 0, 0, 0, 490, 491, 0, 0, 492, 0, 0, 493, 0, 0, 0, 0, 0, 0,
+        0, 494, 0, 0, 0, 0, 0, 495, 0, 199, 496, 497, 0, 0, 0, 0, 0, 0, 498, 0, 0, 0, 0, 499,
+        500, 0, 0, 501, 502, 0, 0, 0, 503, 0, 504, 0, 0, 0, 0, 0, 505, 506, 0, 0, 0, 0, 210, 0,
+        507, 0, 0, 0, 508, 0, 0, 0, 0, 0, 0, 0, 0, 0, 214, 0, 0, 509, 0, 215, 0, 0, 0, 510,
+        511, 0, 0, 512, 0, 218, 0, 0, 513, 0, 0, 0, 514, 515, 0, 0, 516, 0, 0, 0, 0, 0, 517, 0,
+        0, 0, 0, 0, 0, 518, 519, 0, 520, 0, 0, 0, 0, 521, 0, 0, 0, 0, 522, 0, 0, 0, 523, 0,
+        524, 0, 0, 0, 0, 0, 525, 0, 526, 527, 0, 0, 528, 529, 0, 0, 0, 0, 0, 0, 0, 0, 0, 530,
+        531, 532, 0, 0, 533, 534, 0, 0, 0, 535, 0, 0, 536, 0, 0, 0, 0, 0, 0, 0, 537, 0, 538, 539,
+        0, 0, 0, 0, 229, 230, 0, 540, 0, 541, 0, 542, 0, 0, 232, 0, 234, 0, 0, 0, 543, 0, 0, 0,
+        145, 0, 544, 0, 0, 0, 0, 0, 545, 0, 0, 0, 0, 0, 0, 0, 0, 0, 546, 547, 548, 0, 49, 0,
+        0, 0, 0, 0, 0, 549, 0, 0, 550, 0, 0, 0, 551, 0, 0, 0, 552, 0, 553, 554, 0, 555, 0, 0,
+        0, 106, 0, 556, 0, 0, 557, 558, 0, 0, 0, 559, 0, 0, 0, 560, 561, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 562, 563, 0, 0, 564, 17, 0, 0, 0, 565, 0,
+        0, 0, 0, 566, 0, 567, 0, 0, 0, 0, 0, 0, 0, 0, 0, 568, 0, 0, 569, 0, 0, 0, 0, 570,
+        571, 0, 0, 0, 572, 0, 0, 0, 0, 0, 0, 573, 0, 0, 0, 0, 574, 0, 0, 0, 0, 575, 0, 0,
+        0, 0, 0, 250, 576, 0, 0, 0, 577, 0, 0, 0, 578, 0, 0, 0, 579, 0, 580, 0, 581, 0, 0, 0,
+        0, 0, 0, 0, 0, 204, 0, 582, 0, 0, 583, 0, 584, 0, 233, 0, 0, 0, 0, 0, 585, 0, 586, 0,
+        0, 0, 587, 0, 0, 0, 588, 0, 589, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 0, 0, 0, 0, 0,
+        590, 257, 258, 259, 591, 0, 0, 592, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 593, 0,
+        594, 0, 0, 595, 0, 0, 0, 0, 0, 0, 0, 596, 0, 597, 598, 599, 0, 0, 600, 0, 601, 0, 0, 0,
+        0, 602, 0, 0, 0, 0, 0, 603, 604, 0, 0, 0, 0, 605, 606, 0, 607, 0, 0, 608, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 609, 0, 0, 0, 0, 610, 0, 0, 0, 0, 0, 0, 0, 611, 0,
+        0, 612, 0, 0, 267, 0, 613, 614, 0, 0, 0, 0, 0, 0, 0, 0, 0, 615, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 616, 0, 0, 0, 617, 0, 0, 618, 0, 0, 0, 0, 0, 0, 0, 619, 0, 620, 621, 0,
+        622, 0, 0, 0, 0, 0, 623, 624, 0, 625, 0, 0, 0, 0, 626, 0, 0, 0, 124, 0, 0, 627, 0, 628,
+        629, 630, 631, 274, 0, 0, 632, 0, 633, 634, 0, 635, 636, 637, 278, 638, 0, 279, 639, 640, 641, 642, 0, 281,
+        0, 643, 0, 0, 0, 0, 644, 0, 0, 0, 0, 0, 645, 646, 0, 0, 0, 0, 0, 0, 647, 0, 0, 0,
+        0, 0, 0, 648, 0, 0, 0, 649, 0, 650, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 651,
+        0, 297, 652, 0, 653, 0, 0, 654, 0, 655, 0, 0, 0, 0, 0, 0, 0, 656, 0, 0, 0, 657, 0, 0,
+        658, 659, 0, 0, 0, 0, 0, 660, 661, 312, 662, 663, 0, 0, 0, 0, 0, 664, 0, 665, 666, 0, 667, 668,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 669, 670, 671, 333, 0, 672, 673, 226,
+        0, 0, 674, 675, 0, 0, 0, 0, 0, 0, 0, 0, 676, 0, 0, 677, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 678, 0, 0, 0, 0, 679, 0, 0, 0, 0, 0,
+        0, 0, 349, 680, 681, 0, 0, 0, 682, 0, 0, 252, 0, 0, 0, 0, 0, 683, 0, 684, 0, 354, 0, 685,
+        686, 0, 0, 622, 0, 687, 0, 0, 0, 145, 0, 0, 0, 0, 0, 0, 688, 0, 689, 690, 0, 0, 0, 0,
+        0, 691, 692, 693, 694, 0, 0, 0, 695, 0, 377, 378, 379, 696, 0, 697, 698, 699, 700, 0, 0, 137, 0, 701,
+        0, 0, 281, 0, 702, 0, 0, 386, 22, 0, 703, 0, 704, 0, 0, 0, 0, 0, 0, 0, 705, 706, 0, 0,
+        707, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 708, 709, 710, 711, 712,
+        0, 0, 0, 713, 714, 715, 716, 717, 718, 719, 720, 721, 722, 723, 724, 725, 726, 727, 728, 729, 730, 0, 731, 732,
+        733, 734, 735, 736, 737, 738, 0, 0, 0, 739, 740, 741, 742, 743, 744, 745, 746, 747, 748, 0, 644, 749, 750, 751,
+        752, 0, 0, 753, 754, 0, 0, 0, 0, 0, 0, 0, 755, 658, 756, 0, 757, 758, 759, 0, 405, 0, 0, 760,
+        0, 0, 0, 0, 0, 0, 761, 0, 762, 0, 763, 0, 0, 0, 0, 0, 0, 0, 764, 765, 766, 767, 768, 0,
+        769, 770, 0, 0, 0, 0, 0, 771, 0, 0, 0, 0, 772, 0, 773, 774, 0, 775, 0, 0, 0, 776, 0, 777,
+        0, 0, 778, 0, 779, 0, 0, 780, 781, 0, 782, 0, 783, 154, 0, 0, 0, 0, 784, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 785, 786, 787, 788, 0, 0, 789, 790, 0, 0, 431, 0, 791, 792, 0, 0, 0,
+        793, 794, 0, 0, 0, 0, 795, 0, 796, 0, 797, 0, 0, 439, 0, 0, 0, 798, 0, 0, 799, 800, 784, 801,
+        0, 0, 0, 0, 0, 802, 0, 803, 804, 805, 806, 0, 807, 0, 456, 0, 808, 0, 0, 0, 0, 0, 809, 0,
+        0, 0, 0, 0, 0, 810, 811, 0, 812, 0, 0, 813, 0, 814, 0, 0, 815, 0, 175, 816, 817, 818, 819, 820,
+        821, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 822, 823, 0, 0, 0, 0, 0, 824, 0,
+        0, 0, 0, 0, 0, 0, 0, 825, 461, 463, 826, 0, 598, 0, 827, 828, 829, 8, 0, 0, 830, 831, 0, 832,
+        0, 0, 0, 0, 0, 0, 0, 833, 834, 835, 836, 0, 837, 0, 34, 0, 838, 839, 840, 0, 841, 842, 0, 0,
+        0, 843, 0, 844, 0, 0, 0, 0, 845, 0, 478, 846, 0, 0, 0, 0, 0, 0, 0, 0, 847, 848, 849, 0,
+        0, 850, 0, 0, 0, 851, 852, 0, 0, 0, 0, 0, 0, 0, 0, 0, 853, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 854, 855, 0, 856, 857, 0, 0, 858, 0, 0, 0, 195, 859, 860, 861, 862, 0, 0, 0, 0, 863, 0,
+        0, 0, 0, 0, 0, 864, 0, 865, 0, 866, 0, 867, 868, 869, 0, 0, 870, 871, 0, 0, 0, 0, 0, 872,
+        873, 0, 0, 0, 874, 0, 0, 0, 0, 875, 0, 498, 0, 0, 876, 877, 0, 0, 0, 0, 0, 0, 878, 0,
+        0, 0, 0, 0, 70, 0, 879, 880, 0, 881, 0, 882, 0, 0, 0, 883, 0, 884, 885, 0, 886, 0, 887, 0,
+        0, 888, 0, 213, 0, 889, 890, 891, 892, 893, 894, 0, 0, 217, 0, 219, 895, 896, 0, 897, 0, 0, 0, 898,
+        0, 0, 0, 899, 0, 0, 220, 0, 900, 901, 0, 0, 0, 902, 0, 0, 0, 903, 0, 514, 516, 0, 0, 904,
+        905, 0, 221, 0, 906, 907, 0, 908, 0, 0, 909, 0, 0, 0, 0, 0, 0, 0, 0, 910, 911, 0, 912, 0,
+        0, 913, 532, 914, 0, 0, 915, 916, 917, 918, 919, 920, 0, 921, 922, 923, 0, 0, 924, 925, 926, 541, 0, 0,
+        0, 927, 928, 0, 929, 0, 0, 930, 0, 0, 0, 0, 0, 931, 0, 0, 0, 0, 932, 0, 0, 0, 933, 48,
+        0, 0, 0, 547, 934, 0, 0, 0, 0, 0, 0, 0, 935, 0, 936, 0, 0, 0, 0, 0, 937, 0, 0, 0,
+        0, 0, 938, 0, 939, 0, 940, 0, 346, 0, 941, 942, 0, 560, 0, 943, 0, 944, 0, 0, 0, 0, 0, 0,
+        945, 0, 946, 0, 947, 948, 0, 0, 949, 0, 0, 0, 950, 0, 951, 0, 0, 0, 342, 0, 0, 952, 953, 0,
+        0, 0, 0, 0, 0, 0, 0, 954, 955, 0, 956, 957, 958, 959, 960, 0, 0, 0, 0, 961, 0, 962, 0, 0,
+        0, 963, 964, 0, 0, 0, 965, 0, 966, 0, 967, 968, 0, 0, 969, 970, 971, 972, 0, 973, 0, 0, 0, 974,
+        0, 975, 0, 0, 0, 976, 0, 0, 0, 579, 977, 978, 979, 0, 0, 479, 0, 0, 0, 980, 981, 0, 0, 0,
+        982, 0, 983, 0, 984, 0, 0, 985, 0, 0, 0, 0, 561, 0, 0, 0, 986, 0, 199, 0, 0, 0, 987, 988,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 989, 990, 0, 0,
+        0, 0, 0, 991, 0, 992, 0, 0, 593, 0, 0, 0, 0, 0, 0, 993, 0, 0, 0, 0, 0, 22, 0, 596,
+        994, 597, 0, 0, 0, 0, 0, 0, 680, 0, 0, 0, 0, 995, 0, 0, 996, 0, 997, 0, 998, 999, 0, 608,
+        1000, 0, 1001, 0, 1002, 1003, 1004, 1005, 0, 0, 1006, 1007, 1008, 0, 0, 0, 1009, 356, 0, 0, 0, 0, 1010, 1011,
+        1012, 0, 1013, 1014, 0, 1015, 1016, 0, 0, 0, 0, 0, 238, 0, 0, 0, 0, 0, 0, 0, 1017, 0, 1018, 0,
+        0, 1019, 1020, 1021, 551, 1022, 0, 0, 0, 0, 0, 1023, 0, 136, 0, 0, 0, 1024, 1025, 1026, 1027, 1028, 1029, 1030,
+        0, 0, 1031, 1032, 0, 0, 1033, 0, 1034, 1035, 0, 0, 0, 0, 638, 1036, 639, 0, 1037, 643, 0, 1038, 0, 0,
+        402, 1039, 0, 0, 1040, 645, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1041, 0, 1042, 0, 0, 0, 1043, 0, 1044,
+        1045, 0, 0, 0, 1046, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1047, 651, 1048, 652, 0, 0,
+        0, 0, 0, 0, 801, 0, 0, 0, 1049, 0, 1050, 1051, 1052, 0, 1053, 0, 0, 1054, 0, 0, 661, 662, 0, 0,
+        0, 0, 0, 1055, 1056, 1057, 1058, 1059, 0, 1060, 1061, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 1062, 0, 0, 0, 0, 0, 0, 1063, 0, 0, 0, 1064, 1065, 1066, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 669, 671, 1067, 672, 0, 0, 674, 675, 1068, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1069, 1070, 1071, 1072, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1073, 1074, 1075, 1076, 1077, 0, 0, 0, 0, 0, 255,
+        0, 0, 0, 113, 0, 0, 0, 0, 115, 1078, 1079, 0, 0, 0, 0, 0, 0, 0, 1080, 683, 0, 1081, 1082, 685,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1083, 1084, 359, 0, 0, 1085, 693, 1086, 1087, 0, 695,
+        1088, 696, 0, 1089, 0, 1090, 0, 0, 1091, 0, 1092, 22, 0, 0, 703, 0, 0, 0, 0, 0, 1093, 1094, 0, 0,
+        1095, 0, 0, 286, 0, 621, 0, 622, 0, 0, 0, 0, 0, 0, 0, 124, 0, 947, 0, 0, 0, 0, 145, 1096,
+        1097, 0, 0, 0, 1098, 749, 0, 401, 754, 1099, 1100, 0, 1101, 1102, 1103, 1104, 757, 0, 0, 0, 0, 409, 0, 0,
+        0, 1105, 0, 0, 1037, 0, 1106, 1107, 0, 0, 0, 536, 1108, 1109, 0, 0, 1110, 0, 0, 1111, 1112, 1113, 1114, 0,
+        0, 0, 0, 772, 0, 0, 1115, 1116, 1117, 0, 1118, 0, 0, 0, 1119, 0, 0, 154, 0, 1120, 1121, 1122, 1123, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 1124, 1125, 1126, 0, 0, 790, 1127, 1128, 1129, 792, 1130, 0, 1131, 0, 794, 1132,
+        1133, 1134, 0, 430, 0, 0, 1135, 1136, 0, 0, 0, 0, 0, 1137, 1138, 1139, 1049, 0, 456, 1140, 808, 1141, 1142, 1143,
+        1144, 1145, 809, 1146, 1147, 1148, 1149, 1150, 1151, 1152, 1153, 1154, 0, 1155, 0, 1156, 0, 1157, 0, 0, 1158, 821, 0, 0,
+        0, 453, 0, 1159, 309, 1160, 0, 1161, 0, 500, 1162, 0, 0, 1163, 0, 0, 1164, 458, 1165, 1166, 420, 825, 826, 553,
+        1167, 0, 0, 1168, 0, 830, 1169, 0, 0, 0, 0, 835, 0, 1170, 1171, 1172, 1173, 1174, 1175, 1176, 1177, 0, 327, 1178,
+        477, 0, 1179, 1180, 1181, 1182, 0, 1183, 1184, 481, 492, 0, 0, 1185, 1186, 706, 0, 0, 0, 0, 0, 0, 0, 0,
+        1187, 0, 1188, 0, 0, 0, 0, 0, 0, 1189, 1190, 1191, 0, 1192, 1193, 1194, 0, 0, 0, 0, 0, 0, 1195, 0,
+        1196, 1197, 0, 1198, 0, 1199, 1200, 965, 1201, 1202, 1203, 1204, 0, 1205, 0, 0, 0, 0, 200, 0, 0, 0, 1206, 1207,
+        0, 140, 1208, 876, 1209, 1210, 0, 39, 1211, 20, 0, 0, 0, 0, 1212, 1213, 1214, 0, 0, 1215, 1216, 1217, 0, 1218,
+        0, 1219, 599, 1220, 0, 0, 0, 0, 0, 1221, 1222, 0, 0, 0, 0, 0, 0, 0, 0, 1223, 0, 1224, 0, 1225,
+        1226, 0, 1227, 1228, 0, 0, 903, 0, 0, 0, 0, 0, 908, 0, 1229, 1230, 1231, 1232, 0, 1233, 0, 1234, 0, 1235,
+        0, 1236, 913, 1237, 1238, 917, 0, 0, 1239, 0, 1240, 0, 927, 928, 1241, 0, 0, 1242, 1243, 1244, 1245, 0, 329, 0,
+        458, 0, 458, 0, 0, 1246, 1247, 48, 0, 0, 0, 0, 0, 240, 0, 0, 0, 0, 336, 1248, 0, 0, 0, 551,
+        1249, 1250, 1251, 0, 0, 0, 1252, 1253, 0, 559, 1254, 0, 1255, 1256, 1257, 1258, 0, 1259, 1260, 0, 562, 571, 0, 0,
+        1261, 1262, 0, 951, 0, 0, 1263, 1264, 1265, 0, 0, 0, 0, 0, 0, 0, 1266, 0, 1267, 0, 1268, 0, 1269, 962,
+        1270, 1271, 0, 0, 1272, 1273, 1274, 1275, 0, 1276, 0, 601, 0, 811, 1277, 0, 0, 1278, 1278, 1279, 0, 0, 0, 1280,
+        0, 1281, 1282, 1283, 0, 1284, 1285, 1286, 0, 1287, 0, 255, 585, 974, 980, 348, 0, 1288, 0, 0, 0, 0, 256, 0,
+        0, 1289, 1290, 1291, 0, 0, 248, 0, 0, 0, 0, 1292, 0, 0, 0, 0, 0, 0, 0, 260, 0, 0, 1293, 1294,
+        1295, 1296, 0, 1297, 1298, 1299, 1300, 1301, 1302, 0, 0, 1303, 0, 0, 1304, 252, 1305, 0, 1306, 1307, 1308, 0, 1309, 0,
+        1310, 0, 0, 0, 0, 1311, 0, 998, 1312, 1313, 1314, 1002, 1315, 0, 1316, 0, 0, 0, 0, 0, 1317, 0, 1318, 1319,
+        0, 1320, 0, 0, 0, 544, 0, 566, 0, 0, 0, 0, 0, 1321, 1322, 616, 1323, 1324, 1325, 1326, 0, 1327, 1328, 54,
+        55, 1329, 1330, 1331, 1332, 692, 1034, 1333, 1334, 131, 0, 0, 0, 1095, 0, 0, 66, 1335, 405, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 421, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 264, 0,
+        0, 34, 0, 0, 1336, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 556, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 776, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1337, 1338, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 219, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1339, 0, 921, 0,
+        0, 0, 0, 0, 0, 550, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 607, 0, 0, 0, 0, 0, 605, 0, 0, 0, 1340, 0, 0, 0, 697, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 1341, 0, 1342, 0, 1043, 0, 0, 0, 0, 399, 0, 0, 0, 1095, 1343, 997, 1024, 1030, 0, 0, 0, 986, 0,
+        0, 0, 0, 0, 0, 1344, 0, 932, 0, 0, 0, 1345, 1346, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1347, 0,
+        1037, 0, 0, 1348, 1349, 1350, 1351, 0, 1352, 0, 0, 0, 0, 0, 0, 940, 1044, 789, 1353, 421, 0, 1153, 0, 0,
+        0, 1246, 0, 0, 0, 0, 0, 0, 1354, 0, 0, 0, 437, 1129, 0, 0, 1355, 0, 0, 0, 0, 0, 0, 1356,
+        0, 0, 1357, 0, 0, 0, 31, 0, 1358, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 834, 1359, 0, 1360,
+        1361, 1362, 1363, 1364, 0, 0, 0, 0, 0, 0, 0, 1365, 0, 0, 871, 0, 0, 38, 491, 0, 0, 0, 0, 0,
+        0, 0, 1366, 197, 0, 1367, 0, 1368, 0, 497, 0, 0, 0, 0, 1369, 0, 0, 0, 0, 209, 881, 0, 0, 886,
+        1220, 0, 0, 0, 0, 0, 897, 1370, 1371, 898, 1372, 1373, 0, 1374, 517, 0, 0, 0, 1375, 1376, 1020, 0, 518, 1021,
+        0, 0, 1377, 1378, 1379, 912, 1380, 1381, 541, 1382, 0, 0, 1383, 0, 1384, 0, 1385, 1386, 1387, 0, 0, 0, 0, 0,
+        0, 937, 0, 0, 0, 0, 1388, 1136, 0, 1389, 1390, 0, 1391, 1392, 1393, 343, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 1394, 0, 0, 1395, 0, 973, 0, 0, 0, 1396, 1397, 0, 0, 0, 0, 0, 0, 1398, 1399, 1400, 1401, 0, 0,
+        0, 0, 0, 0, 0, 969, 1402, 1403, 1404, 1405, 1406, 1407, 1408, 0, 0, 992, 0, 0, 0, 0, 0, 1409, 0, 0,
+        1410, 1411, 0, 0, 0, 0, 607, 0, 0, 610, 0, 0, 1412, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1413, 1414,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1415, 0, 0, 784, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 181, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 1416, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 41, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 520, 0, 0, 0, 0, 0, 0, 0, 0, 543, 0, 0, 49, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 1017, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 51, 0, 0, 0, 42, 260, 0, 0, 0, 0, 0, 0, 0, 0, 1417, 1197, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1418, 1419, 1420, 1421, 1422, 1423, 1424, 1425, 1426, 1427, 139,
+        1428, 705, 0, 0, 0, 1094, 1429, 1329, 0, 1331, 0, 1332, 692, 0, 0, 0, 1209, 1305, 1430, 1431, 0, 0, 0, 16,
+        45, 0, 0, 0, 1432, 761, 0, 0, 1433, 0, 0, 773, 0, 0, 1434, 0, 0, 429, 1210, 0, 0, 0, 0, 0,
+        677, 1435, 1436, 794, 0, 0, 1437, 0, 0, 0, 1438, 170, 1439, 450, 0, 0, 0, 0, 0, 1276, 1296, 0, 0, 316,
+        8, 1440, 375, 1169, 1441, 1442, 1443, 0, 0, 0, 0, 0, 192, 1444, 0, 0, 0, 1121, 0, 486, 0, 0, 0, 0,
+        0, 1124, 1445, 0, 0, 0, 1446, 0, 878, 0, 0, 0, 331, 1447, 0, 0, 0, 0, 1448, 0, 0, 0, 0, 0,
+        0, 0, 1449, 233, 0, 1450, 1451, 0, 0, 0, 549, 1248, 1452, 1453, 1454, 0, 1455, 0, 17, 0, 0, 0, 0, 0,
+        0, 0, 0, 1456, 1457, 1458, 974, 204, 0, 0, 1459, 0, 984, 0, 985, 0, 0, 0, 589, 0, 0, 0, 0, 0,
+        574, 1275, 592, 0, 0, 0, 1303, 0, 252, 1460, 612, 0, 0, 0, 0, 1461, 1462, 0, 0, 1315, 0, 0, 0, 1317,
+        0, 1173, 0, 0, 1278, 0, 0, 1303, 0, 0, 974, 0, 0, 876, 534, 0, 0, 0, 0, 0, 798, 0, 1108, 0,
+        0, 0, 0, 53, 0, 0, 0, 0, 0, 0, 0, 419, 0, 0, 1463, 0, 0, 0, 0, 0, 0, 417, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 754, 0, 0, 0, 0, 0, 0, 479, 0,
+        0, 0, 0, 0, 0, 1190, 0, 0, 0, 0, 0, 0, 0, 0, 0, 475, 0, 0, 0, 0, 0, 491, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 329, 39, 0, 0, 0, 0, 0, 0, 0, 1464, 0, 0, 0, 1220, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1020, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1465,
+        0, 0, 48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1302, 0, 1304, 0, 0,
+        0, 595, 0, 0, 0, 1009, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1098, 751, 1330,
+        0, 0, 0, 0, 876, 760, 0, 0, 0, 0, 0, 289, 0, 0, 0, 0, 0, 0, 970, 0, 419, 0, 0, 0,
+        0, 0, 0, 0, 167, 169, 0, 455, 1161, 0, 0, 479, 0, 0, 0, 0, 0, 0, 0, 0, 191, 0, 0, 0,
+        0, 0, 0, 0, 0, 495, 0, 0, 0, 0, 0, 0, 509, 0, 0, 513, 516, 0, 514, 0, 905, 0, 907, 0,
+        0, 0, 445, 0, 0, 0, 0, 338, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1283, 0, 0, 0, 0,
+        588, 988, 0, 0, 0, 0, 591, 990, 0, 1302, 0, 0, 0, 602, 0, 0, 0, 0, 0, 0, 0, 0, 0, 551,
+        0, 0, 0, 0, 286, 0, 0, 925, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 439, 0, 0, 0, 0, 303, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 33, 0, 0, 0, 327, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        855, 0, 0, 0, 0, 0, 0, 843, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 897, 0, 215, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 647, 0, 0, 0, 0, 0, 561, 0, 0,
+        0, 0, 0, 0, 1264, 0, 0, 0, 0, 0, 0, 0, 556, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 1466, 579, 0, 22, 1467, 0, 0, 1468, 0, 0, 0, 1446, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 530, 0, 0, 410, 0, 0, 774, 0, 0, 0, 0, 0, 0, 0, 158,
+        0, 0, 0, 0, 166, 0, 0, 0, 0, 0, 0, 0, 0, 0, 188, 187, 1194, 0, 0, 623, 0, 0, 0, 1469,
+        1470, 0, 893, 0, 0, 894, 0, 0, 0, 904, 906, 0, 0, 548, 0, 0, 0, 561, 0, 0, 0, 0, 0, 0,
+        0, 0, 1266, 0, 0, 1286, 1287, 0, 0, 987, 573, 0, 0, 989, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1014,
+        797, 794, 0, 0, 0, 0, 0, 1239, 1241, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 955, 0, 0, 0, 0, 0, 0,
+        31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 851, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 38, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1471, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 504, 0, 0, 0, 0, 220, 0, 0, 0, 0, 0, 0,
+        0, 221, 0, 0, 0, 1021, 0, 0, 0, 0, 0, 0, 0, 594, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 953, 0, 0, 939, 1472, 0, 0, 0, 0, 1107, 0, 0,
+        0, 983, 589, 0, 0, 0, 0, 0, 0, 0, 0, 615, 0, 613, 0, 0, 204, 0, 0, 0, 0, 0, 707, 0,
+        0, 0, 585, 0, 0, 0, 531, 914, 769, 770, 0, 0, 782, 0, 0, 0, 0, 0, 160, 300, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 900, 0, 901, 0, 0, 0, 934, 936, 308,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 544, 966, 968, 22, 0, 0, 0, 0, 0, 615, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 1473, 0, 0, 0, 0, 0, 0, 1469, 0, 0, 25, 0, 0, 30, 0, 0, 0, 0, 453, 309, 0,
+        402, 621, 0, 0, 0, 846, 0, 0, 0, 0, 0, 0, 1470, 0, 1019, 0, 0, 0, 0, 1003, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1219, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 1215, 0, 218, 0, 0, 895, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 551, 0, 0, 0, 0, 0, 0, 950, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 1474, 0, 0, 0, 607, 0, 984, 0, 0, 0, 0, 0, 0, 0, 389, 0, 0, 0, 0, 0, 616,
+        0, 0, 0, 0, 0, 0, 488, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 25, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        799, 0, 0, 0, 427, 494, 0, 0, 0, 0, 0, 0, 1324, 0, 1326, 0, 0, 0, 21, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 649, 0, 0, 0, 0, 605, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1475, 0, 0, 0, 0,
+        0, 1476, 0, 0, 36, 0, 1029, 0, 0, 1028, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 888, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 903, 0,
+        209, 0, 0, 0, 0, 82, 240, 0, 937, 0, 0, 0, 0, 943, 0, 0, 0, 0, 200, 0, 1022, 0, 0, 0,
+        0, 1004, 0, 0, 0, 0, 0, 0, 0, 0, 248, 0, 969, 592, 0, 0, 0, 1001, 0, 0, 0, 55, 1159, 0,
+        0, 1033, 1013, 0, 0, 0, 0, 0, 0, 0, 1120, 0, 0, 0, 0, 791, 1180, 0, 1183, 0, 855, 0, 0, 0,
+        0, 0, 1029, 0, 0, 1181, 0, 1090, 0, 0, 0, 896, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 233, 974,
+        0, 0, 572, 0, 0, 0, 1003, 0, 1323, 1325, 0, 0, 0, 0, 0, 0, 0, 0, 0, 155, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 1016, 0, 0, 0, 0, 0, 854, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1477,
+        0, 396, 32, 35, 0, 0, 0, 0, 780, 0, 457, 0, 0, 0, 0, 0, 0, 179, 0, 192, 0, 1032, 0, 1031,
+        992, 0, 0, 0, 0, 0, 0, 10, 0, 0, 0, 0, 0, 523, 0, 0, 0, 0, 524, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 905, 0, 0, 0, 0, 0, 514, 0, 869, 0, 0, 42, 0, 0, 0, 0, 0, 0, 0, 1478,
+        0, 0, 0, 0, 0, 1479, 419, 479, 0, 0, 0, 985, 0, 0, 411, 0, 0, 912, 0, 0, 1480, 0, 0, 0,
+        0, 0, 0, 1110, 0, 1038, 778, 0, 0, 1256, 0, 857, 457, 0, 0, 0, 1202, 0, 1032, 1257, 0, 0, 516, 0,
+        902, 0, 1259, 0, 953, 0, 0, 0, 0, 0, 0, 872, 0, 0, 0, 1004, 0, 0, 0, 0, 0, 962, 536, 0,
+        0, 0, 0, 0, 0, 417, 475, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 952, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 1481, 1482, 0, 0, 1483, 1484, 0, 0, 0, 973, 0, 0, 0, 0, 0,
+        0, 0, 214, 0, 0, 0, 889, 882, 896, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1485, 0, 0, 0, 0, 0,
+        0, 0, 0, 1486, 0, 0, 0, 0, 0, 0, 0, 781, 0, 0, 0, 0, 0, 0, 561, 0, 0, 0, 0, 0,
+        0, 886, 0, 1025, 0, 0, 0, 919, 0, 1114, 780, 0, 854, 864, 0, 0, 0, 890, 891, 1221, 0, 0, 954, 0,
+        0, 945, 1270, 797, 963, 0, 0, 1019, 0, 0, 0, 0, 0, 378, 0, 817, 994, 0, 0, 0, 0, 0, 556, 0,
+        0, 787, 0, 0, 0, 0, 0, 1487, 0, 0, 0, 169, 29, 0, 477, 0, 0, 0, 0, 0, 1488, 191, 0, 0,
+        0, 0, 0, 0, 0, 210, 0, 0, 0, 0, 0, 0, 0, 0, 0, 517, 0, 0, 902, 0, 0, 0, 0, 518,
+        0, 1489, 907, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1490, 0, 0, 1491, 1492, 0, 0, 0, 0, 1493, 1000,
+        0, 0, 0, 0, 926, 781, 0, 0, 0, 1227, 952, 0, 961, 325, 0, 1022, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 613, 233, 0, 1494, 1495, 0, 0, 0, 1496, 0, 170, 0, 862, 1497, 1498, 872, 0, 0, 0, 0, 1480, 0,
+        0, 0, 0, 503, 0, 0, 0, 513, 0, 1499, 0, 898, 0, 0, 0, 1500, 0, 0, 883, 0, 0, 0, 0, 559,
+        0, 0, 0, 0, 0, 1501, 0, 1286, 0, 0, 1502, 786, 873, 0, 865, 0, 0, 955, 341, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 1503, 1504, 0, 0, 0, 1027, 1026, 0, 1480, 0, 0, 0, 0, 0, 1505, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 934, 865, 0, 0, 959, 1506, 1507, 963, 982, 0, 966, 964, 0, 1027, 0, 0, 0, 0,
+        0, 0, 0, 1028, 0, 0, 1508, 0, 0, 864, 1480, 0, 0, 0, 213, 0, 0, 0, 0, 1509, 0, 0, 0, 0,
+        0, 0, 954, 1287, 822, 4, 0, 0, 0, 0, 0, 179, 0, 1031, 1510, 0, 0, 7, 516, 509, 1221, 0, 0, 0,
+        1375, 0, 0, 852, 788, 0, 951, 0, 0, 1042, 0, 585, 1480, 0, 1224, 1227, 0, 1228, 0, 0, 777, 0, 0, 1376,
+        0, 0, 0, 1511, 1434, 0, 1026, 0, 0, 0, 0, 0, 0, 1428,
+    };
+
+    inline constexpr char EdgeChars[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyzEMabcfglmnop"
+        "rstuaceforsuHOacdefhilorsuDJSZacefiosNTacdfglmopqstuxcfiosJTabcd"
+        "fgorstAacfiosuEJOacdfgmnostucfosuHJacfosJTaceflmostacefiosuJacef"
+        "ostuEacdfgmoprstuvacfhilorsUfosBEacefhiorsuHOacfhimoqstuHRSacfhi"
+        "orsabcdfgmnoprstuDbcdefosvcefosfiosAIUacfosuHacdefosabcefglmnopr"
+        "stuwNabcdefiklnoprsuacdefhilorstuwyAHabcdefhijlorstuwzDacdefglmn"
+        "opqrstuxacefijlnoprsEabcdefgijlnorstvAabcefkosyacefgijmnopqstucf"
+        "mosuacfghjosABEHabcdefghjlmnoprstuvDacdefhilnopsuGLRVabcdefghijl"
+        "moprstuvwSacdefghilmoprstuvacefhilmorsufiopsuABHabcdefhilmnoprst"
+        "uxabcdefhilmopqrstuwzabcdefhioprswAHabcdfghlmoprstuwABDacdeflnop"
+        "rszcefoprscdfhilmnorsuvwacefiosuacdefhioswlPcriyrrpadgppicsimcry"
+        "crtrpecmcPcpyaeioodnrirolnpuocp;occcgrsaylrafptuwctGHcaiyorreapg"
+        "psuciamipyrlprucc;mreiyor;pec;Rctirlprctmclcciyorr;aptvgptcikmiy"
+        "rpcekccpeyrpcc;cmnpraeyfsr;einpwcht;pydlrnpc;ccaeygswrBnptci;lci"
+        "ybrraeipe;climeryri;uip;eiociOrpcaGcnraey;vrogpuichlCcFc;aeiyrog"
+        "aprucabcmpOAHcbuaeyreilpictcrriybrradigpADETadpsicimaayaerrpcdid"
+        "rpcr;pccccciyrpcmccayortrpccr;Ediuyl;rrepapdggp;Eaeiopictyimcioc"
+        "rroyqcmprtrgaakoeoptwxrevceiolmcpraeiuodmnrceirulmnpaocuddelprvw"
+        "cilraglrsklay;aoglmiraaegsvcclptuwbccotdrahaciDocsaioyo;Dr;rs;il"
+        "sapsgsgpalscsuvDacdiahmrciplymilrllaltopraaoc;lcmpriyo;lqsr;gmc;"
+        "EajEaespaci;cdlqrenrilmraialrrsamoprcltbpc;iycxfrr;inolaop;cfotc"
+        "gptruci;ikmiyrapcekpeyrrccpcarta;gacegmnpqrtabraeuycqrs;fgqsilr;"
+        "Eabc;achtioEaesabnoptwzaachmtachiqt;cdhilqrrenDclproyaarocdncdpd"
+        "p;ct;lmgteltiDdbcnptsuaeouya;AadqsxrEestAap;svcAEadestiptaorAait"
+        "chimpqugilr;mDHadgilrsAan;csiyabioslcrortbmnacitaeipael;adiosvcl"
+        "oimbryrrimo;tvau;ipu;Eaceinosucinrnprcaeoartaacdenqrtabraeuyclqs"
+        "acgilraognsahmomabptapaachqhirl;cq;EaceinpsyoAacmstxracoygmaaeit"
+        "flpacsuacemtarbcmnpAanlruraeyolreikolmnepsraipchtioracrriyabhirr"
+        "abctalgpadhlsucitcdiramaraanryaelrrtsprtcuiidirp;;ecaiutrAa;Aaai"
+        "dptAacqpteeciynrcpccmcayoetrcgpcjni;uer;;ahc;oflnrillkvw;ana;fvr"
+        "pyYu;ilrdrntit;;ccsogitfrnsr;Ctyyygrhr;;t;cmff;DEbnrr;;urr;t;amc"
+        "tofiairm;lso;;lfArrymedr;t;farDe;r;bfirrpyiyur;t;acgl;eiofarlclr"
+        ";;frrcyypd;;fryubglrrd;ts;fdgfer;r;;il;ufryurd;atL;rBf;CDEGHLNPR"
+        "STVrliur;l;acgcfnralmlrt;;;snfcmdpr;T;frr;ugrrd;e;;hfngr;eHyTurd"
+        "r;;rmlftarr;sch;;esRDcy;;rd;;rtcndfprrurcer;l;aceoofroqeroeinrll"
+        "sr;s;bty;frarg;fr;fryyyur;;frlyur;toa;frue;;rt;i;afphcl;;adsv;el"
+        "mrszof;c;dsrnr;mllontkvwkn;uapsnahw;costuvwrcn13c;qtf;ttDHUVbdhm"
+        "ptuvivbrmmllpu;abcdseoprdrptipt;yc;;Ecefmsbompgifryrsrbpoapsa;bc"
+        "dosalrveeoncrrgerhaar;grt;tps;rm;ai;ioyorlf;empsbnkorrylroiranyg"
+        "otutrrl;to;a;dn;;dctp;pofruiioilaeiporrom;;lolseol;alil;iitinffa"
+        "krcswr;um;er;t;;qs;cdl;;ey;;;;p;qifvrmcioPuadelsrErrfidrrrrlc;ew"
+        "rtkfbraruhur;yc;;ainfticgtfeaid;celpyofaoernlclr;;tfrrcpd;;eyyfr"
+        "rrar;rumrbg;ur;aerrakrdib;auduht;;qs;cdgsso;;rlyroardu;p;qinrrgp"
+        "afliab;efrroa;rqr;mburciormauPidurEoret;skm;ss;;r;acduprlefrpta;"
+        ";vf;;vgaalug;Eiopupmprdnp;srroueii;;;qsi;rrra;d;yr;rr;fqsi;rdf;i"
+        "nrl;cerrgr;ceromiasbcpllgi;esaapaetnAetAtirreutr;slvtoii;na;a;tr"
+        "irn;cgcdnfrrur;efmgrl;rallmla;ast;cimpt;;vmnc;nsnfn;pu;cmEasdfpi"
+        "rr;c;tfirtstrrarreuimgurairrakrdib;aduhlt;so;r;vhgira;uinrraflir"
+        "orqr;burmiuuu;pru;drEasoi;trrtiwmt;orhyr;m;deglnprrlspdl;et;bfdr"
+        "auu;afrrtiaran;Edemnprsc;g123;Edehlmnpsrrwig;krd;tr;rtcnasrdeta;"
+        "bcfaidadempsterycrxhrrurcer;rlas;arlorrc;ofroauipornrrolirlnrrsg"
+        "eknprst;s;belbt;ruforrbpgrbge;farprpr;rrrrpsoflirrrclreduyr;;;yf"
+        "rylur;tta;yrfr;jgtvcvarn;yg;gd;s;euo;;e;e;;tteoici;lelkenrno;ots"
+        ";ar;;;e;voaroe;oqlABLRTa;otoc;veryn;lll;;;tne;li;;avic;;t;ckce;z"
+        ";oDE;g;tc;vriigrsn;;;dy;c;;cy;;ai;;;td;a;oiACDFRTUVarEFGLSTtoLRl"
+        "r;r;ouis;;;toiteier;ouolqxrueereiquie;dgtcavrar;C;sde;BPiMc;eeuo"
+        ";;;;rt;;toirt;dh;Dc;ctoictal;;r;;eeTreNEy;oieakSe;l;ot;oyvcavrrn"
+        "n;rwuerwr;lg;d;h;ha;iT;;sce;;;;;;;tc;;;;to;W;;;tvcegvshargn;l;;e"
+        "stptan;i;;og;pd;nt;cepsee;tgoutio;;eaiudptqtrpeeokk244ku;;oiLRlr"
+        ";DUduLRlr;HLRhlroLRlr;DUduiliLRlr;HLRhlrmea;i;e;bh;e;Eetnrauo;tn"
+        "soics;lt;e;k;;el;nicsna;fl;dn;o;srs;;e;etrrcrrauor;ryeeedntt;;et"
+        ";;vrcogrsathlr;osmndn;roa;qilqladharo;;;ot;frrg;rt;teo;co;tvotor"
+        "y1;;n;;ss;lvrlmalsvatr;t;;;;tcniligigg;gs;;l;vt123457ln;tavc;;lc"
+        "o;el;;p;qm;e;;el;rtaeproqeit;;s;lc;cw;ctioaarhlr;a;soletc;lvntia"
+        "grelph;drnoagrar;n;;ds;;Edsvdy;ch;;cyaie;;;;r;ir;tpad;dlo;bfhlps"
+        "ti;srkcesoil;;ohs;ahlrt;lco;eadegshoduk;rrrios;p;qmgrklmrar;umsa"
+        "n;;lrrriu;;eg;oo;rteerea;efsht;t;;;etemhuosios;;ul;;oip;t;hssat;"
+        ";dsrr;p;oig;hrhrtiams;qs;m;rrr;;rr;t;qs;smi;;ni;astiu;crrhiu;;r;"
+        "edru;Eesc;Ees;d;arpsr;s;;fr;;rrrmrhrat;;cha;;lgr;vr;rroerar;u;;p"
+        "srr;;o;o;s;de;r;lil;noi;e;aehck;abcdemstt;d;e;acense;pi;als;tme;"
+        "s;;m;eit;r;ir;;tcp;delo;abcfhlpstwiorkcesoil;;ho;;ips;hodu;t;nrr"
+        "sdgrkr;um;glru;;oee;eflhto;oeic;pilm;berhr;;ain;wpc;tao;q;E;Eela"
+        "rlha;e;sc;a;e;ppbpr;r;mlr;fis;o;duEelaeiu;acens;;;;;os;dsauEelei"
+        "urhrage;oi;eeakspines;;oi;o;meno;ilbiz;;yote;;t;yvcrarhvlrkroirn"
+        ";rwrs;hlarogi;td;fr;g;;vhrpaohir;hiuhrhaqia;ibp;pi;nnzcaer;t;;c;"
+        "irrrr;;t;umrr;uui;gt;c;;;;;to;r;;a;;;;ee;e;;;F;neldsu;qeaynl;nlr"
+        "ewC;eutude;par;n;inrtuerreierken;en;SV;o;Tisedle;del;ey;;rokoq;e"
+        ";e;nersi;e;;y;;leacnlnreolierperiqureliateieiLRkmnPenlidnaenpueu"
+        "iemfssevgubcplre;e;ce;;ouhesaraaiad;cr;elnlsACDFTUVaIteyyenl;DLR"
+        "U;Cetehst;;;nlf;Sp;EFTekec;e;ce;BP;P;oni;AonLRo;e;;lrchh;;e;enie"
+        "e;;;ey;;;;do;d;vh;r;rx;;eei;opriedb;;sy;ueprpolicailedwlst;;;;;i"
+        "me;;;;;;;;;;;;;;;;;;x;;;;;;;;num;;;;;;;;;;e;r;;;st;;qedcppt;;;nl"
+        ";;s;yr;mqeidi;u;e;tneotdr;;;;;r;;rcppt;revwna;;i;yrh;o;ne;e;yt;;"
+        "n;m;exnpr;dnuueroarnpk;;;;la;ern;n;etet;;sv34;l;o;co;nst;Dr;;;;t"
+        "eneg;g;;;;l;i234568354585688;;e;de;a;ts;r;;;;;;;rsprtlqsmnptyi;;"
+        "spnrr;teirhklne;;et;n;;;;ia;;e;ttlecro;;t;o;v;e;;;y;;vln;l;etna;"
+        "e;;fskplill;;;ek;lnl;;rahraeiha;tspoqtitr;;l;;nd;ttr;;;;;eair;se"
+        "trgt;n;d;o;;;rk;;esrsr;;han;sora;r;trt;bdsssm;arthh;e;;o;a;enl;d"
+        ";;k;o;vr;t;l;;;;;;ar;l;;;e;Edv;vll;ne;e;;cwt;eet;q;;bp;;e;e;;een"
+        "o;hrhiriri;;k;ore;;cd;;e;;;s;;;os;;;;ofphes;lm;tdlnt;fkvc;iou;ni"
+        "wi;;puqaesi;s;mliuo;lpern;e;l;e;t;;e;p;f;skplil;l;n;;ek;lnl;a;rn"
+        "a;tr;;lahlrstg;;t;;;;;seti;o;res;;tae;n;l;;mi;;;;k;orn;n;ymp;fvt"
+        ";;;;ur;spr;;yrs;s;s;es;esef;nef;g;tol;;urtmbppuqaesituoourl;;utm"
+        "bp;k;or;tnlc4f;svasp;m;;;bdtrre;gtnu;mi;k;ae;e;;c;te;;;np;;;onp;"
+        ";ornp;;;e;;l;;tspti;oogbpei;r;pr;;;;;EeEea;r;qph;;;;;;;se;;ps;ee"
+        ";enfr;;;u;;a;el;;ls;;taDDMPTiu;e;rur;h;;tde;aCDLRUVrefger;;;;tme"
+        "nib;nSV;r;;;r;tn;wu;;asaeb;;;;;e;;griuwogeiDTVcrgulesalr;fgfgei;"
+        "Stl;;;vGLekagCbmasaptstcehascedt;;;;nr;;;rarlnrett;;;;enreolerpe"
+        "rmal;;;;;oeipi;ISU;Edae;;;opaquiD;;i;;;aralwAlrwaein;;;ai;;;;d;;"
+        ";m;p;ab;r;;eq;nnsim;;gr;ev;n;c;tumurau;g;oqrv;;;use;;u;;;;u;;;;;"
+        "mvda;adn;ri;q;;mxt;;;lr;pa;;;;mqee;rn;;;w;rqv;da;o;;;;ousabrwro;"
+        ";;er;;;;;;r;e;;;;n;nt;;Dsang;;;;n;;;;;;;;;;;;;;;;;;n;o;o;tr;;els"
+        ";e;;;r;u;;oo;fg;;;;;;;;;nr;i;;rahd;t;;;;;;;;y;;;s;;;;m;;;;du;;;r"
+        "arrfgrn;o;ptgqrm;;;e;;;aofpgr;s;;e;e;;;;;;;t;aree;dlu;;e;;;;;u;;"
+        ";aria;;;xl;;;o;w;;;saria;;oabcabcl;t;q;;a;;mp;eetqt;g;;;;n;e;e;w"
+        ";;;;;sn;f;e;;;ae;;;;k;o;h;ir;;;monpr;pqim;;anr;;;;ntq;;y;;s;;;;m"
+        ";;a;;du;;r;er;;;raeiqhd;a;s;n;;;;rr;;;;n;w;u;;ia;;;sre;s;;;u;;;e"
+        ";e;;;;;h;ttsr;en;;;pr;pqim;btlbrts;en;;;;w;;;;;;oy;pi;;;a;;;k;l;"
+        "useu;d;;;;;;e;waonr;e;;e;iph;p;mssta;;;;;;;g;;;;;;;;;;;;;rns;lD;"
+        ";;ooilisrnIcCdi;nlooeoipeovth;Ao;ar;lrtmetEFGLSTStnar;lcltlolbno"
+        "h;AVaoeetohalasndrththfgpruere;;kralelttDET;EGLSTeertreerei;l;ce"
+        "Dues;iEUgriuwoeiDTVcrprawfgArnunqsttracullorraru;BDrir;rfg;lnt;e"
+        "abcdefgh;d;q;tgim;eek;;;;;sep;nsezui;s;sbp;;orrRSacdt;t;ee;;;;p;"
+        "psedrt;;;;;s;nts;raonpw;rst;;gl;lttdtt;lx;ose;q;iwwtheteslk;;v;;"
+        ";;;ropthet;rr;tg;;rcxtsho;;r;r;q;oepd;prgr;;st;;nrgnt;;;;;;e;;ri"
+        "a;;;e;;el;;;;;;;;sl;r;r;;;trlpqm;refi;;v;;l;;;;trrfguroc;ti;t;sd"
+        "r;;tlittt;;;;qerlpqm;;;;;;;;qe;rmpmr;es;;mlrr;ro;or;laitaeean;;c"
+        "hiittnumeltntl;ct;ntwfngADrweRTVtrwlydiiarrqurelipaHly;terewilTV"
+        "rtrenwecowtlEt;teoARtartthafsMTVesiupen;TseoqrqreliddsTetes;EFTc"
+        "yekn;sp;ESTolqplolbno;AVaoeetolrynthrctbpiu;EST;;Eecealdt;;cesao"
+        "rborthBLSTSh;;;;;;;;;;;;;leq;;;s;g;;eaa;;;;tkr;;sia;;ns;ru;go;ut"
+        ";;erwao;;;;te;iio;;;;xssqt;;at;;;;;;;;woate;;ort;h;arttw;;qwf;a;"
+        "ohr;;toht;lrdrqqe;;k;;oyr;;;;;o;s;opthieth;;;;;am;t;e;eep;qqoyr;"
+        ";;qqe;r;;;dlqr;;ei;rnw;o;no;tt;gt;sf;;useCy;t;oait;ntghrot;BU;ie"
+        "eTVr;lSeualyfulesalalu;IiCTfB;BRneee;AVrcgnVtr;aGqeE;wriAriaAtc;"
+        ";eheasne;Vti;rwuiuesalGLeerS;EdequiaDQ;et;lqlineuEewilTVrrenweco"
+        "wioeAAtrleseoaqliq;e;lEe;ekn;rworwoAtaieipSo;;;lnrn;;otrst;ecewi"
+        "i;w;rorsoat;;s;;ra;torahstx;rerioalr;ntnwto;wt;;o;a;q;qlr;xeon;w"
+        "oahtgeseli;qqph;;qxeo;;q;ooe;ifgolrsng;nnli;fs;soDQeclaoAARTLRtr"
+        "wiapgeceeoSm;mllS;alasndcLm;ooi;raigBecreotlVeo;Brrurq;rgrrgrrAe"
+        "dirtLgne;l;EFGLSTnaaaasndresEiuqstulllouthaual;amiqB;BLneee;rcgn"
+        "Vtr;ewdrrAoerernlualu;;q;;et;nwi;wrArnplapnegegw;ch;cc;lrtmern;s"
+        "nls;rranrraqi;;;rg;rei;;g;aw;awl;;ei;qxs;toraaate;ln;;si;;qx;xwf"
+        "gthwei;;;eeeoe;;nougkADGTlurrieeiAToncrAhVtecwqa;ESmlEt;teeipnmm"
+        "arg;rVtrcwoeecrarea;uohrohrrr;icnyeeStrdqureliHlnlt;tees;ESlabpu"
+        ";EST;EaldBuo;enandleluraegBecotlVeo;Bs;;rrrw;sts;;andauthA;u;rr;"
+        "eadca;due;llr;;;;ei;edolr;;eeoriduorrumohrfglr;r;lfg;;;anrrrriqe"
+        "ui;;;;nthat;fgqqlrnrtuorwcoriDrrrgefgrewAa;rteoVt;ul;qa;LqeE;;n;"
+        ";mec;haeoot;r;BEct;BroalawtowtoorukSTrsp;teulesalu;g;eE;asqlense"
+        "aqliqlEeabtselte;niiarf;rVtwoeecra;oor;e;Eeltela;ermor;reecop;ee"
+        "ifgsgwei;qwolopwopiewtotherrethiduoprrm;lsl;;etrath;q;qei;eobtai"
+        "utual;Iooh;thre;rlrVcreoaluleurqeasktccrwo;aqtoa;wt;l;Aw;awwomSp"
+        "hGsai;alasndmlrqtLuamgerlualu;q;rlei;;E;tblc;taeo;r;BEct;Brwwocq"
+        "t;E;;lsr;woa;;ew;;dlrfgth;esfg;;w;w;swogs;aw;t;ool;etlopwoooe;;o"
+        "q;err;t;;fgnulelst;bvdnwwtARto;rBoet;BcrrSalsa;u;;;eAkt;B;rruorr"
+        ";e;r;r;;wSpair;cclEt;tepe;ueeanelts;andau;e;sq;rikAccr;aqtoa;;;w"
+        "tu;Eq;io;wt;noeith;t;;th;n;;soa;r;;ww;q;e;w;sowwsn;qor;thtre;;ee"
+        "leet;;AriAwoawcoat;BeqrSslatreoa;;ar;;rrr;pacneea;qeE;;;BEarsltn"
+        "e;EeltelaQ;uiberkt;Bruorr;iaqusw;o;wfg;t;;t;;nrr;;;qn;ns;;;;wo;t"
+        "iIQC;e;;errgr;wr;trroa;ueq;;l;rtrrl;;ooaceSa;lurqaqlGs;Et;BEqt;E"
+        ";;luaurtreoa;ar;;olua;;rnth;;sro;;s;;w;anuoAgrohr;;o;;rra;u;o;;;"
+        ";wwce;ptBa;uru;r;q;aqu;Eq;olmi;otrrl;n;al;;;t;ow;;ltoncrowtor;;r"
+        "aw;;e;aeala;aeuruaqut;;uw;;;;;l;;w;Dettuaw;Aw;er;;crr;llaa;aluae"
+        "m;;;;geotl;r;;ee;;;;tll;al;;r;ue;r;;e;;l;ar;or;lIw;;n;tegral;";
+
+    inline constexpr CodePoints Values[] = {
+        {0, 0},
+        {62, 0},
+        {60, 0},
+        {38, 0},
+        {8517, 0},
+        {208, 0},
+        {8921, 0},
+        {8811, 0},
+        {8465, 0},
+        {8920, 0},
+        {8810, 0},
+        {924, 0},
+        {925, 0},
+        {10836, 0},
+        {928, 0},
+        {10939, 0},
+        {174, 0},
+        {8476, 0},
+        {10940, 0},
+        {926, 0},
+        {8766, 0},
+        {8289, 0},
+        {8776, 0},
+        {8518, 0},
+        {176, 0},
+        {8519, 0},
+        {10906, 0},
+        {10905, 0},
+        {240, 0},
+        {8807, 0},
+        {8805, 0},
+        {8823, 0},
+        {8291, 0},
+        {8520, 0},
+        {8712, 0},
+        {8290, 0},
+        {8806, 0},
+        {8804, 0},
+        {8822, 0},
+        {8723, 0},
+        {956, 0},
+        {8800, 0},
+        {8715, 0},
+        {172, 0},
+        {957, 0},
+        {9416, 0},
+        {8744, 0},
+        {960, 0},
+        {177, 0},
+        {8826, 0},
+        {8478, 0},
+        {8827, 0},
+        {173, 0},
+        {168, 0},
+        {8472, 0},
+        {8768, 0},
+        {958, 0},
+        {165, 0},
+        {1040, 0},
+        {120068, 0},
+        {10835, 0},
+        {196, 0},
+        {1041, 0},
+        {120069, 0},
+        {169, 0},
+        {8914, 0},
+        {8493, 0},
+        {935, 0},
+        {8915, 0},
+        {1044, 0},
+        {8711, 0},
+        {120071, 0},
+        {330, 0},
+        {1069, 0},
+        {120072, 0},
+        {919, 0},
+        {203, 0},
+        {1060, 0},
+        {120073, 0},
+        {1043, 0},
+        {120074, 0},
+        {94, 0},
+        {8460, 0},
+        {1048, 0},
+        {8748, 0},
+        {207, 0},
+        {1049, 0},
+        {120077, 0},
+        {1050, 0},
+        {120078, 0},
+        {1051, 0},
+        {120079, 0},
+        {8624, 0},
+        {10501, 0},
+        {1052, 0},
+        {120080, 0},
+        {1053, 0},
+        {120081, 0},
+        {10988, 0},
+        {1054, 0},
+        {120082, 0},
+        {214, 0},
+        {1055, 0},
+        {120083, 0},
+        {934, 0},
+        {936, 0},
+        {34, 0},
+        {120084, 0},
+        {1056, 0},
+        {929, 0},
+        {8625, 0},
+        {1057, 0},
+        {120086, 0},
+        {8912, 0},
+        {8721, 0},
+        {8913, 0},
+        {9, 0},
+        {932, 0},
+        {1058, 0},
+        {120087, 0},
+        {1059, 0},
+        {120088, 0},
+        {220, 0},
+        {1042, 0},
+        {8897, 0},
+        {120089, 0},
+        {120090, 0},
+        {120091, 0},
+        {1067, 0},
+        {120092, 0},
+        {1047, 0},
+        {8488, 0},
+        {8766, 819},
+        {8767, 0},
+        {1072, 0},
+        {120094, 0},
+        {8743, 0},
+        {8736, 0},
+        {10864, 0},
+        {8778, 0},
+        {42, 0},
+        {228, 0},
+        {1073, 0},
+        {120095, 0},
+        {61, 8421},
+        {8869, 0},
+        {8745, 0},
+        {162, 0},
+        {120096, 0},
+        {967, 0},
+        {9675, 0},
+        {8746, 0},
+        {1076, 0},
+        {120097, 0},
+        {247, 0},
+        {729, 0},
+        {1101, 0},
+        {120098, 0},
+        {10902, 0},
+        {8467, 0},
+        {10901, 0},
+        {331, 0},
+        {951, 0},
+        {235, 0},
+        {1092, 0},
+        {120099, 0},
+        {10892, 0},
+        {10886, 0},
+        {1075, 0},
+        {8923, 0},
+        {10878, 0},
+        {120100, 0},
+        {10898, 0},
+        {10917, 0},
+        {10916, 0},
+        {8809, 0},
+        {10888, 0},
+        {120101, 0},
+        {1080, 0},
+        {8660, 0},
+        {120102, 0},
+        {8747, 0},
+        {239, 0},
+        {1081, 0},
+        {120103, 0},
+        {1082, 0},
+        {120104, 0},
+        {10891, 0},
+        {10885, 0},
+        {10923, 0},
+        {1083, 0},
+        {8922, 0},
+        {10877, 0},
+        {120105, 0},
+        {10897, 0},
+        {8808, 0},
+        {10887, 0},
+        {9674, 0},
+        {8206, 0},
+        {175, 0},
+        {8614, 0},
+        {1084, 0},
+        {120106, 0},
+        {8487, 0},
+        {8739, 0},
+        {8921, 824},
+        {8811, 8402},
+        {8920, 824},
+        {8810, 8402},
+        {8777, 0},
+        {160, 0},
+        {1085, 0},
+        {120107, 0},
+        {8807, 824},
+        {8817, 0},
+        {8815, 0},
+        {8956, 0},
+        {8806, 824},
+        {8816, 0},
+        {8814, 0},
+        {8832, 0},
+        {8833, 0},
+        {35, 0},
+        {1086, 0},
+        {120108, 0},
+        {10689, 0},
+        {937, 0},
+        {10688, 0},
+        {10845, 0},
+        {170, 0},
+        {186, 0},
+        {10843, 0},
+        {246, 0},
+        {8741, 0},
+        {182, 0},
+        {1087, 0},
+        {120109, 0},
+        {966, 0},
+        {982, 0},
+        {10931, 0},
+        {10927, 0},
+        {968, 0},
+        {120110, 0},
+        {1088, 0},
+        {120111, 0},
+        {961, 0},
+        {8207, 0},
+        {10932, 0},
+        {10928, 0},
+        {1089, 0},
+        {167, 0},
+        {120112, 0},
+        {8764, 0},
+        {10922, 0},
+        {47, 0},
+        {9633, 0},
+        {8834, 0},
+        {185, 0},
+        {178, 0},
+        {179, 0},
+        {8835, 0},
+        {964, 0},
+        {1090, 0},
+        {120113, 0},
+        {8868, 0},
+        {1091, 0},
+        {120114, 0},
+        {252, 0},
+        {1074, 0},
+        {120115, 0},
+        {120116, 0},
+        {120117, 0},
+        {1099, 0},
+        {120118, 0},
+        {255, 0},
+        {1079, 0},
+        {120119, 0},
+        {8205, 0},
+        {198, 0},
+        {194, 0},
+        {120120, 0},
+        {197, 0},
+        {119964, 0},
+        {10983, 0},
+        {914, 0},
+        {120121, 0},
+        {8492, 0},
+        {1063, 0},
+        {266, 0},
+        {8450, 0},
+        {119966, 0},
+        {1026, 0},
+        {1029, 0},
+        {1039, 0},
+        {8609, 0},
+        {120123, 0},
+        {119967, 0},
+        {202, 0},
+        {278, 0},
+        {120124, 0},
+        {8496, 0},
+        {10867, 0},
+        {120125, 0},
+        {8497, 0},
+        {1027, 0},
+        {288, 0},
+        {120126, 0},
+        {119970, 0},
+        {8461, 0},
+        {8459, 0},
+        {1045, 0},
+        {1025, 0},
+        {206, 0},
+        {304, 0},
+        {120128, 0},
+        {921, 0},
+        {8464, 0},
+        {120129, 0},
+        {119973, 0},
+        {1061, 0},
+        {1036, 0},
+        {120130, 0},
+        {119974, 0},
+        {1033, 0},
+        {10218, 0},
+        {8606, 0},
+        {120131, 0},
+        {8466, 0},
+        {120132, 0},
+        {8499, 0},
+        {1034, 0},
+        {8469, 0},
+        {119977, 0},
+        {212, 0},
+        {120134, 0},
+        {119978, 0},
+        {8473, 0},
+        {119979, 0},
+        {8474, 0},
+        {119980, 0},
+        {10219, 0},
+        {8608, 0},
+        {8477, 0},
+        {8475, 0},
+        {1064, 0},
+        {120138, 0},
+        {8730, 0},
+        {119982, 0},
+        {8902, 0},
+        {222, 0},
+        {1062, 0},
+        {120139, 0},
+        {119983, 0},
+        {8607, 0},
+        {219, 0},
+        {120140, 0},
+        {978, 0},
+        {119984, 0},
+        {10987, 0},
+        {8214, 0},
+        {120141, 0},
+        {119985, 0},
+        {120142, 0},
+        {119986, 0},
+        {120143, 0},
+        {119987, 0},
+        {1071, 0},
+        {1031, 0},
+        {1070, 0},
+        {120144, 0},
+        {119988, 0},
+        {376, 0},
+        {1046, 0},
+        {379, 0},
+        {918, 0},
+        {8484, 0},
+        {119989, 0},
+        {226, 0},
+        {180, 0},
+        {230, 0},
+        {10844, 0},
+        {10842, 0},
+        {10660, 0},
+        {120146, 0},
+        {8779, 0},
+        {39, 0},
+        {229, 0},
+        {119990, 0},
+        {10989, 0},
+        {9141, 0},
+        {946, 0},
+        {8502, 0},
+        {8976, 0},
+        {120147, 0},
+        {9552, 0},
+        {9553, 0},
+        {9472, 0},
+        {9474, 0},
+        {119991, 0},
+        {8765, 0},
+        {92, 0},
+        {8226, 0},
+        {8782, 0},
+        {8745, 65024},
+        {267, 0},
+        {184, 0},
+        {1095, 0},
+        {10691, 0},
+        {710, 0},
+        {8791, 0},
+        {8705, 0},
+        {8773, 0},
+        {120148, 0},
+        {119992, 0},
+        {10959, 0},
+        {10960, 0},
+        {8746, 65024},
+        {8659, 0},
+        {10597, 0},
+        {8595, 0},
+        {8208, 0},
+        {8900, 0},
+        {1106, 0},
+        {120149, 0},
+        {119993, 0},
+        {1109, 0},
+        {10742, 0},
+        {9663, 0},
+        {1119, 0},
+        {8785, 0},
+        {8790, 0},
+        {234, 0},
+        {279, 0},
+        {8195, 0},
+        {8194, 0},
+        {120150, 0},
+        {8917, 0},
+        {949, 0},
+        {8495, 0},
+        {8770, 0},
+        {8364, 0},
+        {33, 0},
+        {9837, 0},
+        {402, 0},
+        {120151, 0},
+        {8916, 0},
+        {119995, 0},
+        {289, 0},
+        {8923, 65024},
+        {1107, 0},
+        {10890, 0},
+        {120152, 0},
+        {8458, 0},
+        {8819, 0},
+        {10919, 0},
+        {8809, 65024},
+        {189, 0},
+        {8596, 0},
+        {8463, 0},
+        {120153, 0},
+        {119997, 0},
+        {238, 0},
+        {1077, 0},
+        {161, 0},
+        {8887, 0},
+        {1105, 0},
+        {120154, 0},
+        {953, 0},
+        {119998, 0},
+        {120155, 0},
+        {119999, 0},
+        {1093, 0},
+        {1116, 0},
+        {120156, 0},
+        {120000, 0},
+        {8656, 0},
+        {10594, 0},
+        {10216, 0},
+        {171, 0},
+        {8592, 0},
+        {10925, 0},
+        {123, 0},
+        {10550, 0},
+        {8626, 0},
+        {8922, 65024},
+        {1113, 0},
+        {10889, 0},
+        {120157, 0},
+        {10731, 0},
+        {40, 0},
+        {120001, 0},
+        {8818, 0},
+        {91, 0},
+        {10918, 0},
+        {9667, 0},
+        {8808, 65024},
+        {9794, 0},
+        {10016, 0},
+        {181, 0},
+        {10971, 0},
+        {8230, 0},
+        {120158, 0},
+        {120002, 0},
+        {8811, 824},
+        {8810, 824},
+        {8736, 8402},
+        {10864, 824},
+        {10819, 0},
+        {10818, 0},
+        {10878, 824},
+        {8954, 0},
+        {1114, 0},
+        {8229, 0},
+        {10877, 824},
+        {8740, 0},
+        {120159, 0},
+        {8742, 0},
+        {10927, 824},
+        {10928, 824},
+        {120003, 0},
+        {8769, 0},
+        {8836, 0},
+        {8837, 0},
+        {8825, 0},
+        {8824, 0},
+        {8781, 8402},
+        {8805, 8402},
+        {62, 8402},
+        {8804, 8402},
+        {60, 8402},
+        {8859, 0},
+        {8858, 0},
+        {244, 0},
+        {10808, 0},
+        {8857, 0},
+        {731, 0},
+        {8750, 0},
+        {10678, 0},
+        {120160, 0},
+        {10679, 0},
+        {10838, 0},
+        {8500, 0},
+        {8856, 0},
+        {8706, 0},
+        {981, 0},
+        {43, 0},
+        {120161, 0},
+        {163, 0},
+        {10935, 0},
+        {10933, 0},
+        {8719, 0},
+        {8733, 0},
+        {120005, 0},
+        {10764, 0},
+        {120162, 0},
+        {120006, 0},
+        {8658, 0},
+        {10596, 0},
+        {8765, 817},
+        {10217, 0},
+        {187, 0},
+        {8594, 0},
+        {125, 0},
+        {10551, 0},
+        {8627, 0},
+        {9645, 0},
+        {1009, 0},
+        {730, 0},
+        {120163, 0},
+        {41, 0},
+        {120007, 0},
+        {93, 0},
+        {9657, 0},
+        {10936, 0},
+        {10934, 0},
+        {8901, 0},
+        {59, 0},
+        {10038, 0},
+        {1096, 0},
+        {8771, 0},
+        {10910, 0},
+        {10909, 0},
+        {10924, 0},
+        {10692, 0},
+        {120164, 0},
+        {9642, 0},
+        {120008, 0},
+        {9734, 0},
+        {10949, 0},
+        {8838, 0},
+        {9834, 0},
+        {10950, 0},
+        {8839, 0},
+        {223, 0},
+        {9140, 0},
+        {8411, 0},
+        {254, 0},
+        {215, 0},
+        {8749, 0},
+        {10536, 0},
+        {120165, 0},
+        {10537, 0},
+        {8796, 0},
+        {120009, 0},
+        {1094, 0},
+        {8657, 0},
+        {10595, 0},
+        {8593, 0},
+        {251, 0},
+        {120166, 0},
+        {965, 0},
+        {120010, 0},
+        {9653, 0},
+        {8661, 0},
+        {10984, 0},
+        {8597, 0},
+        {124, 0},
+        {120167, 0},
+        {120011, 0},
+        {120168, 0},
+        {120012, 0},
+        {8898, 0},
+        {8899, 0},
+        {10236, 0},
+        {8955, 0},
+        {120169, 0},
+        {120013, 0},
+        {1103, 0},
+        {1111, 0},
+        {120170, 0},
+        {120014, 0},
+        {1102, 0},
+        {380, 0},
+        {950, 0},
+        {1078, 0},
+        {120171, 0},
+        {120015, 0},
+        {8204, 0},
+        {193, 0},
+        {192, 0},
+        {913, 0},
+        {256, 0},
+        {260, 0},
+        {195, 0},
+        {728, 0},
+        {199, 0},
+        {264, 0},
+        {8759, 0},
+        {10799, 0},
+        {10980, 0},
+        {916, 0},
+        {201, 0},
+        {200, 0},
+        {274, 0},
+        {280, 0},
+        {10869, 0},
+        {915, 0},
+        {284, 0},
+        {711, 0},
+        {292, 0},
+        {306, 0},
+        {205, 0},
+        {204, 0},
+        {298, 0},
+        {302, 0},
+        {1030, 0},
+        {308, 0},
+        {1028, 0},
+        {922, 0},
+        {209, 0},
+        {338, 0},
+        {211, 0},
+        {210, 0},
+        {332, 0},
+        {216, 0},
+        {213, 0},
+        {8243, 0},
+        {10512, 0},
+        {348, 0},
+        {931, 0},
+        {8482, 0},
+        {1035, 0},
+        {920, 0},
+        {218, 0},
+        {1038, 0},
+        {217, 0},
+        {362, 0},
+        {370, 0},
+        {366, 0},
+        {8875, 0},
+        {8873, 0},
+        {372, 0},
+        {8896, 0},
+        {221, 0},
+        {374, 0},
+        {225, 0},
+        {224, 0},
+        {8501, 0},
+        {945, 0},
+        {257, 0},
+        {10815, 0},
+        {8735, 0},
+        {261, 0},
+        {227, 0},
+        {10769, 0},
+        {8780, 0},
+        {8222, 0},
+        {1014, 0},
+        {9251, 0},
+        {9618, 0},
+        {9617, 0},
+        {9619, 0},
+        {9608, 0},
+        {9559, 0},
+        {9556, 0},
+        {9558, 0},
+        {9555, 0},
+        {9574, 0},
+        {9577, 0},
+        {9572, 0},
+        {9575, 0},
+        {9565, 0},
+        {9562, 0},
+        {9564, 0},
+        {9561, 0},
+        {9580, 0},
+        {9571, 0},
+        {9568, 0},
+        {9579, 0},
+        {9570, 0},
+        {9567, 0},
+        {9557, 0},
+        {9554, 0},
+        {9488, 0},
+        {9484, 0},
+        {9573, 0},
+        {9576, 0},
+        {9516, 0},
+        {9524, 0},
+        {9563, 0},
+        {9560, 0},
+        {9496, 0},
+        {9492, 0},
+        {9578, 0},
+        {9569, 0},
+        {9566, 0},
+        {9532, 0},
+        {9508, 0},
+        {9500, 0},
+        {166, 0},
+        {8271, 0},
+        {8909, 0},
+        {10693, 0},
+        {10926, 0},
+        {8783, 0},
+        {8257, 0},
+        {10829, 0},
+        {231, 0},
+        {265, 0},
+        {10828, 0},
+        {10003, 0},
+        {9827, 0},
+        {58, 0},
+        {44, 0},
+        {8629, 0},
+        {10007, 0},
+        {10961, 0},
+        {10962, 0},
+        {8943, 0},
+        {8926, 0},
+        {8927, 0},
+        {10821, 0},
+        {164, 0},
+        {8910, 0},
+        {8911, 0},
+        {8753, 0},
+        {8867, 0},
+        {733, 0},
+        {8650, 0},
+        {948, 0},
+        {8643, 0},
+        {8642, 0},
+        {9830, 0},
+        {8946, 0},
+        {8784, 0},
+        {8945, 0},
+        {9662, 0},
+        {8693, 0},
+        {10607, 0},
+        {10871, 0},
+        {233, 0},
+        {8786, 0},
+        {232, 0},
+        {275, 0},
+        {8709, 0},
+        {281, 0},
+        {10865, 0},
+        {1013, 0},
+        {8801, 0},
+        {8787, 0},
+        {10609, 0},
+        {8707, 0},
+        {64256, 0},
+        {64257, 0},
+        {102, 106},
+        {64258, 0},
+        {9649, 0},
+        {10969, 0},
+        {188, 0},
+        {190, 0},
+        {8260, 0},
+        {8994, 0},
+        {947, 0},
+        {285, 0},
+        {10921, 0},
+        {8503, 0},
+        {8935, 0},
+        {96, 0},
+        {10894, 0},
+        {10896, 0},
+        {10874, 0},
+        {8919, 0},
+        {8621, 0},
+        {293, 0},
+        {8703, 0},
+        {237, 0},
+        {236, 0},
+        {8489, 0},
+        {307, 0},
+        {299, 0},
+        {305, 0},
+        {437, 0},
+        {8734, 0},
+        {303, 0},
+        {10812, 0},
+        {191, 0},
+        {8953, 0},
+        {8948, 0},
+        {1110, 0},
+        {309, 0},
+        {567, 0},
+        {1108, 0},
+        {954, 0},
+        {8666, 0},
+        {10510, 0},
+        {10641, 0},
+        {8676, 0},
+        {10925, 65024},
+        {10508, 0},
+        {10098, 0},
+        {10635, 0},
+        {8968, 0},
+        {8220, 0},
+        {10920, 0},
+        {8637, 0},
+        {8636, 0},
+        {9604, 0},
+        {8647, 0},
+        {9722, 0},
+        {8934, 0},
+        {10220, 0},
+        {8701, 0},
+        {10214, 0},
+        {10629, 0},
+        {8646, 0},
+        {8651, 0},
+        {8895, 0},
+        {10893, 0},
+        {10895, 0},
+        {8216, 0},
+        {10873, 0},
+        {8918, 0},
+        {8884, 0},
+        {9666, 0},
+        {8762, 0},
+        {8212, 0},
+        {183, 0},
+        {8722, 0},
+        {8888, 0},
+        {8779, 824},
+        {329, 0},
+        {9838, 0},
+        {8782, 824},
+        {8775, 0},
+        {8211, 0},
+        {8663, 0},
+        {8599, 0},
+        {8784, 824},
+        {8770, 824},
+        {8821, 0},
+        {8654, 0},
+        {8622, 0},
+        {10994, 0},
+        {8653, 0},
+        {8602, 0},
+        {8820, 0},
+        {8938, 0},
+        {8713, 0},
+        {8716, 0},
+        {8706, 824},
+        {8655, 0},
+        {8603, 0},
+        {8939, 0},
+        {8772, 0},
+        {10949, 824},
+        {8840, 0},
+        {10950, 824},
+        {8841, 0},
+        {241, 0},
+        {8199, 0},
+        {8764, 8402},
+        {8662, 0},
+        {8598, 0},
+        {243, 0},
+        {8861, 0},
+        {339, 0},
+        {10687, 0},
+        {242, 0},
+        {10677, 0},
+        {8634, 0},
+        {10686, 0},
+        {8254, 0},
+        {333, 0},
+        {969, 0},
+        {10681, 0},
+        {8853, 0},
+        {8635, 0},
+        {248, 0},
+        {245, 0},
+        {9021, 0},
+        {11005, 0},
+        {9742, 0},
+        {8862, 0},
+        {10866, 0},
+        {8828, 0},
+        {8242, 0},
+        {10937, 0},
+        {8830, 0},
+        {63, 0},
+        {8667, 0},
+        {10511, 0},
+        {10642, 0},
+        {10661, 0},
+        {8677, 0},
+        {10547, 0},
+        {8605, 0},
+        {8758, 0},
+        {10509, 0},
+        {10099, 0},
+        {10636, 0},
+        {8969, 0},
+        {8221, 0},
+        {8641, 0},
+        {8640, 0},
+        {8644, 0},
+        {8652, 0},
+        {10990, 0},
+        {10221, 0},
+        {8702, 0},
+        {10215, 0},
+        {10630, 0},
+        {8649, 0},
+        {8217, 0},
+        {8885, 0},
+        {9656, 0},
+        {8218, 0},
+        {8829, 0},
+        {349, 0},
+        {10938, 0},
+        {8831, 0},
+        {8865, 0},
+        {10854, 0},
+        {8664, 0},
+        {8600, 0},
+        {8726, 0},
+        {9839, 0},
+        {963, 0},
+        {10912, 0},
+        {10911, 0},
+        {8774, 0},
+        {8995, 0},
+        {10924, 65024},
+        {8851, 0},
+        {8852, 0},
+        {8847, 0},
+        {8848, 0},
+        {9733, 0},
+        {10955, 0},
+        {8842, 0},
+        {10956, 0},
+        {8843, 0},
+        {8665, 0},
+        {8601, 0},
+        {952, 0},
+        {732, 0},
+        {10701, 0},
+        {1115, 0},
+        {8812, 0},
+        {250, 0},
+        {1118, 0},
+        {8645, 0},
+        {10606, 0},
+        {249, 0},
+        {8639, 0},
+        {8638, 0},
+        {9600, 0},
+        {9720, 0},
+        {363, 0},
+        {371, 0},
+        {8846, 0},
+        {367, 0},
+        {9721, 0},
+        {8944, 0},
+        {9652, 0},
+        {8648, 0},
+        {10985, 0},
+        {8872, 0},
+        {8866, 0},
+        {8794, 0},
+        {8882, 0},
+        {8834, 8402},
+        {8835, 8402},
+        {8883, 0},
+        {373, 0},
+        {9711, 0},
+        {9661, 0},
+        {10234, 0},
+        {10231, 0},
+        {10232, 0},
+        {10229, 0},
+        {10752, 0},
+        {10233, 0},
+        {10230, 0},
+        {9651, 0},
+        {253, 0},
+        {375, 0},
+        {258, 0},
+        {8788, 0},
+        {8966, 0},
+        {262, 0},
+        {268, 0},
+        {10868, 0},
+        {8751, 0},
+        {8781, 0},
+        {8225, 0},
+        {270, 0},
+        {8412, 0},
+        {272, 0},
+        {282, 0},
+        {8704, 0},
+        {988, 0},
+        {286, 0},
+        {290, 0},
+        {1066, 0},
+        {294, 0},
+        {296, 0},
+        {1032, 0},
+        {310, 0},
+        {313, 0},
+        {923, 0},
+        {317, 0},
+        {315, 0},
+        {319, 0},
+        {321, 0},
+        {323, 0},
+        {327, 0},
+        {325, 0},
+        {336, 0},
+        {10807, 0},
+        {340, 0},
+        {10518, 0},
+        {344, 0},
+        {342, 0},
+        {1065, 0},
+        {1068, 0},
+        {346, 0},
+        {352, 0},
+        {350, 0},
+        {356, 0},
+        {354, 0},
+        {358, 0},
+        {364, 0},
+        {368, 0},
+        {360, 0},
+        {10982, 0},
+        {8874, 0},
+        {377, 0},
+        {381, 0},
+        {259, 0},
+        {10837, 0},
+        {8737, 0},
+        {8738, 0},
+        {10863, 0},
+        {8893, 0},
+        {8965, 0},
+        {8757, 0},
+        {8904, 0},
+        {10697, 0},
+        {8245, 0},
+        {263, 0},
+        {10820, 0},
+        {10827, 0},
+        {10823, 0},
+        {10816, 0},
+        {269, 0},
+        {10991, 0},
+        {64, 0},
+        {8728, 0},
+        {8720, 0},
+        {8471, 0},
+        {8630, 0},
+        {10822, 0},
+        {10826, 0},
+        {8845, 0},
+        {8631, 0},
+        {9005, 0},
+        {8224, 0},
+        {8504, 0},
+        {271, 0},
+        {10623, 0},
+        {8903, 0},
+        {8990, 0},
+        {8973, 0},
+        {36, 0},
+        {8991, 0},
+        {8972, 0},
+        {273, 0},
+        {10862, 0},
+        {283, 0},
+        {8789, 0},
+        {10904, 0},
+        {10903, 0},
+        {8196, 0},
+        {8197, 0},
+        {10723, 0},
+        {61, 0},
+        {8799, 0},
+        {9792, 0},
+        {64259, 0},
+        {64260, 0},
+        {8531, 0},
+        {8533, 0},
+        {8537, 0},
+        {8539, 0},
+        {8532, 0},
+        {8534, 0},
+        {8535, 0},
+        {8540, 0},
+        {8536, 0},
+        {8538, 0},
+        {8541, 0},
+        {8542, 0},
+        {501, 0},
+        {989, 0},
+        {287, 0},
+        {10880, 0},
+        {10900, 0},
+        {10645, 0},
+        {10616, 0},
+        {8202, 0},
+        {1098, 0},
+        {9829, 0},
+        {8889, 0},
+        {8763, 0},
+        {8213, 0},
+        {295, 0},
+        {8259, 0},
+        {10716, 0},
+        {8453, 0},
+        {8890, 0},
+        {8947, 0},
+        {297, 0},
+        {1112, 0},
+        {1008, 0},
+        {311, 0},
+        {312, 0},
+        {10523, 0},
+        {314, 0},
+        {955, 0},
+        {10525, 0},
+        {8617, 0},
+        {8619, 0},
+        {10553, 0},
+        {8610, 0},
+        {10521, 0},
+        {318, 0},
+        {316, 0},
+        {10879, 0},
+        {10899, 0},
+        {10620, 0},
+        {8970, 0},
+        {10602, 0},
+        {10603, 0},
+        {320, 0},
+        {9136, 0},
+        {10797, 0},
+        {8727, 0},
+        {95, 0},
+        {10643, 0},
+        {10605, 0},
+        {8249, 0},
+        {322, 0},
+        {8907, 0},
+        {8905, 0},
+        {10614, 0},
+        {10646, 0},
+        {9646, 0},
+        {10793, 0},
+        {10992, 0},
+        {8863, 0},
+        {8760, 0},
+        {8871, 0},
+        {8879, 0},
+        {8878, 0},
+        {324, 0},
+        {8783, 824},
+        {328, 0},
+        {326, 0},
+        {10532, 0},
+        {8802, 0},
+        {8708, 0},
+        {8940, 0},
+        {8953, 824},
+        {11005, 8421},
+        {8928, 0},
+        {10547, 824},
+        {8605, 824},
+        {8941, 0},
+        {8929, 0},
+        {8470, 0},
+        {8877, 0},
+        {10500, 0},
+        {8876, 0},
+        {10498, 0},
+        {10499, 0},
+        {10531, 0},
+        {10535, 0},
+        {337, 0},
+        {10684, 0},
+        {8854, 0},
+        {8886, 0},
+        {8855, 0},
+        {10995, 0},
+        {37, 0},
+        {46, 0},
+        {8240, 0},
+        {8724, 0},
+        {10789, 0},
+        {8936, 0},
+        {8880, 0},
+        {8200, 0},
+        {8279, 0},
+        {10524, 0},
+        {341, 0},
+        {10613, 0},
+        {10526, 0},
+        {8618, 0},
+        {8620, 0},
+        {10565, 0},
+        {8611, 0},
+        {10522, 0},
+        {345, 0},
+        {343, 0},
+        {10621, 0},
+        {8971, 0},
+        {10604, 0},
+        {9137, 0},
+        {10798, 0},
+        {10644, 0},
+        {8250, 0},
+        {8908, 0},
+        {8906, 0},
+        {347, 0},
+        {353, 0},
+        {351, 0},
+        {8937, 0},
+        {10533, 0},
+        {1097, 0},
+        {962, 0},
+        {10858, 0},
+        {10803, 0},
+        {1100, 0},
+        {9023, 0},
+        {9824, 0},
+        {8851, 65024},
+        {8852, 65024},
+        {8849, 0},
+        {8850, 0},
+        {10941, 0},
+        {10951, 0},
+        {10965, 0},
+        {10963, 0},
+        {10942, 0},
+        {10952, 0},
+        {10964, 0},
+        {10966, 0},
+        {10534, 0},
+        {10538, 0},
+        {8982, 0},
+        {357, 0},
+        {355, 0},
+        {8981, 0},
+        {8756, 0},
+        {977, 0},
+        {8201, 0},
+        {8864, 0},
+        {10800, 0},
+        {9014, 0},
+        {10993, 0},
+        {8244, 0},
+        {9708, 0},
+        {359, 0},
+        {365, 0},
+        {369, 0},
+        {10622, 0},
+        {8988, 0},
+        {8975, 0},
+        {8989, 0},
+        {8974, 0},
+        {361, 0},
+        {10652, 0},
+        {8891, 0},
+        {8942, 0},
+        {10955, 65024},
+        {8842, 65024},
+        {10956, 65024},
+        {8843, 65024},
+        {10847, 0},
+        {8793, 0},
+        {10753, 0},
+        {10754, 0},
+        {10758, 0},
+        {10756, 0},
+        {378, 0},
+        {382, 0},
+        {8752, 0},
+        {917, 0},
+        {10, 0},
+        {8288, 0},
+        {927, 0},
+        {933, 0},
+        {8894, 0},
+        {9084, 0},
+        {10672, 0},
+        {8801, 8421},
+        {10832, 0},
+        {10674, 0},
+        {10690, 0},
+        {10861, 0},
+        {10552, 0},
+        {10549, 0},
+        {10557, 0},
+        {10556, 0},
+        {10673, 0},
+        {10662, 0},
+        {10872, 0},
+        {10882, 0},
+        {10876, 0},
+        {10568, 0},
+        {8949, 0},
+        {10527, 0},
+        {10611, 0},
+        {10639, 0},
+        {10637, 0},
+        {10599, 0},
+        {10881, 0},
+        {10804, 0},
+        {10875, 0},
+        {10598, 0},
+        {10794, 0},
+        {8951, 0},
+        {8950, 0},
+        {8958, 0},
+        {8957, 0},
+        {10772, 0},
+        {8930, 0},
+        {8931, 0},
+        {10718, 0},
+        {8884, 8402},
+        {8885, 8402},
+        {10683, 0},
+        {959, 0},
+        {10839, 0},
+        {8241, 0},
+        {8462, 0},
+        {10786, 0},
+        {10790, 0},
+        {10791, 0},
+        {10774, 0},
+        {10528, 0},
+        {10612, 0},
+        {10638, 0},
+        {10640, 0},
+        {10601, 0},
+        {10805, 0},
+        {10600, 0},
+        {10788, 0},
+        {10610, 0},
+        {10947, 0},
+        {10945, 0},
+        {10943, 0},
+        {10617, 0},
+        {10968, 0},
+        {10948, 0},
+        {10185, 0},
+        {10967, 0},
+        {10619, 0},
+        {10946, 0},
+        {10944, 0},
+        {10970, 0},
+        {10809, 0},
+        {10811, 0},
+        {10663, 0},
+        {10650, 0},
+        {8669, 0},
+        {10513, 0},
+        {10913, 0},
+        {10569, 0},
+        {10840, 0},
+        {10664, 0},
+        {10665, 0},
+        {10666, 0},
+        {10667, 0},
+        {10668, 0},
+        {10669, 0},
+        {10670, 0},
+        {10671, 0},
+        {10653, 0},
+        {8755, 0},
+        {9142, 0},
+        {10184, 0},
+        {10825, 0},
+        {10768, 0},
+        {10824, 0},
+        {8754, 0},
+        {10239, 0},
+        {9191, 0},
+        {10725, 0},
+        {10765, 0},
+        {10884, 0},
+        {10717, 0},
+        {10775, 0},
+        {10676, 0},
+        {10571, 0},
+        {10883, 0},
+        {10570, 0},
+        {8613, 0},
+        {10861, 824},
+        {8949, 824},
+        {10806, 0},
+        {10787, 0},
+        {10773, 0},
+        {9006, 0},
+        {8978, 0},
+        {8979, 0},
+        {10675, 0},
+        {10770, 0},
+        {10702, 0},
+        {10771, 0},
+        {10724, 0},
+        {10801, 0},
+        {10810, 0},
+        {9186, 0},
+        {785, 0},
+        {8813, 0},
+        {9182, 0},
+        {8287, 8202},
+        {9183, 0},
+        {10514, 0},
+        {8615, 0},
+        {8612, 0},
+        {8287, 0},
+        {10740, 0},
+        {10515, 0},
+        {10608, 0},
+        {10586, 0},
+        {10578, 0},
+        {10914, 0},
+        {10587, 0},
+        {10579, 0},
+        {8203, 0},
+        {10574, 0},
+        {10703, 0},
+        {10592, 0},
+        {10584, 0},
+        {8847, 824},
+        {9180, 0},
+        {9723, 0},
+        {10577, 0},
+        {8831, 824},
+        {10704, 0},
+        {10588, 0},
+        {10580, 0},
+        {9181, 0},
+        {10590, 0},
+        {10582, 0},
+        {9724, 0},
+        {10593, 0},
+        {10585, 0},
+        {10913, 824},
+        {8848, 824},
+        {10575, 0},
+        {10072, 0},
+        {10591, 0},
+        {10583, 0},
+        {10703, 824},
+        {10589, 0},
+        {10581, 0},
+        {10576, 0},
+        {10704, 824},
+        {9643, 0},
+        {10914, 824},
+    };
+} // namespace HtmlParser::CharacterReferences
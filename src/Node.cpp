@@ -1,62 +1,275 @@
 #include <HtmlParser/Node.hpp>
 #include <HtmlParser/Query.hpp>
-#include <sstream>
+#include <HtmlParser/Serializer.hpp>
+#include <HtmlParser/TextExtractor.hpp>
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <utility>
+
+#include "Utilities.hpp"
 
 namespace HtmlParser
 {
+    namespace
+    {
+        // Counts clones that shared a tree, which invalidates every earlier CheckModifiable result
+        std::atomic<std::uint64_t> CloneGeneration{0};
+    } // namespace
+
     Node::Node(enum NodeType _Type) : Type(_Type)
     {
     }
 
     void Node::AppendChild(const std::shared_ptr<Node>& Child)
     {
+        CheckModifiable();
+        Child->CheckModifiable();
         Child->Parent = shared_from_this();
+        Child->m_Position = static_cast<std::uint32_t>(Children.size());
+        Child->m_Flags |= Unsourced;
         Children.push_back(Child);
+        MarkChildrenDirty();
+    }
+
+    void Node::RemoveChild(const std::shared_ptr<Node>& Child)
+    {
+        CheckModifiable();
+        auto it = std::find(Children.begin(), Children.end(), Child);
+        if (it == Children.end())
+        {
+            return;
+        }
+        // A child shared with a cloned DOM keeps the parent it has there
+        if (Child->Parent.lock().get() == this)
+        {
+            Child->Parent.reset();
+        }
+        Children.erase(it);
+        MarkChildrenDirty();
     }
 
     std::string Node::GetAttribute(const std::string& Name) const
     {
-        auto it = Attributes.find(Name);
-        return it != Attributes.end() ? it->second : "";
+        // Looked up without interning, so arbitrary names do not grow the pool
+        const Atom Key = Atom::Find(Name);
+        if (Key.empty())
+        {
+            return "";
+        }
+        auto it = Attributes.find(Key);
+        return it != Attributes.end() ? it->second.ToString() : "";
     }
 
     std::string Node::GetTextContent() const
     {
-        if (Type == NodeType::Text)
+        // Every text node, script and style included, without separators
+        TextOptions AllText;
+        AllText.SkipInvisible = false;
+        AllText.CollapseWhitespace = false;
+        AllText.BlockSeparators = false;
+        std::string Result;
+        TextExtractor Extractor(Result);
+        Extractor.SetOptions(AllText);
+        Extractor.Write(*this);
+        return Result;
+    }
+
+    std::string Node::OuterHtml() const
+    {
+        std::string Html;
+        Serializer Writer(Html);
+        Writer.WriteOuterHtml(*this);
+        return Html;
+    }
+
+    std::string Node::InnerHtml() const
+    {
+        std::string Html;
+        Serializer Writer(Html);
+        Writer.WriteInnerHtml(*this);
+        return Html;
+    }
+
+    void Node::SetAttribute(const std::string& Name, const std::string& Value)
+    {
+        CheckModifiable();
+        Attributes[Name] = Value;
+        MarkDirty();
+    }
+
+    void Node::SetText(const std::string& Value)
+    {
+        CheckModifiable();
+        Text = Value;
+        MarkDirty();
+    }
+
+    bool Node::HasClass(const std::string& ClassName) const
+    {
+        static const Atom Class("class");
+        auto it = Attributes.find(Class);
+        const auto IsSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+        if (it == Attributes.end() || ClassName.empty() || std::any_of(ClassName.begin(), ClassName.end(), IsSpace))
         {
-            return Text;
+            return false;
         }
-        else
+
+        // Look for ClassName as a whole whitespace-separated token, without splitting the value
+        const std::string_view Classes = it->second;
+        for (std::size_t Position = Classes.find(ClassName); Position != std::string_view::npos; Position = Classes.find(ClassName, Position + 1))
         {
-            std::string Result;
-            for (const auto& child : Children)
+            const std::size_t End = Position + ClassName.size();
+            if ((Position == 0 || IsSpace(Classes[Position - 1])) && (End == Classes.size() || IsSpace(Classes[End])))
             {
-                Result += child->GetTextContent();
+                return true;
             }
-            return Result;
         }
+        return false;
     }
 
-    void Node::SetAttribute(const std::string& Name, const std::string& Value)
+    void Node::MarkDirty()
     {
-        Attributes[Name] = Value;
+        CheckModifiable();
+        m_Flags |= Dirty;
+        MarkAncestorsDirty();
+        InvalidateHash();
     }
 
-    bool Node::HasClass(const std::string& ClassName) const
+    void Node::MarkChildrenDirty()
     {
-        auto it = Attributes.find("class");
-        if (it != Attributes.end())
+        CheckModifiable();
+        m_Flags |= DirtyDescendants;
+        MarkAncestorsDirty();
+        InvalidateHash();
+    }
+
+    void Node::CheckModifiable()
+    {
+        const std::uint64_t Generation = CloneGeneration.load(std::memory_order_relaxed);
+        if (m_CheckedGeneration == Generation)
+        {
+            return;
+        }
+
+        // Copies made by DOM::Edit point at their copied parents, so only a node still reachable from a cloned
+        // root finds the mark. An ancestor already checked since the last clone ends the walk early.
+        std::shared_ptr<const Node> Ancestor;
+        for (const Node* Current = this; Current; Current = Ancestor.get())
         {
-            std::istringstream Stream(it->second);
-            std::string Token;
-            while (Stream >> Token)
+            if (Current->m_Flags & Shared)
             {
-                if (Token == ClassName)
+                throw std::runtime_error("Node is shared with a cloned DOM; modify the node returned by DOM::Edit");
+            }
+            if (Current != this && Current->m_CheckedGeneration == Generation)
+            {
+                break;
+            }
+            Ancestor = Current->Parent.lock();
+        }
+        m_CheckedGeneration = Generation;
+    }
+
+    void Node::MarkShared()
+    {
+        // A root shared before has no nodes of its own below it
+        if (!(m_Flags & Shared))
+        {
+            m_Flags |= Shared;
+            CloneGeneration.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void Node::MarkAncestorsDirty()
+    {
+        // Every ancestor of a node with dirty descendants has them too, so the walk can stop early
+        for (auto Ancestor = Parent.lock(); Ancestor && !(Ancestor->m_Flags & DirtyDescendants); Ancestor = Ancestor->Parent.lock())
+        {
+            Ancestor->m_Flags |= DirtyDescendants;
+        }
+    }
+
+    void Node::InvalidateHash()
+    {
+        // Hashing a node hashes its whole subtree, so ancestors of a node without a hash have none either
+        m_Hash.Value.store(0, std::memory_order_relaxed);
+        for (auto Ancestor = Parent.lock(); Ancestor && Ancestor->m_Hash.Value.load(std::memory_order_relaxed) != 0; Ancestor = Ancestor->Parent.lock())
+        {
+            Ancestor->m_Hash.Value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::uint64_t Node::GetHash() const
+    {
+        const std::uint64_t Cached = m_Hash.Value.load(std::memory_order_relaxed);
+        if (Cached != 0)
+        {
+            return Cached;
+        }
+
+        // Subtrees are hashed in post-order from an explicit stack, so deep trees do not recurse. Subtrees
+        // that already have a hash are not entered.
+        std::vector<std::pair<const Node*, std::size_t>> Stack{{this, 0}};
+        while (!Stack.empty())
+        {
+            auto& Top = Stack.back();
+            if (Top.second < Top.first->Children.size())
+            {
+                const Node* Child = Top.first->Children[Top.second++].get();
+                if (Child->m_Hash.Value.load(std::memory_order_relaxed) == 0)
                 {
-                    return true;
+                    Stack.push_back({Child, 0});
                 }
+                continue;
             }
+            Top.first->StoreHash();
+            Stack.pop_back();
         }
-        return false;
+        return m_Hash.Value.load(std::memory_order_relaxed);
+    }
+
+    void Node::StoreHash() const
+    {
+        std::uint64_t Hash = Utils::HashCombine(static_cast<std::uint64_t>(Type), Utils::HashBytes(Tag));
+        Hash = Utils::HashCombine(Hash, Utils::HashBytes(Text));
+        // Attribute order is not significant, so their hashes are added up
+        std::uint64_t AttributesHash = 0;
+        for (const auto& Attribute : Attributes)
+        {
+            AttributesHash += Utils::HashCombine(Utils::HashBytes(Attribute.first), Utils::HashBytes(Attribute.second));
+        }
+        Hash = Utils::HashCombine(Hash, AttributesHash);
+        for (const auto& Child : Children)
+        {
+            Hash = Utils::HashCombine(Hash, Child->m_Hash.Value.load(std::memory_order_relaxed));
+        }
+        Hash = Hash != 0 ? Hash : 1;
+        m_Hash.Value.store(Hash, std::memory_order_relaxed);
+    }
+
+    bool Node::IsDirty() const
+    {
+        return m_Flags & Dirty;
+    }
+
+    bool Node::HasDirtyDescendants() const
+    {
+        return m_Flags & DirtyDescendants;
+    }
+
+    bool Node::HasSourceSpan() const
+    {
+        return !(m_Flags & Unsourced);
+    }
+
+    const SourceSpan& Node::GetSourceSpan() const
+    {
+        return m_Span;
+    }
+
+    void Node::SetSourceSpan(const SourceSpan& Span)
+    {
+        m_Span = Span;
+        m_Flags &= ~Unsourced;
     }
 } // namespace HtmlParser
@@ -1,59 +1,520 @@
+#include <HtmlParser/MappedFile.hpp>
 #include <HtmlParser/Node.hpp>
 #include <HtmlParser/Parser.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
+#include <unordered_set>
 
+#include "Probes.hpp"
 #include "Utilities.hpp"
 
 namespace HtmlParser
 {
+    namespace
+    {
+        // Names the tree builder checks for, interned once so that checks compare addresses
+        const Atom HtmlTag("html");
+        const Atom HeadTag("head");
+        const Atom BodyTag("body");
+        const Atom PreTag("pre");
+        const Atom TextareaTag("textarea");
+
+        // Innermost element inside body whose contents contain [Begin, End) and can be parsed on their own:
+        // opened and closed by its own tags, and neither void nor holding raw text. An implied element has
+        // no start tag to restart from, since the input before its first child was parsed in another
+        // insertion mode. Every node must have a span.
+        std::shared_ptr<Node> FindReparseTarget(const std::shared_ptr<Node>& Root, std::size_t Begin, std::size_t End)
+        {
+            std::shared_ptr<Node> Target;
+            bool InBody = false;
+            for (auto Current = Root; Current;)
+            {
+                // Unmodified children follow each other in the source, so the search starts at the first one
+                // that can hold the edit
+                const auto& Children = Current->Children;
+                auto Candidate = std::partition_point(Children.begin(), Children.end(), [&](const std::shared_ptr<Node>& Child) { return Child->GetSourceSpan().End < End; });
+                std::shared_ptr<Node> Next;
+                for (; Candidate != Children.end() && (*Candidate)->GetSourceSpan().Begin <= Begin; ++Candidate)
+                {
+                    const SourceSpan& Span = (*Candidate)->GetSourceSpan();
+                    if ((*Candidate)->Type == NodeType::Element && Span.ContentBegin <= Begin && End <= Span.ContentEnd)
+                    {
+                        Next = *Candidate;
+                        break;
+                    }
+                }
+                if (!Next)
+                {
+                    break;
+                }
+
+                InBody = InBody || Next->Tag == BodyTag;
+                const SourceSpan& Span = Next->GetSourceSpan();
+                if (InBody && Span.ContentBegin > Span.Begin && Span.End > Span.ContentEnd && !Utils::IsVoidElement(Next->Tag) && !Utils::IsRawTextElement(Next->Tag) && !Utils::IsRcdataElement(Next->Tag))
+                {
+                    Target = Next;
+                }
+                Current = Next;
+            }
+            return Target;
+        }
+
+        // Moves the spans of a node kept by Reparse, and those of its descendants other than Skip, to the
+        // edited source, along with values borrowed from it. Subtrees that end before the edit are left
+        // as they are unless the input before the edit moved as well.
+        void RebaseNode(Node& Target, const Node* Skip, std::string_view OldSource, std::string_view NewSource, std::size_t EditEnd, std::ptrdiff_t Delta, bool BorrowsValues, bool MovesPrefix)
+        {
+            const auto Shift = [&](std::uint32_t Offset) { return Offset >= EditEnd ? static_cast<std::uint32_t>(Offset + Delta) : Offset; };
+            const auto Rebase = [&](StringValue& Value) {
+                const auto Address = reinterpret_cast<std::uintptr_t>(Value.data());
+                const auto Base = reinterpret_cast<std::uintptr_t>(OldSource.data());
+                if (Value.IsBorrowed() && Address >= Base && Address <= Base + OldSource.size())
+                {
+                    const std::size_t Offset = Address - Base;
+                    Value = StringValue::Borrow(NewSource.substr(Offset >= EditEnd ? Offset + Delta : Offset, Value.size()));
+                }
+            };
+
+            if (BorrowsValues)
+            {
+                Rebase(Target.Text);
+                for (auto& Attribute : Target.Attributes)
+                {
+                    Rebase(Attribute.second);
+                }
+            }
+            if (&Target == Skip)
+            {
+                return;
+            }
+            SourceSpan Span = Target.GetSourceSpan();
+            Span.Begin = Shift(Span.Begin);
+            Span.ContentBegin = Shift(Span.ContentBegin);
+            Span.ContentEnd = Shift(Span.ContentEnd);
+            Span.End = Shift(Span.End);
+            Target.SetSourceSpan(Span);
+            auto Child = Target.Children.begin();
+            if (!MovesPrefix)
+            {
+                Child = std::partition_point(Child, Target.Children.end(), [&](const std::shared_ptr<Node>& Candidate) { return Candidate->GetSourceSpan().End < EditEnd; });
+            }
+            for (; Child != Target.Children.end(); ++Child)
+            {
+                RebaseNode(**Child, Skip, OldSource, NewSource, EditEnd, Delta, BorrowsValues, MovesPrefix);
+            }
+        }
+    } // namespace
+
     Parser::Parser()
     {
     }
 
-    DOM Parser::Parse(const std::string& Input)
+    // Deadline checks are amortized over this many tokens
+    static constexpr std::size_t DeadlineCheckInterval = 1024;
+
+    DOM Parser::Parse(std::string_view Input)
     {
+        return Parse(Input, nullptr);
+    }
+
+    DOM Parser::Parse(std::string_view Input, std::shared_ptr<const void> InputOwner)
+    {
+        HTMLPARSER_STATS_SCOPE(m_InstrumentationStats);
+        HTMLPARSER_TIME_SCOPE(Parse);
+        if (m_InputEncoding != Encoding::Utf8)
+        {
+            std::string Transcoded;
+            Input = DecodeInput(Input, Transcoded);
+            if (Input.data() == Transcoded.data())
+            {
+                auto Buffer = std::make_shared<const std::string>(std::move(Transcoded));
+                Input = *Buffer;
+                InputOwner = std::move(Buffer);
+            }
+        }
+
+        // Source spans and zero-copy values refer to the input after parsing
+        const bool RetainInput = m_TrackSourceSpans || m_ZeroCopy;
+        if (RetainInput && !InputOwner)
+        {
+            auto Copy = std::make_shared<const std::string>(Input);
+            Input = *Copy;
+            InputOwner = std::move(Copy);
+        }
+
         Tokenizer Instance(Input);
-        Instance.Tokenize();
-        const auto& Tokens = Instance.GetTokens();
+        Instance.SetMaxTokenLength(m_Limits.MaxTextLength);
+        Instance.SetSkipRawTextContent(m_SkipRawTextContent);
+        Instance.SetDiscardedElements(m_DiscardedElements);
+        Instance.SetDiscardComments(m_DiscardOptions.Comments);
+        Instance.SetDecodeCharacterReferences(m_DecodeEntities);
 
         Document = std::make_shared<Node>(NodeType::Document);
         OpenElements.clear();
         OpenElements.push_back(Document);
+        m_OpenCounts.clear();
+        m_PendingWhitespace.clear();
         InsertionMode = InsertionMode::Initial;
+        m_NodeCount = 0;
+        m_ElementCount = 0;
+        m_ScratchUsage = ScratchUsage();
+        m_PreformattedDepth = 0;
+        m_Truncation = TruncationReason::None;
+        m_RecordingSpans = m_TrackSourceSpans && Input.size() <= std::numeric_limits<std::uint32_t>::max();
+        m_SourceCursor = 0;
+        m_SourceGap = false;
+        if (m_RecordingSpans)
+        {
+            Document->SetSourceSpan(SourceSpan());
+        }
+        std::size_t DiscardCount = 0;
+
+        const bool HasDeadline = m_Limits.Timeout.count() > 0;
+        const auto Deadline = std::chrono::steady_clock::now() + m_Limits.Timeout;
+        std::size_t TokenCount = 0;
 
-        for (const auto& Token : Tokens)
+        Token Token;
+        while (m_Truncation == TruncationReason::None && Instance.NextToken(Token))
         {
-            switch (InsertionMode)
+            if (HasDeadline && ++TokenCount % DeadlineCheckInterval == 0 && std::chrono::steady_clock::now() > Deadline)
             {
-            case InsertionMode::Initial:
-                InsertionModeInitial(Token);
+                m_Truncation = TruncationReason::Timeout;
                 break;
-            case InsertionMode::BeforeHtml:
-                InsertionModeBeforeHtml(Token);
-                break;
-            case InsertionMode::BeforeHead:
-                InsertionModeBeforeHead(Token);
-                break;
-            case InsertionMode::InHead:
-                InsertionModeInHead(Token);
-                break;
-            case InsertionMode::AfterHead:
-                InsertionModeAfterHead(Token);
-                break;
-            case InsertionMode::InBody:
-                InsertionModeInBody(Token);
-                break;
-            default:
-                HandleError("Unsupported insertion mode");
+            }
+            if ((m_StopCondition.MaxBytes != 0 && Instance.GetPosition() > m_StopCondition.MaxBytes) || (m_StopCondition.TokenPredicate && m_StopCondition.TokenPredicate(Token)))
+            {
+                m_Truncation = TruncationReason::StopCondition;
                 break;
             }
+            if (m_RecordingSpans && Instance.GetDiscardCount() != DiscardCount)
+            {
+                DiscardCount = Instance.GetDiscardCount();
+                m_SourceGap = true;
+            }
+            ProcessToken(Token);
+        }
+
+        if (Instance.LimitExceeded())
+        {
+            m_Truncation = TruncationReason::MaxTextLength;
+        }
+        FinishScratchUsage(Instance);
+
+        if (m_ComputeHashes)
+        {
+            Document->GetHash();
+        }
+        if (!RetainInput)
+        {
+            return DOM(Document, m_Truncation);
+        }
+        if (m_RecordingSpans)
+        {
+            m_SourceGap = m_SourceGap || Instance.GetDiscardCount() != DiscardCount || !m_PendingWhitespace.empty();
+            FinishSourceSpans(Input.size());
+        }
+        return DOM(Document, m_Truncation, Input, std::move(InputOwner));
+    }
+
+    DOM Parser::ParseFile(const std::string& Path)
+    {
+        // A DOM that references its input keeps the mapping open
+        auto File = std::make_shared<const MappedFile>(Path);
+        return Parse(File->View(), File);
+    }
+
+    bool Parser::Reparse(DOM& Tree, const SourceEdit& Edit)
+    {
+        HTMLPARSER_STATS_SCOPE(m_InstrumentationStats);
+        const std::string_view OldSource = Tree.GetSource();
+        if (!Tree.Root()->HasSourceSpan())
+        {
+            throw std::runtime_error("Reparse requires a DOM parsed with source spans");
+        }
+        if (Edit.Offset > OldSource.size() || Edit.Length > OldSource.size() - Edit.Offset)
+        {
+            throw std::runtime_error("Edit is outside of the source");
+        }
+
+        // A source only this DOM holds is edited in place, which keeps values before the edit valid
+        const std::size_t Size = OldSource.size() - Edit.Length + Edit.Text.size();
+        std::shared_ptr<std::string> Buffer = m_EditBuffer.lock();
+        const bool InPlace = Buffer && Tree.m_SourceOwner == Buffer && Buffer.use_count() == 2 && Buffer->capacity() >= Size;
+        if (InPlace)
+        {
+            Buffer->replace(Edit.Offset, Edit.Length, Edit.Text.data(), Edit.Text.size());
+        }
+        else
+        {
+            // Leaves room for the edits that usually follow
+            Buffer = std::make_shared<std::string>();
+            Buffer->reserve(Size + Size / 16);
+            Buffer->append(OldSource.substr(0, Edit.Offset));
+            Buffer->append(Edit.Text);
+            Buffer->append(OldSource.substr(Edit.Offset + Edit.Length));
+            m_EditBuffer = Buffer;
+        }
+        const std::string_view Source = *Buffer;
+        const std::size_t EditEnd = Edit.Offset + Edit.Length;
+        const std::ptrdiff_t Delta = static_cast<std::ptrdiff_t>(Edit.Text.size()) - static_cast<std::ptrdiff_t>(Edit.Length);
+
+        std::shared_ptr<Node> Element;
+        auto Replacement = std::make_shared<Node>(NodeType::Element);
+        if (CanReparseIncrementally(Tree) && Source.size() <= std::numeric_limits<std::uint32_t>::max())
+        {
+            Element = FindReparseTarget(Tree.Root(), Edit.Offset, EditEnd);
+        }
+        if (!Element || !ReparseElement(Element, Replacement, Source, Element->GetSourceSpan().End + Delta))
+        {
+            // The source is UTF-8 by now and stays with the DOM for later edits
+            const Encoding InputEncoding = m_InputEncoding;
+            const bool TrackSourceSpans = m_TrackSourceSpans;
+            m_InputEncoding = Encoding::Utf8;
+            m_TrackSourceSpans = true;
+            try
+            {
+                Tree = Parse(Source, Buffer);
+            }
+            catch (...)
+            {
+                m_InputEncoding = InputEncoding;
+                m_TrackSourceSpans = TrackSourceSpans;
+                throw;
+            }
+            m_InputEncoding = InputEncoding;
+            m_TrackSourceSpans = TrackSourceSpans;
+            return false;
+        }
+
+        // Everything outside the element moves to the edited source; its new contents are there already
+        RebaseNode(*Tree.Root(), Element.get(), OldSource, Source, EditEnd, Delta, m_ZeroCopy, m_ZeroCopy && !InPlace);
+        Element->Children = std::move(Replacement->Children);
+        for (const auto& Child : Element->Children)
+        {
+            Child->Parent = Element;
+        }
+        Element->SetSourceSpan(Replacement->GetSourceSpan());
+        if (Replacement->HasDirtyDescendants())
+        {
+            Element->MarkChildrenDirty();
+        }
+        Element->InvalidateHash();
+        if (m_ComputeHashes)
+        {
+            Tree.Root()->GetHash();
+        }
+        Tree = DOM(Tree.Root(), TruncationReason::None, Source, std::move(Buffer));
+        return true;
+    }
+
+    bool Parser::CanReparseIncrementally(const DOM& Tree) const
+    {
+        // Budgets and stop conditions apply to the document as a whole, and modified or shared nodes
+        // would not match a fresh parse
+        const auto& Condition = m_StopCondition;
+        const bool HasBudget = m_Limits.MaxDepth != 0 || m_Limits.MaxNodes != 0 || m_Limits.MaxTextLength != 0 || m_Limits.Timeout.count() > 0;
+        const bool HasStopCondition = !m_StopAfterElement.empty() || Condition.MaxBytes != 0 || Condition.MaxElements != 0 || Condition.TokenPredicate || Condition.NodePredicate;
+        const auto& Root = Tree.Root();
+        return !HasBudget && !HasStopCondition && !Tree.IsTruncated() && Tree.m_Owner == 0 && !Root->IsDirty() && !Root->HasDirtyDescendants();
+    }
+
+    bool Parser::ReparseElement(const std::shared_ptr<Node>& Element, const std::shared_ptr<Node>& Replacement, std::string_view Source, std::size_t RegionEnd)
+    {
+        // The new contents go into a stand-in, so the tree is untouched if they turn out not to fit
+        Replacement->Tag = Element->Tag;
+        Replacement->Parent = Element->Parent;
+        const SourceSpan Span = Element->GetSourceSpan();
+        Replacement->SetSourceSpan(Span);
+
+        // The tree builder resumes in body with the element's ancestors open. Only elements opened in
+        // the region are counted, so an end tag closing an ancestor is seen before it is processed.
+        std::vector<Atom> AncestorTags;
+        OpenElements.clear();
+        for (auto Ancestor = Element->Parent.lock(); Ancestor; Ancestor = Ancestor->Parent.lock())
+        {
+            OpenElements.push_back(Ancestor);
+            AncestorTags.push_back(Ancestor->Tag);
+        }
+        std::reverse(OpenElements.begin(), OpenElements.end());
+        OpenElements.push_back(Replacement);
+        Document = OpenElements.front();
+        m_OpenCounts.clear();
+        m_OpenCounts[Replacement->Tag] = 1;
+        m_PreformattedDepth = 0;
+        for (const auto& Open : OpenElements)
+        {
+            if (Open->Tag == PreTag || Open->Tag == TextareaTag)
+            {
+                ++m_PreformattedDepth;
+            }
+        }
+        m_PendingWhitespace.clear();
+        InsertionMode = InsertionMode::InBody;
+        m_NodeCount = 0;
+        m_ElementCount = 0;
+        m_ScratchUsage = ScratchUsage();
+        m_Truncation = TruncationReason::None;
+        m_RecordingSpans = true;
+        m_SourceCursor = Span.ContentBegin;
+        m_SourceGap = false;
+        std::size_t DiscardCount = 0;
+
+        Tokenizer Instance(Source.substr(0, RegionEnd));
+        Instance.SetSkipRawTextContent(m_SkipRawTextContent);
+        Instance.SetDiscardedElements(m_DiscardedElements);
+        Instance.SetDiscardComments(m_DiscardOptions.Comments);
+        Instance.SetDecodeCharacterReferences(m_DecodeEntities);
+        Instance.Seek(Span.ContentBegin);
+
+        const std::size_t Depth = OpenElements.size();
+        Token Token;
+        while (Instance.NextToken(Token))
+        {
+            if (OpenElements.size() < Depth)
+            {
+                // The element was closed before the end of the region
+                return false;
+            }
+            if (Token.Type == TokenType::EndTag && m_OpenCounts[Token.Name] == 0 && std::find(AncestorTags.begin(), AncestorTags.end(), Token.Name) != AncestorTags.end())
+            {
+                return false;
+            }
+            if (Instance.GetDiscardCount() != DiscardCount)
+            {
+                DiscardCount = Instance.GetDiscardCount();
+                m_SourceGap = true;
+            }
+            ProcessToken(Token);
+        }
+
+        // The region has to end with the element's own end tag
+        FinishScratchUsage(Instance);
+        return OpenElements.size() == Depth - 1 && Token.Type == TokenType::EndTag && Token.End == RegionEnd;
+    }
+
+    StringValue Parser::KeepValue(const StringValue& Value) const
+    {
+        StringValue Kept = Value;
+        if (!m_ZeroCopy)
+        {
+            Kept.MakeOwned();
+        }
+        return Kept;
+    }
+
+    std::string_view Parser::DecodeInput(std::string_view Input, std::string& Buffer) const
+    {
+        Encoding Source = m_InputEncoding == Encoding::Auto ? SniffEncoding(Input) : m_InputEncoding;
+        if (Source == Encoding::Utf8)
+        {
+            std::string_view Content = Input.substr(Input.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0);
+            // Valid UTF-8 is parsed in place
+            if (IsValidUtf8(Content))
+            {
+                return Content;
+            }
         }
 
-        return DOM(Document);
+        Buffer = TranscodeToUtf8(Input, Source);
+        return Buffer;
+    }
+
+    void Parser::SetStopCondition(const StopCondition& Condition)
+    {
+        m_StopCondition = Condition;
+        m_StopCondition.AfterElement = Utils::ToLower(Condition.AfterElement);
+        m_StopAfterElement = m_StopCondition.AfterElement;
+    }
+
+    void Parser::SetDiscardOptions(const DiscardOptions& Options)
+    {
+        m_DiscardOptions = Options;
+        m_DiscardedElements.clear();
+        for (const auto& Element : Options.Elements)
+        {
+            m_DiscardedElements.insert(Utils::ToLower(Element));
+        }
+    }
+
+    void Parser::ProcessToken(Token& Token)
+    {
+        if (Token.Type != TokenType::Character && !m_PendingWhitespace.empty())
+        {
+            // Whitespace held back between two elements is dropped for good
+            m_PendingWhitespace.clear();
+            m_SourceGap = true;
+        }
+        if (Token.Type == TokenType::Comment)
+        {
+            InsertComment(Token);
+            return;
+        }
+        if (Token.Type == TokenType::DOCTYPE && InsertionMode != InsertionMode::Initial)
+        {
+            HandleError("Unexpected DOCTYPE");
+            return;
+        }
+
+        if (Token.Type == TokenType::Character && InsertionMode != InsertionMode::InBody && (InsertionMode != InsertionMode::InHead || CurrentNode()->Tag == HeadTag))
+        {
+            // Whitespace before <body> is ignored, except inside head elements such as <title>
+            size_t First = Token.Data.View().find_first_not_of(" \t\n\r\f");
+            if (First == std::string::npos)
+            {
+                return;
+            }
+            Token.Data.RemovePrefix(First);
+        }
+
+        switch (InsertionMode)
+        {
+        case InsertionMode::Initial:
+        {
+            HTMLPARSER_TIME_SCOPE(InitialMode);
+            InsertionModeInitial(Token);
+            break;
+        }
+        case InsertionMode::BeforeHtml:
+        {
+            HTMLPARSER_TIME_SCOPE(BeforeHtmlMode);
+            InsertionModeBeforeHtml(Token);
+            break;
+        }
+        case InsertionMode::BeforeHead:
+        {
+            HTMLPARSER_TIME_SCOPE(BeforeHeadMode);
+            InsertionModeBeforeHead(Token);
+            break;
+        }
+        case InsertionMode::InHead:
+        {
+            HTMLPARSER_TIME_SCOPE(InHeadMode);
+            InsertionModeInHead(Token);
+            break;
+        }
+        case InsertionMode::AfterHead:
+        {
+            HTMLPARSER_TIME_SCOPE(AfterHeadMode);
+            InsertionModeAfterHead(Token);
+            break;
+        }
+        case InsertionMode::InBody:
+        {
+            HTMLPARSER_TIME_SCOPE(InBodyMode);
+            InsertionModeInBody(Token);
+            break;
+        }
+        default:
+            HandleError("Unsupported insertion mode");
+            break;
+        }
     }
 
     void Parser::HandleError(const std::string& ErrorMessage)
     {
+        HTMLPARSER_COUNT(ParseErrors, 1);
         if (m_IsStrict)
         {
             throw std::runtime_error("Parse error: " + ErrorMessage);
@@ -70,45 +531,299 @@ namespace HtmlParser
         return OpenElements.back();
     }
 
+    bool Parser::ReserveNode()
+    {
+        if (m_Truncation != TruncationReason::None)
+        {
+            return false;
+        }
+        if (m_Limits.MaxNodes != 0 && m_NodeCount >= m_Limits.MaxNodes)
+        {
+            m_Truncation = TruncationReason::MaxNodes;
+            return false;
+        }
+        ++m_NodeCount;
+        HTMLPARSER_COUNT(NodesCreated, 1);
+        return true;
+    }
+
     void Parser::InsertElement(const Token& Token)
     {
+        if (m_Truncation != TruncationReason::None)
+        {
+            return;
+        }
+        if (m_Limits.MaxDepth != 0 && OpenElements.size() > m_Limits.MaxDepth)
+        {
+            m_Truncation = TruncationReason::MaxDepth;
+            return;
+        }
+        if (!ReserveNode())
+        {
+            return;
+        }
+
         auto Element = std::make_shared<Node>(NodeType::Element);
-        Element->Tag = Utils::ToLower(Token.Data);
+        Element->Tag = Token.Name;
         Element->Attributes = Token.Attributes;
-        CurrentNode()->AppendChild(Element);
-        if (!Token.SelfClosing)
+        if (!m_ZeroCopy)
+        {
+            for (auto& Attribute : Element->Attributes)
+            {
+                Attribute.second.MakeOwned();
+            }
+        }
+        AppendNode(CurrentNode(), Element, Token);
+        ++m_ElementCount;
+
+        if (Token.SelfClosing || Utils::IsVoidElement(Element->Tag))
+        {
+            // Closed as soon as it is inserted
+            if (!m_StopAfterElement.empty() && Element->Tag == m_StopAfterElement)
+            {
+                m_Truncation = TruncationReason::StopCondition;
+            }
+        }
+        else
         {
             OpenElements.push_back(Element);
+            m_ScratchUsage.MaxOpenElements = std::max(m_ScratchUsage.MaxOpenElements, OpenElements.size());
+            ++m_OpenCounts[Element->Tag];
+            if (Element->Tag == PreTag || Element->Tag == TextareaTag)
+            {
+                ++m_PreformattedDepth;
+            }
         }
+
+        if (m_StopCondition.MaxElements != 0 && m_ElementCount >= m_StopCondition.MaxElements)
+        {
+            m_Truncation = TruncationReason::StopCondition;
+        }
+        OnNodeInserted(Element);
     }
 
     void Parser::InsertCharacter(const Token& Token)
     {
+        auto Parent = CurrentNode();
+        if (!Parent->Children.empty() && Parent->Children.back()->Type == NodeType::Text)
+        {
+            // Text split across tokens continues the previous text node
+            auto& Previous = Parent->Children.back();
+            StringValue& Text = Previous->Text;
+            if (m_ZeroCopy && Text.IsBorrowed() && Token.Data.IsBorrowed() && Text.data() + Text.size() == Token.Data.data())
+            {
+                // Both are views of the input, so the adjacent one is simply extended
+                Text = StringValue::Borrow(std::string_view(Text.data(), Text.size() + Token.Data.size()));
+            }
+            else
+            {
+                Text += Token.Data;
+            }
+            if (m_RecordingSpans)
+            {
+                if (m_SourceGap)
+                {
+                    Previous->MarkDirty();
+                    m_SourceGap = false;
+                }
+                SourceSpan Span = Previous->GetSourceSpan();
+                Span.ContentEnd = Span.End = static_cast<std::uint32_t>(Token.End);
+                Previous->SetSourceSpan(Span);
+                m_SourceCursor = Token.End;
+            }
+            return;
+        }
+
+        if (m_DiscardOptions.WhitespaceText && m_PreformattedDepth == 0 && Token.Data.View().find_first_not_of(" \t\n\r\f") == std::string::npos)
+        {
+            // Held back until it is known whether more text follows before the next tag
+            m_PendingWhitespace += Token.Data;
+            m_ScratchUsage.PendingWhitespaceBytes = std::max(m_ScratchUsage.PendingWhitespaceBytes, m_PendingWhitespace.size());
+            return;
+        }
+        if (!ReserveNode())
+        {
+            return;
+        }
+
+        // Held whitespace is not in the span of the token when something was discarded before it
+        const bool Regenerate = m_SourceGap && !m_PendingWhitespace.empty();
         auto TextNode = std::make_shared<Node>(NodeType::Text);
-        TextNode->Text = Token.Data;
-        CurrentNode()->AppendChild(TextNode);
+        if (m_PendingWhitespace.empty())
+        {
+            TextNode->Text = KeepValue(Token.Data);
+        }
+        else
+        {
+            TextNode->Text = std::move(m_PendingWhitespace);
+            TextNode->Text += Token.Data;
+            m_PendingWhitespace.clear();
+        }
+        AppendNode(Parent, TextNode, Token);
+        if (Regenerate)
+        {
+            TextNode->MarkDirty();
+        }
+        OnNodeInserted(TextNode);
     }
 
-    void Parser::CloseElement(const Token& Token)
+    void Parser::InsertComment(const Token& Token)
+    {
+        if (!ReserveNode())
+        {
+            return;
+        }
+
+        auto CommentNode = std::make_shared<Node>(NodeType::Comment);
+        CommentNode->Text = KeepValue(Token.Data);
+        AppendNode(CurrentNode(), CommentNode, Token);
+        OnNodeInserted(CommentNode);
+    }
+
+    void Parser::OnNodeInserted(const std::shared_ptr<Node>& InsertedNode)
+    {
+        if (m_StopCondition.NodePredicate && m_StopCondition.NodePredicate(InsertedNode))
+        {
+            m_Truncation = TruncationReason::StopCondition;
+        }
+    }
+
+    void Parser::AppendNode(const std::shared_ptr<Node>& Parent, const std::shared_ptr<Node>& Child, const Token& Token)
+    {
+        // Parsed nodes are attached directly; Node::AppendChild would mark them as modified
+        Child->Parent = Parent;
+        Child->m_Position = static_cast<std::uint32_t>(Parent->Children.size());
+        Parent->Children.push_back(Child);
+        if (!m_RecordingSpans)
+        {
+            return;
+        }
+
+        SourceSpan Span;
+        if (Token.End == 0)
+        {
+            // Implied html, head and body take up no input and serialize to nothing while unmodified
+            Span.Begin = Span.ContentBegin = Span.ContentEnd = Span.End = static_cast<std::uint32_t>(m_SourceCursor);
+            Child->SetSourceSpan(Span);
+            return;
+        }
+        if (m_SourceGap)
+        {
+            // Discarded input must not come back, so the parent's children are written one by one
+            Span.Begin = static_cast<std::uint32_t>(Token.Begin);
+            Parent->MarkChildrenDirty();
+            m_SourceGap = false;
+        }
+        else
+        {
+            Span.Begin = static_cast<std::uint32_t>(m_SourceCursor);
+        }
+        Span.ContentBegin = Span.ContentEnd = Span.End = static_cast<std::uint32_t>(Token.End);
+        Child->SetSourceSpan(Span);
+        m_SourceCursor = Token.End;
+    }
+
+    void Parser::FinishSourceSpans(std::size_t InputSize)
+    {
+        // Elements still open end where the inserted input does
+        for (std::size_t i = OpenElements.size(); i-- > 1;)
+        {
+            SourceSpan Span = OpenElements[i]->GetSourceSpan();
+            Span.ContentEnd = Span.End = static_cast<std::uint32_t>(m_SourceCursor);
+            OpenElements[i]->SetSourceSpan(Span);
+        }
+
+        // Trailing input that was ignored stays with the document, unless it was cut off or discarded
+        SourceSpan Span;
+        Span.ContentEnd = static_cast<std::uint32_t>(m_SourceCursor);
+        Span.End = m_Truncation == TruncationReason::None && !m_SourceGap ? static_cast<std::uint32_t>(InputSize) : Span.ContentEnd;
+        Document->SetSourceSpan(Span);
+    }
+
+    void Parser::FinishScratchUsage(const Tokenizer& Instance)
     {
-        std::string TagName = Utils::ToLower(Token.Data);
-        for (auto it = OpenElements.rbegin(); it != OpenElements.rend(); ++it)
+        // A per-tag count is a map entry with its next pointer and cached hash, plus a bucket
+        static constexpr std::size_t OpenCountSize = 3 * sizeof(void*) + sizeof(std::pair<const Atom, std::size_t>);
+        m_ScratchUsage.MaxOpenElements = std::max(m_ScratchUsage.MaxOpenElements, OpenElements.size());
+        m_ScratchUsage.OpenElementBytes = m_ScratchUsage.MaxOpenElements * sizeof(std::shared_ptr<Node>) + m_OpenCounts.size() * OpenCountSize;
+        m_ScratchUsage.TokenizerBytes = Instance.GetScratchBytes();
+        HTMLPARSER_COUNT_MAX(MaxStackDepth, m_ScratchUsage.MaxOpenElements);
+    }
+
+    void Parser::PopElement(const Token* EndTag)
+    {
+        if (m_RecordingSpans)
         {
-            if ((*it)->Tag == TagName)
+            SourceSpan Span = CurrentNode()->GetSourceSpan();
+            if (EndTag == nullptr)
             {
-                OpenElements.erase(it.base() - 1, OpenElements.end());
-                return;
+                Span.ContentEnd = Span.End = static_cast<std::uint32_t>(m_SourceCursor);
             }
+            else
+            {
+                if (m_SourceGap)
+                {
+                    Span.ContentEnd = static_cast<std::uint32_t>(EndTag->Begin);
+                    CurrentNode()->MarkChildrenDirty();
+                    m_SourceGap = false;
+                }
+                else
+                {
+                    Span.ContentEnd = static_cast<std::uint32_t>(m_SourceCursor);
+                }
+                Span.End = static_cast<std::uint32_t>(EndTag->End);
+                m_SourceCursor = EndTag->End;
+            }
+            CurrentNode()->SetSourceSpan(Span);
+        }
+
+        if (!m_StopAfterElement.empty() && CurrentNode()->Tag == m_StopAfterElement)
+        {
+            m_Truncation = TruncationReason::StopCondition;
+        }
+        if (CurrentNode()->Tag == PreTag || CurrentNode()->Tag == TextareaTag)
+        {
+            --m_PreformattedDepth;
+        }
+        if (CurrentNode()->Type == NodeType::Element)
+        {
+            --m_OpenCounts[CurrentNode()->Tag];
+        }
+        OpenElements.pop_back();
+    }
+
+    void Parser::CloseElement(const Token& Token)
+    {
+        const Atom TagName = Token.Name;
+        // Stray end tags are rejected without scanning the stack
+        auto Count = m_OpenCounts.find(TagName);
+        if (Count == m_OpenCounts.end() || Count->second == 0)
+        {
+            HandleError("No matching start tag for end tag: " + Token.Data.ToString());
+            return;
+        }
+
+        // A matching element is open, so this only visits the elements being closed
+        while (CurrentNode()->Tag != TagName)
+        {
+            HandleError("Unclosed element: " + CurrentNode()->Tag.ToString());
+            PopElement();
         }
-        // If we didn't find the tag to close
-        HandleError("No matching start tag for end tag: " + Token.Data);
+        PopElement(&Token);
     }
 
     void Parser::InsertionModeInitial(const Token& Token)
     {
         if (Token.Type == TokenType::DOCTYPE)
         {
-            // Ignore for now
+            if (ReserveNode())
+            {
+                auto DoctypeNode = std::make_shared<Node>(NodeType::Doctype);
+                DoctypeNode->Text = KeepValue(Token.Data);
+                AppendNode(Document, DoctypeNode, Token);
+                OnNodeInserted(DoctypeNode);
+            }
+            InsertionMode = InsertionMode::BeforeHtml;
         }
         else
         {
@@ -119,10 +834,7 @@ namespace HtmlParser
 
     void Parser::InsertionModeBeforeHtml(const Token& Token)
     {
-        if (Token.Type == TokenType::Character && isspace(Token.Data[0])) {
-            return; // Ignore whitespace
-        }
-        if (Token.Type == TokenType::StartTag && Utils::ToLower(Token.Data) == "html")
+        if (Token.Type == TokenType::StartTag && Token.Name == HtmlTag)
         {
             InsertElement(Token);
             InsertionMode = InsertionMode::BeforeHead;
@@ -133,6 +845,7 @@ namespace HtmlParser
             HtmlParser::Token HtmlToken;
             HtmlToken.Type = TokenType::StartTag;
             HtmlToken.Data = "html";
+            HtmlToken.Name = HtmlTag;
             InsertElement(HtmlToken);
             InsertionMode = InsertionMode::BeforeHead;
             InsertionModeBeforeHead(Token);
@@ -141,10 +854,7 @@ namespace HtmlParser
 
     void Parser::InsertionModeBeforeHead(const Token& Token)
     {
-        if (Token.Type == TokenType::Character && isspace(Token.Data[0])) {
-            return; // Ignore whitespace
-        }
-        if (Token.Type == TokenType::StartTag && Utils::ToLower(Token.Data) == "head")
+        if (Token.Type == TokenType::StartTag && Token.Name == HeadTag)
         {
             InsertElement(Token);
             InsertionMode = InsertionMode::InHead;
@@ -155,6 +865,7 @@ namespace HtmlParser
             HtmlParser::Token HeadToken;
             HeadToken.Type = TokenType::StartTag;
             HeadToken.Data = "head";
+            HeadToken.Name = HeadTag;
             InsertElement(HeadToken);
             InsertionMode = InsertionMode::InHead;
             InsertionModeInHead(Token);
@@ -163,18 +874,34 @@ namespace HtmlParser
 
     void Parser::InsertionModeInHead(const Token& Token)
     {
-        if (Token.Type == TokenType::Character && isspace(Token.Data[0])) {
-            return; // Ignore whitespace
+        static const std::unordered_set<Atom> HeadElements = {"base", "basefont", "bgsound", "link", "meta", "noframes", "noscript", "script", "style", "template", "title"};
+
+        bool IsHead = CurrentNode()->Tag == HeadTag;
+        if (Token.Type == TokenType::StartTag && HeadElements.count(Token.Name) > 0)
+        {
+            InsertElement(Token);
         }
-        if (Token.Type == TokenType::EndTag && Utils::ToLower(Token.Data) == "head")
+        else if (Token.Type == TokenType::Character && !IsHead)
         {
-            OpenElements.pop_back();
+            // Contents of <title>, <style> and the like
+            InsertCharacter(Token);
+        }
+        else if (Token.Type == TokenType::EndTag && !IsHead && Token.Name == CurrentNode()->Tag)
+        {
+            PopElement(&Token);
+        }
+        else if (Token.Type == TokenType::EndTag && Token.Name == HeadTag)
+        {
+            CloseElement(Token);
             InsertionMode = InsertionMode::AfterHead;
         }
         else
         {
-            // For simplicity, we'll close <head> here
-            OpenElements.pop_back();
+            // Anything else implicitly closes <head> along with any unclosed head elements
+            while (OpenElements.size() > 1 && CurrentNode()->Tag != HtmlTag)
+            {
+                PopElement();
+            }
             InsertionMode = InsertionMode::AfterHead;
             InsertionModeAfterHead(Token);
         }
@@ -182,10 +909,7 @@ namespace HtmlParser
 
     void Parser::InsertionModeAfterHead(const Token& Token)
     {
-        if (Token.Type == TokenType::Character && isspace(Token.Data[0])) {
-            return; // Ignore whitespace
-        }
-        if (Token.Type == TokenType::StartTag && Utils::ToLower(Token.Data) == "body")
+        if (Token.Type == TokenType::StartTag && Token.Name == BodyTag)
         {
             InsertElement(Token);
             InsertionMode = InsertionMode::InBody;
@@ -196,6 +920,7 @@ namespace HtmlParser
             HtmlParser::Token BodyToken;
             BodyToken.Type = TokenType::StartTag;
             BodyToken.Data = "body";
+            BodyToken.Name = BodyTag;
             InsertElement(BodyToken);
             InsertionMode = InsertionMode::InBody;
             InsertionModeInBody(Token);
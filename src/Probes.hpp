@@ -0,0 +1,79 @@
+#pragma once
+#include <HtmlParser/Instrumentation.hpp>
+
+// Instrumentation points used inside the library. Without HTMLPARSER_INSTRUMENTATION the macros expand to
+// nothing and their arguments are not evaluated.
+#ifdef HTMLPARSER_INSTRUMENTATION
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace HtmlParser::Instrumentation
+{
+    InstrumentationStats& MutableThreadStats();
+
+    // Adds the time until the end of the scope to a phase
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(InstrumentedPhase Phase) : m_Phase(Phase), m_Start(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~ScopedTimer()
+        {
+            PhaseTiming& Timing = MutableThreadStats().Phases[static_cast<std::size_t>(m_Phase)];
+            ++Timing.Calls;
+            Timing.Nanoseconds += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start).count());
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        InstrumentedPhase m_Phase;
+        std::chrono::steady_clock::time_point m_Start;
+    };
+
+    // Collects what is recorded until the end of the scope into Result as well as the thread's stats
+    class ScopedStats
+    {
+    public:
+        explicit ScopedStats(InstrumentationStats& Result) : m_Result(Result), m_Outer(std::exchange(MutableThreadStats(), InstrumentationStats()))
+        {
+        }
+
+        ~ScopedStats()
+        {
+            InstrumentationStats& Thread = MutableThreadStats();
+            m_Result = Thread;
+            Thread = m_Outer;
+            Thread.Merge(m_Result);
+        }
+
+        ScopedStats(const ScopedStats&) = delete;
+        ScopedStats& operator=(const ScopedStats&) = delete;
+
+    private:
+        InstrumentationStats& m_Result;
+        InstrumentationStats m_Outer;
+    };
+} // namespace HtmlParser::Instrumentation
+
+#define HTMLPARSER_PROBE_CONCAT_IMPL(Left, Right) Left##Right
+#define HTMLPARSER_PROBE_CONCAT(Left, Right) HTMLPARSER_PROBE_CONCAT_IMPL(Left, Right)
+#define HTMLPARSER_TIME_SCOPE(Phase) const ::HtmlParser::Instrumentation::ScopedTimer HTMLPARSER_PROBE_CONCAT(ScopedTimer, __LINE__)(::HtmlParser::InstrumentedPhase::Phase)
+#define HTMLPARSER_STATS_SCOPE(Result) const ::HtmlParser::Instrumentation::ScopedStats HTMLPARSER_PROBE_CONCAT(ScopedStats, __LINE__)(Result)
+#define HTMLPARSER_COUNT(Counter, Amount) (::HtmlParser::Instrumentation::MutableThreadStats().Counter += (Amount))
+#define HTMLPARSER_COUNT_MAX(Counter, Value)                                                                                                         \
+    do                                                                                                                                               \
+    {                                                                                                                                                \
+        std::uint64_t& Current = ::HtmlParser::Instrumentation::MutableThreadStats().Counter;                                                     \
+        Current = std::max<std::uint64_t>(Current, (Value));                                                                                         \
+    } while (false)
+#else
+#define HTMLPARSER_TIME_SCOPE(Phase) ((void)0)
+#define HTMLPARSER_STATS_SCOPE(Result) ((void)0)
+#define HTMLPARSER_COUNT(Counter, Amount) ((void)0)
+#define HTMLPARSER_COUNT_MAX(Counter, Value) ((void)0)
+#endif
@@ -0,0 +1,226 @@
+#pragma once
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <HtmlParser/Atom.hpp>
+
+#include "Probes.hpp"
+#include "Utilities.hpp"
+
+// Selector matching shared by Query and Snapshot. A node reference type N plugs in through a
+// specialization of NodeTraits<N> providing IsElement, HasTag, HasClass, HasAttribute, GetAttribute
+// (empty when missing) and ForEachChild.
+namespace HtmlParser::Selectors
+{
+    template <typename N>
+    struct NodeTraits;
+
+    // Splits a selector into compound selectors and combinator tokens (" ", ">", "+", "~")
+    inline std::vector<std::string> Tokenize(const std::string& Selector)
+    {
+        std::vector<std::string> Tokens;
+        std::string Token;
+        for (size_t i = 0; i < Selector.size(); ++i)
+        {
+            char c = Selector[i];
+            if (isspace(c))
+            {
+                if (!Token.empty())
+                {
+                    Tokens.push_back(Token);
+                    Token.clear();
+                }
+                Tokens.push_back(" ");
+            }
+            else if (c == '>' || c == '+' || c == '~')
+            {
+                if (!Token.empty())
+                {
+                    Tokens.push_back(Token);
+                    Token.clear();
+                }
+                Tokens.emplace_back(1, c);
+            }
+            else
+            {
+                Token += c;
+            }
+        }
+        if (!Token.empty())
+        {
+            Tokens.push_back(Token);
+        }
+        return Tokens;
+    }
+
+    // One part of a compound selector such as "div.a[href]", with names interned once per query
+    struct SimpleSelector
+    {
+        enum class Kind
+        {
+            Tag,
+            Class,
+            Id,
+            HasAttribute,
+            AttributeEquals,
+            // An attribute selector without its closing bracket
+            Never,
+        };
+
+        Kind Type;
+        Atom Name;
+        std::string Value;
+    };
+
+    // A compound selector, or a descendant combinator when Descendant is set
+    struct Step
+    {
+        bool Descendant = false;
+        std::vector<SimpleSelector> Parts;
+    };
+
+    inline std::vector<SimpleSelector> ParseCompound(const std::string& Token)
+    {
+        std::vector<SimpleSelector> Parts;
+        const auto NameEnd = [&](size_t Position) {
+            while (Position < Token.size() && Token[Position] != '.' && Token[Position] != '#' && Token[Position] != '[')
+            {
+                ++Position;
+            }
+            return Position;
+        };
+
+        size_t Position = 0;
+        while (Position < Token.size())
+        {
+            if (Token[Position] == '.' || Token[Position] == '#')
+            {
+                // Class or ID selector
+                const auto Type = Token[Position] == '.' ? SimpleSelector::Kind::Class : SimpleSelector::Kind::Id;
+                const size_t Start = Position + 1;
+                Position = NameEnd(Start);
+                Parts.push_back({Type, Atom(), Token.substr(Start, Position - Start)});
+            }
+            else if (Token[Position] == '[')
+            {
+                // Attribute selector
+                size_t Start = Position + 1;
+                size_t End = Token.find(']', Start);
+                if (End == std::string::npos)
+                {
+                    Parts.push_back({SimpleSelector::Kind::Never, Atom(), std::string()});
+                    break;
+                }
+                std::string AttrSelector = Token.substr(Start, End - Start);
+                Position = End + 1;
+
+                size_t EqualPos = AttrSelector.find('=');
+                if (EqualPos != std::string::npos)
+                {
+                    std::string AttrValue = AttrSelector.substr(EqualPos + 1);
+
+                    // Remove quotes if present
+                    if (!AttrValue.empty() && (AttrValue.front() == '"' || AttrValue.front() == '\''))
+                    {
+                        AttrValue = AttrValue.substr(1, AttrValue.size() - 2);
+                    }
+                    Parts.push_back({SimpleSelector::Kind::AttributeEquals, Atom(std::string_view(AttrSelector).substr(0, EqualPos)), AttrValue});
+                }
+                else
+                {
+                    // Attribute existence selector
+                    Parts.push_back({SimpleSelector::Kind::HasAttribute, Atom(AttrSelector), std::string()});
+                }
+            }
+            else
+            {
+                // Tag selector
+                const size_t Start = Position;
+                Position = NameEnd(Start);
+                Parts.push_back({SimpleSelector::Kind::Tag, Atom::Lowercase(std::string_view(Token).substr(Start, Position - Start)), std::string()});
+            }
+        }
+        return Parts;
+    }
+
+    inline std::vector<Step> Compile(const std::string& Selector)
+    {
+        std::vector<Step> Steps;
+        for (const std::string& Token : Tokenize(Selector))
+        {
+            Steps.push_back(Token == " " ? Step{true, {}} : Step{false, ParseCompound(Token)});
+        }
+        return Steps;
+    }
+
+    template <typename N>
+    bool Matches(const N& ElementNode, const std::vector<SimpleSelector>& Parts)
+    {
+        using Traits = NodeTraits<N>;
+        if (!Traits::IsElement(ElementNode))
+            return false;
+
+        static const Atom IdName("id");
+        for (const SimpleSelector& Part : Parts)
+        {
+            bool IsMatching = true;
+            switch (Part.Type)
+            {
+            case SimpleSelector::Kind::Tag:
+                IsMatching = Traits::HasTag(ElementNode, Part.Name);
+                break;
+            case SimpleSelector::Kind::Class:
+                IsMatching = Traits::HasClass(ElementNode, Part.Value);
+                break;
+            case SimpleSelector::Kind::Id:
+                IsMatching = Traits::GetAttribute(ElementNode, IdName) == Part.Value;
+                break;
+            case SimpleSelector::Kind::HasAttribute:
+                IsMatching = Traits::HasAttribute(ElementNode, Part.Name);
+                break;
+            case SimpleSelector::Kind::AttributeEquals:
+                IsMatching = Traits::GetAttribute(ElementNode, Part.Name) == Part.Value;
+                break;
+            case SimpleSelector::Kind::Never:
+                IsMatching = false;
+                break;
+            }
+            if (!IsMatching)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Appends ElementNode and its descendants that match Tokens[Index...] in document order. Each compound
+    // is matched at the highest element possible, which leaves the most descendants for the next one.
+    template <typename N>
+    void Select(const N& ElementNode, const std::vector<Step>& Tokens, size_t Index, std::vector<N>& Results)
+    {
+        using Traits = NodeTraits<N>;
+        HTMLPARSER_COUNT(SelectorNodesVisited, 1);
+        // Descendant combinators are implied by looking for each compound below the previous match
+        while (Index < Tokens.size() && Tokens[Index].Descendant)
+            ++Index;
+        if (Index >= Tokens.size())
+            return;
+
+        size_t Next = Index + 1;
+        while (Next < Tokens.size() && Tokens[Next].Descendant)
+            ++Next;
+
+        if (Matches(ElementNode, Tokens[Index].Parts))
+        {
+            if (Next < Tokens.size())
+            {
+                Traits::ForEachChild(ElementNode, [&](const N& Child) { Select(Child, Tokens, Next, Results); });
+                return;
+            }
+            Results.push_back(ElementNode);
+        }
+        Traits::ForEachChild(ElementNode, [&](const N& Child) { Select(Child, Tokens, Index, Results); });
+    }
+} // namespace HtmlParser::Selectors
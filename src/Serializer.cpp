@@ -0,0 +1,415 @@
+#include <HtmlParser/Escape.hpp>
+#include <HtmlParser/Serializer.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "Utilities.hpp"
+
+namespace HtmlParser
+{
+    namespace
+    {
+        // Tags built by the parser are already lowercase; only others need a copy
+        const std::string& LowerTag(const std::string& Tag, std::string& Scratch)
+        {
+            for (char c : Tag)
+            {
+                if (c >= 'A' && c <= 'Z')
+                {
+                    Scratch = Utils::ToLower(Tag);
+                    return Scratch;
+                }
+            }
+            return Tag;
+        }
+
+        // Unmodified nodes are copied from the source as a whole
+        bool IsVerbatim(const Node& Target, bool Sourced)
+        {
+            return Sourced && !Target.IsDirty() && !Target.HasDirtyDescendants();
+        }
+
+        // Stand-ins for the source offset copying resumes from after a node, when the output does not continue
+        // with copied source
+        constexpr std::uint32_t GeneratedMarkup = UINT32_MAX;
+        constexpr std::uint32_t EndOfOutput = UINT32_MAX - 1;
+
+        // What the output continues with after the child at Index; ParentFollowing is what follows the last child
+        std::uint32_t FollowingOffset(const Node& Target, std::size_t Index, bool Sourced, std::uint32_t ParentFollowing)
+        {
+            if (Index + 1 == Target.Children.size())
+            {
+                return ParentFollowing;
+            }
+            // Clean nodes start with their copied start tag or text, dirty ones with generated markup
+            const Node& Next = *Target.Children[Index + 1];
+            return Sourced && Next.HasSourceSpan() && !Next.IsDirty() ? Next.GetSourceSpan().Begin : GeneratedMarkup;
+        }
+
+        // Element copied from the source whose end tag was left out there, implied by what followed it
+        bool HasImpliedEndTag(const Node& Target)
+        {
+            if (Target.Type != NodeType::Element || !Target.HasSourceSpan() || Target.IsDirty())
+            {
+                return false;
+            }
+            const SourceSpan& Span = Target.GetSourceSpan();
+            std::string Scratch;
+            return Span.ContentEnd == Span.End && !Utils::IsVoidElement(LowerTag(Target.Tag, Scratch));
+        }
+
+        // When something else follows such a child now, it needs a generated end tag, or what follows would end
+        // up inside it on reparse. So do the last descendants that were ended along with it; the same tag may
+        // be nested, so they are closed as well. Visits them outermost first.
+        template <typename Visitor>
+        void ForEachImpliedEndTag(const Node& Child, bool Sourced, std::uint32_t Following, Visitor&& Visit)
+        {
+            if (!Sourced || Following == EndOfOutput || !HasImpliedEndTag(Child) || Following == Child.GetSourceSpan().End)
+            {
+                return;
+            }
+            const Node* Current = &Child;
+            while (true)
+            {
+                Visit(*Current);
+                if (Current->Children.empty())
+                {
+                    break;
+                }
+                const Node& Last = *Current->Children.back();
+                if (!HasImpliedEndTag(Last) || Last.GetSourceSpan().End != Current->GetSourceSpan().End)
+                {
+                    break;
+                }
+                Current = &Last;
+            }
+        }
+
+        std::size_t NodeSize(const Node& Target, std::string_view Source);
+
+        std::size_t ChildrenSize(const Node& Target, bool IsRawText, std::string_view Source, std::uint32_t Following)
+        {
+            const bool Sourced = !Source.empty();
+            std::size_t Size = 0;
+            for (std::size_t i = 0; i < Target.Children.size(); ++i)
+            {
+                const Node& Child = *Target.Children[i];
+                if (IsRawText && Child.Type == NodeType::Text && !IsVerbatim(Child, Sourced && Child.HasSourceSpan()))
+                {
+                    Size += Child.Text.size();
+                }
+                else
+                {
+                    Size += NodeSize(Child, Source);
+                }
+                // "</" Tag ">"
+                ForEachImpliedEndTag(Child, Sourced, FollowingOffset(Target, i, Sourced, Following), [&](const Node& Element) { Size += Element.Tag.size() + 3; });
+            }
+            return Size;
+        }
+
+        // An empty Source measures the markup generated from the node's fields alone
+        std::size_t NodeSize(const Node& Target, std::string_view Source)
+        {
+            const bool Sourced = !Source.empty() && Target.HasSourceSpan();
+            const SourceSpan& Span = Target.GetSourceSpan();
+            if (IsVerbatim(Target, Sourced))
+            {
+                return Span.End - Span.Begin;
+            }
+            if (!Sourced)
+            {
+                Source = {};
+            }
+
+            switch (Target.Type)
+            {
+            case NodeType::Element:
+            {
+                std::size_t Size = 0;
+                if (Sourced && !Target.IsDirty())
+                {
+                    Size += Span.ContentBegin - Span.Begin;
+                }
+                else
+                {
+                    // "<" Tag ">"
+                    Size += Target.Tag.size() + 2;
+                    for (const auto& Attribute : Target.Attributes)
+                    {
+                        // " " Name "=\"" Value "\""
+                        Size += Attribute.first.size() + EscapedAttributeLength(Attribute.second) + 4;
+                    }
+                }
+                std::string Scratch;
+                const std::string& Tag = LowerTag(Target.Tag, Scratch);
+                if (!Utils::IsVoidElement(Tag))
+                {
+                    // "</" Tag ">"
+                    const bool CopyTags = Sourced && !Target.IsDirty();
+                    Size += ChildrenSize(Target, Utils::IsRawTextElement(Tag), Source, CopyTags ? Span.ContentEnd : GeneratedMarkup);
+                    Size += CopyTags ? Span.End - Span.ContentEnd : Target.Tag.size() + 3;
+                }
+                return Size;
+            }
+            case NodeType::Text:
+                return EscapedTextLength(Target.Text);
+            case NodeType::Comment:
+                return Target.Text.size() + 7;
+            case NodeType::Doctype:
+                return Target.Text.size() + 11;
+            case NodeType::Document:
+                return ChildrenSize(Target, false, Source, Sourced ? Span.ContentEnd : EndOfOutput) + (Sourced ? Span.End - Span.ContentEnd : 0);
+            }
+            return 0;
+        }
+    } // namespace
+
+    Serializer::Serializer(std::string& Out) : m_Out(&Out)
+    {
+    }
+
+    Serializer::Serializer(std::ostream& Stream, std::size_t ChunkSize) : m_Out(&m_Buffer), m_Stream(&Stream), m_ChunkSize(ChunkSize)
+    {
+        m_Buffer.reserve(ChunkSize);
+    }
+
+    Serializer::Serializer(std::function<void(std::string_view)> Writer, std::size_t ChunkSize) : m_Out(&m_Buffer), m_Writer(std::move(Writer)), m_ChunkSize(ChunkSize)
+    {
+        if (!m_Writer)
+        {
+            throw std::invalid_argument("Serializer writer is empty");
+        }
+        m_Buffer.reserve(ChunkSize);
+    }
+
+    Serializer::~Serializer()
+    {
+        Flush();
+    }
+
+    void Serializer::WriteOuterHtml(const Node& Target)
+    {
+        if (ShouldPrecomputeSize())
+        {
+            m_Out->reserve(m_Out->size() + NodeSize(Target, m_Source));
+        }
+        WriteNode(Target, !m_Source.empty());
+        FlushSource();
+    }
+
+    void Serializer::WriteInnerHtml(const Node& Target)
+    {
+        if (Target.Type == NodeType::Document)
+        {
+            // A document has no markup of its own, apart from source input after its last child
+            WriteOuterHtml(Target);
+            return;
+        }
+        if (ShouldPrecomputeSize())
+        {
+            // Measured against the source the same way WriteChildren copies from it
+            std::string Scratch;
+            const bool IsRawText = Target.Type == NodeType::Element && Utils::IsRawTextElement(LowerTag(Target.Tag, Scratch));
+            m_Out->reserve(m_Out->size() + ChildrenSize(Target, IsRawText, Target.HasSourceSpan() ? m_Source : std::string_view(), EndOfOutput));
+        }
+        WriteChildren(Target, !m_Source.empty() && Target.HasSourceSpan(), EndOfOutput);
+        FlushSource();
+    }
+
+    void Serializer::Flush()
+    {
+        if (m_Out != &m_Buffer || m_Buffer.empty())
+        {
+            return;
+        }
+        if (m_Stream)
+        {
+            m_Stream->write(m_Buffer.data(), static_cast<std::streamsize>(m_Buffer.size()));
+        }
+        else
+        {
+            m_Writer(m_Buffer);
+        }
+        m_Buffer.clear();
+    }
+
+    std::size_t Serializer::OuterHtmlSize(const Node& Target)
+    {
+        return NodeSize(Target, {});
+    }
+
+    std::size_t Serializer::InnerHtmlSize(const Node& Target)
+    {
+        if (Target.Type != NodeType::Element && Target.Type != NodeType::Document)
+        {
+            return 0;
+        }
+        std::string Scratch;
+        const std::string& Tag = LowerTag(Target.Tag, Scratch);
+        return ChildrenSize(Target, Target.Type == NodeType::Element && Utils::IsRawTextElement(Tag), {}, EndOfOutput);
+    }
+
+    bool Serializer::ShouldPrecomputeSize() const
+    {
+        // Chunked sinks never hold more than a chunk, so measuring only pays off for strings
+        return m_PrecomputeSize && m_Out != &m_Buffer;
+    }
+
+    void Serializer::FlushIfFull()
+    {
+        if (m_Out == &m_Buffer && m_Buffer.size() >= m_ChunkSize)
+        {
+            Flush();
+        }
+    }
+
+    void Serializer::WriteSource(std::uint32_t Begin, std::uint32_t End)
+    {
+        // Runs that continue where the pending one ends are merged, so unmodified siblings cost one copy
+        if (Begin != m_CopyEnd)
+        {
+            FlushSource();
+            m_CopyBegin = Begin;
+        }
+        m_CopyEnd = End;
+    }
+
+    void Serializer::FlushSource()
+    {
+        const std::string_view Bytes = m_Source.substr(m_CopyBegin, m_CopyEnd - m_CopyBegin);
+        m_CopyBegin = m_CopyEnd;
+        if (m_Out != &m_Buffer || Bytes.size() < m_ChunkSize)
+        {
+            m_Out->append(Bytes);
+            FlushIfFull();
+            return;
+        }
+        // Large runs bypass the chunk buffer
+        Flush();
+        if (m_Stream)
+        {
+            m_Stream->write(Bytes.data(), static_cast<std::streamsize>(Bytes.size()));
+        }
+        else
+        {
+            m_Writer(Bytes);
+        }
+    }
+
+    void Serializer::WriteNode(const Node& Target, bool Sourced)
+    {
+        // Below a node without a source span everything is generated
+        Sourced = Sourced && Target.HasSourceSpan();
+        const SourceSpan& Span = Target.GetSourceSpan();
+        std::string& Out = *m_Out;
+        if (IsVerbatim(Target, Sourced))
+        {
+            WriteSource(Span.Begin, Span.End);
+            return;
+        }
+
+        // Only the markup of dirty nodes is regenerated; clean tags around dirty children are still copied
+        const bool CopyTags = Sourced && !Target.IsDirty();
+        switch (Target.Type)
+        {
+        case NodeType::Element:
+        {
+            if (CopyTags)
+            {
+                WriteSource(Span.Begin, Span.ContentBegin);
+            }
+            else
+            {
+                FlushSource();
+                Out += '<';
+                Out += Target.Tag;
+                for (const auto& Attribute : Target.Attributes)
+                {
+                    Out += ' ';
+                    Out += Attribute.first;
+                    Out += "=\"";
+                    AppendEscapedAttribute(Out, Attribute.second);
+                    Out += '"';
+                }
+                Out += '>';
+            }
+
+            std::string Scratch;
+            if (!Utils::IsVoidElement(LowerTag(Target.Tag, Scratch)))
+            {
+                WriteChildren(Target, Sourced, CopyTags ? Span.ContentEnd : GeneratedMarkup);
+                if (CopyTags)
+                {
+                    WriteSource(Span.ContentEnd, Span.End);
+                }
+                else
+                {
+                    FlushSource();
+                    Out += "</";
+                    Out += Target.Tag;
+                    Out += '>';
+                }
+            }
+            break;
+        }
+        case NodeType::Text:
+            FlushSource();
+            AppendEscapedText(Out, Target.Text);
+            break;
+        case NodeType::Comment:
+            FlushSource();
+            Out += "<!--";
+            Out += Target.Text;
+            Out += "-->";
+            break;
+        case NodeType::Doctype:
+            FlushSource();
+            Out += "<!DOCTYPE ";
+            Out += Target.Text;
+            Out += '>';
+            break;
+        case NodeType::Document:
+            WriteChildren(Target, Sourced, Sourced ? Span.ContentEnd : EndOfOutput);
+            if (Sourced)
+            {
+                WriteSource(Span.ContentEnd, Span.End);
+            }
+            break;
+        }
+        FlushIfFull();
+    }
+
+    void Serializer::WriteChildren(const Node& Target, bool Sourced, std::uint32_t Following)
+    {
+        std::string Scratch;
+        // Raw text is emitted unescaped
+        const bool IsRawText = Target.Type == NodeType::Element && Utils::IsRawTextElement(LowerTag(Target.Tag, Scratch));
+        for (std::size_t i = 0; i < Target.Children.size(); ++i)
+        {
+            const Node& Child = *Target.Children[i];
+            if (IsRawText && Child.Type == NodeType::Text && !IsVerbatim(Child, Sourced && Child.HasSourceSpan()))
+            {
+                FlushSource();
+                *m_Out += Child.Text;
+                FlushIfFull();
+            }
+            else
+            {
+                WriteNode(Child, Sourced);
+            }
+            std::vector<const Node*> Unclosed;
+            ForEachImpliedEndTag(Child, Sourced, FollowingOffset(Target, i, Sourced, Following), [&](const Node& Element) { Unclosed.push_back(&Element); });
+            if (!Unclosed.empty())
+            {
+                FlushSource();
+                for (auto Element = Unclosed.rbegin(); Element != Unclosed.rend(); ++Element)
+                {
+                    *m_Out += "</";
+                    *m_Out += (*Element)->Tag;
+                    *m_Out += '>';
+                }
+            }
+        }
+    }
+} // namespace HtmlParser
@@ -0,0 +1,158 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HTMLPARSER_HAS_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define HTMLPARSER_HAS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace HtmlParser::Simd
+{
+    // Returns the length of the leading run of ASCII bytes.
+    inline std::size_t AsciiPrefixLength(const char* Data, std::size_t Size)
+    {
+        std::size_t i = 0;
+#if defined(HTMLPARSER_HAS_SSE2)
+        for (; i + 16 <= Size; i += 16)
+        {
+            int Mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + i)));
+            if (Mask != 0)
+            {
+#if defined(_MSC_VER) && !defined(__clang__)
+                unsigned long Index;
+                _BitScanForward(&Index, static_cast<unsigned long>(Mask));
+                return i + Index;
+#else
+                return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(Mask)));
+#endif
+            }
+        }
+#elif defined(HTMLPARSER_HAS_NEON)
+        for (; i + 16 <= Size; i += 16)
+        {
+            if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(Data + i))) >= 0x80)
+            {
+                break;
+            }
+        }
+#else
+        for (; i + 8 <= Size; i += 8)
+        {
+            std::uint64_t Word;
+            std::memcpy(&Word, Data + i, sizeof(Word));
+            if (Word & 0x8080808080808080ull)
+            {
+                break;
+            }
+        }
+#endif
+        while (i < Size && static_cast<unsigned char>(Data[i]) < 0x80)
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    // Returns the index of the first byte equal to one of Set, or Size if there is none.
+    template <char... Set>
+    inline std::size_t FindFirstOf(const char* Data, std::size_t Size)
+    {
+        std::size_t i = 0;
+#if defined(HTMLPARSER_HAS_SSE2)
+        for (; i + 16 <= Size; i += 16)
+        {
+            const __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + i));
+            __m128i Matches = _mm_setzero_si128();
+            ((Matches = _mm_or_si128(Matches, _mm_cmpeq_epi8(Chunk, _mm_set1_epi8(Set)))), ...);
+            const int Mask = _mm_movemask_epi8(Matches);
+            if (Mask != 0)
+            {
+#if defined(_MSC_VER) && !defined(__clang__)
+                unsigned long Index;
+                _BitScanForward(&Index, static_cast<unsigned long>(Mask));
+                return i + Index;
+#else
+                return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(Mask)));
+#endif
+            }
+        }
+#elif defined(HTMLPARSER_HAS_NEON)
+        for (; i + 16 <= Size; i += 16)
+        {
+            const uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const std::uint8_t*>(Data + i));
+            uint8x16_t Matches = vdupq_n_u8(0);
+            ((Matches = vorrq_u8(Matches, vceqq_u8(Chunk, vdupq_n_u8(static_cast<std::uint8_t>(Set))))), ...);
+            if (vmaxvq_u8(Matches) != 0)
+            {
+                break;
+            }
+        }
+#endif
+        for (; i < Size; ++i)
+        {
+            if (((Data[i] == Set) || ...))
+            {
+                return i;
+            }
+        }
+        return Size;
+    }
+    // Returns the length of the leading run in which whitespace only appears as single spaces between other
+    // bytes, which is the part whitespace collapsing leaves unchanged. A space at either end of the input ends
+    // the run.
+    inline std::size_t CollapsedRunLength(const char* Data, std::size_t Size)
+    {
+        const auto IsWhitespace = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f'; };
+        std::size_t i = 0;
+#if defined(HTMLPARSER_HAS_SSE2)
+        // Text nodes are short, so the last partial chunk is copied out and handled the same way
+        char Tail[16];
+        while (i < Size)
+        {
+            const std::size_t Count = Size - i < 16 ? Size - i : 16;
+            const char* Chunk = Data + i;
+            if (Count < 16)
+            {
+                std::memcpy(Tail, Chunk, Count);
+                Chunk = Tail;
+            }
+            const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Chunk));
+            const __m128i Spaces = _mm_cmpeq_epi8(Bytes, _mm_set1_epi8(' '));
+            const __m128i Controls = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Bytes, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(Bytes, _mm_set1_epi8('\n'))),
+                                                  _mm_or_si128(_mm_cmpeq_epi8(Bytes, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(Bytes, _mm_set1_epi8('\f'))));
+            const __m128i Whitespace = _mm_or_si128(Spaces, Controls);
+            // Bit j of Before and After tells whether the bytes around byte j are whitespace or missing
+            const unsigned Valid = (1u << Count) - 1;
+            const unsigned Current = static_cast<unsigned>(_mm_movemask_epi8(Whitespace)) & Valid;
+            const unsigned Before = (Current << 1) | (i == 0 || IsWhitespace(Data[i - 1]) ? 1u : 0u);
+            const unsigned After = (Current >> 1) | (i + Count == Size || IsWhitespace(Data[i + Count]) ? 1u << (Count - 1) : 0u);
+            const unsigned Single = static_cast<unsigned>(_mm_movemask_epi8(Spaces)) & ~Before & ~After;
+            const unsigned Changed = Current & ~Single;
+            if (Changed != 0)
+            {
+#if defined(_MSC_VER) && !defined(__clang__)
+                unsigned long Index;
+                _BitScanForward(&Index, static_cast<unsigned long>(Changed));
+                return i + Index;
+#else
+                return i + static_cast<std::size_t>(__builtin_ctz(Changed));
+#endif
+            }
+            i += Count;
+        }
+#endif
+        for (; i < Size; ++i)
+        {
+            if (IsWhitespace(Data[i]) && (Data[i] != ' ' || i == 0 || i + 1 == Size || IsWhitespace(Data[i - 1]) || IsWhitespace(Data[i + 1])))
+            {
+                return i;
+            }
+        }
+        return Size;
+    }
+} // namespace HtmlParser::Simd
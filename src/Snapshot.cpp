@@ -0,0 +1,556 @@
+#include <HtmlParser/MappedFile.hpp>
+#include <HtmlParser/Snapshot.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "SelectorEngine.hpp"
+#include "Utilities.hpp"
+
+namespace HtmlParser
+{
+    namespace
+    {
+        constexpr char Magic[8] = {'H', 'T', 'M', 'L', 'S', 'N', 'A', 'P'};
+        constexpr std::uint32_t NoNode = std::numeric_limits<std::uint32_t>::max();
+
+        struct Header
+        {
+            char Magic[8];
+            std::uint32_t Version;
+            std::uint32_t NodeCount;
+            std::uint32_t AttributeCount;
+            std::uint32_t StringBytes;
+            std::uint32_t Truncation;
+            std::uint32_t Reserved;
+        };
+
+        void RequireLittleEndian()
+        {
+            if constexpr (std::endian::native != std::endian::little)
+            {
+                throw std::runtime_error("Snapshots are only supported on little-endian hosts");
+            }
+        }
+
+        bool ContainsClass(std::string_view Classes, std::string_view ClassName)
+        {
+            std::size_t Position = 0;
+            while (Position < Classes.size())
+            {
+                const std::size_t Start = Classes.find_first_not_of(" \t\n\r\f", Position);
+                if (Start == std::string_view::npos)
+                {
+                    break;
+                }
+                std::size_t End = Classes.find_first_of(" \t\n\r\f", Start);
+                End = End == std::string_view::npos ? Classes.size() : End;
+                if (Classes.substr(Start, End - Start) == ClassName)
+                {
+                    return true;
+                }
+                Position = End;
+            }
+            return false;
+        }
+    } // namespace
+
+    namespace Selectors
+    {
+        template <>
+        struct NodeTraits<SnapshotNode>
+        {
+            static bool IsElement(const SnapshotNode& ElementNode)
+            {
+                return ElementNode.Type() == NodeType::Element;
+            }
+
+            static bool HasTag(const SnapshotNode& ElementNode, const Atom& Name)
+            {
+                return Utils::EqualsIgnoreCase(ElementNode.Tag(), Name);
+            }
+
+            static bool HasClass(const SnapshotNode& ElementNode, const std::string& ClassName)
+            {
+                return ElementNode.HasClass(ClassName);
+            }
+
+            static bool HasAttribute(const SnapshotNode& ElementNode, const Atom& Name)
+            {
+                return ElementNode.HasAttribute(Name);
+            }
+
+            static std::string_view GetAttribute(const SnapshotNode& ElementNode, const Atom& Name)
+            {
+                return ElementNode.GetAttribute(Name);
+            }
+
+            template <typename Function>
+            static void ForEachChild(const SnapshotNode& ElementNode, Function&& Visitor)
+            {
+                for (SnapshotNode Child = ElementNode.FirstChild(); Child; Child = Child.NextSibling())
+                {
+                    Visitor(Child);
+                }
+            }
+        };
+    } // namespace Selectors
+
+    std::string Snapshot::Write(const DOM& Document)
+    {
+        RequireLittleEndian();
+
+        // Local so that it can use the private record types
+        struct Builder
+        {
+            std::vector<NodeRecord> Nodes;
+            std::vector<AttributeRecord> Attributes;
+            std::string Strings;
+            // Tag and attribute names repeat, so each is stored once
+            std::unordered_map<std::string, StringRef> Names;
+
+            StringRef AddString(std::string_view Value)
+            {
+                if (Strings.size() + Value.size() > std::numeric_limits<std::uint32_t>::max())
+                {
+                    throw std::runtime_error("Document too large for a snapshot");
+                }
+                StringRef Ref{static_cast<std::uint32_t>(Strings.size()), static_cast<std::uint32_t>(Value.size())};
+                Strings.append(Value);
+                return Ref;
+            }
+
+            StringRef AddName(const std::string& Name)
+            {
+                auto it = Names.find(Name);
+                if (it != Names.end())
+                {
+                    return it->second;
+                }
+                return Names.emplace(Name, AddString(Name)).first->second;
+            }
+
+            std::uint32_t AddNode(const Node& Source, std::uint32_t Parent)
+            {
+                if (Nodes.size() >= NoNode)
+                {
+                    throw std::runtime_error("Document too large for a snapshot");
+                }
+                const auto Index = static_cast<std::uint32_t>(Nodes.size());
+                NodeRecord Record{};
+                Record.Type = static_cast<std::uint8_t>(Source.Type);
+                Record.Parent = Parent;
+                Record.NextSibling = NoNode;
+                Record.Tag = AddName(Source.Tag);
+                Record.Text = AddString(Source.Text);
+                Record.FirstAttribute = static_cast<std::uint32_t>(Attributes.size());
+                Record.AttributeCount = static_cast<std::uint32_t>(Source.Attributes.size());
+
+                std::vector<const std::pair<const Atom, StringValue>*> Sorted;
+                Sorted.reserve(Source.Attributes.size());
+                for (const auto& Attribute : Source.Attributes)
+                {
+                    Sorted.push_back(&Attribute);
+                }
+                std::sort(Sorted.begin(), Sorted.end(), [](const auto* Left, const auto* Right) { return Left->first.View() < Right->first.View(); });
+                for (const auto* Attribute : Sorted)
+                {
+                    Attributes.push_back({AddName(Attribute->first), AddString(Attribute->second)});
+                }
+                Nodes.push_back(Record);
+
+                std::uint32_t Previous = NoNode;
+                for (const auto& Child : Source.Children)
+                {
+                    const std::uint32_t ChildIndex = AddNode(*Child, Index);
+                    if (Previous != NoNode)
+                    {
+                        Nodes[Previous].NextSibling = ChildIndex;
+                    }
+                    Previous = ChildIndex;
+                }
+                Nodes[Index].SubtreeEnd = static_cast<std::uint32_t>(Nodes.size());
+                return Index;
+            }
+        };
+
+        Builder Tables;
+        Tables.AddNode(*Document.Root(), NoNode);
+
+        Header Head{};
+        std::memcpy(Head.Magic, Magic, sizeof(Magic));
+        Head.Version = FormatVersion;
+        Head.NodeCount = static_cast<std::uint32_t>(Tables.Nodes.size());
+        Head.AttributeCount = static_cast<std::uint32_t>(Tables.Attributes.size());
+        Head.StringBytes = static_cast<std::uint32_t>(Tables.Strings.size());
+        Head.Truncation = static_cast<std::uint32_t>(Document.GetTruncationReason());
+
+        const std::size_t NodeBytes = Tables.Nodes.size() * sizeof(NodeRecord);
+        const std::size_t AttributeBytes = Tables.Attributes.size() * sizeof(AttributeRecord);
+        std::string Bytes;
+        Bytes.reserve(sizeof(Header) + NodeBytes + AttributeBytes + Tables.Strings.size());
+        Bytes.append(reinterpret_cast<const char*>(&Head), sizeof(Header));
+        Bytes.append(reinterpret_cast<const char*>(Tables.Nodes.data()), NodeBytes);
+        Bytes.append(reinterpret_cast<const char*>(Tables.Attributes.data()), AttributeBytes);
+        Bytes.append(Tables.Strings);
+        return Bytes;
+    }
+
+    void Snapshot::Write(const DOM& Document, std::ostream& Stream)
+    {
+        const std::string Bytes = Write(Document);
+        Stream.write(Bytes.data(), static_cast<std::streamsize>(Bytes.size()));
+    }
+
+    Snapshot Snapshot::FromBytes(std::string_view Bytes, std::shared_ptr<const void> Owner)
+    {
+        RequireLittleEndian();
+        static_assert(sizeof(Header) == 32 && sizeof(NodeRecord) == 40 && sizeof(AttributeRecord) == 16);
+
+        Header Head;
+        if (Bytes.size() < sizeof(Header))
+        {
+            throw std::runtime_error("Not a snapshot");
+        }
+        std::memcpy(&Head, Bytes.data(), sizeof(Header));
+        if (std::memcmp(Head.Magic, Magic, sizeof(Magic)) != 0)
+        {
+            throw std::runtime_error("Not a snapshot");
+        }
+        if (Head.Version != FormatVersion)
+        {
+            throw std::runtime_error("Unsupported snapshot version: " + std::to_string(Head.Version));
+        }
+
+        Snapshot Result;
+        Result.m_NodeCount = Head.NodeCount;
+        Result.m_AttributeCount = Head.AttributeCount;
+        Result.m_NodeTable = sizeof(Header);
+        Result.m_AttributeTable = Result.m_NodeTable + std::size_t(Head.NodeCount) * sizeof(NodeRecord);
+        Result.m_StringTable = Result.m_AttributeTable + std::size_t(Head.AttributeCount) * sizeof(AttributeRecord);
+        Result.m_StringBytes = Head.StringBytes;
+        if (Head.NodeCount == 0 || Result.m_StringTable + Result.m_StringBytes != Bytes.size() || Head.Truncation > static_cast<std::uint32_t>(TruncationReason::StopCondition))
+        {
+            throw std::runtime_error("Corrupt snapshot");
+        }
+        Result.m_Truncation = static_cast<TruncationReason>(Head.Truncation);
+        Result.m_Bytes = Bytes;
+        Result.m_Owner = std::move(Owner);
+        return Result;
+    }
+
+    Snapshot Snapshot::Open(const std::string& Path)
+    {
+        auto File = std::make_shared<const MappedFile>(Path);
+        return FromBytes(File->View(), File);
+    }
+
+    std::size_t Snapshot::NodeCount() const
+    {
+        return m_NodeCount;
+    }
+
+    SnapshotNode Snapshot::Root() const
+    {
+        return SnapshotNode(this, 0);
+    }
+
+    SnapshotNode Snapshot::NodeAt(std::uint32_t Index) const
+    {
+        return Index < m_NodeCount ? SnapshotNode(this, Index) : SnapshotNode();
+    }
+
+    TruncationReason Snapshot::GetTruncationReason() const
+    {
+        return m_Truncation;
+    }
+
+    Snapshot::NodeRecord Snapshot::ReadNode(std::uint32_t Index) const
+    {
+        if (Index >= m_NodeCount)
+        {
+            throw std::runtime_error("Corrupt snapshot");
+        }
+        NodeRecord Record;
+        std::memcpy(&Record, m_Bytes.data() + m_NodeTable + std::size_t(Index) * sizeof(NodeRecord), sizeof(NodeRecord));
+        // In document order a parent comes before its children and a next sibling starts where the subtree
+        // ends, so links that could form a cycle are rejected
+        if (Record.Type > static_cast<std::uint8_t>(NodeType::Doctype) || Record.SubtreeEnd <= Index || Record.SubtreeEnd > m_NodeCount ||
+            (Record.NextSibling != NoNode && Record.NextSibling != Record.SubtreeEnd) || (Record.Parent != NoNode && Record.Parent >= Index))
+        {
+            throw std::runtime_error("Corrupt snapshot");
+        }
+        return Record;
+    }
+
+    Snapshot::AttributeRecord Snapshot::ReadAttribute(std::uint32_t Index) const
+    {
+        if (Index >= m_AttributeCount)
+        {
+            throw std::runtime_error("Corrupt snapshot");
+        }
+        AttributeRecord Record;
+        std::memcpy(&Record, m_Bytes.data() + m_AttributeTable + std::size_t(Index) * sizeof(AttributeRecord), sizeof(AttributeRecord));
+        return Record;
+    }
+
+    std::string_view Snapshot::ReadString(const StringRef& Ref) const
+    {
+        if (std::size_t(Ref.Offset) + Ref.Length > m_StringBytes)
+        {
+            throw std::runtime_error("Corrupt snapshot");
+        }
+        return m_Bytes.substr(m_StringTable + Ref.Offset, Ref.Length);
+    }
+
+    void Snapshot::Traverse(const std::function<void(const SnapshotNode&)>& Visitor) const
+    {
+        for (std::uint32_t i = 0; i < m_NodeCount; ++i)
+        {
+            Visitor(SnapshotNode(this, i));
+        }
+    }
+
+    std::vector<SnapshotNode> Snapshot::GetElementsByTagName(std::string_view TagName) const
+    {
+        // Document order is table order, so this is a linear scan over fixed-size records
+        std::vector<SnapshotNode> Elements;
+        for (std::uint32_t i = 0; i < m_NodeCount; ++i)
+        {
+            const NodeRecord Record = ReadNode(i);
+            if (Record.Type == static_cast<std::uint8_t>(NodeType::Element) && Utils::EqualsIgnoreCase(ReadString(Record.Tag), TagName))
+            {
+                Elements.push_back(SnapshotNode(this, i));
+            }
+        }
+        return Elements;
+    }
+
+    std::vector<SnapshotNode> Snapshot::GetElementsByClassName(std::string_view ClassName) const
+    {
+        std::vector<SnapshotNode> Elements;
+        for (std::uint32_t i = 0; i < m_NodeCount; ++i)
+        {
+            SnapshotNode Candidate(this, i);
+            if (Candidate.Type() == NodeType::Element && Candidate.HasClass(ClassName))
+            {
+                Elements.push_back(Candidate);
+            }
+        }
+        return Elements;
+    }
+
+    SnapshotNode Snapshot::GetElementById(std::string_view Id) const
+    {
+        for (std::uint32_t i = 0; i < m_NodeCount; ++i)
+        {
+            SnapshotNode Candidate(this, i);
+            if (Candidate.Type() == NodeType::Element && Candidate.HasAttribute("id") && Candidate.GetAttribute("id") == Id)
+            {
+                return Candidate;
+            }
+        }
+        return SnapshotNode();
+    }
+
+    std::vector<SnapshotNode> Snapshot::Select(const std::string& Selector) const
+    {
+        return Root().Select(Selector);
+    }
+
+    SnapshotNode Snapshot::SelectFirst(const std::string& Selector) const
+    {
+        return Root().SelectFirst(Selector);
+    }
+
+    DOM Snapshot::ToDOM() const
+    {
+        // Values can reference the snapshot only if something keeps it alive
+        const bool Borrow = m_Owner != nullptr;
+        const auto MakeValue = [Borrow](std::string_view Value) { return Borrow ? StringValue::Borrow(Value) : StringValue(std::string(Value)); };
+
+        std::vector<std::shared_ptr<Node>> Nodes(m_NodeCount);
+        for (std::uint32_t i = 0; i < m_NodeCount; ++i)
+        {
+            const NodeRecord Record = ReadNode(i);
+            auto Created = std::make_shared<Node>(static_cast<NodeType>(Record.Type));
+            Created->Tag = ReadString(Record.Tag);
+            Created->Text = MakeValue(ReadString(Record.Text));
+            for (std::uint32_t a = 0; a < Record.AttributeCount; ++a)
+            {
+                const AttributeRecord Attribute = ReadAttribute(Record.FirstAttribute + a);
+                Created->Attributes.emplace(ReadString(Attribute.Name), MakeValue(ReadString(Attribute.Value)));
+            }
+
+            if (i > 0)
+            {
+                // A parent always precedes its children
+                if (Record.Parent >= i)
+                {
+                    throw std::runtime_error("Corrupt snapshot");
+                }
+                Created->Parent = Nodes[Record.Parent];
+                Created->m_Position = static_cast<std::uint32_t>(Nodes[Record.Parent]->Children.size());
+                Nodes[Record.Parent]->Children.push_back(Created);
+            }
+            Nodes[i] = std::move(Created);
+        }
+        return DOM(Nodes[0], m_Truncation, {}, m_Owner);
+    }
+
+    NodeType SnapshotNode::Type() const
+    {
+        return static_cast<NodeType>(m_Snapshot->ReadNode(m_Index).Type);
+    }
+
+    std::string_view SnapshotNode::Tag() const
+    {
+        return m_Snapshot->ReadString(m_Snapshot->ReadNode(m_Index).Tag);
+    }
+
+    std::string_view SnapshotNode::Text() const
+    {
+        return m_Snapshot->ReadString(m_Snapshot->ReadNode(m_Index).Text);
+    }
+
+    SnapshotNode SnapshotNode::Parent() const
+    {
+        const std::uint32_t Index = m_Snapshot->ReadNode(m_Index).Parent;
+        return Index == NoNode ? SnapshotNode() : m_Snapshot->NodeAt(Index);
+    }
+
+    SnapshotNode SnapshotNode::FirstChild() const
+    {
+        return m_Snapshot->ReadNode(m_Index).SubtreeEnd > m_Index + 1 ? SnapshotNode(m_Snapshot, m_Index + 1) : SnapshotNode();
+    }
+
+    SnapshotNode SnapshotNode::NextSibling() const
+    {
+        const std::uint32_t Index = m_Snapshot->ReadNode(m_Index).NextSibling;
+        return Index == NoNode ? SnapshotNode() : m_Snapshot->NodeAt(Index);
+    }
+
+    std::vector<SnapshotNode> SnapshotNode::Children() const
+    {
+        std::vector<SnapshotNode> Result;
+        for (SnapshotNode Child = FirstChild(); Child; Child = Child.NextSibling())
+        {
+            Result.push_back(Child);
+        }
+        return Result;
+    }
+
+    std::size_t SnapshotNode::AttributeCount() const
+    {
+        return m_Snapshot->ReadNode(m_Index).AttributeCount;
+    }
+
+    std::string_view SnapshotNode::AttributeName(std::size_t Position) const
+    {
+        const auto Record = m_Snapshot->ReadNode(m_Index);
+        if (Position >= Record.AttributeCount)
+        {
+            return {};
+        }
+        return m_Snapshot->ReadString(m_Snapshot->ReadAttribute(Record.FirstAttribute + static_cast<std::uint32_t>(Position)).Name);
+    }
+
+    std::string_view SnapshotNode::AttributeValue(std::size_t Position) const
+    {
+        const auto Record = m_Snapshot->ReadNode(m_Index);
+        if (Position >= Record.AttributeCount)
+        {
+            return {};
+        }
+        return m_Snapshot->ReadString(m_Snapshot->ReadAttribute(Record.FirstAttribute + static_cast<std::uint32_t>(Position)).Value);
+    }
+
+    bool SnapshotNode::HasAttribute(std::string_view Name) const
+    {
+        // Names are sorted, so look them up by binary search
+        const auto Record = m_Snapshot->ReadNode(m_Index);
+        std::uint32_t Low = 0;
+        std::uint32_t High = Record.AttributeCount;
+        while (Low < High)
+        {
+            const std::uint32_t Middle = Low + (High - Low) / 2;
+            const std::string_view Candidate = m_Snapshot->ReadString(m_Snapshot->ReadAttribute(Record.FirstAttribute + Middle).Name);
+            if (Candidate == Name)
+            {
+                return true;
+            }
+            if (Candidate < Name)
+            {
+                Low = Middle + 1;
+            }
+            else
+            {
+                High = Middle;
+            }
+        }
+        return false;
+    }
+
+    std::string_view SnapshotNode::GetAttribute(std::string_view Name) const
+    {
+        const auto Record = m_Snapshot->ReadNode(m_Index);
+        std::uint32_t Low = 0;
+        std::uint32_t High = Record.AttributeCount;
+        while (Low < High)
+        {
+            const std::uint32_t Middle = Low + (High - Low) / 2;
+            const auto Attribute = m_Snapshot->ReadAttribute(Record.FirstAttribute + Middle);
+            const std::string_view Candidate = m_Snapshot->ReadString(Attribute.Name);
+            if (Candidate == Name)
+            {
+                return m_Snapshot->ReadString(Attribute.Value);
+            }
+            if (Candidate < Name)
+            {
+                Low = Middle + 1;
+            }
+            else
+            {
+                High = Middle;
+            }
+        }
+        return {};
+    }
+
+    bool SnapshotNode::HasClass(std::string_view ClassName) const
+    {
+        return ContainsClass(GetAttribute("class"), ClassName);
+    }
+
+    std::string SnapshotNode::GetTextContent() const
+    {
+        // Descendants follow the node directly in the table
+        const auto Record = m_Snapshot->ReadNode(m_Index);
+        std::string Result;
+        for (std::uint32_t i = m_Index; i < Record.SubtreeEnd; ++i)
+        {
+            const auto Descendant = m_Snapshot->ReadNode(i);
+            if (Descendant.Type == static_cast<std::uint8_t>(NodeType::Text))
+            {
+                Result += m_Snapshot->ReadString(Descendant.Text);
+            }
+        }
+        return Result;
+    }
+
+    std::vector<SnapshotNode> SnapshotNode::Select(const std::string& Selector) const
+    {
+        std::vector<SnapshotNode> Results;
+        Selectors::Select(*this, Selectors::Compile(Selector), 0, Results);
+        return Results;
+    }
+
+    SnapshotNode SnapshotNode::SelectFirst(const std::string& Selector) const
+    {
+        std::vector<SnapshotNode> Results = Select(Selector);
+        return Results.empty() ? SnapshotNode() : Results[0];
+    }
+} // namespace HtmlParser
@@ -0,0 +1,436 @@
+#include <HtmlParser/TextExtractor.hpp>
+#include <stdexcept>
+
+#include "CharacterClasses.hpp"
+#include "CharacterReferences.hpp"
+#include "Simd.hpp"
+
+namespace HtmlParser
+{
+    namespace
+    {
+        // Bit flags describing how an element affects the extracted text
+        enum ElementKind : std::uint8_t
+        {
+            Invisible = 1,
+            Block = 2,
+            LineBreak = 4,
+            Cell = 8,
+            Preformatted = 16,
+            RawText = 32,
+        };
+
+        std::uint8_t GetLowercaseTagKind(std::string_view Tag)
+        {
+            switch (Tag.size())
+            {
+            case 1:
+                return Tag == "p" ? Block : 0;
+            case 2:
+                if (Tag == "br")
+                {
+                    return LineBreak;
+                }
+                if (Tag == "td" || Tag == "th")
+                {
+                    return Cell;
+                }
+                return (Tag[0] == 'h' && Tag[1] >= '1' && Tag[1] <= '6') || Tag == "li" || Tag == "tr" || Tag == "ul" || Tag == "ol" || Tag == "dd" || Tag == "dl" ||
+                               Tag == "dt" || Tag == "hr"
+                           ? Block
+                           : 0;
+            case 3:
+                if (Tag == "pre")
+                {
+                    return Block | Preformatted;
+                }
+                if (Tag == "xmp")
+                {
+                    return RawText;
+                }
+                return Tag == "div" || Tag == "nav" || Tag == "dir" ? Block : 0;
+            case 4:
+                if (Tag == "head")
+                {
+                    return Invisible;
+                }
+                return Tag == "form" || Tag == "main" || Tag == "menu" ? Block : 0;
+            case 5:
+                if (Tag == "style")
+                {
+                    return Invisible | RawText;
+                }
+                return Tag == "aside" || Tag == "table" ? Block : 0;
+            case 6:
+                if (Tag == "script")
+                {
+                    return Invisible | RawText;
+                }
+                if (Tag == "iframe")
+                {
+                    return RawText;
+                }
+                return Tag == "header" || Tag == "footer" || Tag == "figure" || Tag == "center" || Tag == "hgroup" || Tag == "legend" || Tag == "dialog" ? Block : 0;
+            case 7:
+                if (Tag == "listing")
+                {
+                    return Block | Preformatted;
+                }
+                if (Tag == "noembed")
+                {
+                    return RawText;
+                }
+                return Tag == "section" || Tag == "article" || Tag == "address" || Tag == "details" || Tag == "summary" || Tag == "caption" ? Block : 0;
+            case 8:
+                if (Tag == "template" || Tag == "noscript")
+                {
+                    return Invisible;
+                }
+                if (Tag == "noframes")
+                {
+                    return RawText;
+                }
+                if (Tag == "textarea")
+                {
+                    return Preformatted;
+                }
+                return Tag == "fieldset" ? Block : 0;
+            case 9:
+                return Tag == "plaintext" ? Preformatted : 0;
+            case 10:
+                return Tag == "blockquote" || Tag == "figcaption" ? Block : 0;
+            default:
+                return 0;
+            }
+        }
+
+        std::uint8_t GetTagKind(std::string_view Tag)
+        {
+            // Tags built by the parser are already lowercase; only others need a copy
+            char Lowercase[10];
+            if (Tag.size() > sizeof(Lowercase))
+            {
+                return 0;
+            }
+            for (std::size_t i = 0; i < Tag.size(); ++i)
+            {
+                if (Tag[i] >= 'A' && Tag[i] <= 'Z')
+                {
+                    for (std::size_t j = 0; j < Tag.size(); ++j)
+                    {
+                        Lowercase[j] = CharacterClasses::LowerTable[static_cast<unsigned char>(Tag[j])];
+                    }
+                    return GetLowercaseTagKind(std::string_view(Lowercase, Tag.size()));
+                }
+            }
+            return GetLowercaseTagKind(Tag);
+        }
+
+        bool IsWhitespace(char c)
+        {
+            return CharacterClasses::Is(c, CharacterClasses::Whitespace);
+        }
+    } // namespace
+
+    TextExtractor::TextExtractor(std::string& Out) : m_Out(&Out)
+    {
+    }
+
+    TextExtractor::TextExtractor(std::ostream& Stream, std::size_t ChunkSize) : m_Out(&m_Buffer), m_Stream(&Stream), m_ChunkSize(ChunkSize)
+    {
+        m_Buffer.reserve(ChunkSize);
+    }
+
+    TextExtractor::TextExtractor(std::function<void(std::string_view)> Writer, std::size_t ChunkSize) : m_Out(&m_Buffer), m_Writer(std::move(Writer)), m_ChunkSize(ChunkSize)
+    {
+        if (!m_Writer)
+        {
+            throw std::invalid_argument("TextExtractor writer is empty");
+        }
+        m_Buffer.reserve(ChunkSize);
+    }
+
+    TextExtractor::~TextExtractor()
+    {
+        Flush();
+    }
+
+    void TextExtractor::Write(const Node& Target)
+    {
+        static const Atom HiddenAttribute("hidden");
+        const bool Classify = NeedsKinds();
+        const auto GetKind = [&](const Node& Element) -> std::uint8_t {
+            if (!Classify)
+            {
+                return 0;
+            }
+            const bool Hidden = m_Options.SkipInvisible && !Element.Attributes.empty() && Element.Attributes.count(HiddenAttribute) != 0;
+            return GetTagKind(Element.Tag) | (Hidden ? Invisible : 0);
+        };
+
+        Begin();
+        m_Stack.clear();
+        if (Target.Type == NodeType::Text)
+        {
+            WriteText(Target.Text, false);
+        }
+        else if (Target.Type == NodeType::Document)
+        {
+            m_Stack.push_back({&Target, 0, 0});
+        }
+        else if (Target.Type == NodeType::Element)
+        {
+            const std::uint8_t Kind = GetKind(Target);
+            if (Enter(Kind))
+            {
+                m_Stack.push_back({&Target, 0, Kind});
+            }
+        }
+
+        // Children are visited through an explicit stack, so deep trees neither recurse nor copy text per level
+        while (!m_Stack.empty())
+        {
+            Frame& Top = m_Stack.back();
+            if (Top.NextChild == Top.Target->Children.size())
+            {
+                const std::uint8_t Kind = Top.Kind;
+                m_Stack.pop_back();
+                Leave(Kind);
+                continue;
+            }
+            const Node& Child = *Top.Target->Children[Top.NextChild++];
+            if (Child.Type == NodeType::Text)
+            {
+                WriteText(Child.Text, m_RawTextDepth != 0);
+            }
+            else if (Child.Type == NodeType::Element)
+            {
+                const std::uint8_t Kind = GetKind(Child);
+                if (Enter(Kind))
+                {
+                    m_Stack.push_back({&Child, 0, Kind});
+                }
+            }
+        }
+        End();
+    }
+
+    void TextExtractor::Write(const SnapshotNode& Target)
+    {
+        const Snapshot& Owner = *Target.m_Snapshot;
+        const bool Classify = NeedsKinds();
+
+        Begin();
+        m_SnapshotStack.clear();
+        // Descendants follow the node directly in the table, so elements end where their subtree does
+        const std::uint32_t RootEnd = Owner.ReadNode(Target.Index()).SubtreeEnd;
+        std::uint32_t i = Target.Index();
+        while (i < RootEnd)
+        {
+            while (!m_SnapshotStack.empty() && m_SnapshotStack.back().SubtreeEnd <= i)
+            {
+                const std::uint8_t Kind = m_SnapshotStack.back().Kind;
+                m_SnapshotStack.pop_back();
+                Leave(Kind);
+            }
+
+            const Snapshot::NodeRecord Record = Owner.ReadNode(i);
+            if (Record.Type == static_cast<std::uint8_t>(NodeType::Text))
+            {
+                WriteText(Owner.ReadString(Record.Text), m_RawTextDepth != 0);
+            }
+            else if (Record.Type == static_cast<std::uint8_t>(NodeType::Element))
+            {
+                std::uint8_t Kind = 0;
+                if (Classify)
+                {
+                    const bool Hidden = m_Options.SkipInvisible && Record.AttributeCount != 0 && Owner.NodeAt(i).HasAttribute("hidden");
+                    Kind = GetTagKind(Owner.ReadString(Record.Tag)) | (Hidden ? Invisible : 0);
+                }
+                if (!Enter(Kind))
+                {
+                    i = Record.SubtreeEnd;
+                    continue;
+                }
+                m_SnapshotStack.push_back({Record.SubtreeEnd, Kind});
+            }
+            ++i;
+        }
+        while (!m_SnapshotStack.empty())
+        {
+            const std::uint8_t Kind = m_SnapshotStack.back().Kind;
+            m_SnapshotStack.pop_back();
+            Leave(Kind);
+        }
+        End();
+    }
+
+    void TextExtractor::Flush()
+    {
+        if (m_Out != &m_Buffer || m_Buffer.empty())
+        {
+            return;
+        }
+        if (m_Stream)
+        {
+            m_Stream->write(m_Buffer.data(), static_cast<std::streamsize>(m_Buffer.size()));
+        }
+        else
+        {
+            m_Writer(m_Buffer);
+        }
+        m_Buffer.clear();
+    }
+
+    void TextExtractor::Begin()
+    {
+        m_PendingSpace = false;
+        m_PendingNewline = false;
+        m_PreformattedDepth = 0;
+        m_RawTextDepth = 0;
+    }
+
+    void TextExtractor::End()
+    {
+        // Separators only go between text, so none are left after the last of it
+        m_PendingSpace = false;
+        m_PendingNewline = false;
+    }
+
+    bool TextExtractor::NeedsKinds() const
+    {
+        return m_Options.SkipInvisible || m_Options.CollapseWhitespace || m_Options.BlockSeparators || m_Options.DecodeEntities;
+    }
+
+    bool TextExtractor::Enter(std::uint8_t Kind)
+    {
+        if (m_Options.SkipInvisible && (Kind & Invisible))
+        {
+            return false;
+        }
+        if (m_Options.BlockSeparators)
+        {
+            if (Kind & LineBreak)
+            {
+                WritePendingSeparator();
+                m_Out->push_back('\n');
+                m_AtLineStart = true;
+            }
+            else if (Kind & Block)
+            {
+                m_PendingNewline = true;
+            }
+        }
+        if (Kind & Preformatted)
+        {
+            ++m_PreformattedDepth;
+        }
+        if (Kind & RawText)
+        {
+            ++m_RawTextDepth;
+        }
+        return true;
+    }
+
+    void TextExtractor::Leave(std::uint8_t Kind)
+    {
+        if (m_Options.BlockSeparators)
+        {
+            if (Kind & Block)
+            {
+                m_PendingNewline = true;
+            }
+            else if (Kind & Cell)
+            {
+                m_PendingSpace = true;
+            }
+        }
+        if (Kind & Preformatted)
+        {
+            --m_PreformattedDepth;
+        }
+        if (Kind & RawText)
+        {
+            --m_RawTextDepth;
+        }
+    }
+
+    void TextExtractor::WriteText(std::string_view Text, bool InRawText)
+    {
+        if (Text.empty())
+        {
+            return;
+        }
+        if (m_Options.DecodeEntities && !InRawText && Simd::FindFirstOf<'&'>(Text.data(), Text.size()) != Text.size())
+        {
+            m_Decoded.clear();
+            CharacterReferences::DecodeReferences(Text, false, m_Decoded);
+            Text = m_Decoded;
+        }
+
+        if (m_Options.CollapseWhitespace && m_PreformattedDepth == 0)
+        {
+            WriteCollapsed(Text);
+        }
+        else if (!Text.empty())
+        {
+            WritePendingSeparator();
+            m_Out->append(Text);
+            m_AtLineStart = Text.back() == '\n';
+        }
+        FlushIfFull();
+    }
+
+    void TextExtractor::WriteCollapsed(std::string_view Text)
+    {
+        const char* Data = Text.data();
+        const std::size_t Size = Text.size();
+        std::size_t i = 0;
+        while (i < Size)
+        {
+            if (IsWhitespace(Data[i]))
+            {
+                do
+                {
+                    ++i;
+                } while (i < Size && IsWhitespace(Data[i]));
+                m_PendingSpace = true;
+                continue;
+            }
+
+            WritePendingSeparator();
+            // Single spaces between words are already collapsed, so prose is copied a sentence at a time
+            const std::size_t Length = Simd::CollapsedRunLength(Data + i, Size - i);
+            m_Out->append(Data + i, Length);
+            i += Length;
+            m_AtLineStart = false;
+        }
+    }
+
+    void TextExtractor::WritePendingSeparator()
+    {
+        // Separators are never written at the start of a line, so nested blocks give a single line break
+        if (!m_AtLineStart)
+        {
+            if (m_PendingNewline)
+            {
+                m_Out->push_back('\n');
+                m_AtLineStart = true;
+            }
+            else if (m_PendingSpace)
+            {
+                m_Out->push_back(' ');
+            }
+        }
+        m_PendingSpace = false;
+        m_PendingNewline = false;
+    }
+
+    void TextExtractor::FlushIfFull()
+    {
+        if (m_Out == &m_Buffer && m_Buffer.size() >= m_ChunkSize)
+        {
+            Flush();
+        }
+    }
+} // namespace HtmlParser
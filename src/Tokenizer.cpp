@@ -1,116 +1,278 @@
 #include <HtmlParser/Tokenizer.hpp>
+#include <algorithm>
+
+#include "CharacterClasses.hpp"
+#include "CharacterReferences.hpp"
+#include "Probes.hpp"
+#include "Utilities.hpp"
 
 namespace HtmlParser
 {
-    Tokenizer::Tokenizer(const std::string& InputStr) : m_Input(InputStr), m_Position(0), m_CurrentState(State::Data)
+    Tokenizer::Tokenizer(std::string_view InputStr) : m_Input(InputStr), m_Position(0), m_CurrentState(State::Data)
     {
     }
 
     void Tokenizer::Tokenize()
     {
-        while (m_Position < m_Input.size())
+        Token Token;
+        while (NextToken(Token))
+        {
+            m_Tokens.push_back(std::move(Token));
+        }
+    }
+
+    bool Tokenizer::NextToken(Token& Out)
+    {
+        HTMLPARSER_TIME_SCOPE(Tokenize);
+        while (m_PendingIndex >= m_PendingTokens.size())
         {
-            char c = m_Input[m_Position++];
-            switch (m_CurrentState)
+            m_PendingTokens.clear();
+            m_PendingIndex = 0;
+            if (m_Position >= m_Input.size())
             {
-            case State::Data:
-                HandleDataState(c);
-                break;
-            case State::TagOpen:
-                HandleTagOpenState(c);
-                break;
-            case State::TagName:
-                HandleTagNameState(c);
-                break;
-            case State::EndTagOpen:
-                HandleEndTagOpenState(c);
-                break;
-            case State::SelfClosingStartTag:
-                HandleSelfClosingStartTagState(c);
-                break;
-            case State::BeforeAttributeName:
-                HandleBeforeAttributeNameState(c);
-                break;
-            case State::AttributeName:
-                HandleAttributeNameState(c);
-                break;
-            case State::AfterAttributeName:
-                HandleAfterAttributeNameState(c);
-                break;
-            case State::BeforeAttributeValue:
-                HandleBeforeAttributeValueState(c);
-                break;
-            case State::AttributeValueDoubleQuoted:
-                HandleAttributeValueDoubleQuotedState(c);
-                break;
-            case State::AttributeValueSingleQuoted:
-                HandleAttributeValueSingleQuotedState(c);
-                break;
-            case State::AttributeValueUnquoted:
-                HandleAttributeValueUnquotedState(c);
-                break;
-            case State::AfterAttributeValueQuoted:
-                HandleAfterAttributeValueQuotedState(c);
-                break;
-            case State::AfterAttributeValueUnquoted:
-                HandleAfterAttributeValueUnquotedState(c);
-                break;
+                return false;
             }
+            Step();
+        }
+        Out = std::move(m_PendingTokens[m_PendingIndex++]);
+        HTMLPARSER_COUNT(TokensByType[static_cast<std::size_t>(Out.Type)], 1);
+        return true;
+    }
+
+    void Tokenizer::SetMaxTokenLength(std::size_t MaxLength)
+    {
+        m_MaxTokenLength = MaxLength;
+    }
+
+    bool Tokenizer::LimitExceeded() const
+    {
+        return m_LimitExceeded;
+    }
+
+    std::size_t Tokenizer::GetPosition() const
+    {
+        return m_Position;
+    }
+
+    std::size_t Tokenizer::GetScratchBytes() const
+    {
+        return (m_Tokens.capacity() + m_PendingTokens.capacity()) * sizeof(Token) + m_CurrentAttributeName.capacity() + m_CurrentAttributeValue.capacity();
+    }
+
+    void Tokenizer::Seek(std::size_t Position)
+    {
+        m_Position = std::min(Position, m_Input.size());
+        m_CurrentState = State::Data;
+        m_PendingTokens.clear();
+        m_PendingIndex = 0;
+    }
+
+    void Tokenizer::SetSkipRawTextContent(bool Skip)
+    {
+        m_SkipRawTextContent = Skip;
+    }
+
+    void Tokenizer::SetDiscardedElements(const std::unordered_set<std::string>& Elements)
+    {
+        m_DiscardedElements.clear();
+        for (const auto& Element : Elements)
+        {
+            m_DiscardedElements.insert(Element);
         }
     }
 
+    void Tokenizer::SetDiscardComments(bool Discard)
+    {
+        m_DiscardComments = Discard;
+    }
+
+    std::size_t Tokenizer::GetDiscardCount() const
+    {
+        return m_DiscardCount;
+    }
+
+    void Tokenizer::SetDecodeCharacterReferences(bool Decode)
+    {
+        m_DecodeCharacterReferences = Decode;
+    }
+
+    void Tokenizer::Step()
+    {
+        // Dense dispatch table indexed by state; each handler consumes as long a run of bytes as it can
+        using StateHandler = void (Tokenizer::*)();
+        static constexpr StateHandler Handlers[] = {
+            &Tokenizer::HandleDataState,
+            &Tokenizer::HandleTagOpenState,
+            &Tokenizer::HandleTagNameState,
+            &Tokenizer::HandleEndTagOpenState,
+            &Tokenizer::HandleSelfClosingStartTagState,
+            &Tokenizer::HandleBeforeAttributeNameState,
+            &Tokenizer::HandleAttributeNameState,
+            &Tokenizer::HandleAfterAttributeNameState,
+            &Tokenizer::HandleBeforeAttributeValueState,
+            &Tokenizer::HandleAttributeValueDoubleQuotedState,
+            &Tokenizer::HandleAttributeValueSingleQuotedState,
+            &Tokenizer::HandleAttributeValueUnquotedState,
+            &Tokenizer::HandleAfterAttributeValueState,
+            &Tokenizer::HandleAfterAttributeValueState,
+            &Tokenizer::HandleRawTextState,
+        };
+        static_assert(sizeof(Handlers) / sizeof(Handlers[0]) == static_cast<size_t>(State::RawText) + 1);
+
+        (this->*Handlers[static_cast<size_t>(m_CurrentState)])();
+    }
+
     const std::vector<Token>& Tokenizer::GetTokens() const
     {
         return m_Tokens;
     }
 
-    void Tokenizer::EmitToken(const Token& Token)
+    void Tokenizer::EmitToken(Token&& Token)
+    {
+        Token.Begin = m_TokenBegin;
+        Token.End = m_Position;
+        m_PendingTokens.push_back(std::move(Token));
+    }
+
+    void Tokenizer::EmitCurrentTag()
     {
-        m_Tokens.push_back(Token);
+        m_CurrentState = State::Data;
+        if (m_CurrentToken.Type == TokenType::StartTag && !m_CurrentToken.SelfClosing)
+        {
+            m_RawTextTag = m_CurrentToken.Name;
+            if (Utils::IsRawTextElement(m_RawTextTag) || Utils::IsRcdataElement(m_RawTextTag))
+            {
+                m_CurrentState = State::RawText;
+            }
+        }
+        EmitToken(std::move(m_CurrentToken));
     }
 
-    void Tokenizer::ReconsumeChar()
+    void Tokenizer::AssignText(StringValue& Out, std::string_view Text) const
     {
-        --m_Position;
+        // Runs without an '&' reference the input as is
+        if (!m_DecodeCharacterReferences || Text.find('&') == std::string_view::npos)
+        {
+            Out = StringValue::Borrow(Text);
+            return;
+        }
+        std::string Decoded;
+        CharacterReferences::DecodeReferences(Text, false, Decoded);
+        Out = std::move(Decoded);
     }
 
-    bool Tokenizer::IsWhitespace(char c) const
+    void Tokenizer::AppendCharacterReference()
     {
-        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+        // m_Position is just past the '&'
+        size_t Consumed = m_DecodeCharacterReferences ? CharacterReferences::DecodeReference(m_Input, m_Position - 1, true, m_CurrentAttributeValue) : 0;
+        if (Consumed == 0)
+        {
+            m_CurrentAttributeValue += '&';
+            return;
+        }
+        m_Position += Consumed - 1;
+        ExceedsLimit(m_CurrentAttributeValue.size());
     }
 
-    bool Tokenizer::IsAlpha(char c) const
+    bool Tokenizer::ExceedsLimit(std::size_t Length)
     {
-        return std::isalpha(static_cast<unsigned char>(c));
+        if (m_MaxTokenLength == 0 || Length <= m_MaxTokenLength)
+        {
+            return false;
+        }
+        // Abandon the rest of the input
+        m_LimitExceeded = true;
+        m_Position = m_Input.size();
+        return true;
+    }
+
+    size_t Tokenizer::ScanUntil(size_t From, std::uint8_t Class) const
+    {
+        const char* Data = m_Input.data();
+        const size_t Size = m_Input.size();
+        while (From < Size && !CharacterClasses::Is(Data[From], Class))
+        {
+            ++From;
+        }
+        return From;
     }
 
-    // Implement state handling functions
-    void Tokenizer::HandleDataState(char c)
+    size_t Tokenizer::SkipWhitespace(size_t From) const
     {
-        if (c == '<')
+        const char* Data = m_Input.data();
+        const size_t Size = m_Input.size();
+        while (From < Size && CharacterClasses::Is(Data[From], CharacterClasses::Whitespace))
         {
+            ++From;
+        }
+        return From;
+    }
+
+    bool Tokenizer::AppendRun(std::string& Out, std::uint8_t EndClass)
+    {
+        const size_t End = ScanUntil(m_Position, EndClass);
+        if (ExceedsLimit(Out.size() + End - m_Position))
+        {
+            return false;
+        }
+        Out.append(m_Input.data() + m_Position, End - m_Position);
+        m_Position = End;
+        return m_Position < m_Input.size();
+    }
+
+    void Tokenizer::CommitAttribute(StringValue Value)
+    {
+        m_CurrentToken.Attributes.insert_or_assign(Atom(m_CurrentAttributeName), std::move(Value));
+        m_CurrentAttributeName.clear();
+        m_CurrentAttributeValue.clear();
+    }
+
+    // State handlers are entered with at least one byte left and consume it themselves; leaving m_Position
+    // unchanged while switching state reconsumes the current byte.
+    void Tokenizer::HandleDataState()
+    {
+        if (m_Input[m_Position] == '<')
+        {
+            m_TokenBegin = m_Position++;
             m_CurrentState = State::TagOpen;
+            return;
         }
-        else
+
+        // Emit the whole run of text up to the next tag as a single token
+        const size_t Start = m_Position;
+        size_t End = m_Input.find('<', Start);
+        if (End == std::string_view::npos)
         {
-            Token Token;
-            Token.Type = TokenType::Character;
-            Token.Data = c;
-            EmitToken(Token);
+            End = m_Input.size();
+        }
+        if (ExceedsLimit(End - Start))
+        {
+            return;
         }
+        Token Token;
+        Token.Type = TokenType::Character;
+        AssignText(Token.Data, m_Input.substr(Start, End - Start));
+        m_TokenBegin = Start;
+        m_Position = End;
+        EmitToken(std::move(Token));
     }
 
-    void Tokenizer::HandleTagOpenState(char c)
+    void Tokenizer::HandleTagOpenState()
     {
+        const char c = m_Input[m_Position];
         if (c == '/')
         {
+            ++m_Position;
             m_CurrentState = State::EndTagOpen;
         }
-        else if (IsAlpha(c))
+        else if (c == '!' || c == '?')
+        {
+            HandleMarkupDeclaration();
+        }
+        else if (CharacterClasses::Is(c, CharacterClasses::Alpha))
         {
             m_CurrentToken = Token();
             m_CurrentToken.Type = TokenType::StartTag;
-            m_CurrentToken.Data = c;
             m_CurrentState = State::TagName;
         }
         else
@@ -119,273 +281,513 @@ namespace HtmlParser
             m_CurrentState = State::Data;
             Token Token;
             Token.Type = TokenType::Character;
-            Token.Data = '<';
-            EmitToken(Token);
-            ReconsumeChar();
+            Token.Data = StringValue::Borrow(m_Input.substr(m_Position - 1, 1));
+            EmitToken(std::move(Token));
         }
     }
 
-    void Tokenizer::HandleTagNameState(char c)
+    void Tokenizer::HandleTagNameState()
     {
-        if (IsWhitespace(c))
+        // A tag name is never interrupted, so it is a single run of the input
+        const size_t End = ScanUntil(m_Position, CharacterClasses::TagNameEnd);
+        if (ExceedsLimit(End - m_Position))
         {
-            m_CurrentState = State::BeforeAttributeName;
+            return;
         }
-        else if (c == '/')
+        m_CurrentToken.Data = StringValue::Borrow(m_Input.substr(m_Position, End - m_Position));
+        m_CurrentToken.Name = LowercaseAtom(m_CurrentToken.Data.View());
+        m_Position = End;
+        if (m_Position >= m_Input.size())
+        {
+            return;
+        }
+
+        if (!m_DiscardedElements.empty() && m_CurrentToken.Type == TokenType::StartTag && m_DiscardedElements.count(m_CurrentToken.Name) > 0)
+        {
+            SkipDiscardedElement();
+            return;
+        }
+
+        const char c = m_Input[m_Position++];
+        if (c == '/')
         {
             m_CurrentState = State::SelfClosingStartTag;
         }
         else if (c == '>')
         {
-            EmitToken(m_CurrentToken);
-            m_CurrentState = State::Data;
+            EmitCurrentTag();
         }
         else
         {
-            m_CurrentToken.Data += c;
+            m_CurrentState = State::BeforeAttributeName;
         }
     }
 
-    void Tokenizer::HandleEndTagOpenState(char c)
+    void Tokenizer::HandleEndTagOpenState()
     {
-        if (IsAlpha(c))
+        if (CharacterClasses::Is(m_Input[m_Position], CharacterClasses::Alpha))
         {
             m_CurrentToken = Token();
             m_CurrentToken.Type = TokenType::EndTag;
-            m_CurrentToken.Data = c;
             m_CurrentState = State::TagName;
         }
         else
         {
             // Parse error
+            ++m_Position;
             m_CurrentState = State::Data;
         }
     }
 
-    void Tokenizer::HandleSelfClosingStartTagState(char c)
+    void Tokenizer::HandleSelfClosingStartTagState()
     {
-        if (c == '>')
+        if (m_Input[m_Position] == '>')
         {
+            ++m_Position;
             m_CurrentToken.SelfClosing = true;
-            EmitToken(m_CurrentToken);
-            m_CurrentState = State::Data;
+            EmitCurrentTag();
         }
         else
         {
             // Parse error
             m_CurrentState = State::BeforeAttributeName;
-            ReconsumeChar();
         }
     }
 
-    void Tokenizer::HandleBeforeAttributeNameState(char c)
+    void Tokenizer::HandleBeforeAttributeNameState()
     {
-        if (IsWhitespace(c))
+        m_Position = SkipWhitespace(m_Position);
+        if (m_Position >= m_Input.size())
         {
-            // Ignore
+            return;
         }
-        else if (c == '/' || c == '>')
+
+        const char c = m_Input[m_Position];
+        if (c == '/' || c == '>')
         {
             m_CurrentState = State::AfterAttributeName;
-            ReconsumeChar();
         }
         else
         {
             m_CurrentAttributeName.clear();
             m_CurrentAttributeValue.clear();
             m_CurrentState = State::AttributeName;
-            ReconsumeChar();
         }
     }
 
-    void Tokenizer::HandleAttributeNameState(char c)
+    void Tokenizer::HandleAttributeNameState()
     {
-        if (IsWhitespace(c) || c == '/' || c == '>')
+        if (!AppendRun(m_CurrentAttributeName, CharacterClasses::AttributeNameEnd))
         {
-            m_CurrentState = State::AfterAttributeName;
-            ReconsumeChar();
+            return;
         }
-        else if (c == '=')
+
+        if (m_Input[m_Position] == '=')
         {
+            ++m_Position;
             m_CurrentState = State::BeforeAttributeValue;
         }
         else
         {
-            m_CurrentAttributeName += c;
+            m_CurrentState = State::AfterAttributeName;
         }
     }
 
-    void Tokenizer::HandleAfterAttributeNameState(char c)
+    void Tokenizer::HandleAfterAttributeNameState()
     {
-        if (IsWhitespace(c))
+        m_Position = SkipWhitespace(m_Position);
+        if (m_Position >= m_Input.size())
         {
-            // Ignore
+            return;
         }
-        else if (c == '/')
+
+        const char c = m_Input[m_Position];
+        if (c == '/')
         {
+            ++m_Position;
             m_CurrentState = State::SelfClosingStartTag;
         }
         else if (c == '=')
         {
+            ++m_Position;
             m_CurrentState = State::BeforeAttributeValue;
         }
         else if (c == '>')
         {
-            m_CurrentToken.Attributes[m_CurrentAttributeName] = m_CurrentAttributeValue;
-            m_CurrentAttributeName.clear();
-            m_CurrentAttributeValue.clear();
-            EmitToken(m_CurrentToken);
-            m_CurrentState = State::Data;
+            ++m_Position;
+            CommitAttribute(std::move(m_CurrentAttributeValue));
+            EmitCurrentTag();
         }
         else
         {
-            m_CurrentToken.Attributes[m_CurrentAttributeName] = m_CurrentAttributeValue;
-            m_CurrentAttributeName.clear();
-            m_CurrentAttributeValue.clear();
+            CommitAttribute(std::move(m_CurrentAttributeValue));
             m_CurrentState = State::AttributeName;
-            ReconsumeChar();
         }
     }
 
-    void Tokenizer::HandleBeforeAttributeValueState(char c)
+    void Tokenizer::HandleBeforeAttributeValueState()
     {
-        if (IsWhitespace(c))
+        m_Position = SkipWhitespace(m_Position);
+        if (m_Position >= m_Input.size())
         {
-            // Ignore
+            return;
         }
-        else if (c == '"')
+
+        const char c = m_Input[m_Position];
+        if (c == '"')
         {
+            ++m_Position;
             m_CurrentState = State::AttributeValueDoubleQuoted;
         }
         else if (c == '\'')
         {
+            ++m_Position;
             m_CurrentState = State::AttributeValueSingleQuoted;
         }
         else if (c == '>')
         {
             // Parse error
-            m_CurrentToken.Attributes[m_CurrentAttributeName] = m_CurrentAttributeValue;
-            m_CurrentAttributeName.clear();
-            m_CurrentAttributeValue.clear();
-            EmitToken(m_CurrentToken);
-            m_CurrentState = State::Data;
+            ++m_Position;
+            CommitAttribute(std::move(m_CurrentAttributeValue));
+            EmitCurrentTag();
         }
         else
         {
             m_CurrentState = State::AttributeValueUnquoted;
-            ReconsumeChar();
         }
     }
 
-    void Tokenizer::HandleAttributeValueDoubleQuotedState(char c)
+    void Tokenizer::HandleAttributeValueDoubleQuotedState()
     {
-        if (c == '"')
+        HandleAttributeValueQuoted(CharacterClasses::DoubleQuotedValueEnd);
+    }
+
+    void Tokenizer::HandleAttributeValueSingleQuotedState()
+    {
+        HandleAttributeValueQuoted(CharacterClasses::SingleQuotedValueEnd);
+    }
+
+    void Tokenizer::HandleAttributeValueQuoted(std::uint8_t EndClass)
+    {
+        // Values without references are the common case and reference the input directly
+        const size_t End = ScanUntil(m_Position, EndClass);
+        if (End < m_Input.size() && m_Input[End] != '&' && m_CurrentAttributeValue.empty())
         {
-            m_CurrentToken.Attributes[m_CurrentAttributeName] = m_CurrentAttributeValue;
-            m_CurrentAttributeName.clear();
-            m_CurrentAttributeValue.clear();
+            if (ExceedsLimit(End - m_Position))
+            {
+                return;
+            }
+            CommitAttribute(StringValue::Borrow(m_Input.substr(m_Position, End - m_Position)));
+            m_Position = End + 1;
             m_CurrentState = State::AfterAttributeValueQuoted;
+            return;
         }
-        else
+
+        while (AppendRun(m_CurrentAttributeValue, EndClass))
         {
-            m_CurrentAttributeValue += c;
+            if (m_Input[m_Position++] != '&')
+            {
+                CommitAttribute(std::move(m_CurrentAttributeValue));
+                m_CurrentState = State::AfterAttributeValueQuoted;
+                return;
+            }
+            AppendCharacterReference();
         }
     }
 
-    void Tokenizer::HandleAttributeValueSingleQuotedState(char c)
+    void Tokenizer::HandleAttributeValueUnquotedState()
     {
-        if (c == '\'')
+        const size_t End = ScanUntil(m_Position, CharacterClasses::UnquotedValueEnd);
+        if (End < m_Input.size() && m_Input[End] != '&' && m_Input[End] != '\0' && m_CurrentAttributeValue.empty())
         {
-            m_CurrentToken.Attributes[m_CurrentAttributeName] = m_CurrentAttributeValue;
-            m_CurrentAttributeName.clear();
-            m_CurrentAttributeValue.clear();
-            m_CurrentState = State::AfterAttributeValueQuoted;
+            if (ExceedsLimit(End - m_Position))
+            {
+                return;
+            }
+            CommitAttribute(StringValue::Borrow(m_Input.substr(m_Position, End - m_Position)));
+            m_Position = End + 1;
+            if (m_Input[End] == '>')
+            {
+                EmitCurrentTag();
+            }
+            else
+            {
+                m_CurrentState = State::AfterAttributeValueUnquoted;
+            }
+            return;
         }
-        else
+
+        while (AppendRun(m_CurrentAttributeValue, CharacterClasses::UnquotedValueEnd))
         {
-            m_CurrentAttributeValue += c;
+            const char c = m_Input[m_Position++];
+            if (c == '&')
+            {
+                AppendCharacterReference();
+            }
+            else if (c == '>')
+            {
+                CommitAttribute(std::move(m_CurrentAttributeValue));
+                EmitCurrentTag();
+                return;
+            }
+            else if (c != '\0')
+            {
+                CommitAttribute(std::move(m_CurrentAttributeValue));
+                m_CurrentState = State::AfterAttributeValueUnquoted;
+                return;
+            }
+            // NUL is a parse error and dropped
         }
     }
 
-    void Tokenizer::HandleAttributeValueUnquotedState(char c)
+    void Tokenizer::HandleAfterAttributeValueState()
     {
-        if (IsWhitespace(c))
+        const char c = m_Input[m_Position];
+        if (CharacterClasses::Is(c, CharacterClasses::Whitespace))
         {
-            m_CurrentToken.Attributes[m_CurrentAttributeName] = m_CurrentAttributeValue;
-            m_CurrentAttributeName.clear();
-            m_CurrentAttributeValue.clear();
-            m_CurrentState = State::AfterAttributeValueUnquoted;
+            ++m_Position;
+            m_CurrentState = State::BeforeAttributeName;
         }
-        else if (c == '>')
+        else if (c == '/')
         {
-            m_CurrentToken.Attributes[m_CurrentAttributeName] = m_CurrentAttributeValue;
-            m_CurrentAttributeName.clear();
-            m_CurrentAttributeValue.clear();
-            EmitToken(m_CurrentToken);
-            m_CurrentState = State::Data;
+            ++m_Position;
+            m_CurrentState = State::SelfClosingStartTag;
         }
-        else if (c == '&')
+        else if (c == '>')
         {
-            m_CurrentAttributeValue += c;
+            ++m_Position;
+            EmitCurrentTag();
         }
-        else if (c == '\0')
+        else
         {
             // Parse error
+            m_CurrentState = State::BeforeAttributeName;
         }
-        else if (c == '"' || c == '\'' || c == '<' || c == '=' || c == '`')
+    }
+
+    void Tokenizer::HandleRawTextState()
+    {
+        // Find the matching end tag in bulk; nothing before it is markup
+        const size_t Start = m_Position;
+        const size_t End = FindEndTag(Start, m_RawTextTag);
+
+        const bool IsRawText = Utils::IsRawTextElement(m_RawTextTag);
+        m_CurrentState = State::Data;
+        if (End == Start)
         {
-            // Parse error
-            m_CurrentAttributeValue += c;
+            return;
+        }
+        if (IsRawText && m_SkipRawTextContent)
+        {
+            ++m_DiscardCount;
+            m_Position = End;
+            return;
+        }
+        if (ExceedsLimit(End - Start))
+        {
+            return;
+        }
+
+        Token Token;
+        Token.Type = TokenType::Character;
+        if (IsRawText)
+        {
+            Token.Data = StringValue::Borrow(m_Input.substr(Start, End - Start));
         }
         else
         {
-            m_CurrentAttributeValue += c;
+            AssignText(Token.Data, m_Input.substr(Start, End - Start));
         }
+        m_TokenBegin = Start;
+        m_Position = End;
+        EmitToken(std::move(Token));
     }
 
-    void Tokenizer::HandleAfterAttributeValueQuotedState(char c)
+    void Tokenizer::HandleMarkupDeclaration()
     {
-        if (IsWhitespace(c))
+        // m_Position is just past the '<'
+        Token Token;
+        size_t End;
+        if (m_Input.compare(m_Position, 3, "!--") == 0)
+        {
+            const size_t Start = m_Position + 3;
+            End = m_Input.find("-->", Start);
+            if (m_Input.compare(Start, 1, ">") == 0 || m_Input.compare(Start, 2, "->") == 0)
+            {
+                // Abruptly closed empty comment
+                End = Start;
+                m_Position = m_Input.find('>', Start) + 1;
+            }
+            else if (End == std::string_view::npos)
+            {
+                End = m_Input.size();
+                m_Position = End;
+            }
+            else
+            {
+                m_Position = End + 3;
+            }
+            Token.Type = TokenType::Comment;
+            Token.Data = StringValue::Borrow(m_Input.substr(Start, End - Start));
+        }
+        else
         {
-            m_CurrentState = State::BeforeAttributeName;
+            const size_t Start = m_Position + 1;
+            End = m_Input.find('>', Start);
+            if (End == std::string_view::npos)
+            {
+                End = m_Input.size();
+            }
+            m_Position = End == m_Input.size() ? End : End + 1;
+
+            std::string_view Content = m_Input.substr(Start, End - Start);
+            if (m_Input[Start - 1] == '!' && Content.size() >= 7 && Utils::ToLower(std::string(Content.substr(0, 7))) == "doctype")
+            {
+                Token.Type = TokenType::DOCTYPE;
+                Token.Data = Utils::Trim(std::string(Content.substr(7)));
+            }
+            else
+            {
+                // Bogus comment such as <!ELEMENT ...> or <?xml ...?>, which keeps its '?'
+                const size_t DataStart = m_Input[Start - 1] == '?' ? Start - 1 : Start;
+                Token.Type = TokenType::Comment;
+                Token.Data = StringValue::Borrow(m_Input.substr(DataStart, End - DataStart));
+            }
         }
-        else if (c == '/')
+
+        m_CurrentState = State::Data;
+        if (Token.Type == TokenType::Comment && m_DiscardComments)
         {
-            m_CurrentState = State::SelfClosingStartTag;
+            ++m_DiscardCount;
+            return;
         }
-        else if (c == '>')
+        if (!ExceedsLimit(Token.Data.size()))
         {
-            EmitToken(m_CurrentToken);
-            m_CurrentState = State::Data;
+            EmitToken(std::move(Token));
         }
-        else
+    }
+
+    void Tokenizer::SkipDiscardedElement()
+    {
+        const Atom TagName = m_CurrentToken.Name;
+        m_CurrentToken = Token();
+        ++m_DiscardCount;
+        m_CurrentState = State::Data;
+
+        bool SelfClosing = false;
+        m_Position = FindTagEnd(m_Position, SelfClosing);
+        if (SelfClosing || Utils::IsVoidElement(TagName))
         {
-            // Parse error
-            m_CurrentState = State::BeforeAttributeName;
-            ReconsumeChar();
+            return;
+        }
+
+        if (Utils::IsRawTextElement(TagName) || Utils::IsRcdataElement(TagName))
+        {
+            m_Position = FindTagEnd(FindEndTag(m_Position, TagName), SelfClosing);
+            return;
+        }
+
+        // Skip to the matching end tag, keeping track of nested elements of the same name
+        size_t Depth = 1;
+        size_t Position = m_Position;
+        while (true)
+        {
+            Position = m_Input.find('<', Position);
+            if (Position == std::string_view::npos)
+            {
+                m_Position = m_Input.size();
+                return;
+            }
+
+            if (m_Input.compare(Position, 4, "<!--") == 0)
+            {
+                size_t CommentEnd = m_Input.find("-->", Position + 4);
+                Position = CommentEnd == std::string_view::npos ? m_Input.size() : CommentEnd + 3;
+            }
+            else if (m_Input.compare(Position, 2, "</") == 0 && MatchesTagName(Position + 2, TagName))
+            {
+                Position = FindTagEnd(Position + 2, SelfClosing);
+                if (--Depth == 0)
+                {
+                    m_Position = Position;
+                    return;
+                }
+            }
+            else if (MatchesTagName(Position + 1, TagName))
+            {
+                Position = FindTagEnd(Position + 1, SelfClosing);
+                if (!SelfClosing)
+                {
+                    ++Depth;
+                }
+            }
+            else
+            {
+                ++Position;
+            }
         }
     }
 
-    void Tokenizer::HandleAfterAttributeValueUnquotedState(char c)
+    bool Tokenizer::MatchesTagName(size_t Position, std::string_view TagName) const
     {
-        if (IsWhitespace(c))
+        const size_t NameEnd = Position + TagName.size();
+        if (NameEnd > m_Input.size())
         {
-            m_CurrentState = State::BeforeAttributeName;
+            return false;
         }
-        else if (c == '/')
+        for (size_t i = 0; i < TagName.size(); ++i)
         {
-            m_CurrentState = State::SelfClosingStartTag;
+            if (CharacterClasses::ToLower(m_Input[Position + i]) != TagName[i])
+            {
+                return false;
+            }
         }
-        else if (c == '>')
+        return NameEnd == m_Input.size() || CharacterClasses::Is(m_Input[NameEnd], CharacterClasses::TagNameEnd);
+    }
+
+    size_t Tokenizer::FindEndTag(size_t From, std::string_view TagName) const
+    {
+        size_t Position = From;
+        while (true)
         {
-            EmitToken(m_CurrentToken);
-            m_CurrentState = State::Data;
+            Position = m_Input.find("</", Position);
+            if (Position == std::string_view::npos)
+            {
+                return m_Input.size();
+            }
+            if (MatchesTagName(Position + 2, TagName))
+            {
+                return Position;
+            }
+            ++Position;
         }
-        else
+    }
+
+    size_t Tokenizer::FindTagEnd(size_t From, bool& SelfClosing) const
+    {
+        // Returns the position just past the '>' closing the tag, skipping quoted attribute values
+        SelfClosing = false;
+        char Quote = '\0';
+        for (size_t i = From; i < m_Input.size(); ++i)
         {
-            // Parse error
-            m_CurrentState = State::BeforeAttributeName;
-            ReconsumeChar();
+            char c = m_Input[i];
+            if (Quote != '\0')
+            {
+                if (c == Quote)
+                {
+                    Quote = '\0';
+                }
+            }
+            else if (c == '"' || c == '\'')
+            {
+                Quote = c;
+            }
+            else if (c == '>')
+            {
+                SelfClosing = i > From && m_Input[i - 1] == '/';
+                return i + 1;
+            }
         }
+        return m_Input.size();
     }
-} // namespace HtmlParser
\ No newline at end of file
+} // namespace HtmlParser
@@ -1,16 +1,93 @@
 #pragma once
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace HtmlParser::Utils
 {
-    inline std::string ToLower(const std::string& Input)
+    inline std::string ToLower(std::string_view Input)
     {
-        std::string Result = Input;
+        std::string Result(Input);
         std::transform(Result.begin(), Result.end(), Result.begin(), [](unsigned char c) { return std::tolower(c); });
         return Result;
     }
 
+    // Same as comparing ToLower of both, without allocating
+    inline bool EqualsIgnoreCase(std::string_view Left, std::string_view Right)
+    {
+        return Left.size() == Right.size() && std::equal(Left.begin(), Left.end(), Right.begin(), [](unsigned char l, unsigned char r) { return std::tolower(l) == std::tolower(r); });
+    }
+
+    // Called per element while parsing and serializing, so dispatch on length instead of hashing
+    inline bool IsVoidElement(std::string_view Tag)
+    {
+        switch (Tag.size())
+        {
+        case 2:
+            return Tag == "br" || Tag == "hr";
+        case 3:
+            return Tag == "col" || Tag == "img" || Tag == "wbr";
+        case 4:
+            return Tag == "area" || Tag == "base" || Tag == "link" || Tag == "meta";
+        case 5:
+            return Tag == "embed" || Tag == "input" || Tag == "param" || Tag == "track";
+        case 6:
+            return Tag == "source";
+        default:
+            return false;
+        }
+    }
+
+    // Elements whose contents are never parsed as markup nor entity-decoded
+    inline bool IsRawTextElement(std::string_view Tag)
+    {
+        switch (Tag.size())
+        {
+        case 3:
+            return Tag == "xmp";
+        case 5:
+            return Tag == "style";
+        case 6:
+            return Tag == "iframe" || Tag == "script";
+        case 7:
+            return Tag == "noembed";
+        case 8:
+            return Tag == "noframes";
+        default:
+            return false;
+        }
+    }
+
+    // Elements whose contents are never parsed as markup
+    inline bool IsRcdataElement(std::string_view Tag)
+    {
+        return Tag == "textarea" || Tag == "title";
+    }
+
+    // 64-bit FNV-1a, the same on every platform so that hashes can be stored
+    inline std::uint64_t HashBytes(std::string_view Bytes)
+    {
+        std::uint64_t Hash = 0xcbf29ce484222325;
+        for (const unsigned char c : Bytes)
+        {
+            Hash = (Hash ^ c) * 0x100000001b3;
+        }
+        return Hash;
+    }
+
+    // Order-dependent combination of two hashes, using the MurmurHash3 finalizer to mix
+    inline std::uint64_t HashCombine(std::uint64_t Seed, std::uint64_t Value)
+    {
+        const auto Mix = [](std::uint64_t Hash) {
+            Hash = (Hash ^ (Hash >> 33)) * 0xff51afd7ed558ccd;
+            Hash = (Hash ^ (Hash >> 33)) * 0xc4ceb9fe1a85ec53;
+            return Hash ^ (Hash >> 33);
+        };
+        return Mix(Mix(Seed) ^ Value);
+    }
+
     inline std::string Trim(const std::string& Input)
     {
         const std::string Whitespace = " \t\n\r\f";
@@ -20,34 +97,4 @@ namespace HtmlParser::Utils
         size_t End = Input.find_last_not_of(Whitespace);
         return Input.substr(Start, End - Start + 1);
     }
-
-    inline std::string EscapeHtml(const std::string& Input)
-    {
-        std::string Escaped;
-        for (char c : Input)
-        {
-            switch (c)
-            {
-            case '&':
-                Escaped.append("&amp;");
-                break;
-            case '<':
-                Escaped.append("&lt;");
-                break;
-            case '>':
-                Escaped.append("&gt;");
-                break;
-            case '"':
-                Escaped.append("&quot;");
-                break;
-            case '\'':
-                Escaped.append("&#39;");
-                break;
-            default:
-                Escaped.push_back(c);
-                break;
-            }
-        }
-        return Escaped;
-    }
 } // namespace HtmlParser::Utils
\ No newline at end of file
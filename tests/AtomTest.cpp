@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/Atom.hpp>
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Query.hpp>
+#include <thread>
+#include <vector>
+
+TEST(AtomTest, EqualNamesShareOneCopy)
+{
+    const std::string Name = "data-role";
+    HtmlParser::Atom First(Name);
+    HtmlParser::Atom Second(std::string_view("data-role"));
+    ASSERT_EQ(First, Second);
+    ASSERT_EQ(First.data(), Second.data());
+    ASSERT_NE(First, HtmlParser::Atom("data-Role"));
+    ASSERT_EQ(First, "data-role");
+    ASSERT_EQ(HtmlParser::Atom(), "");
+    ASSERT_EQ(HtmlParser::Atom(""), HtmlParser::Atom());
+
+    ASSERT_EQ(HtmlParser::Atom::Lowercase("DIV"), HtmlParser::Atom("div"));
+    ASSERT_EQ(HtmlParser::Atom::Lowercase("div"), HtmlParser::Atom("div"));
+}
+
+TEST(AtomTest, FindDoesNotIntern)
+{
+    ASSERT_TRUE(HtmlParser::Atom::Find("data-never-interned").empty());
+    ASSERT_TRUE(HtmlParser::Atom::Find("data-never-interned").empty());
+
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<div id=box data-found=yes></div>");
+    const auto Box = DOM.GetElementById("box");
+    ASSERT_EQ(Box->GetAttribute("data-lookup-only"), "");
+    ASSERT_TRUE(HtmlParser::Atom::Find("data-lookup-only").empty());
+    ASSERT_TRUE(DOM.GetElementsByTagName("tag-lookup-only").empty());
+    ASSERT_TRUE(HtmlParser::Atom::Find("tag-lookup-only").empty());
+
+    ASSERT_EQ(HtmlParser::Atom::Find("data-found"), HtmlParser::Atom("data-found"));
+    ASSERT_EQ(Box->GetAttribute("data-found"), "yes");
+}
+
+TEST(AtomTest, UnknownNamesAreFreedWithTheirLastAtom)
+{
+    {
+        HtmlParser::Parser Parser;
+        HtmlParser::DOM DOM = Parser.Parse("<custom-element data-unbounded-1=a data-unbounded-2=b></custom-element>");
+        ASSERT_FALSE(HtmlParser::Atom::Find("data-unbounded-1").empty());
+        ASSERT_FALSE(HtmlParser::Atom::Find("custom-element").empty());
+
+        HtmlParser::DOM Copy = DOM.Clone();
+        const auto Element = Copy.GetElementsByTagName("custom-element");
+        ASSERT_EQ(Element.size(), 1u);
+        ASSERT_EQ(Element.front()->GetAttribute("data-unbounded-2"), "b");
+    }
+    ASSERT_TRUE(HtmlParser::Atom::Find("data-unbounded-1").empty());
+    ASSERT_TRUE(HtmlParser::Atom::Find("data-unbounded-2").empty());
+    ASSERT_TRUE(HtmlParser::Atom::Find("custom-element").empty());
+
+    // Known names stay pooled
+    ASSERT_FALSE(HtmlParser::Atom::Find("div").empty());
+    ASSERT_FALSE(HtmlParser::Atom::Find("href").empty());
+}
+
+TEST(AtomTest, InterningIsThreadSafe)
+{
+    // The atoms are kept, since a name that is not a known HTML name is freed with its last atom
+    std::vector<std::vector<HtmlParser::Atom>> Seen(4);
+    std::vector<std::thread> Threads;
+    for (std::size_t t = 0; t < Seen.size(); ++t)
+    {
+        Threads.emplace_back([&, t] {
+            for (int i = 0; i < 1000; ++i)
+            {
+                Seen[t].push_back(HtmlParser::Atom("atom-test-" + std::to_string(i)));
+                // Names interned and released over and over from several threads at once
+                HtmlParser::Atom Transient("atom-transient-" + std::to_string(i % 10));
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+    {
+        Thread.join();
+    }
+    for (std::size_t t = 1; t < Seen.size(); ++t)
+    {
+        for (std::size_t i = 0; i < Seen[t].size(); ++i)
+        {
+            ASSERT_EQ(Seen[t][i].data(), Seen[0][i].data());
+        }
+    }
+    ASSERT_TRUE(HtmlParser::Atom::Find("atom-transient-0").empty());
+}
+
+TEST(AtomTest, ParsedNamesAreShared)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM First = Parser.Parse("<DIV Class=a>x</DIV>");
+    HtmlParser::DOM Second = Parser.Parse("<div Class=b>y</div>");
+
+    auto FirstDiv = First.GetElementsByTagName("div").front();
+    auto SecondDiv = Second.GetElementsByTagName("DIV").front();
+    ASSERT_EQ(FirstDiv->Tag, "div");
+    ASSERT_EQ(FirstDiv->Tag.data(), SecondDiv->Tag.data());
+    ASSERT_EQ(FirstDiv->Attributes.begin()->first.data(), SecondDiv->Attributes.begin()->first.data());
+    ASSERT_EQ(SecondDiv->GetAttribute("Class"), "b");
+}
+
+TEST(AtomTest, HasClassMatchesWholeTokens)
+{
+    HtmlParser::Node Element(HtmlParser::NodeType::Element);
+    Element.Tag = "p";
+    Element.Attributes["class"] = "lead  lead-in\tintro";
+    ASSERT_TRUE(Element.HasClass("lead"));
+    ASSERT_TRUE(Element.HasClass("lead-in"));
+    ASSERT_TRUE(Element.HasClass("intro"));
+    ASSERT_FALSE(Element.HasClass("in"));
+    ASSERT_FALSE(Element.HasClass("lead lead-in"));
+    ASSERT_FALSE(Element.HasClass(""));
+}
+
+TEST(AtomTest, HandMadeTagsMatchAnyCase)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<div id=box></div>");
+    auto Added = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Element);
+    Added->Tag = "SECTION";
+    DOM.GetElementById("box")->AppendChild(Added);
+
+    ASSERT_EQ(DOM.GetElementsByTagName("section").size(), 1u);
+    ASSERT_EQ(HtmlParser::Query(DOM.Root()).Select("Section").size(), 1u);
+
+    // The tag is lowercased when assigned, so it is the same atom as a parsed one
+    ASSERT_EQ(Added->Tag, HtmlParser::Atom("section"));
+    ASSERT_EQ(Added->Tag.data(), HtmlParser::Atom("section").data());
+    Added->Tag = HtmlParser::Atom("My-Widget");
+    ASSERT_EQ(Added->Tag, "my-widget");
+    ASSERT_EQ(DOM.GetElementsByTagName("MY-WIDGET").size(), 1u);
+}
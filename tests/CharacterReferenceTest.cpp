@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+
+static std::string ParagraphText(const std::string& Html)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<p>" + Html + "</p>");
+    return DOM.GetElementsByTagName("p").front()->GetTextContent();
+}
+
+TEST(CharacterReferenceTest, DecodesNamedReferences)
+{
+    ASSERT_EQ(ParagraphText("Fish &amp; Chips &lt;3 &gt;"), "Fish & Chips <3 >");
+    ASSERT_EQ(ParagraphText("&copy;&nbsp;&eacute;"), "\xC2\xA9\xC2\xA0\xC3\xA9");
+    ASSERT_EQ(ParagraphText("&NotEqualTilde;"), "\xE2\x89\x82\xCC\xB8");
+}
+
+TEST(CharacterReferenceTest, DecodesLegacyNamesWithoutSemicolon)
+{
+    ASSERT_EQ(ParagraphText("&amp &copy2024"), "& \xC2\xA9" "2024");
+    ASSERT_EQ(ParagraphText("&notit;"), "\xC2\xACit;");
+}
+
+TEST(CharacterReferenceTest, DecodesNumericReferences)
+{
+    ASSERT_EQ(ParagraphText("&#39;&#x27;&#X41;&#65"), "''AA");
+    ASSERT_EQ(ParagraphText("&#x1F600;"), "\xF0\x9F\x98\x80");
+    ASSERT_EQ(ParagraphText("&#0;&#xD800;&#x110000;"), "\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD");
+    ASSERT_EQ(ParagraphText("&#128;&#x99;"), "\xE2\x82\xAC\xE2\x84\xA2");
+}
+
+TEST(CharacterReferenceTest, LeavesUnknownReferencesAlone)
+{
+    ASSERT_EQ(ParagraphText("AT&T &unknown; &# &#x; & done"), "AT&T &unknown; &# &#x; & done");
+}
+
+TEST(CharacterReferenceTest, DecodesAttributeValues)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(R"(<a href="/search?q=1&amp;lang=en&copy=1" title='&quot;Hi&quot;' data-x=a&lt;b>Link</a>)");
+
+    auto Link = DOM.GetElementsByTagName("a").front();
+    ASSERT_EQ(Link->GetAttribute("href"), "/search?q=1&lang=en&copy=1");
+    ASSERT_EQ(Link->GetAttribute("title"), "\"Hi\"");
+    ASSERT_EQ(Link->GetAttribute("data-x"), "a<b");
+}
+
+TEST(CharacterReferenceTest, DecodesRcdataButNotRawText)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<title>Q&amp;A</title><script>a &amp;&amp; b</script>");
+
+    ASSERT_EQ(DOM.GetElementsByTagName("title").front()->GetTextContent(), "Q&A");
+    ASSERT_EQ(DOM.GetElementsByTagName("script").front()->GetTextContent(), "a &amp;&amp; b");
+}
+
+TEST(CharacterReferenceTest, DecodingCanBeDisabled)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetDecodeEntities(false);
+    HtmlParser::DOM DOM = Parser.Parse("<p title=\"&amp;\">&lt;</p>");
+
+    auto Paragraph = DOM.GetElementsByTagName("p").front();
+    ASSERT_EQ(Paragraph->GetTextContent(), "&lt;");
+    ASSERT_EQ(Paragraph->GetAttribute("title"), "&amp;");
+}
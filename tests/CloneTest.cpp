@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+
+static const char* const TemplateHtml = "<html><head><title>Template</title></head><body><div id=header><h1>Hello</h1></div><ul id=items><li>one</li><li>two</li></ul></body></html>";
+
+TEST(CloneTest, SharesEverythingUntilEdited)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM Base = Parser.Parse(TemplateHtml);
+    HtmlParser::DOM Variant = Base.Clone();
+    ASSERT_EQ(Variant.Root(), Base.Root());
+
+    auto Heading = Variant.Edit(Variant.GetElementsByTagName("h1").front());
+    Heading->SetAttribute("class", "greeting");
+    ASSERT_NE(Variant.Root(), Base.Root());
+
+    // Only the path from the root to the heading was copied
+    ASSERT_EQ(Variant.GetElementsByTagName("head").front(), Base.GetElementsByTagName("head").front());
+    ASSERT_EQ(Variant.GetElementById("items"), Base.GetElementById("items"));
+    ASSERT_NE(Variant.GetElementById("header"), Base.GetElementById("header"));
+    ASSERT_EQ(Heading->Children.front(), Base.GetElementsByTagName("h1").front()->Children.front());
+
+    ASSERT_EQ(Base.ToHtml(), "<html><head><title>Template</title></head><body><div id=\"header\"><h1>Hello</h1></div><ul id=\"items\"><li>one</li><li>two</li></ul></body></html>");
+    ASSERT_EQ(Variant.ToHtml(), "<html><head><title>Template</title></head><body><div id=\"header\"><h1 class=\"greeting\">Hello</h1></div><ul id=\"items\"><li>one</li><li>two</li></ul></body></html>");
+}
+
+TEST(CloneTest, EditsSharedNodesReachedThroughCopies)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM Base = Parser.Parse(TemplateHtml);
+    HtmlParser::DOM Variant = Base.Clone();
+
+    // The text node's Parent still points into the base, but the edit lands in the variant
+    Variant.Edit(Variant.GetElementById("items"))->AppendChild(std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Element));
+    auto Text = Variant.GetElementById("items")->Children.front()->Children.front();
+    Variant.Edit(Text)->SetText("first");
+    Variant.Edit(Variant.GetElementsByTagName("title").front()->Children.front())->SetText("Page");
+
+    ASSERT_EQ(Variant.GetElementById("items")->GetTextContent(), "firsttwo");
+    ASSERT_EQ(Variant.GetElementById("items")->Children.size(), 3u);
+    ASSERT_EQ(Variant.GetElementsByTagName("title").front()->GetTextContent(), "Page");
+    ASSERT_EQ(Base.GetElementById("items")->GetTextContent(), "onetwo");
+    ASSERT_EQ(Base.GetElementById("items")->Children.size(), 2u);
+    ASSERT_EQ(Base.GetElementsByTagName("title").front()->GetTextContent(), "Template");
+
+    // Editing again reuses the copies
+    auto Items = Variant.GetElementById("items");
+    ASSERT_EQ(Variant.Edit(Items), Items);
+}
+
+TEST(CloneTest, OriginalCopiesBeforeEditingAfterClone)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM Base = Parser.Parse(TemplateHtml);
+    HtmlParser::DOM First = Base.Clone();
+    HtmlParser::DOM Second = First.Clone();
+
+    First.Edit(First.GetElementsByTagName("h1").front())->SetAttribute("id", "first");
+    Base.Edit(Base.GetElementsByTagName("h1").front())->SetAttribute("id", "base");
+    HtmlParser::DOM Third = First.Clone();
+    First.Edit(First.GetElementsByTagName("h1").front())->SetAttribute("id", "changed");
+
+    ASSERT_EQ(Base.GetElementsByTagName("h1").front()->GetAttribute("id"), "base");
+    ASSERT_EQ(First.GetElementsByTagName("h1").front()->GetAttribute("id"), "changed");
+    ASSERT_EQ(Second.GetElementsByTagName("h1").front()->GetAttribute("id"), "");
+    ASSERT_EQ(Third.GetElementsByTagName("h1").front()->GetAttribute("id"), "first");
+}
+
+TEST(CloneTest, RejectsNodesOfOtherDocuments)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM Base = Parser.Parse(TemplateHtml);
+    HtmlParser::DOM Other = Parser.Parse(TemplateHtml);
+    HtmlParser::DOM Variant = Base.Clone();
+    ASSERT_THROW(Variant.Edit(Other.GetElementById("items")), std::runtime_error);
+}
+
+TEST(CloneTest, KeepsVerbatimSerialization)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetTrackSourceSpans(true);
+    const std::string Html = "<!DOCTYPE html>\n<html><body>\n<p class='a'>Keep   this</p>\n<p>Change</p>\n</body></html>";
+    HtmlParser::DOM Base = Parser.Parse(Html);
+    HtmlParser::DOM Variant = Base.Clone();
+    Variant.Edit(Variant.GetElementsByTagName("p").back())->SetAttribute("id", "x");
+
+    ASSERT_EQ(Base.ToHtml(), Html);
+    ASSERT_EQ(Variant.ToHtml(), "<!DOCTYPE html>\n<html><body>\n<p class='a'>Keep   this</p>\n<p id=\"x\">Change</p>\n</body></html>");
+}
+
+TEST(CloneTest, RejectsDirectChangesToSharedNodes)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM Base = Parser.Parse(TemplateHtml);
+    HtmlParser::DOM Variant = Base.Clone();
+
+    auto Heading = Variant.GetElementsByTagName("h1").front();
+    auto Text = Heading->Children.front();
+    ASSERT_THROW(Heading->SetAttribute("class", "greeting"), std::runtime_error);
+    ASSERT_THROW(Text->SetText("Changed"), std::runtime_error);
+    ASSERT_THROW(Heading->AppendChild(std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Element)), std::runtime_error);
+    ASSERT_THROW(Heading->RemoveChild(Text), std::runtime_error);
+    ASSERT_THROW(Base.Root()->MarkDirty(), std::runtime_error);
+
+    // A copy accepts changes, but a shared node cannot be moved into it
+    auto Items = Variant.Edit(Variant.GetElementById("items"));
+    ASSERT_THROW(Items->AppendChild(Heading), std::runtime_error);
+    auto Item = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Element);
+    Item->Tag = "li";
+    Items->AppendChild(Item);
+    Item->SetAttribute("class", "new");
+    Items->RemoveChild(Items->Children.front());
+
+    ASSERT_EQ(Base.ToHtml(), "<html><head><title>Template</title></head><body><div id=\"header\"><h1>Hello</h1></div><ul id=\"items\"><li>one</li><li>two</li></ul></body></html>");
+    ASSERT_EQ(Variant.ToHtml(), "<html><head><title>Template</title></head><body><div id=\"header\"><h1>Hello</h1></div><ul id=\"items\"><li>two</li><li class=\"new\"></li></ul></body></html>");
+
+    // The variant's copies become shared once it is cloned in turn
+    HtmlParser::DOM Third = Variant.Clone();
+    ASSERT_THROW(Item->SetAttribute("class", "other"), std::runtime_error);
+    Third.Edit(Item)->SetAttribute("class", "other");
+    ASSERT_EQ(Variant.GetElementById("items")->Children.back()->GetAttribute("class"), "new");
+}
+
+TEST(CloneTest, EditsChildrenAfterEarlierSiblingsAreRemoved)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM Base = Parser.Parse(TemplateHtml);
+    HtmlParser::DOM Variant = Base.Clone();
+
+    auto Items = Variant.Edit(Variant.GetElementById("items"));
+    Items->RemoveChild(Items->Children.front());
+    Variant.Edit(Items->Children.front()->Children.front())->SetText("second");
+
+    ASSERT_EQ(Variant.GetElementById("items")->GetTextContent(), "second");
+    ASSERT_EQ(Base.GetElementById("items")->GetTextContent(), "onetwo");
+}
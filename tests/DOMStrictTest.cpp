@@ -33,4 +33,11 @@ TEST(DOMStrictTest, ParsesWellFormedHTMLInStrictMode)
         auto HtmlElement = Root->Children[0];
         ASSERT_EQ(HtmlElement->Tag, "html");
     });
-}
\ No newline at end of file
+}
+TEST(DOMStrictTest, ThrowsOnStrayEndTag)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetStrict(true);
+
+    ASSERT_THROW({ HtmlParser::DOM DOM = Parser.Parse("<div>Text</span></div>"); }, std::runtime_error);
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+#include <thread>
+
+static const char* const ListHtml = "<html><body><h1 class=title id=top>News</h1><ul><li>one</li><li>two</li><li>three</li></ul><p>End</p></body></html>";
+
+TEST(DiffTest, HashesCoverStructureButNotAttributeOrder)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM First = Parser.Parse(ListHtml);
+    HtmlParser::DOM Second = Parser.Parse(ListHtml);
+    ASSERT_EQ(First.Root()->GetHash(), Second.Root()->GetHash());
+
+    HtmlParser::DOM Reordered = Parser.Parse("<html><body><h1 id=top class=title>News</h1><ul><li>one</li><li>two</li><li>three</li></ul><p>End</p></body></html>");
+    ASSERT_EQ(Reordered.Root()->GetHash(), First.Root()->GetHash());
+
+    HtmlParser::DOM Swapped = Parser.Parse("<html><body><h1 class=title id=top>News</h1><ul><li>two</li><li>one</li><li>three</li></ul><p>End</p></body></html>");
+    ASSERT_NE(Swapped.Root()->GetHash(), First.Root()->GetHash());
+    ASSERT_EQ(Swapped.GetElementsByTagName("h1").front()->GetHash(), First.GetElementsByTagName("h1").front()->GetHash());
+}
+
+TEST(DiffTest, ModificationsInvalidateAncestorHashes)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetComputeHashes(true);
+    HtmlParser::DOM DOM = Parser.Parse(ListHtml);
+    const auto Original = DOM.Root()->GetHash();
+    const auto Heading = DOM.GetElementsByTagName("h1").front()->GetHash();
+
+    auto Item = DOM.GetElementsByTagName("li").back();
+    Item->Children.front()->SetText("four");
+    ASSERT_NE(DOM.Root()->GetHash(), Original);
+    ASSERT_EQ(DOM.GetElementsByTagName("h1").front()->GetHash(), Heading);
+
+    Item->Children.front()->SetText("three");
+    ASSERT_EQ(DOM.Root()->GetHash(), Original);
+
+    Item->SetAttribute("class", "last");
+    ASSERT_NE(DOM.Root()->GetHash(), Original);
+    Item->Attributes.clear();
+    Item->MarkDirty();
+    ASSERT_EQ(DOM.Root()->GetHash(), Original);
+}
+
+TEST(DiffTest, IdenticalDocumentsHaveNoChanges)
+{
+    HtmlParser::Parser Parser;
+    ASSERT_TRUE(HtmlParser::DOM::Diff(Parser.Parse(ListHtml), Parser.Parse(ListHtml)).empty());
+}
+
+TEST(DiffTest, ReportsChangedNodes)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM Before = Parser.Parse(ListHtml);
+    HtmlParser::DOM After = Parser.Parse("<html><body><h1 class=headline id=top>News</h1><ul><li>one</li><li>2</li><li>three</li><li>four</li></ul></body></html>");
+
+    const auto Changes = HtmlParser::DOM::Diff(Before, After);
+    ASSERT_EQ(Changes.size(), 4);
+
+    ASSERT_EQ(Changes[0].Type, HtmlParser::ChangeType::Modified);
+    ASSERT_EQ(Changes[0].Before, Before.GetElementsByTagName("h1").front());
+    ASSERT_EQ(Changes[0].After, After.GetElementsByTagName("h1").front());
+
+    // The text inside the second item
+    ASSERT_EQ(Changes[1].Type, HtmlParser::ChangeType::Modified);
+    ASSERT_EQ(Changes[1].Before->Text, "two");
+    ASSERT_EQ(Changes[1].After->Text, "2");
+
+    ASSERT_EQ(Changes[2].Type, HtmlParser::ChangeType::Added);
+    ASSERT_EQ(Changes[2].Before, nullptr);
+    ASSERT_EQ(Changes[2].After, After.GetElementsByTagName("li").back());
+
+    ASSERT_EQ(Changes[3].Type, HtmlParser::ChangeType::Removed);
+    ASSERT_EQ(Changes[3].Before, Before.GetElementsByTagName("p").front());
+    ASSERT_EQ(Changes[3].After, nullptr);
+}
+
+TEST(DiffTest, ReparseKeepsHashesCurrent)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetTrackSourceSpans(true);
+    Parser.SetComputeHashes(true);
+    const std::string Source = ListHtml;
+    HtmlParser::DOM DOM = Parser.Parse(Source);
+
+    const std::size_t Offset = Source.find("two");
+    ASSERT_TRUE(Parser.Reparse(DOM, {Offset, 3, "<b>2</b>"}));
+    HtmlParser::DOM Expected = Parser.Parse(Source.substr(0, Offset) + "<b>2</b>" + Source.substr(Offset + 3));
+    ASSERT_EQ(DOM.Root()->GetHash(), Expected.Root()->GetHash());
+    ASSERT_TRUE(HtmlParser::DOM::Diff(DOM, Expected).empty());
+}
+
+TEST(DiffTest, ClonesHashFromDifferentThreads)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM Original = Parser.Parse(ListHtml);
+    HtmlParser::DOM Copy = Original.Clone();
+
+    // Both clones share every node, so this computes the same cached hashes twice at once
+    std::uint64_t CopyHash = 0;
+    std::thread Worker([&] { CopyHash = Copy.Root()->GetHash(); });
+    const std::uint64_t OriginalHash = Original.Root()->GetHash();
+    Worker.join();
+    ASSERT_EQ(OriginalHash, CopyHash);
+    ASSERT_EQ(OriginalHash, Parser.Parse(ListHtml).Root()->GetHash());
+}
+
+// A chain of nested divs with Text at the bottom
+static std::shared_ptr<HtmlParser::Node> MakeChain(std::size_t Depth, const char* Text)
+{
+    auto Root = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Document);
+    HtmlParser::Node* Current = Root.get();
+    for (std::size_t i = 0; i < Depth; ++i)
+    {
+        auto Child = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Element);
+        Child->Tag = "div";
+        Current->Children.push_back(Child);
+        Current = Child.get();
+    }
+    auto Leaf = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Text);
+    Leaf->Text = Text;
+    Current->Children.push_back(Leaf);
+    return Root;
+}
+
+// ~Node releases its children recursively, so chains are taken apart from the top
+static void DestroyChain(std::shared_ptr<HtmlParser::Node> Root)
+{
+    while (Root && !Root->Children.empty())
+    {
+        std::shared_ptr<HtmlParser::Node> Child = std::move(Root->Children.front());
+        Root->Children.clear();
+        Root = std::move(Child);
+    }
+}
+
+TEST(DiffTest, HandlesDeepTrees)
+{
+    const std::size_t Depth = 200000;
+    HtmlParser::DOM Before(MakeChain(Depth, "a"));
+    HtmlParser::DOM After(MakeChain(Depth, "b"));
+
+    ASSERT_NE(Before.Root()->GetHash(), After.Root()->GetHash());
+    const std::vector<HtmlParser::NodeChange> Changes = HtmlParser::DOM::Diff(Before, After);
+    ASSERT_EQ(Changes.size(), 1);
+    EXPECT_EQ(Changes[0].Type, HtmlParser::ChangeType::Modified);
+    EXPECT_EQ(Changes[0].Before->Text, "a");
+    EXPECT_EQ(Changes[0].After->Text, "b");
+
+    DestroyChain(Before.Root());
+    DestroyChain(After.Root());
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+
+TEST(DiscardTest, DiscardsElementsWithTheirContent)
+{
+    HtmlParser::DiscardOptions Options;
+    Options.Elements = {"script", "SVG", "noscript"};
+    HtmlParser::Parser Parser;
+    Parser.SetDiscardOptions(Options);
+    HtmlParser::DOM DOM = Parser.Parse(R"(<body>
+<p>Before</p>
+<svg width="10"><svg><g><text>Nested</text></g></svg><!-- </svg> --><path d="M0"/></svg>
+<script type="text/javascript">document.write("</div>");</script>
+<noscript><img src="pixel.gif"></noscript>
+<p>After</p>
+</body>)");
+
+    ASSERT_TRUE(DOM.GetElementsByTagName("svg").empty());
+    ASSERT_TRUE(DOM.GetElementsByTagName("text").empty());
+    ASSERT_TRUE(DOM.GetElementsByTagName("script").empty());
+    ASSERT_TRUE(DOM.GetElementsByTagName("img").empty());
+    auto Paragraphs = DOM.GetElementsByTagName("p");
+    ASSERT_EQ(Paragraphs.size(), 2);
+    ASSERT_EQ(Paragraphs[1]->GetTextContent(), "After");
+    ASSERT_EQ(Paragraphs[1]->Parent.lock()->Tag, "body");
+}
+
+TEST(DiscardTest, DiscardsSelfClosingElements)
+{
+    HtmlParser::DiscardOptions Options;
+    Options.Elements = {"svg"};
+    HtmlParser::Parser Parser;
+    Parser.SetDiscardOptions(Options);
+    HtmlParser::DOM DOM = Parser.Parse("<div><svg data-x=\"a>b\" /><p>Kept</p></div>");
+
+    ASSERT_TRUE(DOM.GetElementsByTagName("svg").empty());
+    ASSERT_EQ(DOM.GetElementsByTagName("p").size(), 1);
+}
+
+TEST(DiscardTest, DiscardsComments)
+{
+    HtmlParser::DiscardOptions Options;
+    Options.Comments = true;
+    HtmlParser::Parser Parser;
+    Parser.SetDiscardOptions(Options);
+    HtmlParser::DOM DOM = Parser.Parse("<div><!-- ad slot --><p>Text</p></div>");
+
+    auto Div = DOM.GetElementsByTagName("div").front();
+    ASSERT_EQ(Div->Children.size(), 1);
+    ASSERT_EQ(Div->Children[0]->Tag, "p");
+}
+
+TEST(DiscardTest, DiscardsWhitespaceTextOutsidePre)
+{
+    HtmlParser::DiscardOptions Options;
+    Options.WhitespaceText = true;
+    HtmlParser::Parser Parser;
+    Parser.SetDiscardOptions(Options);
+    HtmlParser::DOM DOM = Parser.Parse("<div>\n  <p>Text</p>\n  <pre>  </pre>\n</div>");
+
+    auto Div = DOM.GetElementsByTagName("div").front();
+    ASSERT_EQ(Div->Children.size(), 2);
+    auto Pre = DOM.GetElementsByTagName("pre").front();
+    ASSERT_EQ(Pre->Children.size(), 1);
+    ASSERT_EQ(Pre->Children[0]->Text, "  ");
+}
+
+TEST(DiscardTest, KeepsWhitespaceAdjacentToText)
+{
+    HtmlParser::DiscardOptions Options;
+    Options.WhitespaceText = true;
+    HtmlParser::Parser Parser;
+    Parser.SetDiscardOptions(Options);
+    HtmlParser::DOM DOM = Parser.Parse("<p>  < b</p>\n<p>a <  </p>");
+
+    auto Paragraphs = DOM.GetElementsByTagName("p");
+    ASSERT_EQ(Paragraphs.size(), 2);
+    ASSERT_EQ(Paragraphs[0]->Children.size(), 1);
+    ASSERT_EQ(Paragraphs[0]->Children[0]->Text, "  < b");
+    ASSERT_EQ(Paragraphs[1]->Children.size(), 1);
+    ASSERT_EQ(Paragraphs[1]->Children[0]->Text, "a <  ");
+    ASSERT_EQ(DOM.GetElementsByTagName("body").front()->Children.size(), 2);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Encoding.hpp>
+#include <HtmlParser/Parser.hpp>
+
+using HtmlParser::Encoding;
+
+TEST(EncodingTest, SniffsByteOrderMark)
+{
+    ASSERT_EQ(HtmlParser::SniffEncoding("\xEF\xBB\xBF<p>"), Encoding::Utf8);
+    ASSERT_EQ(HtmlParser::SniffEncoding(std::string_view("\xFF\xFE<\0", 4)), Encoding::Utf16LE);
+    ASSERT_EQ(HtmlParser::SniffEncoding(std::string_view("\xFE\xFF\0<", 4)), Encoding::Utf16BE);
+    ASSERT_EQ(HtmlParser::SniffEncoding("<p>No declaration</p>"), Encoding::Utf8);
+}
+
+TEST(EncodingTest, SniffsMetaCharset)
+{
+    ASSERT_EQ(HtmlParser::SniffEncoding("<html><head><meta charset=\"ISO-8859-2\">"), Encoding::Iso8859_2);
+    ASSERT_EQ(HtmlParser::SniffEncoding("<meta http-equiv=\"Content-Type\" content=\"text/html; charset=windows-1251\">"), Encoding::Windows1251);
+    ASSERT_EQ(HtmlParser::SniffEncoding("<meta content='text/html; charset=koi8-r' http-equiv='content-type'>"), Encoding::Koi8R);
+    ASSERT_EQ(HtmlParser::SniffEncoding("<!-- <meta charset=latin2> --><meta charset=latin1>"), Encoding::Windows1252);
+    ASSERT_EQ(HtmlParser::SniffEncoding("<meta charset=utf-16>"), Encoding::Utf8);
+    ASSERT_EQ(HtmlParser::SniffEncoding("<title a='>'><meta charset=\"bogus\"></title>"), Encoding::Utf8);
+}
+
+TEST(EncodingTest, ResolvesLabels)
+{
+    ASSERT_EQ(HtmlParser::EncodingFromLabel(" Latin1 "), Encoding::Windows1252);
+    ASSERT_EQ(HtmlParser::EncodingFromLabel("iso-8859-9"), Encoding::Windows1254);
+    ASSERT_EQ(HtmlParser::EncodingFromLabel("UTF8"), Encoding::Utf8);
+    ASSERT_EQ(HtmlParser::EncodingFromLabel("Shift_JIS"), Encoding::Auto);
+}
+
+TEST(EncodingTest, ValidatesUtf8)
+{
+    ASSERT_TRUE(HtmlParser::IsValidUtf8("plain ascii that is longer than one vector width"));
+    ASSERT_TRUE(HtmlParser::IsValidUtf8("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80"));
+    ASSERT_FALSE(HtmlParser::IsValidUtf8("overlong \xC0\xAF"));
+    ASSERT_FALSE(HtmlParser::IsValidUtf8("surrogate \xED\xA0\x80"));
+    ASSERT_FALSE(HtmlParser::IsValidUtf8("truncated \xE2\x82"));
+    ASSERT_FALSE(HtmlParser::IsValidUtf8("latin1 caf\xE9 in a long enough string"));
+}
+
+TEST(EncodingTest, TranscodesSingleByteEncodings)
+{
+    ASSERT_EQ(HtmlParser::TranscodeToUtf8("caf\xE9 \x80", Encoding::Windows1252), "caf\xC3\xA9 \xE2\x82\xAC");
+    ASSERT_EQ(HtmlParser::TranscodeToUtf8("\xC1\xC2", Encoding::Koi8R), "\xD0\xB0\xD0\xB1");
+    ASSERT_EQ(HtmlParser::TranscodeToUtf8("\xA1", Encoding::Windows874), "\xE0\xB8\x81");
+}
+
+TEST(EncodingTest, ReplacesMalformedUtf8)
+{
+    ASSERT_EQ(HtmlParser::TranscodeToUtf8("a\xE2\x82x", Encoding::Utf8), "a\xEF\xBF\xBDx");
+    ASSERT_EQ(HtmlParser::TranscodeToUtf8("\xC0\xAF", Encoding::Utf8), "\xEF\xBF\xBD\xEF\xBF\xBD");
+    ASSERT_EQ(HtmlParser::TranscodeToUtf8("end\xF0\x9F\x98", Encoding::Utf8), "end\xEF\xBF\xBD");
+}
+
+TEST(EncodingTest, CarriesSequencesAcrossChunks)
+{
+    const std::string Input = "\xEF\xBB\xBF" "a\xE2\x82\xAC" "b\xF0\x9F\x98\x80";
+    for (std::size_t ChunkSize = 1; ChunkSize <= 4; ++ChunkSize)
+    {
+        HtmlParser::Utf8Transcoder Transcoder(Encoding::Utf8);
+        std::string Out;
+        for (std::size_t i = 0; i < Input.size(); i += ChunkSize)
+        {
+            Transcoder.Transcode(std::string_view(Input).substr(i, ChunkSize), Out);
+        }
+        Transcoder.Finish(Out);
+        ASSERT_EQ(Out, "a\xE2\x82\xAC" "b\xF0\x9F\x98\x80");
+    }
+}
+
+TEST(EncodingTest, TranscodesUtf16)
+{
+    const std::string Input("\xFF\xFE" "a\0\xAC\x20\x3D\xD8\x00\xDE\x00\xDC", 12);
+    ASSERT_EQ(HtmlParser::TranscodeToUtf8(Input, Encoding::Utf16LE), "a\xE2\x82\xAC\xF0\x9F\x98\x80\xEF\xBF\xBD");
+
+    HtmlParser::Utf8Transcoder Transcoder(Encoding::Utf16BE);
+    std::string Out;
+    Transcoder.Transcode(std::string_view("\0a\xD8", 3), Out);
+    Transcoder.Transcode(std::string_view("\x3D\xDE\x00\0", 4), Out);
+    Transcoder.Finish(Out);
+    ASSERT_EQ(Out, "a\xF0\x9F\x98\x80\xEF\xBF\xBD");
+}
+
+TEST(EncodingTest, ParserTranscodesDeclaredEncoding)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetInputEncoding(Encoding::Auto);
+    HtmlParser::DOM DOM = Parser.Parse("<html><head><meta charset=\"windows-1252\"></head><body><p>Caf\xE9 \x93quoted\x94</p></body></html>");
+    ASSERT_EQ(DOM.GetElementsByTagName("p").front()->GetTextContent(), "Caf\xC3\xA9 \xE2\x80\x9Cquoted\xE2\x80\x9D");
+}
+
+TEST(EncodingTest, ParserStripsByteOrderMark)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetInputEncoding(Encoding::Auto);
+    HtmlParser::DOM DOM = Parser.Parse("\xEF\xBB\xBF<p>caf\xC3\xA9</p>");
+    ASSERT_EQ(DOM.GetElementsByTagName("p").front()->GetTextContent(), "caf\xC3\xA9");
+    ASSERT_EQ(DOM.GetElementsByTagName("body").front()->Children.size(), 1);
+}
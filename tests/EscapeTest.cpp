@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/Escape.hpp>
+
+static std::string EscapeText(std::string_view Text)
+{
+    std::string Out = ">";
+    HtmlParser::AppendEscapedText(Out, Text);
+    return Out.substr(1);
+}
+
+TEST(EscapeTest, EscapesTextAndAttributesDifferently)
+{
+    ASSERT_EQ(EscapeText("Fish & \"chips\" <b>'s"), "Fish &amp; \"chips\" &lt;b&gt;'s");
+
+    std::string Attribute;
+    HtmlParser::AppendEscapedAttribute(Attribute, "say \"hi\" & <wave>'s");
+    ASSERT_EQ(Attribute, "say &quot;hi&quot; &amp; &lt;wave&gt;'s");
+}
+
+TEST(EscapeTest, HandlesCleanSparseAndDenseRuns)
+{
+    const std::string Clean(100, 'x');
+    ASSERT_EQ(EscapeText(Clean), Clean);
+    ASSERT_EQ(EscapeText(""), "");
+
+    // Escapes at every offset around the vector width, then a long dense stretch
+    std::string Input;
+    std::string Expected;
+    for (std::size_t i = 0; i < 40; ++i)
+    {
+        Input += std::string(i, 'a') + "&";
+        Expected += std::string(i, 'a') + "&amp;";
+    }
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        Input += "<>";
+        Expected += "&lt;&gt;";
+    }
+    Input += Clean;
+    Expected += Clean;
+
+    ASSERT_EQ(EscapeText(Input), Expected);
+    ASSERT_EQ(HtmlParser::EscapedTextLength(Input), Expected.size());
+    ASSERT_EQ(HtmlParser::EscapedAttributeLength("\"&\""), 17);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/Instrumentation.hpp>
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Query.hpp>
+
+#include <thread>
+
+static const char* const PageHtml = "<!DOCTYPE html><html><head><title>Stats</title></head><body><div><p>One <b>two</b></p></span><!-- c --><p>Three</p></div></body></html>";
+
+TEST(InstrumentationTest, MergesAndExportsStats)
+{
+    HtmlParser::InstrumentationStats First;
+    First.Phases[static_cast<size_t>(HtmlParser::InstrumentedPhase::Parse)] = {1, 100};
+    First.TokensByType[static_cast<size_t>(HtmlParser::TokenType::StartTag)] = 3;
+    First.MaxStackDepth = 5;
+    HtmlParser::InstrumentationStats Second = First;
+    Second.NodesCreated = 7;
+    Second.MaxStackDepth = 2;
+
+    First.Merge(Second);
+    ASSERT_EQ(First.GetPhase(HtmlParser::InstrumentedPhase::Parse).Calls, 2);
+    ASSERT_EQ(First.GetPhase(HtmlParser::InstrumentedPhase::Parse).Nanoseconds, 200);
+    ASSERT_EQ(First.TokensByType[static_cast<size_t>(HtmlParser::TokenType::StartTag)], 6);
+    ASSERT_EQ(First.NodesCreated, 7);
+    ASSERT_EQ(First.MaxStackDepth, 5);
+
+    const std::string Json = First.ToJson();
+    ASSERT_NE(Json.find("\"parse\":{\"calls\":2,\"nanoseconds\":200}"), std::string::npos);
+    ASSERT_NE(Json.find("\"start_tag\":6"), std::string::npos);
+    ASSERT_NE(Json.find("\"nodes_created\":7"), std::string::npos);
+    ASSERT_NE(Json.find("\"max_stack_depth\":5"), std::string::npos);
+}
+
+TEST(InstrumentationTest, RecordsEachParse)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+    const HtmlParser::InstrumentationStats& Stats = Parser.GetInstrumentationStats();
+    if (!HtmlParser::Instrumentation::Enabled)
+    {
+        ASSERT_EQ(Stats.ToJson(), HtmlParser::InstrumentationStats().ToJson());
+        GTEST_SKIP() << "Built without HTMLPARSER_INSTRUMENTATION";
+    }
+
+    ASSERT_EQ(Stats.GetPhase(HtmlParser::InstrumentedPhase::Parse).Calls, 1);
+    ASSERT_GT(Stats.GetPhase(HtmlParser::InstrumentedPhase::Tokenize).Calls, 0);
+    ASSERT_GT(Stats.GetPhase(HtmlParser::InstrumentedPhase::InBodyMode).Calls, 0);
+    ASSERT_EQ(Stats.TokensByType[static_cast<size_t>(HtmlParser::TokenType::DOCTYPE)], 1);
+    // html, head, title, body, div, p, b and p
+    ASSERT_EQ(Stats.TokensByType[static_cast<size_t>(HtmlParser::TokenType::StartTag)], 8);
+    ASSERT_EQ(Stats.TokensByType[static_cast<size_t>(HtmlParser::TokenType::Comment)], 1);
+    // Everything but the document node
+    std::size_t NodeCount = 0;
+    DOM.Traverse([&](const std::shared_ptr<HtmlParser::Node>&) { ++NodeCount; });
+    ASSERT_EQ(Stats.NodesCreated, NodeCount - 1);
+    // The stray </span>
+    ASSERT_EQ(Stats.ParseErrors, 1);
+    ASSERT_EQ(Stats.MaxStackDepth, Parser.GetScratchUsage().MaxOpenElements);
+
+    // The next parse starts from zero
+    Parser.Parse("<p>x</p>");
+    ASSERT_EQ(Parser.GetInstrumentationStats().GetPhase(HtmlParser::InstrumentedPhase::Parse).Calls, 1);
+    ASSERT_EQ(Parser.GetInstrumentationStats().ParseErrors, 0);
+}
+
+TEST(InstrumentationTest, AggregatesQueriesAndThreads)
+{
+    if (!HtmlParser::Instrumentation::Enabled)
+    {
+        GTEST_SKIP() << "Built without HTMLPARSER_INSTRUMENTATION";
+    }
+    HtmlParser::Instrumentation::Reset();
+
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+    ASSERT_EQ(HtmlParser::Query(DOM.Root()).Select("div p").size(), 2);
+    DOM.ToHtml();
+
+    const HtmlParser::InstrumentationStats& Thread = HtmlParser::Instrumentation::GetThreadStats();
+    ASSERT_EQ(Thread.GetPhase(HtmlParser::InstrumentedPhase::Parse).Calls, 1);
+    ASSERT_EQ(Thread.GetPhase(HtmlParser::InstrumentedPhase::Select).Calls, 1);
+    ASSERT_EQ(Thread.GetPhase(HtmlParser::InstrumentedPhase::Serialize).Calls, 1);
+    ASSERT_GT(Thread.SelectorNodesVisited, 0);
+    ASSERT_EQ(Thread.NodesCreated, Parser.GetInstrumentationStats().NodesCreated);
+
+    std::thread Worker([] {
+        HtmlParser::Parser WorkerParser;
+        WorkerParser.Parse(PageHtml);
+    });
+    Worker.join();
+
+    const HtmlParser::InstrumentationStats Process = HtmlParser::Instrumentation::GetProcessStats();
+    ASSERT_EQ(Process.GetPhase(HtmlParser::InstrumentedPhase::Parse).Calls, 2);
+    ASSERT_EQ(Process.NodesCreated, 2 * Thread.NodesCreated);
+    HtmlParser::Instrumentation::Reset();
+}
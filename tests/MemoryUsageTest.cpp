@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+
+#include <string>
+
+static const std::string PageHtml = "<!DOCTYPE html><html><head><title>Memory</title></head><body><!-- note --><div class=\"a long class attribute value\">Some text that does not fit inline</div><p>Short</p></body></html>";
+
+TEST(MemoryUsageTest, CountsNodesByType)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+    const HtmlParser::MemoryBreakdown Usage = DOM.MemoryUsage();
+
+    ASSERT_EQ(Usage.NodeCounts[static_cast<size_t>(HtmlParser::NodeType::Document)], 1);
+    ASSERT_EQ(Usage.NodeCounts[static_cast<size_t>(HtmlParser::NodeType::Doctype)], 1);
+    ASSERT_EQ(Usage.NodeCounts[static_cast<size_t>(HtmlParser::NodeType::Element)], 6);
+    ASSERT_EQ(Usage.NodeCounts[static_cast<size_t>(HtmlParser::NodeType::Text)], 3);
+    ASSERT_EQ(Usage.NodeCounts[static_cast<size_t>(HtmlParser::NodeType::Comment)], 1);
+    ASSERT_EQ(Usage.NodeBytes, 12 * sizeof(HtmlParser::Node));
+    ASSERT_GT(Usage.ControlBlockBytes, 0);
+    ASSERT_GT(Usage.ChildVectorBytes, 0);
+    ASSERT_GT(Usage.AttributeMapBytes, 0);
+    ASSERT_EQ(Usage.SourceBytes, 0);
+    ASSERT_EQ(Usage.TotalBytes(), Usage.NodeBytes + Usage.ControlBlockBytes + Usage.TextBytes + Usage.TagBytes + Usage.AttributeMapBytes + Usage.ChildVectorBytes);
+}
+
+TEST(MemoryUsageTest, SeparatesOwnedTextFromTheSource)
+{
+    HtmlParser::Parser Parser;
+    const HtmlParser::MemoryBreakdown Owned = Parser.Parse(PageHtml).MemoryUsage();
+    // The long text and class value need heap storage; short ones are stored inline
+    ASSERT_GE(Owned.TextBytes, std::string("Some text that does not fit inline").size() + std::string("a long class attribute value").size());
+
+    Parser.SetZeroCopy(true);
+    const HtmlParser::MemoryBreakdown Borrowed = Parser.Parse(PageHtml).MemoryUsage();
+    ASSERT_EQ(Borrowed.TextBytes, 0);
+    ASSERT_EQ(Borrowed.SourceBytes, PageHtml.size());
+
+    // Tag and attribute names are counted once each
+    ASSERT_EQ(Owned.TagBytes, Borrowed.TagBytes);
+    // html, head, title, body, div, p and class
+    ASSERT_EQ(Owned.TagBytes, 7 * sizeof(std::string));
+}
+
+TEST(MemoryUsageTest, ReportsParserScratchUsage)
+{
+    HtmlParser::Parser Parser;
+    Parser.Parse("<div><div><div><span>deep</span></div></div></div><p>shallow</p>");
+    const HtmlParser::ScratchUsage& Usage = Parser.GetScratchUsage();
+    // Document, html, body, three divs and the span
+    ASSERT_EQ(Usage.MaxOpenElements, 7);
+    ASSERT_GE(Usage.OpenElementBytes, 7 * sizeof(std::shared_ptr<HtmlParser::Node>));
+    ASSERT_GT(Usage.TokenizerBytes, 0);
+    ASSERT_EQ(Usage.PendingWhitespaceBytes, 0);
+
+    HtmlParser::DiscardOptions Options;
+    Options.WhitespaceText = true;
+    Parser.SetDiscardOptions(Options);
+    Parser.Parse("<div>\n    <p>text</p>\n</div>");
+    ASSERT_EQ(Parser.GetScratchUsage().MaxOpenElements, 5);
+    ASSERT_EQ(Parser.GetScratchUsage().PendingWhitespaceBytes, 5);
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+#include <filesystem>
+#include <fstream>
+
+TEST(ParseFileTest, ParsesMappedFile)
+{
+    const auto Path = std::filesystem::temp_directory_path() / "HtmlParserParseFileTest.html";
+    {
+        std::ofstream File(Path, std::ios::binary);
+        File << "<html><body><p id=\"greeting\">Hello World</p></body></html>";
+    }
+
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.ParseFile(Path.string());
+    std::filesystem::remove(Path);
+
+    auto Paragraph = DOM.GetElementById("greeting");
+    ASSERT_NE(Paragraph, nullptr);
+    ASSERT_EQ(Paragraph->GetTextContent(), "Hello World");
+}
+
+TEST(ParseFileTest, ParsesEmptyFile)
+{
+    const auto Path = std::filesystem::temp_directory_path() / "HtmlParserParseFileEmptyTest.html";
+    std::ofstream(Path, std::ios::binary).close();
+
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.ParseFile(Path.string());
+    std::filesystem::remove(Path);
+
+    ASSERT_TRUE(DOM.Root()->Children.empty());
+}
+
+TEST(ParseFileTest, ThrowsOnMissingFile)
+{
+    HtmlParser::Parser Parser;
+    ASSERT_THROW(Parser.ParseFile("does/not/exist.html"), std::runtime_error);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+#include <string>
+
+TEST(ParseLimitsTest, UnlimitedByDefault)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<div><p>Hello</p></div>");
+    ASSERT_FALSE(DOM.IsTruncated());
+    ASSERT_EQ(DOM.GetTruncationReason(), HtmlParser::TruncationReason::None);
+}
+
+TEST(ParseLimitsTest, StopsAtMaxDepth)
+{
+    std::string Html;
+    for (int i = 0; i < 100; ++i)
+    {
+        Html += "<div>";
+    }
+
+    HtmlParser::ParseLimits Limits;
+    Limits.MaxDepth = 10;
+    HtmlParser::Parser Parser;
+    Parser.SetLimits(Limits);
+    HtmlParser::DOM DOM = Parser.Parse(Html);
+
+    ASSERT_TRUE(DOM.IsTruncated());
+    ASSERT_EQ(DOM.GetTruncationReason(), HtmlParser::TruncationReason::MaxDepth);
+    // html and body count towards the depth
+    ASSERT_EQ(DOM.GetElementsByTagName("div").size(), 8);
+}
+
+TEST(ParseLimitsTest, StopsAtMaxNodes)
+{
+    std::string Html;
+    for (int i = 0; i < 100; ++i)
+    {
+        Html += "<p>Item</p>";
+    }
+
+    HtmlParser::ParseLimits Limits;
+    Limits.MaxNodes = 20;
+    HtmlParser::Parser Parser;
+    Parser.SetLimits(Limits);
+    HtmlParser::DOM DOM = Parser.Parse(Html);
+
+    ASSERT_EQ(DOM.GetTruncationReason(), HtmlParser::TruncationReason::MaxNodes);
+    // html, head and body plus nine <p>Item</p> pairs
+    ASSERT_EQ(DOM.GetElementsByTagName("p").size(), 9);
+}
+
+TEST(ParseLimitsTest, StopsAtMaxTextLength)
+{
+    std::string Html = "<p>Short</p><img src=\"" + std::string(1000, 'x') + "\"><p>After</p>";
+
+    HtmlParser::ParseLimits Limits;
+    Limits.MaxTextLength = 100;
+    HtmlParser::Parser Parser;
+    Parser.SetLimits(Limits);
+    HtmlParser::DOM DOM = Parser.Parse(Html);
+
+    ASSERT_EQ(DOM.GetTruncationReason(), HtmlParser::TruncationReason::MaxTextLength);
+    ASSERT_EQ(DOM.GetElementsByTagName("p").size(), 1);
+    ASSERT_TRUE(DOM.GetElementsByTagName("img").empty());
+}
+
+TEST(ParseLimitsTest, StopsAtTimeout)
+{
+    std::string Html;
+    for (int i = 0; i < 100000; ++i)
+    {
+        Html += "<span>x</span>";
+    }
+
+    HtmlParser::ParseLimits Limits;
+    Limits.Timeout = std::chrono::nanoseconds(1);
+    HtmlParser::Parser Parser;
+    Parser.SetLimits(Limits);
+    HtmlParser::DOM DOM = Parser.Parse(Html);
+
+    ASSERT_EQ(DOM.GetTruncationReason(), HtmlParser::TruncationReason::Timeout);
+    ASSERT_LT(DOM.GetElementsByTagName("span").size(), 100000);
+}
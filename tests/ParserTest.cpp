@@ -17,3 +17,43 @@ TEST(ParserTest, BasicParse)
     auto Text = Paragraph.front()->GetTextContent();
     ASSERT_EQ(Text, "Hello World");
 }
+
+TEST(ParserTest, ParsesCommentsAndDoctype)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<!DOCTYPE html><html><body><!-- note --><p>Text</p><?xml version=\"1.0\"?></body></html>");
+
+    auto Root = DOM.Root();
+    ASSERT_EQ(Root->Children.size(), 2);
+    ASSERT_EQ(Root->Children[0]->Type, HtmlParser::NodeType::Doctype);
+    ASSERT_EQ(Root->Children[0]->Text, "html");
+
+    auto Body = DOM.GetElementsByTagName("body").front();
+    ASSERT_EQ(Body->Children.size(), 3);
+    ASSERT_EQ(Body->Children[0]->Type, HtmlParser::NodeType::Comment);
+    ASSERT_EQ(Body->Children[0]->Text, " note ");
+    ASSERT_EQ(Body->Children[2]->Type, HtmlParser::NodeType::Comment);
+    ASSERT_EQ(Body->Children[2]->Text, "?xml version=\"1.0\"?");
+
+    ASSERT_EQ(DOM.ToHtml(), "<!DOCTYPE html><html><head></head><body><!-- note --><p>Text</p><!--?xml version=\"1.0\"?--></body></html>");
+}
+
+TEST(ParserTest, IgnoresStrayEndTags)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<div><span>One</span></span></p>Two<div>Three</div></div>");
+
+    ASSERT_EQ(DOM.ToHtml(), "<html><head></head><body><div><span>One</span>Two<div>Three</div></div></body></html>");
+}
+
+TEST(ParserTest, MergesAdjacentText)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<p>1 < 2 </ 3 and <!-->more</p>");
+
+    auto Paragraph = DOM.GetElementsByTagName("p").front();
+    ASSERT_EQ(Paragraph->Children.size(), 3);
+    ASSERT_EQ(Paragraph->Children[0]->Text, "1 < 2 3 and ");
+    ASSERT_EQ(Paragraph->Children[1]->Type, HtmlParser::NodeType::Comment);
+    ASSERT_EQ(Paragraph->Children[2]->Text, "more");
+}
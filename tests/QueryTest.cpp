@@ -47,4 +47,26 @@ TEST(QueryTest, SelectById)
     auto Title = Query.SelectFirst("#title");
     ASSERT_NE(Title, nullptr);
     ASSERT_EQ(Title->Tag, "h1");
-}
\ No newline at end of file
+}
+
+TEST(QueryTest, SelectDescendants)
+{
+    std::string Html = R"(
+    <table>
+        <tr class="odd"><td>1</td><td><span>2</span></td></tr>
+        <tr><td>3</td></tr>
+    </table>
+    <ul><li>a<ul><li>b</li></ul></li></ul>
+    )";
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(Html);
+    HtmlParser::Query Query(DOM.Root());
+
+    // Direct children are descendants too
+    ASSERT_EQ(Query.Select("tr td").size(), 3);
+    ASSERT_EQ(Query.Select("tr.odd td").size(), 2);
+    ASSERT_EQ(Query.Select("table span").size(), 1);
+    // Matches nested inside other matches are kept, without duplicates
+    ASSERT_EQ(Query.Select("li").size(), 2);
+    ASSERT_EQ(Query.Select("ul li").size(), 2);
+}
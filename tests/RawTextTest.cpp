@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+
+TEST(RawTextTest, ScriptContentIsSingleTextNode)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<body><script>if (a < b && c > d) { document.write('<div>'); }</script><p>After</p></body>");
+
+    auto Scripts = DOM.GetElementsByTagName("script");
+    ASSERT_EQ(Scripts.size(), 1);
+    ASSERT_EQ(Scripts[0]->Children.size(), 1);
+    ASSERT_EQ(Scripts[0]->Children[0]->Text, "if (a < b && c > d) { document.write('<div>'); }");
+    ASSERT_TRUE(DOM.GetElementsByTagName("div").empty());
+    ASSERT_EQ(DOM.GetElementsByTagName("p").size(), 1);
+}
+
+TEST(RawTextTest, EndTagIsMatchedCaseInsensitively)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<style>a::after { content: '</styles>'; }</STYLE ><p>After</p>");
+
+    auto Styles = DOM.GetElementsByTagName("style");
+    ASSERT_EQ(Styles.size(), 1);
+    ASSERT_EQ(Styles[0]->GetTextContent(), "a::after { content: '</styles>'; }");
+    ASSERT_EQ(DOM.GetElementsByTagName("p").size(), 1);
+}
+
+TEST(RawTextTest, RcdataElementsDoNotParseMarkup)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<title>A <b>bold</b> title</title><textarea><p>Not a paragraph</p></textarea>");
+
+    ASSERT_EQ(DOM.GetElementsByTagName("title")[0]->GetTextContent(), "A <b>bold</b> title");
+    ASSERT_EQ(DOM.GetElementsByTagName("textarea")[0]->GetTextContent(), "<p>Not a paragraph</p>");
+    ASSERT_TRUE(DOM.GetElementsByTagName("b").empty());
+    ASSERT_TRUE(DOM.GetElementsByTagName("p").empty());
+}
+
+TEST(RawTextTest, UnterminatedScriptRunsToEndOfInput)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<script>var x = '<p>';");
+
+    auto Scripts = DOM.GetElementsByTagName("script");
+    ASSERT_EQ(Scripts.size(), 1);
+    ASSERT_EQ(Scripts[0]->GetTextContent(), "var x = '<p>';");
+}
+
+TEST(RawTextTest, SkipsRawTextContent)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetSkipRawTextContent(true);
+    HtmlParser::DOM DOM = Parser.Parse("<script>var x = 1;</script><style>p {}</style><title>Kept</title>");
+
+    ASSERT_TRUE(DOM.GetElementsByTagName("script")[0]->Children.empty());
+    ASSERT_TRUE(DOM.GetElementsByTagName("style")[0]->Children.empty());
+    ASSERT_EQ(DOM.GetElementsByTagName("title")[0]->GetTextContent(), "Kept");
+}
+
+TEST(RawTextTest, SerializesScriptUnescaped)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<html><head><script>if (a < b) {}</script></head><body></body></html>");
+
+    ASSERT_EQ(DOM.ToHtml(), "<html><head><script>if (a < b) {}</script></head><body></body></html>");
+}
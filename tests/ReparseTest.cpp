@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+
+#include <string>
+#include <vector>
+
+static const std::string PageHtml = "<!DOCTYPE html><html><head><title>Page</title></head><body>\n<div id=main><p class=intro>Hello <b>world</b></p>\n<ul><li>one</li><li>two</li></ul></div>\n<p>Footer</p></body></html>\n";
+
+// Node for node, including where each one came from
+static void ExpectSameTree(const HtmlParser::Node& Actual, const HtmlParser::Node& Expected)
+{
+    ASSERT_EQ(Actual.Type, Expected.Type);
+    ASSERT_EQ(Actual.Tag, Expected.Tag);
+    ASSERT_EQ(Actual.Text, Expected.Text);
+    ASSERT_EQ(Actual.Attributes, Expected.Attributes);
+    ASSERT_EQ(Actual.HasSourceSpan(), Expected.HasSourceSpan());
+    const HtmlParser::SourceSpan& ActualSpan = Actual.GetSourceSpan();
+    const HtmlParser::SourceSpan& ExpectedSpan = Expected.GetSourceSpan();
+    ASSERT_EQ(ActualSpan.Begin, ExpectedSpan.Begin);
+    ASSERT_EQ(ActualSpan.ContentBegin, ExpectedSpan.ContentBegin);
+    ASSERT_EQ(ActualSpan.ContentEnd, ExpectedSpan.ContentEnd);
+    ASSERT_EQ(ActualSpan.End, ExpectedSpan.End);
+    ASSERT_EQ(Actual.Children.size(), Expected.Children.size());
+    for (size_t i = 0; i < Actual.Children.size(); ++i)
+    {
+        ASSERT_EQ(Actual.Children[i]->Parent.lock().get(), &Actual);
+        ExpectSameTree(*Actual.Children[i], *Expected.Children[i]);
+    }
+}
+
+static std::string ApplyEdit(const std::string& Source, const HtmlParser::SourceEdit& Edit)
+{
+    return Source.substr(0, Edit.Offset) + std::string(Edit.Text) + Source.substr(Edit.Offset + Edit.Length);
+}
+
+TEST(ReparseTest, ReplacesOnlyTheEnclosingElement)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetTrackSourceSpans(true);
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+    auto Main = DOM.GetElementById("main");
+    auto List = DOM.GetElementsByTagName("ul").front();
+    auto Footer = DOM.GetElementsByTagName("p").back();
+
+    // "world" becomes "there, <i>everyone</i>"
+    HtmlParser::SourceEdit Edit{PageHtml.find("world"), 5, "there, <i>everyone</i>"};
+    ASSERT_TRUE(Parser.Reparse(DOM, Edit));
+
+    // Nodes outside the <b> element are the same objects as before
+    ASSERT_EQ(DOM.GetElementById("main"), Main);
+    ASSERT_EQ(DOM.GetElementsByTagName("ul").front(), List);
+    ASSERT_EQ(DOM.GetElementsByTagName("p").back(), Footer);
+    ASSERT_EQ(DOM.GetElementsByTagName("i").size(), 1);
+
+    const std::string Edited = ApplyEdit(PageHtml, Edit);
+    ASSERT_EQ(DOM.GetSource(), Edited);
+    HtmlParser::DOM Expected = Parser.Parse(Edited);
+    ExpectSameTree(*DOM.Root(), *Expected.Root());
+    ASSERT_EQ(DOM.ToHtml(), Edited);
+}
+
+TEST(ReparseTest, MatchesFullParseAcrossEdits)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetTrackSourceSpans(true);
+    Parser.SetZeroCopy(true);
+    std::string Source = PageHtml;
+    HtmlParser::DOM DOM = Parser.Parse(Source);
+
+    const HtmlParser::SourceEdit Edits[] = {
+        // Insertion, deletion and replacement inside different elements
+        {Source.find("one"), 0, "item "},
+        {Source.find("Footer"), 6, ""},
+        {Source.find("Hello"), 5, "<em>Hi</em>"},
+        // Unbalanced markup inside the element is closed by its end tag
+        {Source.find("two"), 3, "<span>two"},
+    };
+    for (const auto& Original : Edits)
+    {
+        // Offsets above are into the original source; find the same text in the current one
+        const std::string Anchor = PageHtml.substr(Original.Offset, 3);
+        HtmlParser::SourceEdit Edit = Original;
+        Edit.Offset = Source.find(Anchor);
+        ASSERT_NE(Edit.Offset, std::string::npos);
+
+        ASSERT_TRUE(Parser.Reparse(DOM, Edit));
+        Source = ApplyEdit(Source, Edit);
+        ASSERT_EQ(DOM.GetSource(), Source);
+        HtmlParser::DOM Expected = Parser.Parse(Source);
+        ExpectSameTree(*DOM.Root(), *Expected.Root());
+        ASSERT_EQ(DOM.ToHtml(), Source);
+    }
+}
+
+TEST(ReparseTest, FallsBackWhenTheEditEscapesItsElement)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetTrackSourceSpans(true);
+    const std::vector<HtmlParser::SourceEdit> Edits = {
+        // Closes the enclosing <li> and <ul> early
+        {PageHtml.find("one"), 3, "one</ul>"},
+        // Opens an element that swallows the end tag
+        {PageHtml.find("Footer"), 0, "<script>"},
+        // Touches the start tag of body
+        {PageHtml.find("<body>") + 5, 0, " class=x"},
+        // Inside <head>
+        {PageHtml.find("Page"), 4, "Title"},
+    };
+    for (const auto& Edit : Edits)
+    {
+        HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+        auto Main = DOM.GetElementById("main");
+        ASSERT_FALSE(Parser.Reparse(DOM, Edit));
+
+        const std::string Edited = ApplyEdit(PageHtml, Edit);
+        ASSERT_EQ(DOM.GetSource(), Edited);
+        HtmlParser::DOM Expected = Parser.Parse(Edited);
+        ExpectSameTree(*DOM.Root(), *Expected.Root());
+        // The rejected attempt left the old tree alone
+        ASSERT_EQ(Main->GetSourceSpan().Begin, PageHtml.find("<div"));
+    }
+}
+
+TEST(ReparseTest, FallsBackForImpliedElements)
+{
+    // Body has no start tag, so whitespace before it belongs to the after-head mode, not to body
+    const std::string Html = "<html>\n<p>a</p>X</body></html>";
+    HtmlParser::Parser Parser;
+    Parser.SetTrackSourceSpans(true);
+    HtmlParser::DOM DOM = Parser.Parse(Html);
+    const HtmlParser::SourceEdit Edit = {Html.find('X'), 1, "Y"};
+    ASSERT_FALSE(Parser.Reparse(DOM, Edit));
+
+    const std::string Edited = ApplyEdit(Html, Edit);
+    HtmlParser::DOM Expected = Parser.Parse(Edited);
+    ExpectSameTree(*DOM.Root(), *Expected.Root());
+    ASSERT_EQ(DOM.GetElementsByTagName("body").front()->Children.size(), 2u);
+}
+
+TEST(ReparseTest, FallsBackForModifiedOrSharedTrees)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetTrackSourceSpans(true);
+    const HtmlParser::SourceEdit Edit{PageHtml.find("Footer"), 6, "End"};
+
+    HtmlParser::DOM Modified = Parser.Parse(PageHtml);
+    Modified.GetElementById("main")->SetAttribute("class", "changed");
+    ASSERT_FALSE(Parser.Reparse(Modified, Edit));
+    ASSERT_EQ(Modified.ToHtml(), ApplyEdit(PageHtml, Edit));
+
+    HtmlParser::DOM Shared = Parser.Parse(PageHtml);
+    HtmlParser::DOM Copy = Shared.Clone();
+    ASSERT_FALSE(Parser.Reparse(Shared, Edit));
+    ASSERT_EQ(Copy.GetElementsByTagName("p").back()->GetTextContent(), "Footer");
+}
+
+TEST(ReparseTest, RequiresSourceSpans)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+    ASSERT_THROW(Parser.Reparse(DOM, {0, 0, "x"}), std::runtime_error);
+
+    Parser.SetTrackSourceSpans(true);
+    DOM = Parser.Parse(PageHtml);
+    ASSERT_THROW(Parser.Reparse(DOM, {PageHtml.size(), 1, ""}), std::runtime_error);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Serializer.hpp>
+#include <sstream>
+
+static const char* SampleHtml = "<!DOCTYPE html><html><head><title>A &amp; B</title><script>if (a < b) {}</script></head>"
+                                "<body><div id=\"main\"><p title='say \"hi\"'>Fish &amp; chips<br>&lt;fresh&gt;</p><!-- note --></div></body></html>";
+
+TEST(SerializerTest, WritesOuterAndInnerHtml)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(SampleHtml);
+
+    auto Paragraph = DOM.GetElementsByTagName("p").front();
+    ASSERT_EQ(Paragraph->OuterHtml(), "<p title=\"say &quot;hi&quot;\">Fish &amp; chips<br>&lt;fresh&gt;</p>");
+    ASSERT_EQ(Paragraph->InnerHtml(), "Fish &amp; chips<br>&lt;fresh&gt;");
+    ASSERT_EQ(DOM.GetElementsByTagName("script").front()->InnerHtml(), "if (a < b) {}");
+    ASSERT_EQ(DOM.Root()->InnerHtml(), DOM.ToHtml());
+}
+
+TEST(SerializerTest, PrecomputedSizeIsExact)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(SampleHtml);
+    const std::string Expected = DOM.ToHtml();
+
+    ASSERT_EQ(HtmlParser::Serializer::InnerHtmlSize(*DOM.Root()), Expected.size());
+
+    std::string Buffer = "prefix";
+    {
+        HtmlParser::Serializer Writer(Buffer);
+        Writer.SetPrecomputeSize(true);
+        Writer.WriteInnerHtml(*DOM.Root());
+    }
+    ASSERT_EQ(Buffer, "prefix" + Expected);
+}
+
+TEST(SerializerTest, WritesChunksToCallbackAndStream)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(SampleHtml);
+    const std::string Expected = DOM.ToHtml();
+
+    std::string Collected;
+    std::size_t ChunkCount = 0;
+    {
+        HtmlParser::Serializer Writer([&](std::string_view Chunk) {
+            Collected += Chunk;
+            ++ChunkCount;
+        }, 16);
+        Writer.WriteInnerHtml(*DOM.Root());
+    }
+    ASSERT_EQ(Collected, Expected);
+    ASSERT_GT(ChunkCount, 1);
+
+    std::ostringstream Stream;
+    DOM.ToHtml(Stream);
+    ASSERT_EQ(Stream.str(), Expected);
+}
+
+TEST(SerializerTest, RejectsEmptyWriter)
+{
+    ASSERT_THROW(HtmlParser::Serializer(std::function<void(std::string_view)>()), std::invalid_argument);
+}
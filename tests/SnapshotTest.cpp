@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Query.hpp>
+#include <HtmlParser/Snapshot.hpp>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+// Elements carry at most one attribute so that serialized attribute order is deterministic
+static const char* const SampleHtml = "<!DOCTYPE html><html><head><title>Snap</title></head><body>"
+                                      "<div id=\"main\"><p class=\"box wide\">One <b>two</b></p><!-- note --><p class=box>three</p></div>"
+                                      "<script>if (a < b) {}</script></body></html>";
+
+TEST(SnapshotTest, RoundTripsThroughBytes)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(SampleHtml);
+    const std::string Bytes = HtmlParser::Snapshot::Write(DOM);
+
+    const HtmlParser::Snapshot Snapshot = HtmlParser::Snapshot::FromBytes(Bytes);
+    ASSERT_EQ(Snapshot.ToDOM().ToHtml(), DOM.ToHtml());
+}
+
+TEST(SnapshotTest, QueriesWithoutBuildingNodes)
+{
+    HtmlParser::Parser Parser;
+    const std::string Bytes = HtmlParser::Snapshot::Write(Parser.Parse(SampleHtml));
+    const HtmlParser::Snapshot Snapshot = HtmlParser::Snapshot::FromBytes(Bytes);
+
+    auto Div = Snapshot.GetElementById("main");
+    ASSERT_TRUE(Div);
+    ASSERT_EQ(Div.Tag(), "div");
+    ASSERT_EQ(Div.AttributeCount(), 1u);
+    ASSERT_EQ(Div.AttributeName(0), "id");
+    ASSERT_EQ(Div.AttributeValue(0), "main");
+    ASSERT_FALSE(Div.HasAttribute("title"));
+    ASSERT_EQ(Div.GetTextContent(), "One twothree");
+    ASSERT_EQ(Div.Children().size(), 3u);
+    ASSERT_EQ(Div.Parent().Tag(), "body");
+
+    ASSERT_EQ(Snapshot.GetElementsByTagName("P").size(), 2u);
+    ASSERT_EQ(Snapshot.GetElementsByClassName("box").size(), 2u);
+    ASSERT_EQ(Snapshot.GetElementsByClassName("wide").front().GetTextContent(), "One two");
+    ASSERT_EQ(Snapshot.GetElementsByTagName("title").front().GetTextContent(), "Snap");
+    ASSERT_FALSE(Snapshot.GetElementById("missing"));
+    ASSERT_FALSE(Snapshot.Root().Parent());
+}
+
+TEST(SnapshotTest, RejectsForeignAndDamagedData)
+{
+    HtmlParser::Parser Parser;
+    std::string Bytes = HtmlParser::Snapshot::Write(Parser.Parse(SampleHtml));
+
+    ASSERT_THROW(HtmlParser::Snapshot::FromBytes("<html></html>"), std::runtime_error);
+    ASSERT_THROW(HtmlParser::Snapshot::FromBytes(std::string_view(Bytes).substr(0, Bytes.size() - 1)), std::runtime_error);
+
+    std::string NewerVersion = Bytes;
+    NewerVersion[8] = static_cast<char>(HtmlParser::Snapshot::FormatVersion + 1);
+    ASSERT_THROW(HtmlParser::Snapshot::FromBytes(NewerVersion), std::runtime_error);
+
+    // A node referring past the string table is reported when it is read
+    std::string BadString = Bytes;
+    BadString[32 + 20] = '\xff';
+    BadString[32 + 23] = '\x7f';
+    const HtmlParser::Snapshot Snapshot = HtmlParser::Snapshot::FromBytes(BadString);
+    ASSERT_THROW(Snapshot.Root().Tag(), std::runtime_error);
+
+    // The head pointing back to itself as its next sibling would otherwise loop forever
+    std::string Cycle = Bytes;
+    const std::uint32_t Head = 3;
+    std::memcpy(&Cycle[32 + Head * 40 + 12], &Head, sizeof(Head));
+    const HtmlParser::Snapshot Cyclic = HtmlParser::Snapshot::FromBytes(Cycle);
+    ASSERT_THROW(Cyclic.NodeAt(Head).Tag(), std::runtime_error);
+    ASSERT_THROW(Cyclic.NodeAt(2).Children(), std::runtime_error);
+    ASSERT_THROW(Cyclic.Select("p"), std::runtime_error);
+}
+
+TEST(SnapshotTest, SavesAndLoadsFiles)
+{
+    const auto Path = std::filesystem::temp_directory_path() / "HtmlParserSnapshotTest.snap";
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(SampleHtml);
+    DOM.SaveSnapshot(Path.string());
+
+    const std::string Expected = DOM.ToHtml();
+    {
+        HtmlParser::DOM Loaded = HtmlParser::DOM::LoadSnapshot(Path.string());
+        ASSERT_EQ(Loaded.ToHtml(), Expected);
+        ASSERT_EQ(Loaded.GetElementsByClassName("wide").front()->GetAttribute("class"), "box wide");
+
+        const HtmlParser::Snapshot Snapshot = HtmlParser::Snapshot::Open(Path.string());
+        ASSERT_EQ(Snapshot.GetElementsByTagName("script").front().GetTextContent(), "if (a < b) {}");
+    }
+    std::filesystem::remove(Path);
+}
+
+TEST(SnapshotTest, SortsAttributesByName)
+{
+    HtmlParser::Parser Parser;
+    const std::string Bytes = HtmlParser::Snapshot::Write(Parser.Parse("<a title=t href=h data-id=1 class=c>x</a>"));
+    const HtmlParser::Snapshot Snapshot = HtmlParser::Snapshot::FromBytes(Bytes);
+
+    auto Link = Snapshot.GetElementsByTagName("a").front();
+    ASSERT_EQ(Link.AttributeCount(), 4u);
+    ASSERT_EQ(Link.AttributeName(0), "class");
+    ASSERT_EQ(Link.AttributeName(3), "title");
+    ASSERT_EQ(Link.GetAttribute("href"), "h");
+    ASSERT_EQ(Link.GetAttribute("data-id"), "1");
+    ASSERT_EQ(Snapshot.ToDOM().GetElementsByTagName("a").front()->Attributes.size(), 4u);
+}
+
+TEST(SnapshotTest, FrozenDOMMatchesQueries)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<div class=list><ul><li class=a>1</li><li class='a b' data-x=y>2</li></ul><p id=p1><li>3</li></p></div>");
+    const HtmlParser::Snapshot Frozen = DOM.Freeze();
+
+    for (const std::string Selector : {"li", "div li", "ul>li", ".a.b", "li[data-x=y]", "#p1 li", "[data-x]", "DIV .a", "span"})
+    {
+        const auto Expected = HtmlParser::Query(DOM.Root()).Select(Selector);
+        const auto Actual = Frozen.Select(Selector);
+        ASSERT_EQ(Actual.size(), Expected.size()) << Selector;
+        for (std::size_t i = 0; i < Actual.size(); ++i)
+        {
+            ASSERT_EQ(Actual[i].GetTextContent(), Expected[i]->GetTextContent()) << Selector;
+        }
+    }
+    ASSERT_EQ(Frozen.SelectFirst("ul").SelectFirst(".b").GetAttribute("data-x"), "y");
+
+    std::size_t ElementCount = 0;
+    Frozen.Traverse([&](const HtmlParser::SnapshotNode& Node) { ElementCount += Node.Type() == HtmlParser::NodeType::Element; });
+    ASSERT_EQ(ElementCount, 9u);
+}
+
+TEST(SnapshotTest, SelectsDescendantsAtAnyDepth)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<table><tr class=odd><td>1</td><td><span>2</span></td></tr><tr><td>3</td></tr></table><ul><li>a<ul><li>b</li></ul></li></ul>");
+    const HtmlParser::Snapshot Frozen = DOM.Freeze();
+
+    // Direct children are descendants too, and matches nested in other matches are kept once
+    ASSERT_EQ(Frozen.Select("tr td").size(), 3u);
+    ASSERT_EQ(Frozen.Select("tr.odd td").size(), 2u);
+    ASSERT_EQ(Frozen.Select("table span").size(), 1u);
+    ASSERT_EQ(Frozen.Select("ul li").size(), 2u);
+    ASSERT_EQ(Frozen.Select("ul li").back().GetTextContent(), "b");
+}
+
+TEST(SnapshotTest, FrozenDOMIsSharedAcrossThreads)
+{
+    std::string Html = "<ul>";
+    for (int i = 0; i < 500; ++i)
+    {
+        Html += "<li class=item><a href='/" + std::to_string(i) + "'>" + std::to_string(i) + "</a></li>";
+    }
+    HtmlParser::Parser Parser;
+    const HtmlParser::Snapshot Frozen = Parser.Parse(Html + "</ul>").Freeze();
+
+    std::vector<std::size_t> Counts(4);
+    std::vector<std::thread> Threads;
+    for (std::size_t t = 0; t < Counts.size(); ++t)
+    {
+        Threads.emplace_back([&, t] {
+            for (int Round = 0; Round < 20; ++Round)
+            {
+                Counts[t] += Frozen.Select("li.item").size();
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+    {
+        Thread.join();
+    }
+    for (std::size_t Count : Counts)
+    {
+        ASSERT_EQ(Count, 500u * 20);
+    }
+}
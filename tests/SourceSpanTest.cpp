@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Serializer.hpp>
+
+// Uppercase tags, unquoted and single-quoted attributes, entities, stray end tags and implied html/head/body
+static const char* MessyHtml = "  <!doctype html>\n<TITLE>A &amp B</TITLE>\n<DIV class=box id='main'>\n"
+                               "  <P>One &lt; two</span>\n  <p>Three<BR/>four</p><!-- note -->\n</div>\n</body>\n";
+
+static HtmlParser::DOM ParseWithSpans(const std::string& Html)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetTrackSourceSpans(true);
+    return Parser.Parse(Html);
+}
+
+TEST(SourceSpanTest, UnmodifiedDocumentRoundTripsByteForByte)
+{
+    HtmlParser::DOM DOM = ParseWithSpans(MessyHtml);
+    ASSERT_EQ(DOM.ToHtml(), MessyHtml);
+
+    auto Box = DOM.GetElementById("main");
+    auto Span = Box->GetSourceSpan();
+    ASSERT_EQ(DOM.GetSource().substr(Span.ContentBegin - 25, 25), "<DIV class=box id='main'>");
+    ASSERT_EQ(DOM.GetSource().substr(Span.ContentEnd, Span.End - Span.ContentEnd), "</div>");
+
+    // Without spans the document is regenerated from the tree
+    HtmlParser::Parser Parser;
+    ASSERT_EQ(Parser.Parse(MessyHtml).ToHtml().find("<DIV"), std::string::npos);
+}
+
+TEST(SourceSpanTest, RegeneratesOnlyModifiedMarkup)
+{
+    HtmlParser::DOM DOM = ParseWithSpans(MessyHtml);
+    auto Paragraphs = DOM.GetElementsByTagName("p");
+    Paragraphs[1]->SetAttribute("lang", "en");
+    ASSERT_TRUE(Paragraphs[1]->IsDirty());
+    ASSERT_TRUE(DOM.Root()->HasDirtyDescendants());
+    ASSERT_FALSE(DOM.GetElementsByTagName("title").front()->HasDirtyDescendants());
+
+    std::string Expected = MessyHtml;
+    Expected.replace(Expected.find("<p>Three"), 3, "<p lang=\"en\">");
+    ASSERT_EQ(DOM.ToHtml(), Expected);
+
+    // The second paragraph is nested in the first, which is left open
+    auto Box = DOM.GetElementById("main");
+    Box->RemoveChild(Paragraphs[0]);
+    auto Added = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Element);
+    Added->Tag = "em";
+    Added->AppendChild(std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Text));
+    Added->Children.back()->Text = "new & shiny";
+    Box->AppendChild(Added);
+    ASSERT_FALSE(Added->HasSourceSpan());
+
+    std::string Html = DOM.ToHtml();
+    ASSERT_EQ(Html.find("Three"), std::string::npos);
+    ASSERT_NE(Html.find("<DIV class=box id='main'>\n  <em>new &amp; shiny</em></div>\n</body>\n"), std::string::npos);
+}
+
+TEST(SourceSpanTest, EditedTextAndMovedNodesAreRegenerated)
+{
+    HtmlParser::DOM DOM = ParseWithSpans("<ul><li>a</li><li>b&amp;c</li></ul><ol></ol>");
+    auto Items = DOM.GetElementsByTagName("li");
+    Items[0]->Children.front()->SetText("x < y");
+
+    auto List = DOM.GetElementsByTagName("ol").front();
+    Items[1]->Parent.lock()->RemoveChild(Items[1]);
+    List->AppendChild(Items[1]);
+    ASSERT_EQ(DOM.ToHtml(), "<ul><li>x &lt; y</li></ul><ol><li>b&amp;c</li></ol>");
+}
+
+TEST(SourceSpanTest, DiscardedContentDoesNotReappear)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetTrackSourceSpans(true);
+    HtmlParser::DiscardOptions Options;
+    Options.Elements = {"script"};
+    Options.Comments = true;
+    Options.WhitespaceText = true;
+    Parser.SetDiscardOptions(Options);
+
+    HtmlParser::DOM DOM = Parser.Parse("<div id=a>\n  <p>x<!-- gone -->y</p>\n  <script>gone()</script></div><p>kept</p>\n");
+    const std::string Html = DOM.ToHtml();
+    ASSERT_EQ(Html.find("gone"), std::string::npos);
+    ASSERT_EQ(Html, "<div id=a><p>xy</p></div><p>kept</p>");
+}
+
+TEST(SourceSpanTest, PrecomputedSizeCountsCopiedMarkup)
+{
+    HtmlParser::DOM DOM = ParseWithSpans(MessyHtml);
+    DOM.GetElementsByTagName("p").front()->SetAttribute("hidden", "");
+
+    std::string Buffer;
+    HtmlParser::Serializer Writer(Buffer);
+    Writer.SetSource(DOM.GetSource());
+    Writer.SetPrecomputeSize(true);
+    Writer.WriteInnerHtml(*DOM.Root());
+    ASSERT_EQ(Buffer, DOM.ToHtml());
+}
+
+TEST(SourceSpanTest, PrecomputedInnerSizeCountsCopiedMarkup)
+{
+    HtmlParser::DOM DOM = ParseWithSpans(MessyHtml);
+    const auto Division = DOM.GetElementsByTagName("div").front();
+    DOM.GetElementsByTagName("p").back()->SetAttribute("hidden", "");
+
+    std::string Expected;
+    {
+        HtmlParser::Serializer Writer(Expected);
+        Writer.SetSource(DOM.GetSource());
+        Writer.WriteInnerHtml(*Division);
+    }
+
+    // Reserving the exact output leaves no room for the doubling growth of a wrong estimate
+    std::string Buffer;
+    HtmlParser::Serializer Writer(Buffer);
+    Writer.SetSource(DOM.GetSource());
+    Writer.SetPrecomputeSize(true);
+    Writer.WriteInnerHtml(*Division);
+    ASSERT_EQ(Buffer, Expected);
+    ASSERT_LT(Buffer.capacity() - Buffer.size(), 16u);
+}
+
+TEST(SourceSpanTest, ClosesImpliedEndTagsBeforeGeneratedSiblings)
+{
+    struct Case
+    {
+        const char* Html;
+        const char* Parent;
+        const char* Expected;
+    };
+    const Case Cases[] = {
+        {"<body><div><p>x</div></body>", "div", "<body><div><p>x</p><em></em></div></body>"},
+        {"<ul><li>a<li>b</ul>", "ul", "<ul><li>a<li>b</li></li><em></em></ul>"},
+        {"<body><title>t", "body", "<body><title>t</title><em></em>"},
+        {"<body><textarea>x", "body", "<body><textarea>x</textarea><em></em>"},
+    };
+    for (const Case& Test : Cases)
+    {
+        HtmlParser::DOM DOM = ParseWithSpans(Test.Html);
+        auto Parent = DOM.GetElementsByTagName(Test.Parent).front();
+        auto Added = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Element);
+        Added->Tag = "em";
+        Parent->AppendChild(Added);
+
+        const std::string Html = DOM.ToHtml();
+        ASSERT_EQ(Html, Test.Expected);
+        HtmlParser::Parser Parser;
+        const auto Reparsed = Parser.Parse(Html).GetElementsByTagName("em");
+        ASSERT_EQ(Reparsed.size(), 1u) << Test.Html;
+        ASSERT_EQ(Reparsed.front()->Parent.lock()->Tag, Test.Parent);
+
+        std::string Buffer;
+        HtmlParser::Serializer Writer(Buffer);
+        Writer.SetSource(DOM.GetSource());
+        Writer.SetPrecomputeSize(true);
+        Writer.WriteInnerHtml(*DOM.Root());
+        ASSERT_EQ(Buffer, Html);
+        ASSERT_LT(Buffer.capacity() - Buffer.size(), 16u);
+    }
+
+    // Nothing changes while the element is still followed by what followed it in the source
+    HtmlParser::DOM DOM = ParseWithSpans("<ul><li>a<li>b</ul>");
+    DOM.GetElementsByTagName("li").back()->Children.front()->SetText("c");
+    ASSERT_EQ(DOM.ToHtml(), "<ul><li>a<li>c</ul>");
+}
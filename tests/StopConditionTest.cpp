@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+
+static const char* const PageHtml = R"(
+<html>
+<head>
+    <meta charset="utf-8">
+    <title>Page Title</title>
+    <link rel="stylesheet" href="style.css">
+</head>
+<body>
+    <div><p>First</p><p>Second</p></div>
+</body>
+</html>
+)";
+
+TEST(StopConditionTest, StopsAfterHead)
+{
+    HtmlParser::StopCondition Condition;
+    Condition.AfterElement = "head";
+    HtmlParser::Parser Parser;
+    Parser.SetStopCondition(Condition);
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+
+    ASSERT_EQ(DOM.GetTruncationReason(), HtmlParser::TruncationReason::StopCondition);
+    auto Title = DOM.GetElementsByTagName("title");
+    ASSERT_EQ(Title.size(), 1);
+    ASSERT_EQ(Title[0]->GetTextContent(), "Page Title");
+    ASSERT_EQ(DOM.GetElementsByTagName("meta").size(), 1);
+    ASSERT_EQ(DOM.GetElementsByTagName("link").size(), 1);
+    ASSERT_TRUE(DOM.GetElementsByTagName("body").empty());
+}
+
+TEST(StopConditionTest, StopsAfterImplicitlyClosedHead)
+{
+    HtmlParser::StopCondition Condition;
+    Condition.AfterElement = "head";
+    HtmlParser::Parser Parser;
+    Parser.SetStopCondition(Condition);
+    HtmlParser::DOM DOM = Parser.Parse("<title>Title</title><p>Body</p>");
+
+    ASSERT_TRUE(DOM.IsTruncated());
+    ASSERT_EQ(DOM.GetElementsByTagName("title").size(), 1);
+    ASSERT_TRUE(DOM.GetElementsByTagName("p").empty());
+}
+
+TEST(StopConditionTest, StopsAfterMaxElements)
+{
+    HtmlParser::StopCondition Condition;
+    Condition.MaxElements = 8;
+    HtmlParser::Parser Parser;
+    Parser.SetStopCondition(Condition);
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+
+    // html, head, meta, title, link, body, div and the first p
+    ASSERT_EQ(DOM.GetElementsByTagName("p").size(), 1);
+    ASSERT_EQ(DOM.GetElementsByTagName("p")[0]->GetTextContent(), "");
+}
+
+TEST(StopConditionTest, StopsAfterMaxBytes)
+{
+    HtmlParser::StopCondition Condition;
+    Condition.MaxBytes = 20;
+    HtmlParser::Parser Parser;
+    Parser.SetStopCondition(Condition);
+    HtmlParser::DOM DOM = Parser.Parse("<p>One</p><p>Two</p><p>Three</p>");
+
+    ASSERT_TRUE(DOM.IsTruncated());
+    ASSERT_EQ(DOM.GetElementsByTagName("p").size(), 2);
+}
+
+TEST(StopConditionTest, StopsOnTokenPredicate)
+{
+    HtmlParser::StopCondition Condition;
+    Condition.TokenPredicate = [](const HtmlParser::Token& Token) { return Token.Type == HtmlParser::TokenType::StartTag && Token.Data == "div"; };
+    HtmlParser::Parser Parser;
+    Parser.SetStopCondition(Condition);
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+
+    ASSERT_EQ(DOM.GetElementsByTagName("body").size(), 1);
+    ASSERT_TRUE(DOM.GetElementsByTagName("div").empty());
+}
+
+TEST(StopConditionTest, StopsOnNodePredicate)
+{
+    HtmlParser::StopCondition Condition;
+    Condition.NodePredicate = [](const std::shared_ptr<HtmlParser::Node>& Node) { return Node->Type == HtmlParser::NodeType::Text && Node->Text == "First"; };
+    HtmlParser::Parser Parser;
+    Parser.SetStopCondition(Condition);
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+
+    auto Paragraphs = DOM.GetElementsByTagName("p");
+    ASSERT_EQ(Paragraphs.size(), 1);
+    ASSERT_EQ(Paragraphs[0]->GetTextContent(), "First");
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+#include <HtmlParser/Snapshot.hpp>
+#include <HtmlParser/TextExtractor.hpp>
+#include <sstream>
+#include <vector>
+
+static const char* PageHtml = "<html><head><title>T</title><style>p {}</style></head><body><h1>Title</h1><p>Hello   <b>big</b>\n world</p>"
+                              "<script>var x;</script><div hidden>secret</div><ul><li>one</li><li>two</li></ul><pre>a  b\n c</pre>"
+                              "<table><tr><td>1</td><td>2</td></tr></table>a<br>b</body></html>";
+
+static std::string Extract(const HtmlParser::Node& Target, const HtmlParser::TextOptions& Options = HtmlParser::TextOptions())
+{
+    std::string Text;
+    HtmlParser::TextExtractor Extractor(Text);
+    Extractor.SetOptions(Options);
+    Extractor.Write(Target);
+    return Text;
+}
+
+TEST(TextExtractorTest, ExtractsVisibleText)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+
+    ASSERT_EQ(Extract(*DOM.Root()), "Title\nHello big world\none\ntwo\na  b\n c\n1 2\na\nb");
+    ASSERT_EQ(Extract(*DOM.GetElementsByTagName("p").front()), "Hello big world");
+}
+
+TEST(TextExtractorTest, OptionsCanBeTurnedOff)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse("<body><p>  a  </p><script>s</script><p hidden>b</p><div>c<br>d</div></body>");
+
+    HtmlParser::TextOptions Options;
+    Options.CollapseWhitespace = false;
+    ASSERT_EQ(Extract(*DOM.Root(), Options), "  a  \nc\nd");
+
+    Options = HtmlParser::TextOptions();
+    Options.SkipInvisible = false;
+    ASSERT_EQ(Extract(*DOM.Root(), Options), "a\ns\nb\nc\nd");
+
+    Options = HtmlParser::TextOptions();
+    Options.BlockSeparators = false;
+    ASSERT_EQ(Extract(*DOM.Root(), Options), "a cd");
+
+    Options.SkipInvisible = false;
+    Options.CollapseWhitespace = false;
+    ASSERT_EQ(Extract(*DOM.Root(), Options), DOM.Root()->GetTextContent());
+    ASSERT_EQ(DOM.Root()->GetTextContent(), "  a  sbcd");
+}
+
+TEST(TextExtractorTest, DecodesEntitiesOutsideRawText)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetDecodeEntities(false);
+    HtmlParser::DOM DOM = Parser.Parse("<p>Fish &amp; chips</p><script>a &amp; b</script>");
+
+    HtmlParser::TextOptions Options;
+    Options.SkipInvisible = false;
+    ASSERT_EQ(Extract(*DOM.Root(), Options), "Fish &amp; chips\na &amp; b");
+
+    Options.DecodeEntities = true;
+    ASSERT_EQ(Extract(*DOM.Root(), Options), "Fish & chips\na &amp; b");
+}
+
+TEST(TextExtractorTest, ReadsSnapshots)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+    const std::string Bytes = HtmlParser::Snapshot::Write(DOM);
+    const HtmlParser::Snapshot Flat = HtmlParser::Snapshot::FromBytes(Bytes);
+
+    std::string Text;
+    {
+        HtmlParser::TextExtractor Extractor(Text);
+        Extractor.Write(Flat.Root());
+    }
+    ASSERT_EQ(Text, Extract(*DOM.Root()));
+
+    HtmlParser::TextOptions AllText;
+    AllText.SkipInvisible = false;
+    AllText.CollapseWhitespace = false;
+    AllText.BlockSeparators = false;
+    Text.clear();
+    {
+        HtmlParser::TextExtractor Extractor(Text);
+        Extractor.SetOptions(AllText);
+        Extractor.Write(Flat.Root());
+    }
+    ASSERT_EQ(Text, Flat.Root().GetTextContent());
+}
+
+TEST(TextExtractorTest, ClassifiesUppercaseTags)
+{
+    auto Body = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Element);
+    Body->Tag = "BODY";
+    for (const char* Tag : {"P", "SCRIPT", "P"})
+    {
+        auto Element = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Element);
+        Element->Tag = Tag;
+        auto Text = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Text);
+        Text->Text = Tag;
+        Element->AppendChild(Text);
+        Body->AppendChild(Element);
+    }
+
+    ASSERT_EQ(Extract(*Body), "P\nP");
+}
+
+TEST(TextExtractorTest, WritesChunksToCallbackAndStream)
+{
+    HtmlParser::Parser Parser;
+    HtmlParser::DOM DOM = Parser.Parse(PageHtml);
+    const std::string Expected = Extract(*DOM.Root());
+
+    std::string Collected;
+    std::size_t ChunkCount = 0;
+    {
+        HtmlParser::TextExtractor Extractor([&](std::string_view Chunk) {
+            Collected += Chunk;
+            ++ChunkCount;
+        }, 8);
+        Extractor.Write(*DOM.Root());
+    }
+    ASSERT_EQ(Collected, Expected);
+    ASSERT_GT(ChunkCount, 1);
+
+    std::ostringstream Stream;
+    {
+        HtmlParser::TextExtractor Extractor(Stream);
+        Extractor.Write(*DOM.Root());
+    }
+    ASSERT_EQ(Stream.str(), Expected);
+}
+
+TEST(TextExtractorTest, RejectsEmptyWriter)
+{
+    ASSERT_THROW(HtmlParser::TextExtractor(std::function<void(std::string_view)>()), std::invalid_argument);
+}
+
+TEST(TextExtractorTest, HandlesDeepTrees)
+{
+    const std::size_t Depth = 10000;
+    auto Root = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Element);
+    Root->Tag = "div";
+    HtmlParser::Node* Current = Root.get();
+    for (std::size_t i = 0; i < Depth; ++i)
+    {
+        auto Text = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Text);
+        Text->Text = "x";
+        auto Child = std::make_shared<HtmlParser::Node>(HtmlParser::NodeType::Element);
+        Child->Tag = "span";
+        Current->Children.push_back(Text);
+        Current->Children.push_back(Child);
+        Current = Child.get();
+    }
+
+    EXPECT_EQ(Root->GetTextContent(), std::string(Depth, 'x'));
+    EXPECT_EQ(Extract(*Root), std::string(Depth, 'x'));
+
+    // ~Node releases its children recursively, which would overflow the stack in sanitizer builds, so
+    // the chain is taken apart from the top first
+    std::vector<std::shared_ptr<HtmlParser::Node>> Pending{std::move(Root)};
+    while (!Pending.empty())
+    {
+        const std::shared_ptr<HtmlParser::Node> Next = std::move(Pending.back());
+        Pending.pop_back();
+        for (auto& Child : Next->Children)
+        {
+            Pending.push_back(std::move(Child));
+        }
+        Next->Children.clear();
+    }
+}
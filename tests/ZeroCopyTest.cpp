@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <HtmlParser/DOM.hpp>
+#include <HtmlParser/Parser.hpp>
+#include <filesystem>
+#include <fstream>
+
+static bool PointsInto(std::string_view Source, const HtmlParser::StringValue& Value)
+{
+    return Value.IsBorrowed() && Value.data() >= Source.data() && Value.data() + Value.size() <= Source.data() + Source.size();
+}
+
+TEST(ZeroCopyTest, ValuesReferenceTheRetainedInput)
+{
+    HtmlParser::DOM DOM = [] {
+        // The input goes out of scope before the DOM is used
+        std::string Html = "<div id=main title='Fish &amp; chips'>Plain text<!-- note --></div><p>A &lt; B</p>";
+        HtmlParser::Parser Parser;
+        Parser.SetZeroCopy(true);
+        return Parser.Parse(Html);
+    }();
+
+    auto Div = DOM.GetElementById("main");
+    ASSERT_NE(Div, nullptr);
+    ASSERT_TRUE(PointsInto(DOM.GetSource(), Div->Attributes.at("id")));
+    ASSERT_TRUE(PointsInto(DOM.GetSource(), Div->Children[0]->Text));
+    ASSERT_TRUE(PointsInto(DOM.GetSource(), Div->Children[1]->Text));
+    ASSERT_EQ(Div->Children[0]->Text, "Plain text");
+
+    // Decoded values cannot reference the input
+    ASSERT_FALSE(Div->Attributes.at("title").IsBorrowed());
+    ASSERT_EQ(Div->GetAttribute("title"), "Fish & chips");
+    ASSERT_EQ(DOM.GetElementsByTagName("p").front()->GetTextContent(), "A < B");
+}
+
+TEST(ZeroCopyTest, ModifiedValuesAreCopied)
+{
+    HtmlParser::Parser Parser;
+    Parser.SetZeroCopy(true);
+    HtmlParser::DOM DOM = Parser.Parse("<p class=a>one</p>");
+    const std::string Source(DOM.GetSource());
+
+    auto Paragraph = DOM.GetElementsByTagName("p").front();
+    Paragraph->Children[0]->Text += " two";
+    Paragraph->SetAttribute("class", "b");
+    ASSERT_FALSE(Paragraph->Children[0]->Text.IsBorrowed());
+    ASSERT_EQ(Paragraph->Children[0]->Text, "one two");
+    ASSERT_EQ(DOM.GetSource(), Source);
+    ASSERT_EQ(DOM.ToHtml(), "<html><head></head><body><p class=\"b\">one two</p></body></html>");
+}
+
+TEST(ZeroCopyTest, MatchesCopyingParse)
+{
+    const std::string Html = "<!DOCTYPE html><title>T &amp; U</title><ul><li a=1 b=\"2\">x</li><li>y<br>z</li></ul><script>a < b</script>";
+    HtmlParser::Parser Copying;
+    HtmlParser::Parser Referencing;
+    Referencing.SetZeroCopy(true);
+    ASSERT_EQ(Referencing.Parse(Html).ToHtml(), Copying.Parse(Html).ToHtml());
+
+    // Without zero-copy nothing references the input
+    HtmlParser::DOM DOM = Copying.Parse(Html);
+    ASSERT_TRUE(DOM.GetSource().empty());
+    DOM.Traverse([](const std::shared_ptr<HtmlParser::Node>& Node) { ASSERT_FALSE(Node->Text.IsBorrowed()); });
+}
+
+TEST(ZeroCopyTest, KeepsMappedFileOpen)
+{
+    const auto Path = std::filesystem::temp_directory_path() / "HtmlParserZeroCopyTest.html";
+    {
+        std::ofstream File(Path, std::ios::binary);
+        File << "<p id=\"greeting\">Hello World</p>";
+    }
+
+    HtmlParser::Parser Parser;
+    Parser.SetZeroCopy(true);
+    HtmlParser::DOM DOM = Parser.ParseFile(Path.string());
+    std::filesystem::remove(Path);
+
+    auto Paragraph = DOM.GetElementById("greeting");
+    ASSERT_TRUE(PointsInto(DOM.GetSource(), Paragraph->Children[0]->Text));
+    ASSERT_EQ(Paragraph->GetTextContent(), "Hello World");
+}
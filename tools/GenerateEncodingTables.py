@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""Generates src/EncodingTables.hpp, the upper-half code point tables of the supported single-byte encodings.
+
+Table order must match the single-byte entries of HtmlParser::Encoding.
+Bytes 0x80-0x9F without a mapping decode to the matching C1 control, as the
+WHATWG encoding standard specifies; other unmapped bytes decode to U+FFFD.
+
+Usage: python3 tools/GenerateEncodingTables.py > src/EncodingTables.hpp
+"""
+import codecs
+
+# (Encoding enumerator, Python codec)
+SINGLE_BYTE_ENCODINGS = [
+    ("Ibm866", "cp866"),
+    ("Iso8859_2", "iso8859_2"),
+    ("Iso8859_3", "iso8859_3"),
+    ("Iso8859_4", "iso8859_4"),
+    ("Iso8859_5", "iso8859_5"),
+    ("Iso8859_6", "iso8859_6"),
+    ("Iso8859_7", "iso8859_7"),
+    ("Iso8859_8", "iso8859_8"),
+    ("Iso8859_10", "iso8859_10"),
+    ("Iso8859_13", "iso8859_13"),
+    ("Iso8859_14", "iso8859_14"),
+    ("Iso8859_15", "iso8859_15"),
+    ("Iso8859_16", "iso8859_16"),
+    ("Koi8R", "koi8_r"),
+    ("Koi8U", "koi8_u"),
+    ("Macintosh", "mac_roman"),
+    ("Windows874", "cp874"),
+    ("Windows1250", "cp1250"),
+    ("Windows1251", "cp1251"),
+    ("Windows1252", "cp1252"),
+    ("Windows1253", "cp1253"),
+    ("Windows1254", "cp1254"),
+    ("Windows1255", "cp1255"),
+    ("Windows1256", "cp1256"),
+    ("Windows1257", "cp1257"),
+    ("Windows1258", "cp1258"),
+    ("XMacCyrillic", "mac_cyrillic"),
+]
+
+# Where the WHATWG indexes differ from Python's codecs
+OVERRIDES = {
+    "Koi8U": {0xAE: 0x045E, 0xBE: 0x040E},
+}
+
+
+def table(name, codec):
+    decoder = codecs.getdecoder(codec)
+    values = []
+    for byte in range(0x80, 0x100):
+        try:
+            text = decoder(bytes([byte]))[0]
+            value = ord(text) if len(text) == 1 else 0xFFFD
+        except UnicodeDecodeError:
+            value = byte if byte < 0xA0 else 0xFFFD
+        values.append(OVERRIDES.get(name, {}).get(byte, value))
+    return values
+
+
+def main():
+    rows = []
+    for name, codec in SINGLE_BYTE_ENCODINGS:
+        values = table(name, codec)
+        lines = []
+        for start in range(0, 128, 16):
+            lines.append("            " + ", ".join("0x%04X" % v for v in values[start:start + 16]) + ",")
+        rows.append("        // %s\n        {\n%s\n        }," % (name, "\n".join(lines)))
+
+    print("""#pragma once
+#include <cstdint>
+
+// Generated by tools/GenerateEncodingTables.py; do not edit.
+
+namespace HtmlParser::EncodingTables
+{
+    inline constexpr int SingleByteEncodingCount = %d;
+
+    // Code points of bytes 0x80-0xFF
+    inline constexpr std::uint16_t SingleByteUpperHalf[SingleByteEncodingCount][128] = {
+%s
+    };
+} // namespace HtmlParser::EncodingTables""" % (len(SINGLE_BYTE_ENCODINGS), "\n".join(rows)))
+
+
+if __name__ == "__main__":
+    main()
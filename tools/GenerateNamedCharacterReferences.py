@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""Generates src/NamedCharacterReferences.hpp from the HTML5 named character reference table.
+
+The table is flattened into a breadth-first numbered trie: node i owns the
+edges [NodeEdgeStart[i], NodeEdgeStart[i + 1]), sorted by character, and
+edge e always leads to node e + 1. NodeValue[i] is a 1-based index into
+Values (0 when no reference ends at node i).
+
+Usage: python3 tools/GenerateNamedCharacterReferences.py > src/NamedCharacterReferences.hpp
+"""
+import html.entities
+
+
+def main():
+    entities = html.entities.html5
+
+    # Build a nested trie keyed by character
+    root = {}
+    for name in entities:
+        node = root
+        for c in name:
+            node = node.setdefault(c, {})
+        node[None] = name
+
+    values = []
+    value_index = {}
+    node_edge_start = []
+    node_value = []
+    edge_chars = []
+
+    # Breadth-first numbering keeps each node's edges contiguous
+    order = [root]
+    ids = {id(root): 0}
+    i = 0
+    while i < len(order):
+        node = order[i]
+        i += 1
+        for c in sorted(k for k in node if k is not None):
+            child = node[c]
+            ids[id(child)] = len(order)
+            order.append(child)
+
+    for node in order:
+        node_edge_start.append(len(edge_chars))
+        name = node.get(None)
+        if name is None:
+            node_value.append(0)
+        else:
+            codepoints = tuple(ord(c) for c in entities[name])
+            if codepoints not in value_index:
+                values.append(codepoints)
+                value_index[codepoints] = len(values)
+            node_value.append(value_index[codepoints])
+        for c in sorted(k for k in node if k is not None):
+            assert ids[id(node[c])] == len(edge_chars) + 1
+            edge_chars.append(c)
+    node_edge_start.append(len(edge_chars))
+
+    def numbers(items, per_line=24):
+        lines = []
+        for start in range(0, len(items), per_line):
+            lines.append("        " + ", ".join(str(x) for x in items[start:start + per_line]) + ",")
+        return "\n".join(lines)
+
+    def chars(items, per_line=64):
+        lines = []
+        for start in range(0, len(items), per_line):
+            lines.append('        "' + "".join(items[start:start + per_line]) + '"')
+        return "\n".join(lines)
+
+    print("""#pragma once
+#include <cstdint>
+
+// Generated by tools/GenerateNamedCharacterReferences.py; do not edit.
+
+namespace HtmlParser::CharacterReferences
+{
+    struct CodePoints
+    {
+        std::uint32_t First;
+        std::uint32_t Second;
+    };
+
+    inline constexpr std::uint32_t NodeCount = %d;
+
+    inline constexpr std::uint16_t NodeEdgeStart[] = {
+%s
+    };
+
+    inline constexpr std::uint16_t NodeValue[] = {
+%s
+    };
+
+    inline constexpr char EdgeChars[] =
+%s;
+
+    inline constexpr CodePoints Values[] = {
+        {0, 0},
+%s
+    };
+} // namespace HtmlParser::CharacterReferences""" % (
+        len(order),
+        numbers(node_edge_start),
+        numbers(node_value),
+        chars(edge_chars),
+        "\n".join("        {%d, %d}," % (v[0], v[1] if len(v) > 1 else 0) for v in values),
+    ))
+
+
+if __name__ == "__main__":
+    main()